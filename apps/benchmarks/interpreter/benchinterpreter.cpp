@@ -0,0 +1,195 @@
+#include <benchmark/benchmark.h>
+
+#include <components/compiler/context.hpp>
+#include <components/compiler/fileparser.hpp>
+#include <components/compiler/scanner.hpp>
+#include <components/compiler/streamerrorhandler.hpp>
+#include <components/interpreter/context.hpp>
+#include <components/interpreter/installopcodes.hpp>
+#include <components/interpreter/interpreter.hpp>
+#include <components/interpreter/program.hpp>
+
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace
+{
+    // Typical local script doing some arithmetic and branching each frame
+    const std::string script = R"mwscript(Begin benchmark
+short counter
+long total
+float timer
+
+set counter to 0
+set total to 0
+while ( counter < 100 )
+    if ( counter > 50 )
+        set total to ( total + counter * 2 )
+    elseif ( counter == 25 )
+        set timer to ( timer + 0.5 )
+    else
+        set total to ( total - 1 )
+    endif
+    set counter to ( counter + 1 )
+endwhile
+
+End)mwscript";
+
+    class CompilerContext final : public Compiler::Context
+    {
+    public:
+        bool canDeclareLocals() const override { return true; }
+
+        char getGlobalType(const std::string& /*name*/) const override { return ' '; }
+
+        std::pair<char, bool> getMemberType(const std::string& /*name*/, const ESM::RefId& /*id*/) const override
+        {
+            return { ' ', false };
+        }
+
+        bool isId(const ESM::RefId& /*name*/) const override { return false; }
+    };
+
+    // Supports only local variables
+    class InterpreterContext final : public Interpreter::Context
+    {
+    public:
+        std::vector<int> mShorts = std::vector<int>(1);
+        std::vector<int> mLongs = std::vector<int>(1);
+        std::vector<float> mFloats = std::vector<float>(1);
+
+        ESM::RefId getTarget() const override { return ESM::RefId(); }
+
+        int getLocalShort(int index) const override { return mShorts.at(index); }
+
+        int getLocalLong(int index) const override { return mLongs.at(index); }
+
+        float getLocalFloat(int index) const override { return mFloats.at(index); }
+
+        void setLocalShort(int index, int value) override { mShorts.at(index) = value; }
+
+        void setLocalLong(int index, int value) override { mLongs.at(index) = value; }
+
+        void setLocalFloat(int index, float value) override { mFloats.at(index) = value; }
+
+        void messageBox(std::string_view /*message*/, const std::vector<std::string>& /*buttons*/) override {}
+
+        void report(const std::string& /*message*/) override {}
+
+        int getGlobalShort(std::string_view /*name*/) const override { return 0; }
+
+        int getGlobalLong(std::string_view /*name*/) const override { return 0; }
+
+        float getGlobalFloat(std::string_view /*name*/) const override { return 0; }
+
+        void setGlobalShort(std::string_view /*name*/, int /*value*/) override {}
+
+        void setGlobalLong(std::string_view /*name*/, int /*value*/) override {}
+
+        void setGlobalFloat(std::string_view /*name*/, float /*value*/) override {}
+
+        std::vector<std::string> getGlobals() const override { return {}; }
+
+        char getGlobalType(std::string_view /*name*/) const override { return ' '; }
+
+        std::string getActionBinding(std::string_view /*action*/) const override { return {}; }
+
+        std::string_view getActorName() const override { return {}; }
+
+        std::string_view getNPCRace() const override { return {}; }
+
+        std::string_view getNPCClass() const override { return {}; }
+
+        std::string_view getNPCFaction() const override { return {}; }
+
+        std::string_view getNPCRank() const override { return {}; }
+
+        std::string_view getPCName() const override { return {}; }
+
+        std::string_view getPCRace() const override { return {}; }
+
+        std::string_view getPCClass() const override { return {}; }
+
+        std::string_view getPCRank() const override { return {}; }
+
+        std::string_view getPCNextRank() const override { return {}; }
+
+        int getPCBounty() const override { return 0; }
+
+        std::string_view getCurrentCellName() const override { return {}; }
+
+        int getMemberShort(ESM::RefId /*id*/, std::string_view /*name*/, bool /*global*/) const override { return 0; }
+
+        int getMemberLong(ESM::RefId /*id*/, std::string_view /*name*/, bool /*global*/) const override { return 0; }
+
+        float getMemberFloat(ESM::RefId /*id*/, std::string_view /*name*/, bool /*global*/) const override
+        {
+            return 0;
+        }
+
+        void setMemberShort(ESM::RefId /*id*/, std::string_view /*name*/, int /*value*/, bool /*global*/) override {}
+
+        void setMemberLong(ESM::RefId /*id*/, std::string_view /*name*/, int /*value*/, bool /*global*/) override {}
+
+        void setMemberFloat(ESM::RefId /*id*/, std::string_view /*name*/, float /*value*/, bool /*global*/) override
+        {
+        }
+    };
+
+    Interpreter::Program compile()
+    {
+        Compiler::StreamErrorHandler errorHandler;
+        CompilerContext compilerContext;
+        Compiler::FileParser parser(errorHandler, compilerContext);
+        std::istringstream input(script);
+        Compiler::Scanner scanner(errorHandler, input, compilerContext.getExtensions());
+        scanner.scan(parser);
+        if (!errorHandler.isGood())
+            throw std::runtime_error("Failed to compile benchmark script");
+        return parser.getProgram();
+    }
+
+    void runProgram(benchmark::State& state)
+    {
+        const Interpreter::Program program = compile();
+        Interpreter::Interpreter interpreter;
+        Interpreter::installOpcodes(interpreter);
+        InterpreterContext context;
+        for ([[maybe_unused]] auto _ : state)
+        {
+            interpreter.run(program, context);
+            benchmark::DoNotOptimize(context.mLongs[0]);
+        }
+    }
+
+    void runPreparedProgram(benchmark::State& state)
+    {
+        const Interpreter::Program program = compile();
+        Interpreter::Interpreter interpreter;
+        Interpreter::installOpcodes(interpreter);
+        const std::vector<Interpreter::PreparedInstruction> instructions = interpreter.prepare(program);
+        InterpreterContext context;
+        for ([[maybe_unused]] auto _ : state)
+        {
+            interpreter.run(program, instructions, context);
+            benchmark::DoNotOptimize(context.mLongs[0]);
+        }
+    }
+
+    void prepareProgram(benchmark::State& state)
+    {
+        const Interpreter::Program program = compile();
+        Interpreter::Interpreter interpreter;
+        Interpreter::installOpcodes(interpreter);
+        for ([[maybe_unused]] auto _ : state)
+            benchmark::DoNotOptimize(interpreter.prepare(program));
+    }
+}
+
+BENCHMARK(runProgram);
+BENCHMARK(runPreparedProgram);
+BENCHMARK(prepareProgram);
+
+BENCHMARK_MAIN();
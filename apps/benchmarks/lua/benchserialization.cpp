@@ -0,0 +1,89 @@
+#include <benchmark/benchmark.h>
+
+#include <components/lua/serialization.hpp>
+
+#include <string>
+
+namespace
+{
+    // Typical payload of an event sent by a local script
+    sol::table makeSmallEvent(sol::state& lua)
+    {
+        sol::table table(lua, sol::create);
+        table["x"] = 1.5;
+        table["y"] = -2.5;
+        table["name"] = "attack";
+        table["flag"] = true;
+        return table;
+    }
+
+    sol::table makeArray(sol::state& lua)
+    {
+        sol::table table(lua, sol::create);
+        for (int i = 1; i <= 1000; ++i)
+            table[i] = i * 0.5;
+        return table;
+    }
+
+    sol::table makeNestedRecords(sol::state& lua)
+    {
+        sol::table table(lua, sol::create);
+        for (int i = 1; i <= 100; ++i)
+        {
+            sol::table record(lua, sol::create);
+            record["id"] = "record_" + std::to_string(i);
+            record["count"] = i;
+            record["enabled"] = i % 2 == 0;
+            sol::table position(lua, sol::create);
+            position[1] = i;
+            position[2] = -i;
+            position[3] = 0;
+            record["position"] = position;
+            table[i] = record;
+        }
+        return table;
+    }
+
+    template <sol::table (*makeTable)(sol::state&)>
+    void serialize(benchmark::State& state)
+    {
+        sol::state lua;
+        const sol::table table = makeTable(lua);
+        for ([[maybe_unused]] auto _ : state)
+            benchmark::DoNotOptimize(LuaUtil::serialize(table));
+    }
+
+    template <sol::table (*makeTable)(sol::state&)>
+    void serializeToReusedBuffer(benchmark::State& state)
+    {
+        sol::state lua;
+        const sol::table table = makeTable(lua);
+        LuaUtil::BinaryData buffer;
+        for ([[maybe_unused]] auto _ : state)
+        {
+            LuaUtil::serialize(buffer, table);
+            benchmark::DoNotOptimize(buffer.data());
+        }
+    }
+
+    template <sol::table (*makeTable)(sol::state&)>
+    void deserialize(benchmark::State& state)
+    {
+        sol::state lua;
+        const LuaUtil::BinaryData data = LuaUtil::serialize(makeTable(lua));
+        for ([[maybe_unused]] auto _ : state)
+            benchmark::DoNotOptimize(LuaUtil::deserialize(lua, data));
+    }
+}
+
+BENCHMARK(serialize<makeSmallEvent>);
+BENCHMARK(serialize<makeArray>);
+BENCHMARK(serialize<makeNestedRecords>);
+BENCHMARK(serializeToReusedBuffer<makeSmallEvent>);
+BENCHMARK(serializeToReusedBuffer<makeArray>);
+BENCHMARK(serializeToReusedBuffer<makeNestedRecords>);
+BENCHMARK(deserialize<makeSmallEvent>);
+BENCHMARK(deserialize<makeArray>);
+BENCHMARK(deserialize<makeNestedRecords>);
+
+BENCHMARK_MAIN();
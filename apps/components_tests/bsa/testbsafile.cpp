@@ -13,6 +13,7 @@
 #include <filesystem>
 #include <format>
 #include <fstream>
+#include <iterator>
 #include <memory>
 #include <sstream>
 #include <vector>
@@ -284,6 +285,103 @@ namespace Bsa
                     }));
         }
 
+        TEST(BSAFileTest, getFileShouldReturnFileContent)
+        {
+            const std::filesystem::path path = makeOutputPath();
+
+            const std::string content1 = "first file content";
+            const std::string content2 = "second";
+
+            {
+                std::ofstream stream;
+                stream.exceptions(std::ifstream::failbit | std::ifstream::badbit);
+
+                stream.open(path, std::ios::binary);
+
+                const auto fileSize1 = static_cast<std::uint32_t>(content1.size());
+                const auto fileSize2 = static_cast<std::uint32_t>(content2.size());
+
+                const Header header{
+                    .mFormat = static_cast<std::uint32_t>(BsaVersion::Uncompressed),
+                    .mDirSize = 28,
+                    .mFileCount = 2,
+                };
+
+                const Archive archive{
+                    .mHeader = header,
+                    .mOffsets = { fileSize1, 0, fileSize2, fileSize1, 0, 2 },
+                    .mStringBuffer = { 'a', '\0', 'b', '\0' },
+                    .mHashes = { BSAFile::Hash{ .mLow = 1, .mHigh = 2 }, BSAFile::Hash{ .mLow = 3, .mHigh = 4 } },
+                    .mTailSize = 0,
+                };
+
+                writeArchive(archive, stream);
+
+                stream << content1 << content2;
+            }
+
+            BSAFile file;
+            file.open(path);
+
+            ASSERT_EQ(file.getList().size(), 2);
+
+            for (const auto& [fileStruct, content] :
+                { std::pair(&file.getList()[0], content1), std::pair(&file.getList()[1], content2) })
+            {
+                const Files::IStreamPtr stream = file.getFile(fileStruct);
+                ASSERT_NE(stream, nullptr);
+                const std::string actual{ std::istreambuf_iterator<char>(*stream), std::istreambuf_iterator<char>() };
+                EXPECT_EQ(actual, content);
+            }
+        }
+
+        TEST(BSAFileTest, streamReturnedByGetFileShouldBeReadableAfterClose)
+        {
+            const std::filesystem::path path = makeOutputPath();
+
+            const std::string content = "file content";
+
+            {
+                std::ofstream stream;
+                stream.exceptions(std::ifstream::failbit | std::ifstream::badbit);
+
+                stream.open(path, std::ios::binary);
+
+                const auto fileSize = static_cast<std::uint32_t>(content.size());
+
+                const Header header{
+                    .mFormat = static_cast<std::uint32_t>(BsaVersion::Uncompressed),
+                    .mDirSize = 14,
+                    .mFileCount = 1,
+                };
+
+                const Archive archive{
+                    .mHeader = header,
+                    .mOffsets = { fileSize, 0, 0 },
+                    .mStringBuffer = { 'a', '\0' },
+                    .mHashes = { BSAFile::Hash{ .mLow = 1, .mHigh = 2 } },
+                    .mTailSize = 0,
+                };
+
+                writeArchive(archive, stream);
+
+                stream << content;
+            }
+
+            BSAFile file;
+            file.open(path);
+
+            ASSERT_EQ(file.getList().size(), 1);
+
+            const Files::IStreamPtr stream = file.getFile(&file.getList()[0]);
+            ASSERT_NE(stream, nullptr);
+
+            file.close();
+
+            const std::string actual{ std::istreambuf_iterator<char>(*stream), std::istreambuf_iterator<char>() };
+            EXPECT_EQ(actual, content);
+        }
+
         TEST(BSAFileTest, shouldHandleSomewhatLargeFiles)
         {
             constexpr std::uint32_t maxUInt32 = std::numeric_limits<uint32_t>::max();
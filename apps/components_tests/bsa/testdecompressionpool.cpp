@@ -0,0 +1,69 @@
+#include <components/bsa/decompressionpool.hpp>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <vector>
+
+namespace Bsa
+{
+    namespace
+    {
+        using namespace ::testing;
+        using namespace std::chrono_literals;
+
+        TEST(BsaDecompressionPoolTest, parallelForShouldCallFunctionForEachIndexOnce)
+        {
+            DecompressionPool pool(3);
+            std::vector<std::atomic<int>> calls(100);
+            pool.parallelFor(calls.size(), [&](std::size_t i) { ++calls[i]; });
+            for (const std::atomic<int>& v : calls)
+                EXPECT_EQ(v.load(), 1);
+        }
+
+        TEST(BsaDecompressionPoolTest, parallelForShouldWorkWithoutThreads)
+        {
+            DecompressionPool pool(0);
+            std::vector<int> calls(10);
+            pool.parallelFor(calls.size(), [&](std::size_t i) { ++calls[i]; });
+            EXPECT_THAT(calls, Each(1));
+        }
+
+        TEST(BsaDecompressionPoolTest, parallelForShouldRethrowException)
+        {
+            DecompressionPool pool(2);
+            std::atomic<int> calls{ 0 };
+            EXPECT_THROW(pool.parallelFor(10,
+                             [&](std::size_t i) {
+                                 ++calls;
+                                 if (i == 5)
+                                     throw std::runtime_error("error");
+                             }),
+                std::runtime_error);
+            EXPECT_EQ(calls.load(), 10);
+        }
+
+        TEST(BsaDecompressionPoolTest, parallelForShouldSupportNestedCalls)
+        {
+            DecompressionPool pool(1);
+            std::atomic<int> calls{ 0 };
+            pool.parallelFor(4, [&](std::size_t) { pool.parallelFor(4, [&](std::size_t) { ++calls; }); });
+            EXPECT_EQ(calls.load(), 16);
+        }
+
+        TEST(BsaDecompressionPoolTest, getStatsShouldReturnAccumulatedStats)
+        {
+            DecompressionPool pool(0);
+            pool.addStats(10, 20, 3ns);
+            pool.addStats(1, 2, 4ns);
+            const DecompressionStats stats = pool.getStats();
+            EXPECT_EQ(stats.mJobs, 2);
+            EXPECT_EQ(stats.mInputBytes, 11);
+            EXPECT_EQ(stats.mOutputBytes, 22);
+            EXPECT_EQ(stats.mTime, 7ns);
+        }
+    }
+}
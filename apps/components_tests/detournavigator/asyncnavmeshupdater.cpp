@@ -512,6 +512,77 @@ namespace
         EXPECT_EQ(queue.size(), 0);
     }
 
+    TEST_F(DetourNavigatorSpatialJobQueueTest, pop_should_return_nearest_to_player_for_same_predicted_tile)
+    {
+        std::list<Job> jobs;
+        SpatialJobQueue queue;
+
+        for (const TilePosition tile : { TilePosition(3, 0), TilePosition(-1, 0), TilePosition(0, 2) })
+            queue.push(jobs.emplace(
+                jobs.end(), mAgentBounds, mNavMeshCacheItem, mWorldspace, tile, ChangeType::add, mProcessTime));
+
+        const auto job = queue.pop(mPlayerTile, mPlayerTile);
+        ASSERT_TRUE(job.has_value());
+        EXPECT_EQ((*job)->mChangedTile, TilePosition(-1, 0));
+    }
+
+    TEST_F(DetourNavigatorSpatialJobQueueTest, pop_should_prefer_tiles_towards_predicted_tile)
+    {
+        std::list<Job> jobs;
+        SpatialJobQueue queue;
+
+        for (const TilePosition tile :
+            { TilePosition(-1, 0), TilePosition(0, 1), TilePosition(3, 0), TilePosition(1, 0), TilePosition(2, 0) })
+            queue.push(jobs.emplace(
+                jobs.end(), mAgentBounds, mNavMeshCacheItem, mWorldspace, tile, ChangeType::add, mProcessTime));
+
+        std::vector<TilePosition> tiles;
+        while (const auto job = queue.pop(mPlayerTile, TilePosition(3, 0)))
+            tiles.push_back((*job)->mChangedTile);
+
+        EXPECT_EQ(tiles,
+            (std::vector<TilePosition>{
+                TilePosition(1, 0), TilePosition(2, 0), TilePosition(3, 0), TilePosition(0, 1), TilePosition(-1, 0) }));
+    }
+
+    TEST_F(DetourNavigatorSpatialJobQueueTest, pop_from_empty_should_return_nullopt)
+    {
+        SpatialJobQueue queue;
+        EXPECT_FALSE(queue.pop(mPlayerTile, TilePosition(1, 1)).has_value());
+    }
+
+    TEST_F(DetourNavigatorSpatialJobQueueTest, db_job_queue_pop_should_return_up_to_max_reading_jobs_nearest_first)
+    {
+        std::list<Job> jobs;
+        DbJobQueue queue;
+
+        for (const TilePosition tile : { TilePosition(2, 0), TilePosition(0, 0), TilePosition(1, 0) })
+            queue.push(jobs.emplace(
+                jobs.end(), mAgentBounds, mNavMeshCacheItem, mWorldspace, tile, ChangeType::add, mProcessTime));
+
+        const std::vector<JobIt> first = queue.pop(2);
+        ASSERT_EQ(first.size(), 2);
+        EXPECT_EQ(first[0]->mChangedTile, TilePosition(0, 0));
+        EXPECT_EQ(first[1]->mChangedTile, TilePosition(1, 0));
+
+        const std::vector<JobIt> second = queue.pop(2);
+        ASSERT_EQ(second.size(), 1);
+        EXPECT_EQ(second[0]->mChangedTile, TilePosition(2, 0));
+    }
+
+    TEST(DetourNavigatorLatencyHistogramTest, add_should_increment_bucket_with_upper_bound_greater_than_value)
+    {
+        using namespace std::chrono_literals;
+        LatencyHistogram histogram;
+        histogram.add(0ms);
+        histogram.add(3ms);
+        histogram.add(4ms);
+        histogram.add(100ms);
+        histogram.add(1024ms);
+        histogram.add(1h);
+        EXPECT_EQ(histogram.mCounts, (std::array<std::size_t, 6>{ 2, 1, 0, 1, 0, 2 }));
+    }
+
     struct DetourNavigatorJobQueueTest : DetourNavigatorSpatialJobQueueTest
     {
     };
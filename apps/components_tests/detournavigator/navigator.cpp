@@ -2,6 +2,7 @@
 #include "settings.hpp"
 
 #include <components/bullethelpers/heightfield.hpp>
+#include <components/detournavigator/asyncpathfinder.hpp>
 #include <components/detournavigator/navigatorimpl.hpp>
 #include <components/detournavigator/navigatorutils.hpp>
 #include <components/detournavigator/navmeshdb.hpp>
@@ -21,11 +22,13 @@
 #include <gtest/gtest.h>
 
 #include <array>
+#include <chrono>
 #include <condition_variable>
 #include <deque>
 #include <limits>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <thread>
 
 MATCHER_P3(Vec3fEq, x, y, z, "")
@@ -182,6 +185,130 @@ namespace
             << mPath;
     }
 
+    TEST_F(DetourNavigatorNavigatorTest, update_with_shared_rasterization_then_find_path_should_return_path)
+    {
+        mSettings.mMaxRasterizedRecastMeshCacheSize = 16;
+        mNavigator.reset(new NavigatorImpl(
+            mSettings, std::make_unique<NavMeshDb>(":memory:", std::numeric_limits<std::uint64_t>::max())));
+
+        const HeightfieldSurface surface = makeSquareHeightfieldSurface(defaultHeightfieldData);
+        const int cellSize = heightfieldTileSize * static_cast<int>(surface.mSize - 1);
+        const AgentBounds otherAgentBounds{ CollisionShapeType::Aabb, { 41, 41, 93 } };
+
+        ASSERT_TRUE(mNavigator->addAgent(mAgentBounds));
+        ASSERT_TRUE(mNavigator->addAgent(otherAgentBounds));
+        auto updateGuard = mNavigator->makeUpdateGuard();
+        mNavigator->addHeightfield(mCellPosition, cellSize, surface, updateGuard.get());
+        mNavigator->update(mPlayerPosition, updateGuard.get());
+        updateGuard.reset();
+        mNavigator->wait(WaitConditionType::requiredTilesPresent, &mListener);
+
+        EXPECT_EQ(findPath(*mNavigator, mAgentBounds, mStart, mEnd, Flag_walk, mAreaCosts, mEndTolerance, {}, mOut),
+            Status::Success);
+
+        EXPECT_THAT(mPath,
+            ElementsAre( //
+                Vec3fEq(56.66664886474609375, 460, 1.99999392032623291015625),
+                Vec3fEq(460, 56.66664886474609375, 1.99999392032623291015625)))
+            << mPath;
+
+        mPath.clear();
+
+        EXPECT_EQ(findPath(*mNavigator, otherAgentBounds, mStart, mEnd, Flag_walk, mAreaCosts, mEndTolerance, {},
+                      mOut),
+            Status::Success);
+    }
+
+    std::optional<PathResult> waitForResult(AsyncPathFinder& pathFinder, PathRequestId id)
+    {
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+        while (std::chrono::steady_clock::now() < deadline)
+        {
+            if (std::optional<PathResult> result = pathFinder.takeResult(id))
+                return result;
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return pathFinder.takeResult(id);
+    }
+
+    TEST_F(DetourNavigatorNavigatorTest, async_path_finder_should_return_same_path_as_find_path)
+    {
+        const HeightfieldSurface surface = makeSquareHeightfieldSurface(defaultHeightfieldData);
+        const int cellSize = heightfieldTileSize * static_cast<int>(surface.mSize - 1);
+
+        ASSERT_TRUE(mNavigator->addAgent(mAgentBounds));
+        auto updateGuard = mNavigator->makeUpdateGuard();
+        mNavigator->addHeightfield(mCellPosition, cellSize, surface, updateGuard.get());
+        mNavigator->update(mPlayerPosition, updateGuard.get());
+        updateGuard.reset();
+        mNavigator->wait(WaitConditionType::requiredTilesPresent, &mListener);
+
+        AsyncPathFinder pathFinder(*mNavigator, 3);
+        const PathRequest request{
+            .mAgentBounds = mAgentBounds,
+            .mStart = mStart,
+            .mEnd = mEnd,
+            .mIncludeFlags = Flag_walk,
+            .mAreaCosts = mAreaCosts,
+            .mEndTolerance = mEndTolerance,
+        };
+        std::vector<PathRequestId> ids;
+        for (int i = 0; i < 8; ++i)
+            ids.push_back(pathFinder.request(request));
+
+        EXPECT_TRUE(pathFinder.isPending(ids.front()));
+        EXPECT_FALSE(pathFinder.takeResult(ids.front()).has_value());
+
+        pathFinder.update();
+
+        for (const PathRequestId id : ids)
+        {
+            const std::optional<PathResult> result = waitForResult(pathFinder, id);
+            ASSERT_TRUE(result.has_value());
+            EXPECT_EQ(result->mStatus, Status::Success);
+            EXPECT_THAT(result->mPath,
+                ElementsAre( //
+                    Vec3fEq(56.66664886474609375, 460, 1.99999392032623291015625),
+                    Vec3fEq(460, 56.66664886474609375, 1.99999392032623291015625)));
+            EXPECT_FALSE(pathFinder.isPending(id));
+        }
+    }
+
+    TEST_F(DetourNavigatorNavigatorTest, async_path_finder_should_return_navmesh_not_found_for_unknown_agent)
+    {
+        AsyncPathFinder pathFinder(*mNavigator, 1);
+        const PathRequestId id = pathFinder.request(PathRequest{
+            .mAgentBounds = mAgentBounds,
+            .mStart = mStart,
+            .mEnd = mEnd,
+            .mIncludeFlags = Flag_walk,
+            .mAreaCosts = mAreaCosts,
+            .mEndTolerance = mEndTolerance,
+        });
+        pathFinder.update();
+        const std::optional<PathResult> result = waitForResult(pathFinder, id);
+        ASSERT_TRUE(result.has_value());
+        EXPECT_EQ(result->mStatus, Status::NavMeshNotFound);
+        EXPECT_THAT(result->mPath, IsEmpty());
+    }
+
+    TEST_F(DetourNavigatorNavigatorTest, async_path_finder_should_forget_cancelled_request)
+    {
+        AsyncPathFinder pathFinder(*mNavigator, 1);
+        const PathRequestId id = pathFinder.request(PathRequest{
+            .mAgentBounds = mAgentBounds,
+            .mStart = mStart,
+            .mEnd = mEnd,
+            .mIncludeFlags = Flag_walk,
+            .mAreaCosts = mAreaCosts,
+            .mEndTolerance = mEndTolerance,
+        });
+        pathFinder.cancel(id);
+        pathFinder.update();
+        EXPECT_FALSE(pathFinder.isPending(id));
+        EXPECT_FALSE(pathFinder.takeResult(id).has_value());
+    }
+
     TEST_F(DetourNavigatorNavigatorTest, find_path_to_the_start_position_should_contain_single_point)
     {
         const HeightfieldSurface surface = makeSquareHeightfieldSurface(defaultHeightfieldData);
@@ -167,6 +167,70 @@ namespace
                     << "x=" << x << " y=" << y;
     }
 
+    TEST_F(DetourNavigatorNavMeshDbTest, get_tiles_data_should_return_matching_tiles_inside_given_rectangle)
+    {
+        TileId tileId{ 1 };
+        const TileVersion version{ 1 };
+        const ESM::RefId worldspace = ESM::RefId::stringRefId("sys::default");
+        const std::vector<std::byte> input = generateData();
+        const std::vector<std::byte> data = generateData();
+        for (int x = -2; x <= 2; ++x)
+        {
+            for (int y = -2; y <= 2; ++y)
+            {
+                ASSERT_EQ(mDb.insertTile(tileId, worldspace, TilePosition{ x, y }, version, input, data), 1);
+                ++tileId;
+            }
+        }
+        const TilesPositionsRange range{ TilePosition{ -1, 0 }, TilePosition{ 2, 2 } };
+        const std::vector<std::byte> otherInput = generateData();
+        const std::vector<TileInputAt> tiles{
+            TileInputAt{ .mTilePosition = TilePosition{ -1, 0 }, .mInput = &input },
+            TileInputAt{ .mTilePosition = TilePosition{ 1, 1 }, .mInput = &input },
+            TileInputAt{ .mTilePosition = TilePosition{ 0, 1 }, .mInput = &otherInput },
+            TileInputAt{ .mTilePosition = TilePosition{ 2, 2 }, .mInput = &input },
+        };
+        const std::vector<std::optional<TileData>> result = mDb.getTilesData(worldspace, range, tiles);
+        ASSERT_EQ(result.size(), 4);
+        ASSERT_TRUE(result[0].has_value());
+        EXPECT_EQ(result[0]->mTileId, TileId{ 8 });
+        EXPECT_EQ(result[0]->mVersion, version);
+        EXPECT_EQ(result[0]->mData, data);
+        ASSERT_TRUE(result[1].has_value());
+        EXPECT_EQ(result[1]->mTileId, TileId{ 19 });
+        EXPECT_EQ(result[1]->mData, data);
+        EXPECT_FALSE(result[2].has_value());
+        EXPECT_FALSE(result[3].has_value());
+    }
+
+    TEST_F(DetourNavigatorNavMeshDbTest, get_tiles_data_should_match_tiles_with_different_input_for_same_position)
+    {
+        const TileVersion version{ 1 };
+        const ESM::RefId worldspace = ESM::RefId::stringRefId("sys::default");
+        const TilePosition tilePosition{ 3, 4 };
+        const std::vector<std::byte> input1 = generateData();
+        const std::vector<std::byte> input2 = generateData();
+        const std::vector<std::byte> data1 = generateData();
+        const std::vector<std::byte> data2 = generateData();
+        ASSERT_EQ(mDb.insertTile(TileId{ 53 }, worldspace, tilePosition, version, input1, data1), 1);
+        ASSERT_EQ(mDb.insertTile(TileId{ 54 }, worldspace, tilePosition, version, input2, data2), 1);
+        ASSERT_EQ(mDb.insertTile(TileId{ 55 }, ESM::RefId::stringRefId("other"), tilePosition, version, input1, data1),
+            1);
+        const std::vector<TileInputAt> tiles{
+            TileInputAt{ .mTilePosition = tilePosition, .mInput = &input2 },
+            TileInputAt{ .mTilePosition = tilePosition, .mInput = &input1 },
+        };
+        const TilesPositionsRange range{ tilePosition, tilePosition + TilePosition(1, 1) };
+        const std::vector<std::optional<TileData>> result = mDb.getTilesData(worldspace, range, tiles);
+        ASSERT_EQ(result.size(), 2);
+        ASSERT_TRUE(result[0].has_value());
+        EXPECT_EQ(result[0]->mTileId, TileId{ 54 });
+        EXPECT_EQ(result[0]->mData, data2);
+        ASSERT_TRUE(result[1].has_value());
+        EXPECT_EQ(result[1]->mTileId, TileId{ 53 });
+        EXPECT_EQ(result[1]->mData, data1);
+    }
+
     TEST_F(DetourNavigatorNavMeshDbTest, should_support_file_size_limit)
     {
         mDb = NavMeshDb(":memory:", 4096);
@@ -0,0 +1,53 @@
+#include <components/detournavigator/playermovementpredictor.hpp>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+    using namespace testing;
+    using namespace DetourNavigator;
+    using namespace std::chrono_literals;
+
+    struct DetourNavigatorPlayerMovementPredictorTest : Test
+    {
+        const std::chrono::steady_clock::time_point mStart{};
+        PlayerMovementPredictor mPredictor{ 1000ms, 8192 };
+    };
+
+    TEST_F(DetourNavigatorPlayerMovementPredictorTest, first_update_should_return_position)
+    {
+        EXPECT_EQ(mPredictor.update(osg::Vec3f(1, 2, 3), mStart), osg::Vec3f(1, 2, 3));
+    }
+
+    TEST_F(DetourNavigatorPlayerMovementPredictorTest, should_predict_position_ahead_of_moving_player)
+    {
+        osg::Vec3f predicted;
+        for (int i = 0; i <= 100; ++i)
+            predicted = mPredictor.update(osg::Vec3f(static_cast<float>(i) * 10, 0, 0), mStart + i * 20ms);
+        EXPECT_NEAR(mPredictor.getVelocity().x(), 500, 1);
+        EXPECT_NEAR(predicted.x(), 1500, 1);
+        EXPECT_NEAR(predicted.y(), 0, 1e-3);
+    }
+
+    TEST_F(DetourNavigatorPlayerMovementPredictorTest, should_not_predict_movement_for_standing_player)
+    {
+        mPredictor.update(osg::Vec3f(1, 2, 3), mStart);
+        EXPECT_EQ(mPredictor.update(osg::Vec3f(1, 2, 3), mStart + 20ms), osg::Vec3f(1, 2, 3));
+    }
+
+    TEST_F(DetourNavigatorPlayerMovementPredictorTest, should_reset_velocity_on_teleport)
+    {
+        for (int i = 0; i <= 10; ++i)
+            mPredictor.update(osg::Vec3f(static_cast<float>(i) * 10, 0, 0), mStart + i * 20ms);
+        ASSERT_GT(mPredictor.getVelocity().x(), 0);
+        EXPECT_EQ(mPredictor.update(osg::Vec3f(1e5f, 0, 0), mStart + 220ms), osg::Vec3f(1e5f, 0, 0));
+        EXPECT_EQ(mPredictor.getVelocity(), osg::Vec3f());
+    }
+
+    TEST_F(DetourNavigatorPlayerMovementPredictorTest, reset_should_forget_previous_position)
+    {
+        mPredictor.update(osg::Vec3f(0, 0, 0), mStart);
+        mPredictor.reset();
+        EXPECT_EQ(mPredictor.update(osg::Vec3f(10, 0, 0), mStart + 20ms), osg::Vec3f(10, 0, 0));
+    }
+}
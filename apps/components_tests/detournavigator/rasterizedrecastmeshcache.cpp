@@ -0,0 +1,73 @@
+#include "settings.hpp"
+
+#include <components/detournavigator/rasterizedrecastmeshcache.hpp>
+#include <components/detournavigator/recastmesh.hpp>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+    using namespace testing;
+    using namespace DetourNavigator;
+    using namespace DetourNavigator::Tests;
+
+    struct DetourNavigatorRasterizedRecastMeshCacheTest : Test
+    {
+        const Settings mSettings = makeSettings();
+        const ESM::RefId mWorldspace = ESM::RefId::stringRefId("worldspace");
+        const TilePosition mTilePosition{ 0, 0 };
+
+        static RecastMesh makeRecastMesh(const Version& version)
+        {
+            std::vector<FlatHeightfield> flatHeightfields{
+                FlatHeightfield{ .mCellPosition = osg::Vec2i(0, 0), .mCellSize = 8192, .mHeight = 0 },
+            };
+            return RecastMesh(version, Mesh({}, {}, {}), {}, {}, std::move(flatHeightfields), {});
+        }
+    };
+
+    TEST_F(DetourNavigatorRasterizedRecastMeshCacheTest, get_should_rasterize_recast_mesh)
+    {
+        RasterizedRecastMeshCache cache(1);
+        const RecastMesh recastMesh = makeRecastMesh(Version{ .mGeneration = 1, .mRevision = 1 });
+        EXPECT_NE(cache.get(mWorldspace, mTilePosition, recastMesh, mSettings.mRecast), nullptr);
+        EXPECT_EQ(cache.getSize(), 1);
+    }
+
+    TEST_F(DetourNavigatorRasterizedRecastMeshCacheTest, get_should_return_same_value_for_same_version)
+    {
+        RasterizedRecastMeshCache cache(1);
+        const RecastMesh recastMesh = makeRecastMesh(Version{ .mGeneration = 1, .mRevision = 1 });
+        const auto value = cache.get(mWorldspace, mTilePosition, recastMesh, mSettings.mRecast);
+        EXPECT_EQ(cache.get(mWorldspace, mTilePosition, recastMesh, mSettings.mRecast), value);
+    }
+
+    TEST_F(DetourNavigatorRasterizedRecastMeshCacheTest, get_should_return_new_value_for_different_version)
+    {
+        RasterizedRecastMeshCache cache(1);
+        const auto value = cache.get(mWorldspace, mTilePosition,
+            makeRecastMesh(Version{ .mGeneration = 1, .mRevision = 1 }), mSettings.mRecast);
+        EXPECT_NE(cache.get(mWorldspace, mTilePosition, makeRecastMesh(Version{ .mGeneration = 1, .mRevision = 2 }),
+                      mSettings.mRecast),
+            value);
+        EXPECT_EQ(cache.getSize(), 1);
+    }
+
+    TEST_F(DetourNavigatorRasterizedRecastMeshCacheTest, get_should_remove_least_recently_used_value_when_full)
+    {
+        RasterizedRecastMeshCache cache(1);
+        const RecastMesh recastMesh = makeRecastMesh(Version{ .mGeneration = 1, .mRevision = 1 });
+        const auto value = cache.get(mWorldspace, mTilePosition, recastMesh, mSettings.mRecast);
+        cache.get(mWorldspace, TilePosition(1, 0), recastMesh, mSettings.mRecast);
+        EXPECT_EQ(cache.getSize(), 1);
+        EXPECT_NE(cache.get(mWorldspace, mTilePosition, recastMesh, mSettings.mRecast), value);
+    }
+
+    TEST_F(DetourNavigatorRasterizedRecastMeshCacheTest, get_for_zero_max_size_should_not_store_value)
+    {
+        RasterizedRecastMeshCache cache(0);
+        const RecastMesh recastMesh = makeRecastMesh(Version{ .mGeneration = 1, .mRevision = 1 });
+        EXPECT_NE(cache.get(mWorldspace, mTilePosition, recastMesh, mSettings.mRecast), nullptr);
+        EXPECT_EQ(cache.getSize(), 0);
+    }
+}
@@ -1,6 +1,7 @@
 
 #include <components/detournavigator/debug.hpp>
 #include <components/detournavigator/settingsutils.hpp>
+#include <components/detournavigator/stats.hpp>
 #include <components/detournavigator/tilecachedrecastmeshmanager.hpp>
 
 #include <BulletCollision/CollisionShapes/btBoxShape.h>
@@ -503,4 +504,113 @@ namespace
 
         ASSERT_EQ(manager.getCachedMesh(mWorldspace, tilePosition), nullptr);
     }
+
+    TEST_F(DetourNavigatorTileCachedRecastMeshManagerTest,
+        get_new_mesh_with_objects_triangles_cache_should_return_same_mesh_as_without)
+    {
+        TileCachedRecastMeshManager manager(mSettings);
+        TileCachedRecastMeshManager cachingManager(mSettings, std::numeric_limits<std::size_t>::max());
+        const btBoxShape boxShape(btVector3(100, 100, 20));
+        const CollisionShape shape(mInstance, boxShape, mObjectTransform);
+        const btTransform transform(btQuaternion(btVector3(0, 0, 1), 0.3f), btVector3(10, 20, 30));
+        for (TileCachedRecastMeshManager* v : { &manager, &cachingManager })
+        {
+            v->setWorldspace(mWorldspace, nullptr);
+            v->addObject(ObjectId(&boxShape), shape, transform, AreaType::AreaType_ground, nullptr);
+        }
+        const TilePosition tilePosition(0, 0);
+        const std::shared_ptr<RecastMesh> expected = manager.getNewMesh(mWorldspace, tilePosition);
+        ASSERT_NE(expected, nullptr);
+        for (int i = 0; i < 2; ++i)
+        {
+            const std::shared_ptr<RecastMesh> mesh = cachingManager.getNewMesh(mWorldspace, tilePosition);
+            ASSERT_NE(mesh, nullptr);
+            EXPECT_EQ(mesh->getMesh().getVertices(), expected->getMesh().getVertices());
+            EXPECT_EQ(mesh->getMesh().getIndices(), expected->getMesh().getIndices());
+            EXPECT_EQ(mesh->getMesh().getAreaTypes(), expected->getMesh().getAreaTypes());
+            EXPECT_EQ(mesh->getMeshSources().size(), 1);
+        }
+    }
+
+    TEST_F(DetourNavigatorTileCachedRecastMeshManagerTest, get_new_mesh_should_cache_objects_triangles)
+    {
+        TileCachedRecastMeshManager manager(mSettings, std::numeric_limits<std::size_t>::max());
+        manager.setWorldspace(mWorldspace, nullptr);
+        const btBoxShape boxShape(btVector3(20, 20, 100));
+        const CollisionShape shape(mInstance, boxShape, mObjectTransform);
+        manager.addObject(ObjectId(&boxShape), shape, btTransform::getIdentity(), AreaType::AreaType_ground, nullptr);
+        EXPECT_EQ(manager.getStats().mObjectsTrianglesCacheSize, 0);
+        ASSERT_NE(manager.getNewMesh(mWorldspace, TilePosition(0, 0)), nullptr);
+        EXPECT_GT(manager.getStats().mObjectsTrianglesCacheSize, 0);
+    }
+
+    TEST_F(DetourNavigatorTileCachedRecastMeshManagerTest, update_object_should_reset_cached_objects_triangles)
+    {
+        TileCachedRecastMeshManager manager(mSettings, std::numeric_limits<std::size_t>::max());
+        manager.setWorldspace(mWorldspace, nullptr);
+        const btBoxShape boxShape(btVector3(20, 20, 100));
+        const CollisionShape shape(mInstance, boxShape, mObjectTransform);
+        manager.addObject(ObjectId(&boxShape), shape, btTransform::getIdentity(), AreaType::AreaType_ground, nullptr);
+        ASSERT_NE(manager.getNewMesh(mWorldspace, TilePosition(0, 0)), nullptr);
+        ASSERT_GT(manager.getStats().mObjectsTrianglesCacheSize, 0);
+        const btTransform transform(btMatrix3x3::getIdentity(), btVector3(1, 0, 0));
+        manager.updateObject(ObjectId(&boxShape), transform, AreaType::AreaType_ground, nullptr);
+        EXPECT_EQ(manager.getStats().mObjectsTrianglesCacheSize, 0);
+        const std::shared_ptr<RecastMesh> mesh = manager.getNewMesh(mWorldspace, TilePosition(0, 0));
+        ASSERT_NE(mesh, nullptr);
+        EXPECT_THAT(mesh->getMesh().getVertices(), Contains(21.0f));
+    }
+
+    TEST_F(DetourNavigatorTileCachedRecastMeshManagerTest, remove_object_should_reset_cached_objects_triangles)
+    {
+        TileCachedRecastMeshManager manager(mSettings, std::numeric_limits<std::size_t>::max());
+        manager.setWorldspace(mWorldspace, nullptr);
+        const btBoxShape boxShape(btVector3(20, 20, 100));
+        const CollisionShape shape(mInstance, boxShape, mObjectTransform);
+        manager.addObject(ObjectId(&boxShape), shape, btTransform::getIdentity(), AreaType::AreaType_ground, nullptr);
+        ASSERT_NE(manager.getNewMesh(mWorldspace, TilePosition(0, 0)), nullptr);
+        ASSERT_GT(manager.getStats().mObjectsTrianglesCacheSize, 0);
+        manager.removeObject(ObjectId(&boxShape), nullptr);
+        EXPECT_EQ(manager.getStats().mObjectsTrianglesCacheSize, 0);
+    }
+
+    TEST_F(DetourNavigatorTileCachedRecastMeshManagerTest, get_new_mesh_should_not_exceed_objects_triangles_cache_size)
+    {
+        TileCachedRecastMeshManager manager(mSettings, 1);
+        manager.setWorldspace(mWorldspace, nullptr);
+        const btBoxShape boxShape(btVector3(20, 20, 100));
+        const CollisionShape shape(mInstance, boxShape, mObjectTransform);
+        manager.addObject(ObjectId(&boxShape), shape, btTransform::getIdentity(), AreaType::AreaType_ground, nullptr);
+        ASSERT_NE(manager.getNewMesh(mWorldspace, TilePosition(0, 0)), nullptr);
+        EXPECT_EQ(manager.getStats().mObjectsTrianglesCacheSize, 0);
+    }
+
+    TEST_F(DetourNavigatorTileCachedRecastMeshManagerTest,
+        get_new_mesh_should_evict_least_recently_used_objects_triangles_when_cache_is_full)
+    {
+        const btBoxShape boxShape(btVector3(20, 20, 100));
+        const CollisionShape shape(mInstance, boxShape, mObjectTransform);
+        // Object is inside all tiles with borders so triangles are the same for each tile
+        std::size_t size = 0;
+        {
+            TileCachedRecastMeshManager manager(mSettings, std::numeric_limits<std::size_t>::max());
+            manager.setWorldspace(mWorldspace, nullptr);
+            manager.addObject(
+                ObjectId(&boxShape), shape, btTransform::getIdentity(), AreaType::AreaType_ground, nullptr);
+            ASSERT_NE(manager.getNewMesh(mWorldspace, TilePosition(0, 0)), nullptr);
+            size = manager.getStats().mObjectsTrianglesCacheSize;
+            ASSERT_GT(size, 0);
+        }
+        TileCachedRecastMeshManager manager(mSettings, 2 * size);
+        manager.setWorldspace(mWorldspace, nullptr);
+        manager.addObject(ObjectId(&boxShape), shape, btTransform::getIdentity(), AreaType::AreaType_ground, nullptr);
+        ASSERT_NE(manager.getNewMesh(mWorldspace, TilePosition(0, 0)), nullptr);
+        ASSERT_NE(manager.getNewMesh(mWorldspace, TilePosition(-1, -1)), nullptr);
+        ASSERT_NE(manager.getNewMesh(mWorldspace, TilePosition(0, 0)), nullptr);
+        ASSERT_NE(manager.getNewMesh(mWorldspace, TilePosition(-1, 0)), nullptr);
+        EXPECT_EQ(manager.getStats().mObjectsTrianglesCacheSize, 2 * size);
+        // Drop triangles for all tiles except (-1, -1) which is expected to be evicted
+        manager.setRange(TilesPositionsRange{ TilePosition(-1, -1), TilePosition(0, 0) }, nullptr);
+        EXPECT_EQ(manager.getStats().mObjectsTrianglesCacheSize, 0);
+    }
 }
@@ -1,9 +1,16 @@
 #include <components/esm3/readerscache.hpp>
 #include <components/files/collections.hpp>
 #include <components/files/multidircollection.hpp>
+#include <components/testing/util.hpp>
+#include <components/toutf8/toutf8.hpp>
 
 #include <gtest/gtest.h>
 
+#include <atomic>
+#include <fstream>
+#include <thread>
+#include <vector>
+
 #ifndef OPENMW_DATA_DIR
 #error "OPENMW_DATA_DIR is not defined"
 #endif
@@ -35,6 +42,111 @@ namespace
         EXPECT_FALSE(reader->isOpen());
     }
 
+    struct ESM3ReadersCacheWithFile : Test
+    {
+        const std::filesystem::path mPath = TestingOpenMW::outputFilePath("readerscache.omwaddon");
+
+        ESM3ReadersCacheWithFile() { std::ofstream(mPath, std::ios::binary) << "0123456789"; }
+    };
+
+    TEST_F(ESM3ReadersCacheWithFile, shouldCreateAnotherReaderForBusyReaderOpenedBefore)
+    {
+        ReadersCache readers(1);
+        readers.get(0)->openRaw(mPath);
+        const ReadersCache::BusyItem reader0 = readers.get(0);
+        const ReadersCache::BusyItem reader1 = readers.get(0);
+        EXPECT_NE(&*reader0, &*reader1);
+        EXPECT_TRUE(reader1->isOpen());
+        EXPECT_EQ(reader1->getName(), mPath);
+        EXPECT_EQ(reader1->getFileSize(), 10);
+        EXPECT_EQ(reader1->getIndex(), 0);
+    }
+
+    TEST_F(ESM3ReadersCacheWithFile, readersForTheSameFileShouldHaveIndependentPositions)
+    {
+        ReadersCache readers;
+        readers.get(0)->openRaw(mPath);
+        const ReadersCache::BusyItem reader0 = readers.get(0);
+        const ReadersCache::BusyItem reader1 = readers.get(0);
+        reader0->skip(3);
+        reader1->skip(7);
+        EXPECT_EQ(reader0->getFileOffset(), 3);
+        EXPECT_EQ(reader1->getFileOffset(), 7);
+    }
+
+    TEST_F(ESM3ReadersCacheWithFile, releasedReaderShouldBeReused)
+    {
+        ReadersCache readers;
+        readers.get(0)->openRaw(mPath);
+        const ESMReader* reader0 = nullptr;
+        const ESMReader* reader1 = nullptr;
+        {
+            const ReadersCache::BusyItem busy0 = readers.get(0);
+            const ReadersCache::BusyItem busy1 = readers.get(0);
+            reader0 = &*busy0;
+            reader1 = &*busy1;
+        }
+        const ReadersCache::BusyItem busy0 = readers.get(0);
+        const ReadersCache::BusyItem busy1 = readers.get(0);
+        EXPECT_TRUE((&*busy0 == reader0 && &*busy1 == reader1) || (&*busy0 == reader1 && &*busy1 == reader0));
+    }
+
+    TEST_F(ESM3ReadersCacheWithFile, eachReaderShouldHaveOwnEncoder)
+    {
+        ToUTF8::Utf8Encoder encoder(ToUTF8::WINDOWS_1252);
+        ReadersCache readers;
+        {
+            const ReadersCache::BusyItem reader = readers.get(0);
+            reader->setEncoder(&encoder);
+            reader->openRaw(mPath);
+        }
+        const ReadersCache::BusyItem reader0 = readers.get(0);
+        const ReadersCache::BusyItem reader1 = readers.get(0);
+        EXPECT_NE(reader0->getEncoder(), nullptr);
+        EXPECT_NE(reader0->getEncoder(), &encoder);
+        EXPECT_NE(reader1->getEncoder(), nullptr);
+        EXPECT_NE(reader1->getEncoder(), &encoder);
+        EXPECT_NE(reader0->getEncoder(), reader1->getEncoder());
+    }
+
+    TEST_F(ESM3ReadersCacheWithFile, shouldSupportGettingReadersForTheSameFileFromMultipleThreads)
+    {
+        ReadersCache readers(2);
+        readers.get(0)->openRaw(mPath);
+        std::vector<std::thread> threads;
+        std::atomic<std::size_t> failures{ 0 };
+        for (std::size_t i = 0; i < 4; ++i)
+            threads.emplace_back([&] {
+                for (std::size_t j = 0; j < 100; ++j)
+                {
+                    const ReadersCache::BusyItem reader = readers.get(0);
+                    if (!reader->isOpen())
+                        reader->openRaw(mPath);
+                    if (reader->getFileOffset() < 9)
+                        reader->skip(1);
+                    if (reader->getName() != mPath || readers.getFileSize(0) != 10)
+                        ++failures;
+                }
+            });
+        for (std::thread& thread : threads)
+            thread.join();
+        EXPECT_EQ(failures.load(), 0);
+    }
+
+    TEST_F(ESM3ReadersCacheWithFile, shouldWaitForReaderBeingOpenedByAnotherThread)
+    {
+        ReadersCache readers;
+        std::thread thread;
+        std::atomic_bool isOpen{ false };
+        {
+            const ReadersCache::BusyItem reader = readers.get(0);
+            thread = std::thread([&] { isOpen = readers.get(0)->isOpen(); });
+            reader->openRaw(mPath);
+        }
+        thread.join();
+        EXPECT_TRUE(isOpen);
+    }
+
     struct ESM3ReadersCacheWithContentFile : Test
     {
         static constexpr std::size_t sInitialOffset = 324;
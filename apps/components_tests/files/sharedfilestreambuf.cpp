@@ -0,0 +1,92 @@
+#include <components/files/sharedfilestreambuf.hpp>
+#include <components/testing/util.hpp>
+
+#include <gtest/gtest.h>
+
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    using namespace testing;
+    using namespace Files;
+
+    struct FilesSharedFileStreamBuf : Test
+    {
+        const std::filesystem::path mPath = TestingOpenMW::outputFilePath("sharedfilestreambuf.bin");
+        std::string mContent;
+        std::shared_ptr<const Platform::File::ScopedHandle> mFile;
+
+        FilesSharedFileStreamBuf()
+        {
+            for (std::size_t i = 0; i < 20000; ++i)
+                mContent.push_back(static_cast<char>('a' + i % 26));
+            std::ofstream(mPath, std::ios::binary) << mContent;
+            mFile = std::make_shared<const Platform::File::ScopedHandle>(Platform::File::open(mPath));
+        }
+    };
+
+    TEST_F(FilesSharedFileStreamBuf, shouldReadWholeFile)
+    {
+        const IStreamPtr stream = openSharedFileStream(mFile);
+        const std::string result(std::istreambuf_iterator<char>(*stream), {});
+        EXPECT_EQ(result, mContent);
+    }
+
+    TEST_F(FilesSharedFileStreamBuf, streamsShouldHaveIndependentPositions)
+    {
+        const IStreamPtr first = openSharedFileStream(mFile);
+        const IStreamPtr second = openSharedFileStream(mFile);
+        first->seekg(10000);
+        std::string firstValue(5, '\0');
+        std::string secondValue(5, '\0');
+        first->read(firstValue.data(), 5);
+        second->read(secondValue.data(), 5);
+        EXPECT_EQ(firstValue, mContent.substr(10000, 5));
+        EXPECT_EQ(secondValue, mContent.substr(0, 5));
+        EXPECT_EQ(first->tellg(), 10005);
+        EXPECT_EQ(second->tellg(), 5);
+    }
+
+    TEST_F(FilesSharedFileStreamBuf, shouldSupportSeekRelativeToCurrentAndEnd)
+    {
+        const IStreamPtr stream = openSharedFileStream(mFile);
+        stream->seekg(100);
+        char value = 0;
+        stream->get(value);
+        stream->seekg(-11, std::ios_base::cur);
+        EXPECT_EQ(stream->tellg(), 90);
+        stream->get(value);
+        EXPECT_EQ(value, mContent[90]);
+        stream->seekg(-1, std::ios_base::end);
+        stream->get(value);
+        EXPECT_EQ(value, mContent.back());
+        EXPECT_EQ(stream->get(), std::char_traits<char>::eof());
+    }
+
+    TEST_F(FilesSharedFileStreamBuf, shouldFailToSeekBeyondEnd)
+    {
+        const IStreamPtr stream = openSharedFileStream(mFile);
+        stream->seekg(mContent.size() + 1);
+        EXPECT_TRUE(stream->fail());
+    }
+
+    TEST_F(FilesSharedFileStreamBuf, shouldSupportReadingFromMultipleThreads)
+    {
+        std::vector<std::string> results(4);
+        std::vector<std::thread> threads;
+        for (std::size_t i = 0; i < results.size(); ++i)
+            threads.emplace_back([&, i] {
+                const IStreamPtr stream = openSharedFileStream(mFile);
+                stream->seekg(i * 1000);
+                results[i].assign(std::istreambuf_iterator<char>(*stream), {});
+            });
+        for (std::thread& thread : threads)
+            thread.join();
+        for (std::size_t i = 0; i < results.size(); ++i)
+            EXPECT_EQ(results[i], mContent.substr(i * 1000)) << i;
+    }
+}
@@ -5,6 +5,11 @@
 #include <components/testing/expecterror.hpp>
 #include <components/testing/util.hpp>
 
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+
 namespace
 {
     using namespace testing;
@@ -262,4 +267,58 @@ return {
         // without safe get we crash here
         EXPECT_ERROR(LuaUtil::safeGet(t, "any key"), "meta index error");
     }
+
+    TEST_F(LuaStateTest, GuardedCFunctionCallsFromSeveralStatesShouldNotOverlap)
+    {
+        constexpr int statesCount = 4;
+        constexpr int callsCount = 1000;
+        std::recursive_mutex mutex;
+        std::atomic_int activeCalls{ 0 };
+        std::atomic_int overlaps{ 0 };
+        int calls = 0;
+        std::vector<std::unique_ptr<LuaUtil::LuaState>> states;
+        for (int i = 0; i < statesCount; ++i)
+        {
+            LuaUtil::LuaState& lua = *states.emplace_back(std::make_unique<LuaUtil::LuaState>(mVFS.get(), &mCfg));
+            if (!lua.guardCFunctionCalls())
+                GTEST_SKIP() << "C function calls can be guarded only with LuaJIT";
+            lua.protectedCall([&](LuaUtil::LuaView& view) {
+                view.sol()["engineCall"] = [&] {
+                    if (activeCalls.fetch_add(1) != 0)
+                        ++overlaps;
+                    ++calls;
+                    std::this_thread::yield();
+                    activeCalls.fetch_sub(1);
+                };
+            });
+        }
+        std::vector<std::thread> threads;
+        for (const std::unique_ptr<LuaUtil::LuaState>& lua : states)
+            threads.emplace_back([&, lua = lua.get()] {
+                const LuaUtil::CFunctionCallsGuard guard(mutex);
+                lua->protectedCall([&](LuaUtil::LuaView& view) {
+                    view.sol().script("for i = 1, " + std::to_string(callsCount) + " do engineCall() end");
+                });
+            });
+        for (std::thread& thread : threads)
+            thread.join();
+        EXPECT_EQ(overlaps.load(), 0);
+        EXPECT_EQ(calls, statesCount * callsCount);
+    }
+
+    TEST_F(LuaStateTest, GuardedCFunctionCallShouldReleaseMutexOnError)
+    {
+        if (!mLua.guardCFunctionCalls())
+            GTEST_SKIP() << "C function calls can be guarded only with LuaJIT";
+        std::recursive_mutex mutex;
+        const LuaUtil::CFunctionCallsGuard guard(mutex);
+        mLua.protectedCall([&](LuaUtil::LuaView& view) {
+            view.sol()["fail"] = [] { throw std::runtime_error("engine error"); };
+            EXPECT_FALSE(view.sol().script("return pcall(fail)").get<bool>());
+        });
+        std::thread([&] {
+            EXPECT_TRUE(mutex.try_lock());
+            mutex.unlock();
+        }).join();
+    }
 }
@@ -0,0 +1,174 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <components/esm/luascripts.hpp>
+
+#include <components/lua/luastate.hpp>
+#include <components/lua/profiler.hpp>
+#include <components/lua/scriptscontainer.hpp>
+
+#include <components/testing/util.hpp>
+
+#include <sstream>
+
+namespace
+{
+    using namespace testing;
+    using namespace TestingOpenMW;
+
+    constexpr VFS::Path::NormalizedView busyPath("busy.lua");
+
+    VFSTestFile busyScript(R"X(
+local function square(x) return x * x end
+local sum = 0
+local tables = {}
+return {
+    engineHandlers = {
+        onUpdate = function()
+            for i = 1, 10000 do
+                sum = sum + square(i)
+            end
+        end,
+    },
+    eventHandlers = {
+        Allocate = function()
+            for i = 1, 100 do
+                tables[i] = { i, tostring(i) }
+            end
+        end,
+    },
+}
+)X");
+
+    struct LuaProfilerTest : Test
+    {
+        std::unique_ptr<VFS::Manager> mVFS = createTestVFS({ { busyPath, &busyScript } });
+
+        LuaUtil::ScriptsConfiguration mCfg;
+        LuaUtil::LuaState mLua{ mVFS.get(), &mCfg };
+        LuaUtil::Profiler mProfiler;
+        LuaUtil::ScriptsContainer mScripts{ &mLua, "Test" };
+        const LuaUtil::Profiler::HandlerId mUpdateId{ "busy.lua", "onUpdate" };
+        const LuaUtil::Profiler::HandlerId mEventId{ "busy.lua", "Allocate" };
+
+        LuaProfilerTest()
+        {
+            ESM::LuaScriptsCfg cfg;
+            LuaUtil::parseOMWScripts(cfg, "CUSTOM: busy.lua\n");
+            mCfg.init(std::move(cfg), false);
+            mLua.setProfiler(&mProfiler);
+            mScripts.addCustomScript(*mCfg.findId(busyPath));
+        }
+
+        void sendAllocateEvent()
+        {
+            mScripts.receiveEvent("Allocate", LuaUtil::serialize(sol::state_view(mLua.unsafeState()).create_table()));
+        }
+    };
+
+    TEST_F(LuaProfilerTest, shouldNotMeasureHandlersWhenNotStarted)
+    {
+        mScripts.update(1.0f);
+        EXPECT_THAT(mProfiler.getHandlerStats(), IsEmpty());
+        EXPECT_THAT(mProfiler.getSampledStacks(), IsEmpty());
+    }
+
+    TEST_F(LuaProfilerTest, shouldCountCallsPerScriptAndHandler)
+    {
+        mProfiler.start();
+        mScripts.update(1.0f);
+        mScripts.update(1.0f);
+        sendAllocateEvent();
+        mProfiler.stop();
+        const auto stats = mProfiler.getHandlerStats();
+        ASSERT_EQ(stats.size(), 2);
+        EXPECT_EQ(stats.at(mUpdateId).mCalls, 2);
+        EXPECT_GT(stats.at(mUpdateId).mTime.count(), 0);
+        EXPECT_EQ(stats.at(mEventId).mCalls, 1);
+    }
+
+    TEST_F(LuaProfilerTest, shouldNotMeasureHandlersAfterStop)
+    {
+        mProfiler.start();
+        mScripts.update(1.0f);
+        mProfiler.stop();
+        mScripts.update(1.0f);
+        EXPECT_EQ(mProfiler.getHandlerStats().at(mUpdateId).mCalls, 1);
+    }
+
+    TEST_F(LuaProfilerTest, startShouldDropPreviousCapture)
+    {
+        mProfiler.start();
+        mScripts.update(1.0f);
+        mProfiler.stop();
+        mProfiler.start();
+        sendAllocateEvent();
+        mProfiler.stop();
+        EXPECT_THAT(mProfiler.getHandlerStats(), ElementsAre(Key(mEventId)));
+    }
+
+    TEST_F(LuaProfilerTest, shouldMeasureAllocatedMemory)
+    {
+        if (!LuaUtil::LuaState::isProfilerEnabled())
+            GTEST_SKIP() << "Memory is tracked only by Lua profiler";
+        mProfiler.start();
+        sendAllocateEvent();
+        mProfiler.stop();
+        EXPECT_GT(mProfiler.getHandlerStats().at(mEventId).mAllocated, 0);
+    }
+
+    TEST_F(LuaProfilerTest, shouldSampleCallStacksStartingFromScriptAndHandler)
+    {
+        if (!LuaUtil::LuaState::isProfilerEnabled())
+            GTEST_SKIP() << "Call stacks are sampled only by Lua profiler";
+        mProfiler.start();
+        mScripts.update(1.0f);
+        mProfiler.stop();
+        const auto stacks = mProfiler.getSampledStacks();
+        ASSERT_THAT(stacks, Not(IsEmpty()));
+        for (const auto& [stack, count] : stacks)
+        {
+            EXPECT_THAT(stack, StartsWith("busy.lua;onUpdate;"));
+            EXPECT_GT(count, 0);
+        }
+    }
+
+    TEST_F(LuaProfilerTest, writeCollapsedStacksShouldWriteStackAndCountPerLine)
+    {
+        if (!LuaUtil::LuaState::isProfilerEnabled())
+            GTEST_SKIP() << "Call stacks are sampled only by Lua profiler";
+        mProfiler.start();
+        mScripts.update(1.0f);
+        mProfiler.stop();
+        std::ostringstream stream;
+        mProfiler.writeCollapsedStacks(stream);
+        std::istringstream lines(stream.str());
+        std::string line;
+        while (std::getline(lines, line))
+            EXPECT_THAT(line, MatchesRegex("busy\\.lua;onUpdate;.* [0-9]+"));
+    }
+
+    TEST_F(LuaProfilerTest, writeChromeTraceShouldWriteCompleteEventPerCall)
+    {
+        mProfiler.start();
+        mScripts.update(1.0f);
+        sendAllocateEvent();
+        mProfiler.stop();
+        std::ostringstream stream;
+        mProfiler.writeChromeTrace(stream);
+        const std::string trace = stream.str();
+        EXPECT_THAT(trace, StartsWith("{\"traceEvents\":["));
+        EXPECT_THAT(trace, HasSubstr("{\"name\":\"onUpdate\",\"cat\":\"busy.lua\",\"ph\":\"X\",\"ts\":"));
+        EXPECT_THAT(trace, HasSubstr("{\"name\":\"Allocate\",\"cat\":\"busy.lua\",\"ph\":\"X\",\"ts\":"));
+    }
+
+    TEST_F(LuaProfilerTest, writeSummaryShouldWriteHandlers)
+    {
+        mProfiler.start();
+        mScripts.update(1.0f);
+        mProfiler.stop();
+        std::ostringstream stream;
+        mProfiler.writeSummary(stream, 10);
+        EXPECT_THAT(stream.str(), HasSubstr("busy.lua: onUpdate\n"));
+    }
+}
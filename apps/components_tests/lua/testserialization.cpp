@@ -276,4 +276,45 @@ namespace
         EXPECT_EQ(ry.b, 3);
     }
 
+    TEST(LuaSerializationTest, SerializeToReusedBuffer)
+    {
+        sol::state lua;
+        sol::table table(lua, sol::create);
+        table[1] = 1;
+        table["x"] = "a";
+        table["nested"] = sol::table(lua, sol::create);
+        table["nested"][1] = true;
+
+        std::string buffer = "previous content";
+        LuaUtil::serialize(buffer, table);
+        EXPECT_EQ(buffer, LuaUtil::serialize(table));
+
+        LuaUtil::serialize(buffer, sol::nil);
+        EXPECT_EQ(buffer, "");
+
+        buffer = "previous content";
+        table["f"] = [] {};
+        EXPECT_ERROR(LuaUtil::serialize(buffer, table), "Functions are not allowed to be serialized.");
+        EXPECT_EQ(buffer, "");
+    }
+
+    TEST(LuaSerializationTest, DeserializedTableShouldContainAllEntries)
+    {
+        sol::state lua;
+        sol::table table(lua, sol::create);
+        for (int i = 1; i <= 100; ++i)
+            table[i] = i;
+        for (int i = 0; i < 50; ++i)
+            table["key" + std::to_string(i)] = i;
+
+        sol::table res = LuaUtil::deserialize(lua, LuaUtil::serialize(table));
+        EXPECT_EQ(res.size(), 100);
+        std::size_t count = 0;
+        for (const auto& [key, value] : res)
+            ++count;
+        EXPECT_EQ(count, 150);
+        EXPECT_EQ(res.get<int>(100), 100);
+        EXPECT_EQ(res.get<int>("key49"), 49);
+    }
+
 }
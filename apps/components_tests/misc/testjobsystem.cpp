@@ -0,0 +1,125 @@
+#include <components/misc/jobsystem.hpp>
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    using namespace testing;
+    using namespace Misc;
+
+    TEST(MiscJobSystemTest, withoutThreadsShouldRunJobsImmediately)
+    {
+        JobSystem jobSystem(0);
+        JobGroup group;
+        int value = 0;
+        jobSystem.run(group, [&] { value = 42; });
+        EXPECT_EQ(value, 42);
+        EXPECT_TRUE(group.isDone());
+        jobSystem.wait(group);
+    }
+
+    TEST(MiscJobSystemTest, destructorShouldFinishPostedJobs)
+    {
+        std::atomic<int> done{ 0 };
+        {
+            JobSystem jobSystem(2);
+            for (int i = 0; i < 100; ++i)
+                jobSystem.post([&] { ++done; });
+        }
+        EXPECT_EQ(done, 100);
+    }
+
+    TEST(MiscJobSystemTest, waitShouldReturnWhenAllGroupJobsAreFinished)
+    {
+        JobSystem jobSystem(3);
+        JobGroup group;
+        std::vector<int> values(100, 0);
+        for (std::size_t i = 0; i < values.size(); ++i)
+            jobSystem.run(group, [&values, i] { values[i] = static_cast<int>(i); });
+        jobSystem.wait(group);
+        EXPECT_TRUE(group.isDone());
+        for (std::size_t i = 0; i < values.size(); ++i)
+            EXPECT_EQ(values[i], static_cast<int>(i));
+    }
+
+    TEST(MiscJobSystemTest, waitShouldRethrowJobException)
+    {
+        JobSystem jobSystem(2);
+        JobGroup group;
+        jobSystem.run(group, [] { throw std::runtime_error("error"); });
+        EXPECT_THROW(jobSystem.wait(group), std::runtime_error);
+        EXPECT_NO_THROW(jobSystem.wait(group));
+    }
+
+    TEST(MiscJobSystemTest, parallelForShouldCallFunctionForEachIndexOnce)
+    {
+        JobSystem jobSystem(4);
+        std::vector<std::atomic<int>> calls(1000);
+        jobSystem.parallelFor(calls.size(), [&](std::size_t i) { ++calls[i]; });
+        for (const std::atomic<int>& v : calls)
+            EXPECT_EQ(v, 1);
+    }
+
+    TEST(MiscJobSystemTest, parallelForShouldRethrowException)
+    {
+        JobSystem jobSystem(2);
+        EXPECT_THROW(jobSystem.parallelFor(100,
+                         [](std::size_t i) {
+                             if (i == 50)
+                                 throw std::runtime_error("error");
+                         }),
+            std::runtime_error);
+    }
+
+    TEST(MiscJobSystemTest, jobsShouldBeAbleToWaitForNestedJobs)
+    {
+        JobSystem jobSystem(2);
+        JobGroup group;
+        std::atomic<int> done{ 0 };
+        for (int i = 0; i < 8; ++i)
+            jobSystem.run(group, [&] {
+                JobGroup nested;
+                for (int j = 0; j < 8; ++j)
+                    jobSystem.run(nested, [&] { jobSystem.parallelFor(4, [&](std::size_t) { ++done; }); });
+                jobSystem.wait(nested);
+            });
+        jobSystem.wait(group);
+        EXPECT_EQ(done, 8 * 8 * 4);
+    }
+
+    TEST(MiscJobSystemTest, idleWorkerShouldStealJobsAddedByOtherWorker)
+    {
+        JobSystem jobSystem(2);
+        JobGroup group;
+        std::atomic<int> started{ 0 };
+        std::atomic<bool> concurrent{ true };
+        const auto job = [&] {
+            ++started;
+            const auto end = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+            while (started < 2)
+            {
+                if (std::chrono::steady_clock::now() > end)
+                {
+                    concurrent = false;
+                    return;
+                }
+                std::this_thread::yield();
+            }
+        };
+        // Both jobs go into the first worker queue, the second one can only run concurrently when stolen
+        jobSystem.run(group, [&] {
+            JobGroup nested;
+            jobSystem.run(nested, job);
+            jobSystem.run(nested, job);
+            jobSystem.wait(nested);
+        });
+        jobSystem.wait(group);
+        EXPECT_TRUE(concurrent);
+    }
+}
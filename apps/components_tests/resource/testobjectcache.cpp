@@ -5,6 +5,11 @@
 
 #include <osg/Object>
 
+#include <algorithm>
+#include <thread>
+#include <tuple>
+#include <vector>
+
 namespace Resource
 {
     namespace
@@ -373,5 +378,189 @@ namespace Resource
             cache->addEntryToObjectCache(key, value);
             EXPECT_TRUE(cache->checkInObjectCache(std::string_view("key"), 0));
         }
+
+        TEST(ResourceGenericObjectCacheTest, shardedCacheShouldStoreValues)
+        {
+            osg::ref_ptr<GenericObjectCache<int>> cache(new GenericObjectCache<int>(4));
+            std::vector<osg::ref_ptr<Object>> values;
+            for (int i = 0; i < 16; ++i)
+            {
+                values.emplace_back(new Object);
+                cache->addEntryToObjectCache(i, values.back());
+            }
+            for (int i = 0; i < 16; ++i)
+                EXPECT_EQ(cache->getRefFromObjectCache(i), values[i]) << i;
+            EXPECT_EQ(cache->getStats().mSize, 16);
+        }
+
+        TEST(ResourceGenericObjectCacheTest, shardedCacheShouldSupportHeterogeneousLookup)
+        {
+            osg::ref_ptr<GenericObjectCache<std::string>> cache(new GenericObjectCache<std::string>(8));
+            osg::ref_ptr<Object> value(new Object);
+            cache->addEntryToObjectCache(std::string_view("meshes/a.nif"), value);
+            EXPECT_EQ(cache->getRefFromObjectCache(std::string("meshes/a.nif")), value);
+            EXPECT_EQ(cache->getRefFromObjectCache(VFS::Path::NormalizedView("meshes/a.nif")), value);
+            EXPECT_EQ(cache->getRefFromObjectCache(VFS::Path::Normalized("meshes/a.nif")), value);
+        }
+
+        TEST(ResourceGenericObjectCacheTest, shardedCacheLowerBoundShouldReturnFirstNotLessThatGivenKeyOverAllShards)
+        {
+            osg::ref_ptr<GenericObjectCache<int>> cache(new GenericObjectCache<int>(4));
+            for (int i = 0; i < 32; i += 2)
+                cache->addEntryToObjectCache(i, nullptr);
+            for (int i = 1; i < 30; i += 2)
+                EXPECT_THAT(cache->lowerBound(i), Optional(Pair(i + 1, _))) << i;
+            EXPECT_EQ(cache->lowerBound(31), std::nullopt);
+        }
+
+        TEST(ResourceGenericObjectCacheTest, shardedCacheUpdateShouldRemoveExpiredItemsFromAllShards)
+        {
+            osg::ref_ptr<GenericObjectCache<int>> cache(new GenericObjectCache<int>(4));
+
+            const double referenceTime = 1;
+            const double expiryDelay = 1;
+
+            for (int i = 0; i < 16; ++i)
+                cache->addEntryToObjectCache(i, nullptr, referenceTime);
+
+            cache->update(referenceTime + expiryDelay, expiryDelay);
+
+            const CacheStats stats = cache->getStats();
+            EXPECT_EQ(stats.mSize, 0);
+            EXPECT_EQ(stats.mExpired, 16);
+        }
+
+        TEST(ResourceGenericObjectCacheTest, getShardStatsShouldReturnStatsForEachShard)
+        {
+            osg::ref_ptr<GenericObjectCache<int>> cache(new GenericObjectCache<int>(4));
+            for (int i = 0; i < 16; ++i)
+                cache->addEntryToObjectCache(i, nullptr);
+
+            const std::vector<CacheStats> stats = cache->getShardStats();
+
+            ASSERT_EQ(stats.size(), 4);
+            std::size_t size = 0;
+            for (const CacheStats& v : stats)
+            {
+                size += v.mSize;
+                EXPECT_EQ(v.mContended, 0);
+            }
+            EXPECT_EQ(size, 16);
+        }
+
+        TEST(ResourceGenericObjectCacheTest, setShardCountShouldKeepItems)
+        {
+            osg::ref_ptr<GenericObjectCache<int>> cache(new GenericObjectCache<int>);
+            std::vector<osg::ref_ptr<Object>> values;
+            for (int i = 0; i < 16; ++i)
+            {
+                values.emplace_back(new Object);
+                cache->addEntryToObjectCache(i, values.back());
+            }
+            ASSERT_EQ(cache->getRefFromObjectCache(0), values[0]);
+
+            cache->setShardCount(8);
+
+            EXPECT_EQ(cache->getShardCount(), 8);
+            for (int i = 0; i < 16; ++i)
+                EXPECT_EQ(cache->getRefFromObjectCache(i), values[i]) << i;
+            const CacheStats stats = cache->getStats();
+            EXPECT_EQ(stats.mSize, 16);
+            EXPECT_EQ(stats.mGet, 17);
+            EXPECT_EQ(stats.mHit, 17);
+        }
+
+        TEST(ResourceGenericObjectCacheTest, shardedCacheShouldSupportConcurrentAccess)
+        {
+            osg::ref_ptr<GenericObjectCache<int>> cache(new GenericObjectCache<int>(4));
+            osg::ref_ptr<Object> value(new Object);
+            std::vector<std::thread> threads;
+            for (int t = 0; t < 4; ++t)
+                threads.emplace_back([&, t] {
+                    for (int i = 0; i < 1000; ++i)
+                    {
+                        cache->addEntryToObjectCache(t * 1000 + i, value);
+                        cache->getRefFromObjectCache(i);
+                        if (t == 0)
+                            cache->update(i, 1000);
+                    }
+                });
+            for (std::thread& thread : threads)
+                thread.join();
+            EXPECT_EQ(cache->getStats().mSize, 4000);
+        }
+
+        std::size_t getTestMemoryUsage(const osg::Object& /*object*/)
+        {
+            return 10;
+        }
+
+        TEST(ResourceGenericObjectCacheTest, getStatsShouldReturnMemoryUsage)
+        {
+            osg::ref_ptr<GenericObjectCache<int>> cache(new GenericObjectCache<int>);
+            cache->setMemoryUsageFunction(&getTestMemoryUsage);
+            osg::ref_ptr<Object> value(new Object);
+            cache->addEntryToObjectCache(1, value);
+            cache->addEntryToObjectCache(2, value);
+            cache->addEntryToObjectCache(3, nullptr);
+            EXPECT_EQ(cache->getStats().mMemoryUsage, 20);
+            cache->addEntryToObjectCache(2, nullptr);
+            EXPECT_EQ(cache->getStats().mMemoryUsage, 10);
+            cache->removeFromObjectCache(1);
+            EXPECT_EQ(cache->getStats().mMemoryUsage, 0);
+        }
+
+        TEST(ResourceGenericObjectCacheTest, updateShouldEvictLeastRecentlyUsedItemsOverMemoryBudget)
+        {
+            osg::ref_ptr<GenericObjectCache<int>> cache(new GenericObjectCache<int>);
+            cache->setMemoryUsageFunction(&getTestMemoryUsage);
+            cache->setMemoryBudget(25);
+
+            const double expiryDelay = 100;
+
+            cache->addEntryToObjectCache(1, new Object, 3);
+            cache->addEntryToObjectCache(2, new Object, 1);
+            cache->addEntryToObjectCache(3, new Object, 2);
+
+            cache->update(4, expiryDelay);
+
+            EXPECT_THAT(cache->getRefFromObjectCacheOrNone(1), Optional(_));
+            EXPECT_EQ(cache->getRefFromObjectCacheOrNone(2), std::nullopt);
+            EXPECT_THAT(cache->getRefFromObjectCacheOrNone(3), Optional(_));
+            const CacheStats stats = cache->getStats();
+            EXPECT_EQ(stats.mMemoryUsage, 20);
+            EXPECT_EQ(stats.mEvicted, 1);
+            EXPECT_EQ(stats.mExpired, 0);
+        }
+
+        TEST(ResourceGenericObjectCacheTest, evictShouldKeepExternallyReferencedItems)
+        {
+            osg::ref_ptr<GenericObjectCache<int>> cache(new GenericObjectCache<int>);
+            cache->setMemoryUsageFunction(&getTestMemoryUsage);
+
+            osg::ref_ptr<Object> value(new Object);
+            cache->addEntryToObjectCache(1, value, 1);
+            cache->addEntryToObjectCache(2, new Object, 2);
+
+            EXPECT_EQ(cache->evict(20), 10);
+            EXPECT_THAT(cache->getRefFromObjectCacheOrNone(1), Optional(value));
+            EXPECT_EQ(cache->getRefFromObjectCacheOrNone(2), std::nullopt);
+        }
+
+        TEST(ResourceGenericObjectCacheTest, shardedCacheShouldSpreadTupleKeysOverShards)
+        {
+            using Key = std::tuple<osg::Vec2f, float, bool>;
+            static_assert(GenericObjectCache<Key>::sSupportsSharding);
+            osg::ref_ptr<GenericObjectCache<Key>> cache(new GenericObjectCache<Key>(4));
+            for (int i = 0; i < 64; ++i)
+                cache->addEntryToObjectCache(Key(osg::Vec2f(i, -i), 0.5f, i % 2 == 0), nullptr);
+
+            for (int i = 0; i < 64; ++i)
+                EXPECT_THAT(cache->getRefFromObjectCacheOrNone(Key(osg::Vec2f(i, -i), 0.5f, i % 2 == 0)), Optional(_))
+                    << i;
+            const std::vector<CacheStats> stats = cache->getShardStats();
+            ASSERT_EQ(stats.size(), 4);
+            EXPECT_GT(std::count_if(stats.begin(), stats.end(), [](const CacheStats& v) { return v.mSize > 0; }), 1);
+        }
     }
 }
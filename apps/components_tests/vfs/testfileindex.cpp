@@ -0,0 +1,142 @@
+#include <components/testing/util.hpp>
+#include <components/vfs/fileindex.hpp>
+#include <components/vfs/filesystemarchive.hpp>
+#include <components/vfs/pathutil.hpp>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <fstream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace VFS
+{
+    namespace
+    {
+        using namespace testing;
+        using namespace std::chrono_literals;
+
+        static_assert(!std::is_copy_constructible_v<FileIndex>);
+        static_assert(!std::is_move_constructible_v<FileIndex>);
+        static_assert(!std::is_copy_assignable_v<FileIndex>);
+        static_assert(!std::is_move_assignable_v<FileIndex>);
+
+        std::vector<std::string> getPaths(FileIndex::const_iterator begin, FileIndex::const_iterator end)
+        {
+            std::vector<std::string> result;
+            for (auto it = begin; it != end; ++it)
+                result.push_back(it->first.value());
+            return result;
+        }
+
+        std::vector<std::string> listResources(Archive& archive)
+        {
+            FileIndex index;
+            archive.listResources(index);
+            index.build();
+            return getPaths(index.begin(), index.end());
+        }
+
+        struct VFSFileIndexTest : Test
+        {
+            TestingOpenMW::VFSTestFile mFile1{ "1" };
+            TestingOpenMW::VFSTestFile mFile2{ "2" };
+            FileIndex mIndex;
+        };
+
+        TEST_F(VFSFileIndexTest, findShouldReturnNullptrForMissingFile)
+        {
+            mIndex.insert(Path::Normalized("a/b"), &mFile1);
+            mIndex.build();
+            EXPECT_EQ(mIndex.find("a/c"), nullptr);
+            EXPECT_FALSE(mIndex.contains("a"));
+        }
+
+        TEST_F(VFSFileIndexTest, findShouldReturnFile)
+        {
+            mIndex.insert(Path::Normalized("a/b"), &mFile1);
+            mIndex.insert(Path::Normalized("a/c"), &mFile2);
+            mIndex.build();
+            EXPECT_EQ(mIndex.find("a/b"), &mFile1);
+            EXPECT_EQ(mIndex.find("a/c"), &mFile2);
+        }
+
+        TEST_F(VFSFileIndexTest, buildShouldKeepLastInsertedFileForTheSamePath)
+        {
+            mIndex.insert(Path::Normalized("a/b"), &mFile1);
+            mIndex.insert(Path::Normalized("a/c"), &mFile1);
+            mIndex.insert(Path::Normalized("a/b"), &mFile2);
+            mIndex.build();
+            EXPECT_EQ(mIndex.size(), 2);
+            EXPECT_EQ(mIndex.find("a/b"), &mFile2);
+        }
+
+        TEST_F(VFSFileIndexTest, getPrefixRangeShouldReturnSortedFilesWithPrefix)
+        {
+            for (std::string_view path : { "b/c", "a", "b/a", "ba", "c/a", "b" })
+                mIndex.insert(Path::Normalized(path), &mFile1);
+            mIndex.build();
+            const auto [begin, end] = mIndex.getPrefixRange("b/");
+            EXPECT_THAT(getPaths(begin, end), ElementsAre("b/a", "b/c"));
+        }
+
+        TEST_F(VFSFileIndexTest, getPrefixRangeShouldReturnAllFilesForEmptyPrefix)
+        {
+            for (std::string_view path : { "b", "a", "c" })
+                mIndex.insert(Path::Normalized(path), &mFile1);
+            mIndex.build();
+            const auto [begin, end] = mIndex.getPrefixRange("");
+            EXPECT_THAT(getPaths(begin, end), ElementsAre("a", "b", "c"));
+        }
+
+        struct VFSFileSystemArchiveIndexCacheTest : Test
+        {
+            const std::string mName = UnitTest::GetInstance()->current_test_info()->name();
+            const std::filesystem::path mData = TestingOpenMW::outputDirPath(mName + "/data");
+            const std::filesystem::path mCache = TestingOpenMW::outputDir() / mName / "cache";
+
+            void createFile(const std::filesystem::path& path)
+            {
+                std::filesystem::create_directories(path.parent_path());
+                std::ofstream(path) << "content";
+            }
+        };
+
+        TEST_F(VFSFileSystemArchiveIndexCacheTest, shouldListFilesWithCache)
+        {
+            createFile(mData / "Textures" / "A.dds");
+            createFile(mData / "b.nif");
+            FileSystemArchive archive(mData, mCache);
+            EXPECT_THAT(listResources(archive), ElementsAre("b.nif", "textures/a.dds"));
+            FileSystemArchive cached(mData, mCache);
+            EXPECT_THAT(listResources(cached), ElementsAre("b.nif", "textures/a.dds"));
+        }
+
+        TEST_F(VFSFileSystemArchiveIndexCacheTest, shouldUseCacheWhenDirectoriesAreNotChanged)
+        {
+            const std::filesystem::path directory = mData / "textures";
+            createFile(directory / "a.dds");
+            FileSystemArchive archive(mData, mCache);
+            const auto lastWriteTime = std::filesystem::last_write_time(directory);
+            createFile(directory / "b.dds");
+            std::filesystem::last_write_time(directory, lastWriteTime);
+            FileSystemArchive cached(mData, mCache);
+            EXPECT_THAT(listResources(cached), ElementsAre("textures/a.dds"));
+        }
+
+        TEST_F(VFSFileSystemArchiveIndexCacheTest, shouldListDirectoryWhenItIsChanged)
+        {
+            const std::filesystem::path directory = mData / "textures";
+            createFile(directory / "a.dds");
+            FileSystemArchive archive(mData, mCache);
+            const auto lastWriteTime = std::filesystem::last_write_time(directory);
+            createFile(directory / "b.dds");
+            std::filesystem::last_write_time(directory, lastWriteTime + 1s);
+            FileSystemArchive updated(mData, mCache);
+            EXPECT_THAT(listResources(updated), ElementsAre("textures/a.dds", "textures/b.dds"));
+        }
+    }
+}
@@ -18,13 +18,14 @@
 #include <components/files/configurationmanager.hpp>
 #include <components/files/conversion.hpp>
 #include <components/files/multidircollection.hpp>
+#include <components/misc/jobsystem.hpp>
+#include <components/misc/pathhelpers.hpp>
 #include <components/platform/platform.hpp>
 #include <components/resource/bgsmfilemanager.hpp>
 #include <components/resource/bulletshapemanager.hpp>
 #include <components/resource/imagemanager.hpp>
 #include <components/resource/niffilemanager.hpp>
 #include <components/resource/scenemanager.hpp>
-#include <components/sceneutil/workqueue.hpp>
 #include <components/settings/values.hpp>
 #include <components/toutf8/toutf8.hpp>
 #include <components/version/version.hpp>
@@ -35,11 +36,13 @@
 
 #include <boost/program_options.hpp>
 
+#include <chrono>
 #include <cstddef>
 #include <cstdint>
 #include <filesystem>
 #include <iostream>
 #include <map>
+#include <memory>
 #include <regex>
 #include <string>
 #include <thread>
@@ -120,6 +123,12 @@ namespace NavMeshTool
             addOption("write-binary-log", bpo::value<bool>()->implicit_value(true)->default_value(false),
                 "write progress in binary messages to be consumed by the launcher");
 
+            addOption("resume", bpo::value<bool>()->implicit_value(true)->default_value(false),
+                "skip worldspaces completely processed by previous run with the same content and settings");
+
+            addOption("benchmark", bpo::value<bool>()->implicit_value(true)->default_value(false),
+                "generate all tiles into in-memory database and report tiles generation rate per thread");
+
             addOption("worldspace-filter", bpo::value<std::string>()->default_value(".*"),
                 "Regular expression to filter in specified worldspaces in modified ECMAScript grammar (see "
                 "https://en.cppreference.com/w/cpp/regex/ecmascript.html)");
@@ -184,6 +193,8 @@ namespace NavMeshTool
             const bool processInteriorCells = variables["process-interior-cells"].as<bool>();
             const bool removeUnusedTiles = variables["remove-unused-tiles"].as<bool>();
             const bool writeBinaryLog = variables["write-binary-log"].as<bool>();
+            const bool resume = variables["resume"].as<bool>();
+            const bool benchmark = variables["benchmark"].as<bool>();
 
             const std::regex worldspaceFilter(variables["worldspace-filter"].as<std::string>());
 
@@ -205,7 +216,9 @@ namespace NavMeshTool
                 Settings::game().mDefaultActorPathfindHalfExtents,
             };
             const std::uint64_t maxDbFileSize = Settings::navigator().mMaxNavmeshdbFileSize;
-            const auto dbPath = Files::pathToUnicodeString(config.getUserDataPath() / "navmesh.db");
+            const std::string dbPath = benchmark
+                ? std::string(":memory:")
+                : Files::pathToUnicodeString(config.getUserDataPath() / "navmesh.db");
 
             Log(Debug::Info) << "Using navmeshdb at " << dbPath;
 
@@ -239,35 +252,73 @@ namespace NavMeshTool
             const std::unordered_map<ESM::RefId, std::vector<std::size_t>> worldspaceCells
                 = collectWorldspaceCells(esmData, processInteriorCells, worldspaceFilter);
 
-            Status status = Status::Ok;
-            bool needVacuum = false;
-            std::size_t count = 0;
+            std::vector<std::filesystem::path> contentPaths;
+            for (const std::string& file : contentFiles)
+            {
+                const Files::MultiDirCollection& collection
+                    = fileCollections.getCollection(Misc::getFileExtension(file));
+                if (collection.doesExist(file))
+                    contentPaths.push_back(collection.getPath(file));
+            }
 
-            SceneUtil::WorkQueue workQueue(threadsNumber);
+            Misc::JobSystem jobSystem(threadsNumber);
 
             Log(Debug::Info) << "Using " << threadsNumber << " parallel workers...";
 
+            NavMeshGenerator generator(agentBounds, navigatorSettings, removeUnusedTiles, writeBinaryLog,
+                makeCheckpointKey(contentPaths, agentBounds, navigatorSettings, removeUnusedTiles), db, jobSystem);
+
+            // Next worldspace data is gathered while tiles of the previous one are generated
+            constexpr std::size_t maxPendingWorldspaces = 2;
+            const auto start = std::chrono::steady_clock::now();
+            std::size_t count = 0;
+
             for (const auto& [worldspace, cells] : worldspaceCells)
             {
-                const WorldspaceData worldspaceData = gatherWorldspaceData(
-                    navigatorSettings, readers, vfs, bulletShapeManager, esmData, writeBinaryLog, worldspace, cells);
+                ++count;
 
-                const Result result = generateAllNavMeshTiles(
-                    agentBounds, navigatorSettings, removeUnusedTiles, writeBinaryLog, worldspaceData, db, workQueue);
+                if (resume && generator.hasCheckpoint(worldspace))
+                {
+                    Log(Debug::Info) << "Skipping already processed worldspace (" << count << "/"
+                                     << worldspaceCells.size() << ") " << worldspace;
+                    continue;
+                }
 
-                ++count;
+                if (!generator.waitForPendingWorldspaces(maxPendingWorldspaces))
+                    break;
+
+                auto worldspaceData = std::make_shared<const WorldspaceData>(gatherWorldspaceData(
+                    navigatorSettings, readers, vfs, bulletShapeManager, esmData, writeBinaryLog, worldspace, cells));
 
-                Log(Debug::Info) << "Processed worldspace (" << count << "/" << worldspaceCells.size() << ") "
+                Log(Debug::Info) << "Scheduled worldspace (" << count << "/" << worldspaceCells.size() << ") "
                                  << worldspace;
 
-                status = result.mStatus;
-                needVacuum = needVacuum || result.mNeedVacuum;
+                generator.generate(std::move(worldspaceData));
+            }
 
-                if (status != Status::Ok)
-                    break;
+            const Result result = generator.wait();
+            const Status status = result.mStatus;
+            const bool needVacuum = result.mNeedVacuum;
+
+            if (benchmark)
+            {
+                using Seconds = std::chrono::duration<double>;
+                const double elapsed = Seconds(std::chrono::steady_clock::now() - start).count();
+                std::size_t totalTiles = 0;
+                std::size_t thread = 0;
+                for (const auto& [id, stats] : generator.getThreadStats())
+                {
+                    const double busy = Seconds(stats.mBusyTime).count();
+                    Log(Debug::Info) << "Thread " << thread++ << ": " << stats.mTiles << " tiles, " << busy
+                                     << " seconds busy, " << (busy > 0 ? stats.mTiles / busy : 0) << " tiles/sec";
+                    totalTiles += stats.mTiles;
+                }
+                Log(Debug::Info) << "Generated " << totalTiles << " tiles in " << elapsed << " seconds, "
+                                 << (elapsed > 0 ? totalTiles / elapsed : 0) << " tiles/sec using " << threadsNumber
+                                 << " threads";
             }
 
-            if (status == Status::Ok && needVacuum)
+            if (status == Status::Ok && needVacuum && !benchmark)
             {
                 Log(Debug::Info) << "Vacuuming the database...";
                 db.vacuum();
@@ -4,6 +4,7 @@
 
 #include <components/debug/debugging.hpp>
 #include <components/debug/debuglog.hpp>
+#include <components/detournavigator/dbrefgeometryobject.hpp>
 #include <components/detournavigator/generatenavmeshtile.hpp>
 #include <components/detournavigator/gettilespositions.hpp>
 #include <components/detournavigator/navmeshdb.hpp>
@@ -14,17 +15,24 @@
 #include <components/detournavigator/serialization.hpp>
 #include <components/detournavigator/settings.hpp>
 #include <components/detournavigator/tileposition.hpp>
+#include <components/files/constrainedfilestream.hpp>
+#include <components/files/conversion.hpp>
+#include <components/files/hash.hpp>
+#include <components/misc/jobsystem.hpp>
 #include <components/misc/progressreporter.hpp>
 #include <components/navmeshtool/protocol.hpp>
-#include <components/sceneutil/workqueue.hpp>
 #include <components/sqlite3/transaction.hpp>
 
 #include <osg/Vec3f>
 
+#include <algorithm>
 #include <atomic>
 #include <chrono>
+#include <condition_variable>
 #include <cstddef>
+#include <mutex>
 #include <random>
+#include <sstream>
 #include <string_view>
 #include <vector>
 
@@ -72,223 +80,387 @@ namespace NavMeshTool
             void operator()(std::size_t provided, std::size_t expected) const { logGeneratedTiles(provided, expected); }
         };
 
-        class NavMeshTileConsumer final : public DetourNavigator::NavMeshTileConsumer
+        template <class T, class Container>
+        void appendBytes(const T& value, Container& data)
         {
-        public:
-            std::atomic_size_t mExpected{ 0 };
-
-            explicit NavMeshTileConsumer(NavMeshDb& db, bool removeUnusedTiles, bool writeBinaryLog)
-                : mDb(db)
-                , mRemoveUnusedTiles(removeUnusedTiles)
-                , mWriteBinaryLog(writeBinaryLog)
-                , mTransaction(mDb.startTransaction(Sqlite3::TransactionMode::Immediate))
-                , mNextTileId(mDb.getMaxTileId() + 1)
-                , mNextShapeId(mDb.getMaxShapeId() + 1)
-            {
-            }
+            const auto bytes = reinterpret_cast<const typename Container::value_type*>(&value);
+            data.insert(data.end(), bytes, bytes + sizeof(value));
+        }
 
-            std::size_t getProvided() const { return mProvided.load(); }
+        Sqlite3::ConstBlob toBlob(const std::vector<std::byte>& value)
+        {
+            return Sqlite3::ConstBlob{ reinterpret_cast<const char*>(value.data()), static_cast<int>(value.size()) };
+        }
+    }
 
-            std::size_t getInserted() const { return mInserted.load(); }
+    class NavMeshTileConsumer final : public DetourNavigator::NavMeshTileConsumer
+    {
+    public:
+        explicit NavMeshTileConsumer(
+            NavMeshDb& db, bool removeUnusedTiles, bool writeBinaryLog, std::vector<std::byte> checkpointKey)
+            : mDb(db)
+            , mRemoveUnusedTiles(removeUnusedTiles)
+            , mWriteBinaryLog(writeBinaryLog)
+            , mCheckpointKey(std::move(checkpointKey))
+            , mTransaction(mDb.startTransaction(Sqlite3::TransactionMode::Immediate))
+            , mLastCommit(std::chrono::steady_clock::now())
+            , mNextTileId(mDb.getMaxTileId() + 1)
+            , mNextShapeId(mDb.getMaxShapeId() + 1)
+        {
+        }
+
+        std::size_t getProvided() const { return mProvided.load(); }
 
-            std::size_t getUpdated() const { return mUpdated.load(); }
+        std::size_t getInserted() const { return mInserted.load(); }
 
-            std::size_t getDeleted() const
+        std::size_t getUpdated() const { return mUpdated.load(); }
+
+        std::size_t getDeleted() const
+        {
+            const std::lock_guard lock(mMutex);
+            return mDeleted;
+        }
+
+        bool isCancelled() const
+        {
+            const std::lock_guard lock(mMutex);
+            return mStatus != Status::Ok;
+        }
+
+        std::int64_t resolveMeshSource(const MeshSource& source) override
+        {
+            const std::lock_guard lock(mMutex);
+            return DetourNavigator::resolveMeshSource(mDb, source, mNextShapeId);
+        }
+
+        std::optional<NavMeshTileInfo> find(
+            ESM::RefId worldspace, const TilePosition& tilePosition, const std::vector<std::byte>& input) override
+        {
+            std::optional<NavMeshTileInfo> result;
+            std::lock_guard lock(mMutex);
+            if (const auto tile = mDb.findTile(worldspace, tilePosition, input))
             {
-                const std::lock_guard lock(mMutex);
-                return mDeleted;
+                NavMeshTileInfo info;
+                info.mTileId = tile->mTileId;
+                info.mVersion = tile->mVersion;
+                result.emplace(info);
             }
+            return result;
+        }
 
-            std::int64_t resolveMeshSource(const MeshSource& source) override
+        void ignore(ESM::RefId worldspace, const TilePosition& tilePosition) override
+        {
+            if (mRemoveUnusedTiles)
             {
-                const std::lock_guard lock(mMutex);
-                return DetourNavigator::resolveMeshSource(mDb, source, mNextShapeId);
+                std::lock_guard lock(mMutex);
+                mDeleted += static_cast<std::size_t>(mDb.deleteTilesAt(worldspace, tilePosition));
             }
+            report();
+        }
 
-            std::optional<NavMeshTileInfo> find(
-                ESM::RefId worldspace, const TilePosition& tilePosition, const std::vector<std::byte>& input) override
+        void identity(ESM::RefId worldspace, const TilePosition& tilePosition, std::int64_t tileId) override
+        {
+            if (mRemoveUnusedTiles)
             {
-                std::optional<NavMeshTileInfo> result;
                 std::lock_guard lock(mMutex);
-                if (const auto tile = mDb.findTile(worldspace, tilePosition, input))
-                {
-                    NavMeshTileInfo info;
-                    info.mTileId = tile->mTileId;
-                    info.mVersion = tile->mVersion;
-                    result.emplace(info);
-                }
-                return result;
+                mDeleted += static_cast<std::size_t>(
+                    mDb.deleteTilesAtExcept(worldspace, tilePosition, TileId{ tileId }));
             }
+            report();
+        }
 
-            void ignore(ESM::RefId worldspace, const TilePosition& tilePosition) override
+        void insert(ESM::RefId worldspace, const TilePosition& tilePosition, std::int64_t version,
+            const std::vector<std::byte>& input, PreparedNavMeshData& data) override
+        {
             {
+                std::lock_guard lock(mMutex);
                 if (mRemoveUnusedTiles)
-                {
-                    std::lock_guard lock(mMutex);
                     mDeleted += static_cast<std::size_t>(mDb.deleteTilesAt(worldspace, tilePosition));
-                }
-                report();
+                data.mUserId = static_cast<unsigned>(mNextTileId);
+                mDb.insertTile(mNextTileId, worldspace, tilePosition, TileVersion{ version }, input, serialize(data));
+                ++mNextTileId;
             }
+            ++mInserted;
+            report();
+        }
 
-            void identity(ESM::RefId worldspace, const TilePosition& tilePosition, std::int64_t tileId) override
+        void update(ESM::RefId worldspace, const TilePosition& tilePosition, std::int64_t tileId,
+            std::int64_t version, PreparedNavMeshData& data) override
+        {
+            data.mUserId = static_cast<unsigned>(tileId);
             {
+                std::lock_guard lock(mMutex);
                 if (mRemoveUnusedTiles)
-                {
-                    std::lock_guard lock(mMutex);
                     mDeleted += static_cast<std::size_t>(
                         mDb.deleteTilesAtExcept(worldspace, tilePosition, TileId{ tileId }));
-                }
-                report();
+                mDb.updateTile(TileId{ tileId }, TileVersion{ version }, serialize(data));
             }
+            ++mUpdated;
+            report();
+        }
 
-            void insert(ESM::RefId worldspace, const TilePosition& tilePosition, std::int64_t version,
-                const std::vector<std::byte>& input, PreparedNavMeshData& data) override
-            {
-                {
-                    std::lock_guard lock(mMutex);
-                    if (mRemoveUnusedTiles)
-                        mDeleted += static_cast<std::size_t>(mDb.deleteTilesAt(worldspace, tilePosition));
-                    data.mUserId = static_cast<unsigned>(mNextTileId);
-                    mDb.insertTile(
-                        mNextTileId, worldspace, tilePosition, TileVersion{ version }, input, serialize(data));
-                    ++mNextTileId;
-                }
-                ++mInserted;
-                report();
-            }
+        void cancel(std::string_view reason) override
+        {
+            const std::lock_guard lock(mMutex);
+            setCancelled(reason);
+        }
 
-            void update(ESM::RefId worldspace, const TilePosition& tilePosition, std::int64_t tileId,
-                std::int64_t version, PreparedNavMeshData& data) override
-            {
-                data.mUserId = static_cast<unsigned>(tileId);
-                {
-                    std::lock_guard lock(mMutex);
-                    if (mRemoveUnusedTiles)
-                        mDeleted += static_cast<std::size_t>(
-                            mDb.deleteTilesAtExcept(worldspace, tilePosition, TileId{ tileId }));
-                    mDb.updateTile(TileId{ tileId }, TileVersion{ version }, serialize(data));
-                }
-                ++mUpdated;
-                report();
-            }
+        bool hasCheckpoint(ESM::RefId worldspace) const
+        {
+            const std::lock_guard lock(mMutex);
+            return mDb.hasCheckpoint(worldspace, toBlob(mCheckpointKey));
+        }
 
-            void cancel(std::string_view reason) override
+        void addWorldspace(std::size_t tiles)
+        {
+            std::size_t expected = 0;
             {
-                std::unique_lock lock(mMutex);
-                if (reason.find("database or disk is full") != std::string_view::npos)
-                    mStatus = Status::NotEnoughSpace;
-                else
-                    mStatus = Status::Cancelled;
-                mHasTile.notify_one();
+                const std::lock_guard lock(mMutex);
+                ++mPendingWorldspaces;
+                expected = mExpected.fetch_add(tiles) + tiles;
             }
+            if (mWriteBinaryLog)
+                serializeToStderr(ExpectedTiles{ static_cast<std::uint64_t>(expected) });
+        }
 
-            Status wait()
+        void completeWorldspace(ESM::RefId worldspace)
+        {
+            const std::lock_guard lock(mMutex);
+            --mPendingWorldspaces;
+            if (mStatus == Status::Ok)
             {
-                constexpr std::chrono::seconds transactionInterval(1);
-                std::unique_lock lock(mMutex);
-                auto start = std::chrono::steady_clock::now();
-                while (mProvided < mExpected && mStatus == Status::Ok)
+                try
                 {
-                    mHasTile.wait(lock);
-                    const auto now = std::chrono::steady_clock::now();
-                    if (now - start > transactionInterval)
-                    {
-                        mTransaction.commit();
-                        mTransaction = mDb.startTransaction(Sqlite3::TransactionMode::Immediate);
-                        start = now;
-                    }
+                    mDb.insertCheckpoint(worldspace, toBlob(mCheckpointKey));
+                    Log(Debug::Info) << "Processed worldspace " << worldspace;
+                }
+                catch (const std::exception& e)
+                {
+                    Log(Debug::Warning) << "Failed to write checkpoint for worldspace \"" << worldspace
+                                        << "\": " << e.what();
+                    setCancelled(e.what());
                 }
-                logGeneratedTiles(mProvided, mExpected);
-                if (mWriteBinaryLog)
-                    logGeneratedTilesMessage(mProvided);
-                return mStatus;
             }
+            mHasTile.notify_all();
+        }
 
-            void commit()
-            {
-                const std::lock_guard lock(mMutex);
-                mTransaction.commit();
-            }
+        void addThreadStats(std::chrono::steady_clock::duration busyTime)
+        {
+            const std::lock_guard lock(mThreadStatsMutex);
+            ThreadStats& stats = mThreadStats[std::this_thread::get_id()];
+            ++stats.mTiles;
+            stats.mBusyTime += busyTime;
+        }
 
-            void removeTilesOutsideRange(ESM::RefId worldspace, const TilesPositionsRange& range)
+        std::map<std::thread::id, ThreadStats> getThreadStats() const
+        {
+            const std::lock_guard lock(mThreadStatsMutex);
+            return mThreadStats;
+        }
+
+        bool waitForPendingWorldspaces(std::size_t maxPendingWorldspaces)
+        {
+            std::unique_lock lock(mMutex);
+            mHasTile.wait(
+                lock, [&] { return mPendingWorldspaces < maxPendingWorldspaces || mStatus != Status::Ok; });
+            return mStatus == Status::Ok;
+        }
+
+        Status wait()
+        {
+            std::unique_lock lock(mMutex);
+            mHasTile.wait(lock, [&] { return mPendingWorldspaces == 0 || mStatus != Status::Ok; });
+            logGeneratedTiles(mProvided, mExpected);
+            if (mWriteBinaryLog)
+                logGeneratedTilesMessage(mProvided);
+            return mStatus;
+        }
+
+        void commit()
+        {
+            const std::lock_guard lock(mMutex);
+            mTransaction.commit();
+        }
+
+        void removeTilesOutsideRange(ESM::RefId worldspace, const TilesPositionsRange& range)
+        {
+            const std::lock_guard lock(mMutex);
+            mTransaction.commit();
+            Log(Debug::Info) << "Removing tiles outside processed range for worldspace \"" << worldspace << "\"...";
+            mDeleted += static_cast<std::size_t>(mDb.deleteTilesOutsideRange(worldspace, range));
+            mTransaction = mDb.startTransaction(Sqlite3::TransactionMode::Immediate);
+            mLastCommit = std::chrono::steady_clock::now();
+        }
+
+    private:
+        std::atomic_size_t mExpected{ 0 };
+        std::atomic_size_t mProvided{ 0 };
+        std::atomic_size_t mInserted{ 0 };
+        std::atomic_size_t mUpdated{ 0 };
+        std::size_t mDeleted = 0;
+        std::size_t mPendingWorldspaces = 0;
+        Status mStatus = Status::Ok;
+        mutable std::mutex mMutex;
+        NavMeshDb& mDb;
+        const bool mRemoveUnusedTiles;
+        const bool mWriteBinaryLog;
+        const std::vector<std::byte> mCheckpointKey;
+        Transaction mTransaction;
+        std::chrono::steady_clock::time_point mLastCommit;
+        TileId mNextTileId;
+        std::condition_variable mHasTile;
+        Misc::ProgressReporter<LogGeneratedTiles> mReporter;
+        ShapeId mNextShapeId;
+        mutable std::mutex mThreadStatsMutex;
+        std::map<std::thread::id, ThreadStats> mThreadStats;
+
+        void setCancelled(std::string_view reason)
+        {
+            if (reason.find("database or disk is full") != std::string_view::npos)
+                mStatus = Status::NotEnoughSpace;
+            else
+                mStatus = Status::Cancelled;
+            mHasTile.notify_all();
+        }
+
+        // Called by the workers so the transaction is committed periodically while the main thread is busy with
+        // gathering next worldspace data. Must not throw because it's called from a destructor.
+        void commitIfExpired() noexcept
+        {
+            constexpr std::chrono::seconds transactionInterval(1);
+            const std::lock_guard lock(mMutex);
+            const auto now = std::chrono::steady_clock::now();
+            if (mStatus != Status::Ok || now - mLastCommit <= transactionInterval)
+                return;
+            try
             {
-                const std::lock_guard lock(mMutex);
                 mTransaction.commit();
-                Log(Debug::Info) << "Removing tiles outside processed range for worldspace \"" << worldspace << "\"...";
-                mDeleted += static_cast<std::size_t>(mDb.deleteTilesOutsideRange(worldspace, range));
                 mTransaction = mDb.startTransaction(Sqlite3::TransactionMode::Immediate);
+                mLastCommit = now;
             }
-
-        private:
-            std::atomic_size_t mProvided{ 0 };
-            std::atomic_size_t mInserted{ 0 };
-            std::atomic_size_t mUpdated{ 0 };
-            std::size_t mDeleted = 0;
-            Status mStatus = Status::Ok;
-            mutable std::mutex mMutex;
-            NavMeshDb& mDb;
-            const bool mRemoveUnusedTiles;
-            const bool mWriteBinaryLog;
-            Transaction mTransaction;
-            TileId mNextTileId;
-            std::condition_variable mHasTile;
-            Misc::ProgressReporter<LogGeneratedTiles> mReporter;
-            ShapeId mNextShapeId;
-            std::mutex mReportMutex;
-
-            void report()
+            catch (const std::exception& e)
             {
-                const std::size_t provided = mProvided.fetch_add(1, std::memory_order_relaxed) + 1;
-                mReporter(provided, mExpected);
-                mHasTile.notify_one();
-                if (mWriteBinaryLog)
-                    logGeneratedTilesMessage(provided);
+                Log(Debug::Warning) << "Failed to commit navmesh tiles: " << e.what();
+                setCancelled(e.what());
             }
-        };
+        }
+
+        void report()
+        {
+            const std::size_t provided = mProvided.fetch_add(1, std::memory_order_relaxed) + 1;
+            mReporter(provided, mExpected);
+            commitIfExpired();
+            if (mWriteBinaryLog)
+                logGeneratedTilesMessage(provided);
+        }
+    };
+
+    std::vector<std::byte> makeCheckpointKey(std::span<const std::filesystem::path> contentFiles,
+        const AgentBounds& agentBounds, const Settings& settings, bool removeUnusedTiles)
+    {
+        std::string data;
+        for (const std::filesystem::path& path : contentFiles)
+        {
+            const std::string name = Files::pathToUnicodeString(path.filename());
+            const Files::IStreamPtr stream = Files::openConstrainedFileStream(path);
+            data += name;
+            appendBytes(Files::getHash(name, *stream), data);
+        }
+        appendBytes(DetourNavigator::navMeshFormatVersion, data);
+        appendBytes(removeUnusedTiles, data);
+        const DetourNavigator::RecastMesh emptyRecastMesh(
+            DetourNavigator::Version{}, DetourNavigator::Mesh({}, {}, {}), {}, {}, {}, {});
+        const std::vector<std::byte> settingsData = serialize(settings.mRecast, agentBounds, emptyRecastMesh, {});
+        data.append(reinterpret_cast<const char*>(settingsData.data()), settingsData.size());
+        std::istringstream stream(std::move(data));
+        std::vector<std::byte> result;
+        for (const std::uint64_t value : Files::getHash("checkpoint", stream))
+            appendBytes(value, result);
+        return result;
     }
 
-    Result generateAllNavMeshTiles(const AgentBounds& agentBounds, const Settings& settings, bool removeUnusedTiles,
-        bool writeBinaryLog, const WorldspaceData& data, NavMeshDb& db, SceneUtil::WorkQueue& workQueue)
+    NavMeshGenerator::NavMeshGenerator(const AgentBounds& agentBounds, const Settings& settings,
+        bool removeUnusedTiles, bool writeBinaryLog, std::vector<std::byte> checkpointKey, NavMeshDb& db,
+        Misc::JobSystem& jobSystem)
+        : mAgentBounds(agentBounds)
+        , mSettings(settings)
+        , mRemoveUnusedTiles(removeUnusedTiles)
+        , mJobSystem(jobSystem)
+        , mConsumer(std::make_shared<NavMeshTileConsumer>(db, removeUnusedTiles, writeBinaryLog,
+              std::move(checkpointKey)))
     {
-        Log(Debug::Info) << "Generating navmesh tiles for " << data.mWorldspace << " worldspace...";
+    }
 
-        auto navMeshTileConsumer = std::make_shared<NavMeshTileConsumer>(db, removeUnusedTiles, writeBinaryLog);
+    NavMeshGenerator::~NavMeshGenerator() = default;
 
-        const auto range = DetourNavigator::makeTilesPositionsRange(
-            Misc::Convert::toOsgXY(data.mAabb.m_min), Misc::Convert::toOsgXY(data.mAabb.m_max), settings.mRecast);
+    bool NavMeshGenerator::hasCheckpoint(ESM::RefId worldspace) const
+    {
+        return mConsumer->hasCheckpoint(worldspace);
+    }
 
-        if (removeUnusedTiles)
-            navMeshTileConsumer->removeTilesOutsideRange(data.mWorldspace, range);
+    bool NavMeshGenerator::waitForPendingWorldspaces(std::size_t maxPendingWorldspaces)
+    {
+        return mConsumer->waitForPendingWorldspaces(maxPendingWorldspaces);
+    }
 
-        std::vector<TilePosition> worldspaceTiles = data.mTiles;
+    void NavMeshGenerator::generate(std::shared_ptr<const WorldspaceData> data)
+    {
+        Log(Debug::Info) << "Generating navmesh tiles for " << data->mWorldspace << " worldspace...";
 
-        {
-            const std::size_t tiles = worldspaceTiles.size();
+        const auto range = DetourNavigator::makeTilesPositionsRange(
+            Misc::Convert::toOsgXY(data->mAabb.m_min), Misc::Convert::toOsgXY(data->mAabb.m_max), mSettings.mRecast);
 
-            if (writeBinaryLog)
-                serializeToStderr(ExpectedTiles{ static_cast<std::uint64_t>(tiles) });
+        if (mRemoveUnusedTiles)
+            mConsumer->removeTilesOutsideRange(data->mWorldspace, range);
 
-            navMeshTileConsumer->mExpected = tiles;
-        }
+        std::vector<TilePosition> worldspaceTiles = data->mTiles;
 
         {
             std::mt19937_64 random;
             std::shuffle(worldspaceTiles.begin(), worldspaceTiles.end(), random);
         }
 
-        for (const TilePosition& tilePosition : worldspaceTiles)
-            workQueue.addWorkItem(new GenerateNavMeshTile(data.mWorldspace, tilePosition,
-                RecastMeshProvider(*data.mTileCachedRecastMeshManager), agentBounds, settings, navMeshTileConsumer));
+        mConsumer->addWorldspace(worldspaceTiles.size());
+
+        if (worldspaceTiles.empty())
+        {
+            mConsumer->completeWorldspace(data->mWorldspace);
+            return;
+        }
+
+        // Tiles are posted from a worker thread to get into its own queue where they can be stolen by other workers
+        mJobSystem.post([&jobSystem = mJobSystem, &agentBounds = mAgentBounds, &settings = mSettings,
+                            consumer = std::weak_ptr(mConsumer), data = std::move(data),
+                            worldspaceTiles = std::move(worldspaceTiles)] {
+            const auto remaining = std::make_shared<std::atomic_size_t>(worldspaceTiles.size());
+            for (const TilePosition& tilePosition : worldspaceTiles)
+                jobSystem.post([&agentBounds, &settings, consumer, data, tilePosition, remaining] {
+                    const auto locked = consumer.lock();
+                    if (locked == nullptr || locked->isCancelled())
+                        return;
+                    const auto start = std::chrono::steady_clock::now();
+                    const osg::ref_ptr<GenerateNavMeshTile> tile(new GenerateNavMeshTile(data->mWorldspace,
+                        tilePosition, RecastMeshProvider(*data->mTileCachedRecastMeshManager), agentBounds,
+                        settings, locked));
+                    tile->doWork();
+                    locked->addThreadStats(std::chrono::steady_clock::now() - start);
+                    if (remaining->fetch_sub(1) == 1)
+                        locked->completeWorldspace(data->mWorldspace);
+                });
+        });
+    }
 
-        const Status status = navMeshTileConsumer->wait();
+    Result NavMeshGenerator::wait()
+    {
+        const Status status = mConsumer->wait();
         if (status == Status::Ok)
-            navMeshTileConsumer->commit();
+            mConsumer->commit();
 
-        const auto inserted = navMeshTileConsumer->getInserted();
-        const auto updated = navMeshTileConsumer->getUpdated();
-        const auto deleted = navMeshTileConsumer->getDeleted();
+        const auto inserted = mConsumer->getInserted();
+        const auto updated = mConsumer->getUpdated();
+        const auto deleted = mConsumer->getDeleted();
 
-        Log(Debug::Info) << "Generated navmesh for " << navMeshTileConsumer->getProvided() << " tiles, " << inserted
+        Log(Debug::Info) << "Generated navmesh for " << mConsumer->getProvided() << " tiles, " << inserted
                          << " are inserted, " << updated << " updated and " << deleted << " deleted";
 
         return Result{
@@ -296,4 +468,9 @@ namespace NavMeshTool
             .mNeedVacuum = inserted + updated + deleted > 0,
         };
     }
+
+    std::map<std::thread::id, ThreadStats> NavMeshGenerator::getThreadStats() const
+    {
+        return mConsumer->getThreadStats();
+    }
 }
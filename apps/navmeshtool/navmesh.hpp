@@ -1,6 +1,15 @@
 #ifndef OPENMW_NAVMESHTOOL_NAVMESH_H
 #define OPENMW_NAVMESHTOOL_NAVMESH_H
 
+#include <chrono>
+#include <cstddef>
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <span>
+#include <thread>
+#include <vector>
+
 namespace DetourNavigator
 {
     class NavMeshDb;
@@ -8,14 +17,20 @@ namespace DetourNavigator
     struct AgentBounds;
 }
 
-namespace SceneUtil
+namespace ESM
 {
-    class WorkQueue;
+    class RefId;
+}
+
+namespace Misc
+{
+    class JobSystem;
 }
 
 namespace NavMeshTool
 {
     struct WorldspaceData;
+    class NavMeshTileConsumer;
 
     enum class Status
     {
@@ -30,9 +45,51 @@ namespace NavMeshTool
         bool mNeedVacuum;
     };
 
-    Result generateAllNavMeshTiles(const DetourNavigator::AgentBounds& agentBounds,
-        const DetourNavigator::Settings& settings, bool removeUnusedTiles, bool writeBinaryLog,
-        const WorldspaceData& data, DetourNavigator::NavMeshDb& db, SceneUtil::WorkQueue& workQueue);
+    struct ThreadStats
+    {
+        std::size_t mTiles = 0;
+        std::chrono::steady_clock::duration mBusyTime{ 0 };
+    };
+
+    /// Returns a key identifying content files and settings affecting generated tiles. Worldspace checkpoint with the
+    /// same key means it is already completely processed.
+    std::vector<std::byte> makeCheckpointKey(std::span<const std::filesystem::path> contentFiles,
+        const DetourNavigator::AgentBounds& agentBounds, const DetourNavigator::Settings& settings,
+        bool removeUnusedTiles);
+
+    /// Generates navmesh tiles for multiple worldspaces using one job per tile. Tiles of a worldspace are scheduled
+    /// from a worker thread so idle workers steal them from its queue. Tiles of the next worldspace may be scheduled
+    /// while tiles of the previous ones are still being generated.
+    class NavMeshGenerator
+    {
+    public:
+        explicit NavMeshGenerator(const DetourNavigator::AgentBounds& agentBounds,
+            const DetourNavigator::Settings& settings, bool removeUnusedTiles, bool writeBinaryLog,
+            std::vector<std::byte> checkpointKey, DetourNavigator::NavMeshDb& db, Misc::JobSystem& jobSystem);
+
+        ~NavMeshGenerator();
+
+        bool hasCheckpoint(ESM::RefId worldspace) const;
+
+        /// Blocks until less than maxPendingWorldspaces are being generated. Returns false if generation is cancelled.
+        bool waitForPendingWorldspaces(std::size_t maxPendingWorldspaces);
+
+        /// Schedules generation of all worldspace tiles. Worldspace checkpoint is written when all of them are
+        /// processed.
+        void generate(std::shared_ptr<const WorldspaceData> data);
+
+        /// Returns when all scheduled tiles are processed or generation is cancelled.
+        Result wait();
+
+        std::map<std::thread::id, ThreadStats> getThreadStats() const;
+
+    private:
+        const DetourNavigator::AgentBounds& mAgentBounds;
+        const DetourNavigator::Settings& mSettings;
+        const bool mRemoveUnusedTiles;
+        Misc::JobSystem& mJobSystem;
+        std::shared_ptr<NavMeshTileConsumer> mConsumer;
+    };
 }
 
 #endif
@@ -44,6 +44,7 @@
 #include <components/loadinglistener/loadinglistener.hpp>
 
 #include <components/misc/frameratelimiter.hpp>
+#include <components/misc/pathhelpers.hpp>
 
 #include <components/sceneutil/color.hpp>
 #include <components/sceneutil/depth.hpp>
@@ -62,6 +63,7 @@
 #include "mwlua/worker.hpp"
 
 #include "mwscript/interpretercontext.hpp"
+#include "mwscript/scriptcache.hpp"
 #include "mwscript/scriptmanagerimp.hpp"
 
 #include "mwsound/constants.hpp"
@@ -172,6 +174,20 @@ namespace
         for (osg::Camera* camera : cameras)
             camera->getStats()->report(stream, frameNumber);
     }
+
+    std::vector<std::filesystem::path> getContentFilePaths(
+        const Files::Collections& fileCollections, const std::vector<std::string>& contentFiles)
+    {
+        std::vector<std::filesystem::path> result;
+        for (const std::string& file : contentFiles)
+        {
+            const Files::MultiDirCollection& collection
+                = fileCollections.getCollection(Misc::getFileExtension(file));
+            if (collection.doesExist(file))
+                result.push_back(collection.getPath(file));
+        }
+        return result;
+    }
 }
 
 void OMW::Engine::executeLocalScripts()
@@ -736,10 +752,15 @@ void OMW::Engine::prepareEngine()
 
     mVFS = std::make_unique<VFS::Manager>();
 
-    VFS::registerArchives(mVFS.get(), mFileCollections, mArchives, true, &mEncoder.get()->getStatelessEncoder());
+    VFS::registerArchives(mVFS.get(), mFileCollections, mArchives, true, &mEncoder.get()->getStatelessEncoder(),
+        Settings::general().mCacheFileIndex ? mCfgMgr.getCachePath() / "vfs" : std::filesystem::path());
+    mVFS->setDecompressionThreads(static_cast<std::size_t>(Settings::cells().mArchiveDecompressionThreads));
 
     mResourceSystem = std::make_unique<Resource::ResourceSystem>(
         mVFS.get(), Settings::cells().mCacheExpiryDelay, &mEncoder.get()->getStatelessEncoder());
+    mResourceSystem->setCacheShards(static_cast<std::size_t>(Settings::cells().mCacheShards));
+    mResourceSystem->setMemoryBudget(static_cast<std::size_t>(Settings::cells().mCacheMemoryBudget) * 1024 * 1024,
+        static_cast<std::size_t>(Settings::cells().mCacheTypeMemoryBudget) * 1024 * 1024);
     mResourceSystem->getSceneManager()->getShaderManager().setMaxTextureUnits(mGlMaxTextureImageUnits);
     mResourceSystem->getSceneManager()->setUnRefImageDataAfterApply(
         false); // keep to Off for now to allow better state sharing
@@ -767,6 +788,13 @@ void OMW::Engine::prepareEngine()
 
     mLuaManager = std::make_unique<MWLua::LuaManager>(mVFS.get(), mResDir / "lua_libs");
     mEnvironment.setLuaManager(*mLuaManager);
+    if (mLuaProfilePath.empty())
+        mLuaManager->setProfilerOutputPath(mCfgMgr.getLogPath() / "lua_profile");
+    else
+    {
+        mLuaManager->setProfilerOutputPath(mLuaProfilePath);
+        mLuaManager->startProfiler();
+    }
 
     // Create input and UI first to set up a bootstrapping environment for
     // showing a loading screen and keeping the window responsive while doing so
@@ -884,8 +912,12 @@ void OMW::Engine::prepareEngine()
 
     Loading::Listener* listener = MWBase::Environment::get().getWindowManager()->getLoadingScreen();
     Loading::AsyncListener asyncListener(*listener);
-    auto dataLoading = std::async(std::launch::async,
-        [&] { mWorld->loadData(mFileCollections, mContentFiles, mGroundcoverFiles, mEncoder.get(), &asyncListener); });
+    const std::filesystem::path contentCacheDir
+        = Settings::general().mCacheContent ? mCfgMgr.getCachePath() / "content" : std::filesystem::path();
+    auto dataLoading = std::async(std::launch::async, [&] {
+        mWorld->loadData(
+            mFileCollections, mContentFiles, mGroundcoverFiles, mEncoder.get(), contentCacheDir, &asyncListener);
+    });
 
     if (!mSkipMenu)
     {
@@ -911,6 +943,22 @@ void OMW::Engine::prepareEngine()
     mLuaManager->initPostLoad();
 
     // scripts
+    if (Settings::general().mCacheScripts)
+    {
+        std::vector<std::filesystem::path> contentFiles = getContentFilePaths(mFileCollections, mContentFiles);
+        const std::vector<std::filesystem::path> groundcoverFiles
+            = getContentFilePaths(mFileCollections, mGroundcoverFiles);
+        contentFiles.insert(contentFiles.end(), groundcoverFiles.begin(), groundcoverFiles.end());
+        try
+        {
+            mScriptManager->loadCache(mCfgMgr.getCachePath() / "scripts" / "scripts.bin",
+                MWScript::makeScriptCacheKey(mExtensions, contentFiles));
+        }
+        catch (const std::exception& e)
+        {
+            Log(Debug::Warning) << "Failed to use compiled scripts cache: " << e.what();
+        }
+    }
     if (mCompileAll)
     {
         std::pair<int, int> result = mScriptManager->compileAll();
@@ -1070,6 +1118,9 @@ void OMW::Engine::go()
     }
 
     mLuaWorker->join();
+    mLuaManager->stopProfiler();
+
+    mScriptManager->saveCache();
 
     // Save user settings
     Settings::Manager::saveUser(mCfgMgr.getUserConfigPath() / "settings.cfg");
@@ -1127,6 +1178,11 @@ void OMW::Engine::setSaveGameFile(const std::filesystem::path& savegame)
     mSaveGameFile = savegame;
 }
 
+void OMW::Engine::setLuaProfilePath(const std::filesystem::path& path)
+{
+    mLuaProfilePath = path;
+}
+
 void OMW::Engine::setRandomSeed(unsigned int seed)
 {
     mRandomSeed = seed;
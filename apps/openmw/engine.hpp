@@ -169,6 +169,7 @@ namespace OMW
         std::filesystem::path mStartupScript;
         int mActivationDistanceOverride;
         std::filesystem::path mSaveGameFile;
+        std::filesystem::path mLuaProfilePath;
         // Grab mouse?
         bool mGrab;
 
@@ -262,6 +263,9 @@ namespace OMW
         /// Set the save game file to load after initialising the engine.
         void setSaveGameFile(const std::filesystem::path& savegame);
 
+        /// Profile Lua handlers from startup and write the capture to the given path on exit.
+        void setLuaProfilePath(const std::filesystem::path& path);
+
         void setRandomSeed(unsigned int seed);
 
         void setRecastMaxLogLevel(Debug::Level value) { mMaxRecastLogLevel = value; }
@@ -241,6 +241,9 @@ namespace MWBase
         void setSimulationTimeScale(float scale) { mSimulationTimeScale = scale; }
         float getSimulationTimeScale() const { return mSimulationTimeScale; }
 
+        virtual void preloadSounds(const MWWorld::CellStore& cell) = 0;
+        ///< Start loading region and creature sounds of the cell in background if sounds are loaded asynchronously.
+
         virtual void clear() = 0;
     };
 }
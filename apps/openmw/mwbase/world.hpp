@@ -81,6 +81,7 @@ namespace MWMechanics
 namespace DetourNavigator
 {
     struct Navigator;
+    class AsyncPathFinder;
     struct AgentBounds;
 }
 
@@ -576,6 +577,9 @@ namespace MWBase
 
         virtual DetourNavigator::Navigator* getNavigator() const = 0;
 
+        /// Returns nullptr if paths should be found synchronously.
+        virtual DetourNavigator::AsyncPathFinder* getAsyncPathFinder() const = 0;
+
         virtual void updateActorPath(const MWWorld::ConstPtr& actor, const std::deque<osg::Vec3f>& path,
             const DetourNavigator::AgentBounds& agentBounds, const osg::Vec3f& start, const osg::Vec3f& end) const = 0;
 
@@ -711,6 +711,36 @@ bool MWDialogue::Filter::hasFactionRankReputationRequirements(
     return stats.getFactionReputation(factionId) >= faction.mData.mRankData.at(rank).mFactReputation;
 }
 
+void MWDialogue::Filter::getCandidates(
+    const ESM::Dialogue& dialogue, std::vector<const ESM::DialInfo*>& candidates) const
+{
+    const MWWorld::DialogueInfoIndex* index
+        = MWBase::Environment::get().getESMStore()->get<ESM::Dialogue>().searchInfoIndex(dialogue.mId);
+
+    if (index == nullptr || &index->getDialogue() != &dialogue)
+    {
+        candidates.clear();
+        for (const auto& info : dialogue.mInfo)
+            candidates.push_back(&info);
+        return;
+    }
+
+    MWWorld::DialogueInfoIndex::Query query;
+    query.mActor = mActor.getCellRef().getRefId();
+    query.mCreature = mActor.getType() != ESM::NPC::sRecordId;
+    if (!query.mCreature)
+    {
+        const ESM::NPC& npc = *mActor.get<ESM::NPC>()->mBase;
+        query.mRace = npc.mRace;
+        query.mClass = npc.mClass;
+        query.mFaction = mActor.getClass().getPrimaryFaction(mActor);
+    }
+    const MWWorld::Ptr player = MWMechanics::getPlayer();
+    query.mCell = MWBase::Environment::get().getWorld()->getCellName(player.getCell());
+
+    index->getCandidates(query, candidates);
+}
+
 MWDialogue::Filter::Filter(const MWWorld::Ptr& actor, int choice, bool talkedToPlayer)
     : mActor(actor)
     , mChoice(choice)
@@ -741,14 +771,17 @@ std::vector<MWDialogue::Filter::Response> MWDialogue::Filter::list(
 
     bool infoRefusal = false;
 
+    std::vector<const ESM::DialInfo*> candidates;
+    getCandidates(dialogue, candidates);
+
     // Iterate over topic responses to find a matching one
-    for (const auto& info : dialogue.mInfo)
+    for (const ESM::DialInfo* info : candidates)
     {
-        if (testActor(info) && testPlayer(info) && testSelectStructs(info))
+        if (testActor(*info) && testPlayer(*info) && testSelectStructs(*info))
         {
-            if (testDisposition(info, invertDisposition))
+            if (testDisposition(*info, invertDisposition))
             {
-                infos.emplace_back(&dialogue, &info);
+                infos.emplace_back(&dialogue, info);
                 if (!searchAll)
                     break;
             }
@@ -766,11 +799,13 @@ std::vector<MWDialogue::Filter::Response> MWDialogue::Filter::list(
 
         const ESM::Dialogue& infoRefusalDialogue = *dialogues.find(ESM::RefId::stringRefId("Info Refusal"));
 
-        for (const auto& info : infoRefusalDialogue.mInfo)
-            if (testActor(info) && testPlayer(info) && testSelectStructs(info)
-                && testDisposition(info, invertDisposition))
+        getCandidates(infoRefusalDialogue, candidates);
+
+        for (const ESM::DialInfo* info : candidates)
+            if (testActor(*info) && testPlayer(*info) && testSelectStructs(*info)
+                && testDisposition(*info, invertDisposition))
             {
-                infos.emplace_back(&infoRefusalDialogue, &info);
+                infos.emplace_back(&infoRefusalDialogue, info);
                 if (!searchAll)
                     break;
             }
@@ -52,6 +52,9 @@ namespace MWDialogue
         bool hasFactionRankReputationRequirements(
             const MWWorld::Ptr& actor, const ESM::RefId& factionId, int rank) const;
 
+        void getCandidates(const ESM::Dialogue& dialogue, std::vector<const ESM::DialInfo*>& candidates) const;
+        ///< Get infos of \a dialogue in order skipping those that can't match the actor or the player cell.
+
     public:
         using Response = std::pair<const ESM::Dialogue*, const ESM::DialInfo*>;
 
@@ -147,8 +147,9 @@ namespace MWLua
             if (context.mType != Context::Menu)
             {
                 api["sendGlobalEvent"] = [context](std::string eventName, const sol::object& eventData) {
-                    context.mLuaEvents->addGlobalEvent(
-                        { std::move(eventName), LuaUtil::serialize(eventData, context.mSerializer) });
+                    std::string data = context.mLuaEvents->takeBuffer();
+                    LuaUtil::serialize(data, eventData, context.mSerializer);
+                    context.mLuaEvents->addGlobalEvent({ std::move(eventName), std::move(data) });
                 };
                 api["sound"]
                     = context.cachePackage("openmw_core_sound", [context]() { return initCoreSoundBindings(context); });
@@ -160,8 +161,9 @@ namespace MWLua
                     {
                         throw std::logic_error("Can't send global events when no game is loaded");
                     }
-                    context.mLuaEvents->addGlobalEvent(
-                        { std::move(eventName), LuaUtil::serialize(eventData, context.mSerializer) });
+                    std::string data = context.mLuaEvents->takeBuffer();
+                    LuaUtil::serialize(data, eventData, context.mSerializer);
+                    context.mLuaEvents->addGlobalEvent({ std::move(eventName), std::move(data) });
                 };
             }
         }
@@ -94,6 +94,14 @@ namespace MWLua
             });
         };
 
+        api["startLuaProfiler"] = [context]() {
+            context.mLuaManager->addAction([luaManager = context.mLuaManager] { luaManager->startProfiler(); });
+        };
+        api["stopLuaProfiler"] = [context]() {
+            context.mLuaManager->addAction([luaManager = context.mLuaManager] { luaManager->stopProfiler(); });
+        };
+        api["isLuaProfilerRunning"] = [context]() { return context.mLuaManager->isProfilerRunning(); };
+
         return LuaUtil::makeReadOnly(api);
     }
 }
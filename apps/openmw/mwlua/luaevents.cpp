@@ -1,5 +1,7 @@
 #include "luaevents.hpp"
 
+#include <iterator>
+
 #include <components/debug/debuglog.hpp>
 
 #include <components/esm/luascripts.hpp>
@@ -17,6 +19,29 @@
 
 namespace MWLua
 {
+    namespace
+    {
+        constexpr std::size_t maxPooledBuffers = 256;
+        // Don't keep memory of rare large events
+        constexpr std::size_t maxPooledBufferCapacity = 4096;
+    }
+
+    std::string LuaEvents::takeBuffer()
+    {
+        if (mBufferPool.empty())
+            return {};
+        std::string buffer = std::move(mBufferPool.back());
+        mBufferPool.pop_back();
+        return buffer;
+    }
+
+    void LuaEvents::releaseBuffer(std::string&& buffer)
+    {
+        if (mBufferPool.size() >= maxPooledBuffers || buffer.capacity() > maxPooledBufferCapacity)
+            return;
+        buffer.clear();
+        mBufferPool.push_back(std::move(buffer));
+    }
 
     void LuaEvents::clear()
     {
@@ -27,6 +52,27 @@ namespace MWLua
         mMenuEvents.clear();
     }
 
+    void LuaEvents::moveNewEventsTo(LuaEvents& events)
+    {
+        // Buffers of the moved events return to the pool of `events`, give back the same number of pooled buffers
+        std::size_t buffers = mNewGlobalEventBatch.size() + mNewLocalEventBatch.size() + mMenuEvents.size();
+        while (buffers > 0 && !events.mBufferPool.empty() && mBufferPool.size() < maxPooledBuffers)
+        {
+            mBufferPool.push_back(std::move(events.mBufferPool.back()));
+            events.mBufferPool.pop_back();
+            --buffers;
+        }
+        events.mNewGlobalEventBatch.insert(events.mNewGlobalEventBatch.end(),
+            std::make_move_iterator(mNewGlobalEventBatch.begin()), std::make_move_iterator(mNewGlobalEventBatch.end()));
+        events.mNewLocalEventBatch.insert(events.mNewLocalEventBatch.end(),
+            std::make_move_iterator(mNewLocalEventBatch.begin()), std::make_move_iterator(mNewLocalEventBatch.end()));
+        events.mMenuEvents.insert(events.mMenuEvents.end(), std::make_move_iterator(mMenuEvents.begin()),
+            std::make_move_iterator(mMenuEvents.end()));
+        mNewGlobalEventBatch.clear();
+        mNewLocalEventBatch.clear();
+        mMenuEvents.clear();
+    }
+
     void LuaEvents::finalizeEventBatch()
     {
         mNewGlobalEventBatch.swap(mGlobalEventBatch);
@@ -37,10 +83,13 @@ namespace MWLua
 
     void LuaEvents::callEventHandlers()
     {
-        for (const Global& e : mGlobalEventBatch)
+        for (Global& e : mGlobalEventBatch)
+        {
             mGlobalScripts.receiveEvent(e.mEventName, e.mEventData);
+            releaseBuffer(std::move(e.mEventData));
+        }
         mGlobalEventBatch.clear();
-        for (const Local& e : mLocalEventBatch)
+        for (Local& e : mLocalEventBatch)
         {
             MWWorld::Ptr ptr = MWBase::Environment::get().getWorldModel()->getPtr(e.mDest);
             LocalScripts* scripts = ptr.isEmpty() ? nullptr : ptr.getRefData().getLuaScripts();
@@ -49,14 +98,18 @@ namespace MWLua
             else
                 Log(Debug::Debug) << "Ignored event " << e.mEventName << " to L" << e.mDest.toString()
                                   << ". Object not found or has no attached scripts";
+            releaseBuffer(std::move(e.mEventData));
         }
         mLocalEventBatch.clear();
     }
 
     void LuaEvents::callMenuEventHandlers()
     {
-        for (const Global& e : mMenuEvents)
+        for (Global& e : mMenuEvents)
+        {
             mMenuScripts.receiveEvent(e.mEventName, e.mEventData);
+            releaseBuffer(std::move(e.mEventData));
+        }
         mMenuEvents.clear();
     }
 
@@ -3,6 +3,7 @@
 
 #include <map>
 #include <string>
+#include <vector>
 
 #include <components/esm3/cellref.hpp> // defines RefNum that is used as a unique id
 
@@ -50,7 +51,14 @@ namespace MWLua
         void addMenuEvent(Global event) { mMenuEvents.push_back(std::move(event)); }
         void addLocalEvent(Local event) { mNewLocalEventBatch.push_back(std::move(event)); }
 
+        // Returns an empty buffer for event data. Buffers of the delivered events are reused to avoid allocating
+        // new ones for every event.
+        std::string takeBuffer();
+
         void clear();
+        // Moves events that are not finalized yet to the end of the new batch of `events`. Takes as many pooled
+        // buffers from `events` in exchange.
+        void moveNewEventsTo(LuaEvents& events);
         void finalizeEventBatch();
         void callEventHandlers();
         void callMenuEventHandlers();
@@ -60,6 +68,8 @@ namespace MWLua
         void save(ESM::ESMWriter& esm) const;
 
     private:
+        void releaseBuffer(std::string&& buffer);
+
         GlobalScripts& mGlobalScripts;
         MenuScripts& mMenuScripts;
         std::vector<Global> mNewGlobalEventBatch;
@@ -67,6 +77,7 @@ namespace MWLua
         std::vector<Global> mGlobalEventBatch;
         std::vector<Local> mLocalEventBatch;
         std::vector<Global> mMenuEvents;
+        std::vector<std::string> mBufferPool;
     };
 
 }
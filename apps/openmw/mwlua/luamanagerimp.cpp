@@ -1,6 +1,10 @@
 #include "luamanagerimp.hpp"
 
+#include <algorithm>
 #include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <sstream>
 
 #include <MyGUI_InputManager.h>
 #include <osg/Stats>
@@ -57,6 +61,8 @@ namespace MWLua
         };
     }
 
+    thread_local LuaManager::LocalState* LuaManager::sUpdatingLocalState = nullptr;
+
     static LuaUtil::LuaStateSettings createLuaStateSettings()
     {
         if (!Settings::lua().mLuaProfiler)
@@ -79,6 +85,25 @@ namespace MWLua
         mLocalLoader = createUserdataSerializer(true, &mContentFileMapping);
 
         mGlobalScripts.setSerializer(mGlobalSerializer.get());
+        mLua.setProfiler(&mProfiler);
+
+        int localScriptsThreads = Settings::lua().mLocalScriptsThreads;
+        if (localScriptsThreads > 0 && !mLua.guardCFunctionCalls())
+        {
+            Log(Debug::Warning) << "Local Lua scripts can run in parallel only with LuaJIT, ignoring \"local scripts "
+                                   "threads\" setting";
+            localScriptsThreads = 0;
+        }
+        for (int i = 0; i < localScriptsThreads; ++i)
+        {
+            mLocalStates.push_back(std::make_unique<LocalState>(vfs, &mConfiguration, mGlobalScripts, mMenuScripts));
+            mLocalStates.back()->mLua.addInternalLibSearchPath(libsDir);
+            mLocalStates.back()->mLua.setProfiler(&mProfiler);
+            mLocalStates.back()->mLua.guardCFunctionCalls();
+        }
+        mLocalScriptsByState.resize(mLocalStates.size() + 1);
+        if (!mLocalStates.empty())
+            mLocalScriptsJobs = std::make_unique<Misc::JobSystem>(mLocalStates.size());
     }
 
     LuaManager::~LuaManager()
@@ -114,6 +139,21 @@ namespace MWLua
 
             LuaUtil::LuaStorage::initLuaBindings(view);
         });
+
+        for (const std::unique_ptr<LocalState>& state : mLocalStates)
+        {
+            state->mLua.protectedCall([&](LuaUtil::LuaView& view) {
+                Context context;
+                context.mType = Context::Load;
+                context.mLuaManager = this;
+                context.mLua = &state->mLua;
+
+                for (const auto& [name, package] : initCommonPackages(context))
+                    state->mLua.addCommonPackage(name, package);
+
+                LuaUtil::LuaStorage::initLuaBindings(view);
+            });
+        }
     }
 
     void LuaManager::contentFilesLoaded()
@@ -160,6 +200,18 @@ namespace MWLua
             mPlayerPackages["openmw.storage"]
                 = LuaUtil::LuaStorage::initPlayerPackage(view, &mGlobalStorage, &mPlayerStorage);
 
+            for (const std::unique_ptr<LocalState>& state : mLocalStates)
+            {
+                state->mLua.protectedCall([&](LuaUtil::LuaView& localView) {
+                    Context context = localContext;
+                    context.mLua = &state->mLua;
+                    context.mLuaEvents = &state->mLuaEvents;
+                    state->mPackages = initLocalPackages(context);
+                    state->mPackages["openmw.storage"]
+                        = LuaUtil::LuaStorage::initLocalPackage(localView, &mGlobalStorage);
+                });
+            }
+
             mPlayerStorage.setActive(true);
             mGlobalStorage.setActive(false);
 
@@ -208,6 +260,10 @@ namespace MWLua
         if (const int steps = Settings::lua().mGcStepsPerFrame; steps > 0)
             lua_gc(mLua.unsafeState(), LUA_GCSTEP, steps);
 
+        // Events that local scripts of additional states have sent since the last update, e.g. from handlers
+        // called by the engine
+        collectLocalStatesOutput();
+
         if (mPlayer.isEmpty())
             return; // The game is not started yet.
 
@@ -258,14 +314,87 @@ namespace MWLua
             bool isPaused = timeManager.isPaused();
 
             float frameDuration = MWBase::Environment::get().getFrameDuration();
-            for (LocalScripts* scripts : mActiveLocalScripts)
-                scripts->update(isPaused ? 0 : frameDuration);
+            updateLocalScripts(isPaused ? 0 : frameDuration);
             mGlobalScripts.update(isPaused ? 0 : frameDuration);
 
             mScriptTracker.unloadInactiveScripts(lua);
         });
     }
 
+    void LuaManager::updateLocalScripts(float dt)
+    {
+        if (mLocalStates.empty())
+        {
+            for (LocalScripts* scripts : mActiveLocalScripts)
+                scripts->update(dt);
+            return;
+        }
+
+        for (std::vector<LocalScripts*>& scripts : mLocalScriptsByState)
+            scripts.clear();
+        for (LocalScripts* scripts : mActiveLocalScripts)
+        {
+            const LuaUtil::LuaState* lua = &scripts->getLuaState();
+            const auto it = std::find_if(mLocalStates.begin(), mLocalStates.end(),
+                [&](const std::unique_ptr<LocalState>& state) { return &state->mLua == lua; });
+            const std::size_t index
+                = it == mLocalStates.end() ? 0 : static_cast<std::size_t>(it - mLocalStates.begin()) + 1;
+            mLocalScriptsByState[index].push_back(scripts);
+        }
+
+        const int gcSteps = Settings::lua().mGcStepsPerFrame;
+        mLocalScriptsJobs->parallelFor(mLocalScriptsByState.size(), [&](std::size_t index) {
+            // Bindings use engine state that is not thread safe and may change it even when they only read data,
+            // e.g. by registering objects in the world model
+            const LuaUtil::CFunctionCallsGuard guard(mEngineCallsMutex);
+            if (index == 0)
+            {
+                for (LocalScripts* scripts : mLocalScriptsByState[0])
+                    scripts->update(dt);
+                return;
+            }
+            LocalState& state = *mLocalStates[index - 1];
+            sUpdatingLocalState = &state;
+            try
+            {
+                if (gcSteps > 0)
+                    lua_gc(state.mLua.unsafeState(), LUA_GCSTEP, gcSteps);
+                state.mLua.protectedCall([&](LuaUtil::LuaView& view) {
+                    for (LocalScripts* scripts : mLocalScriptsByState[index])
+                        scripts->update(dt);
+                    state.mScriptTracker.unloadInactiveScripts(view);
+                });
+            }
+            catch (const std::exception& e)
+            {
+                Log(Debug::Error) << "Failed to update local Lua scripts: " << e.what();
+            }
+            sUpdatingLocalState = nullptr;
+        });
+
+        collectLocalStatesOutput();
+    }
+
+    void LuaManager::collectLocalStatesOutput()
+    {
+        for (const std::unique_ptr<LocalState>& state : mLocalStates)
+        {
+            state->mLuaEvents.moveNewEventsTo(mLuaEvents);
+            mActionQueue.insert(mActionQueue.end(), std::make_move_iterator(state->mActionQueue.begin()),
+                std::make_move_iterator(state->mActionQueue.end()));
+            state->mActionQueue.clear();
+        }
+    }
+
+    LuaManager::LocalState* LuaManager::getLocalState(const MWWorld::Ptr& ptr) const
+    {
+        if (mLocalStates.empty())
+            return nullptr;
+        // The main state gets its share of objects too
+        const std::size_t index = std::hash<ObjectId>()(getId(ptr)) % (mLocalStates.size() + 1);
+        return index == 0 ? nullptr : mLocalStates[index - 1].get();
+    }
+
     void LuaManager::objectTeleported(const MWWorld::Ptr& ptr)
     {
         if (ptr == mPlayer)
@@ -397,8 +526,17 @@ namespace MWLua
         mInputActions.clear();
         mInputTriggers.clear();
         mQueuedAutoStartedScripts.clear();
+        for (const std::unique_ptr<LocalState>& state : mLocalStates)
+        {
+            state->mLuaEvents.clear();
+            state->mActionQueue.clear();
+        }
         for (int i = 0; i < 5; ++i)
+        {
             lua_gc(mLua.unsafeState(), LUA_GCCOLLECT, 0);
+            for (const std::unique_ptr<LocalState>& state : mLocalStates)
+                lua_gc(state->mLua.unsafeState(), LUA_GCCOLLECT, 0);
+        }
     }
 
     void LuaManager::setupPlayer(const MWWorld::Ptr& ptr)
@@ -513,7 +651,11 @@ namespace MWLua
         const MWRender::AnimPriority& priority, int blendMask, bool autodisable, float speedmult,
         std::string_view start, std::string_view stop, float startpoint, uint32_t loops, bool loopfallback)
     {
-        mLua.protectedCall([&](LuaUtil::LuaView& view) {
+        LocalScripts* scripts = actor.getRefData().getLuaScripts();
+        if (!scripts)
+            return;
+        // The options are passed to the handlers, so they must be created in the Lua state of the scripts
+        scripts->getLuaState().protectedCall([&](LuaUtil::LuaView& view) {
             sol::table options = view.newTable();
             options["blendMask"] = blendMask;
             options["autoDisable"] = autodisable;
@@ -541,8 +683,7 @@ namespace MWLua
             // mEngineEvents.addToQueue(event);
             //  Has to be called immediately, otherwise engine details that depend on animations playing immediately
             //  break.
-            if (auto* scripts = actor.getRefData().getLuaScripts())
-                scripts->onPlayAnimation(groupname, options);
+            scripts->onPlayAnimation(groupname, options);
         });
     }
 
@@ -695,11 +836,15 @@ namespace MWLua
         }
         else
         {
-            scripts = std::make_shared<LocalScripts>(&mLua, LObject(getId(ptr)), &mScriptTracker);
+            LocalState* state = getLocalState(ptr);
+            if (state != nullptr)
+                scripts = std::make_shared<LocalScripts>(&state->mLua, LObject(getId(ptr)), &state->mScriptTracker);
+            else
+                scripts = std::make_shared<LocalScripts>(&mLua, LObject(getId(ptr)), &mScriptTracker);
             if (!autoStartConf.has_value())
                 autoStartConf = mConfiguration.getLocalConf(type, ptr.getCellRef().getRefId(), getId(ptr));
             scripts->setAutoStartConf(std::move(*autoStartConf));
-            for (const auto& [name, package] : mLocalPackages)
+            for (const auto& [name, package] : state != nullptr ? state->mPackages : mLocalPackages)
                 scripts->addPackage(name, package);
         }
         scripts->setSerializer(mLocalSerializer.get());
@@ -719,6 +864,7 @@ namespace MWLua
         ESM::LuaScripts globalScripts;
         mGlobalScripts.save(globalScripts);
         globalScripts.save(writer);
+        collectLocalStatesOutput();
         mLuaEvents.save(writer);
 
         writer.endRecord(ESM::REC_LUAM);
@@ -790,6 +936,8 @@ namespace MWLua
         MWBase::Environment::get().getL10nManager()->dropCache();
         mUiResourceManager.clear();
         mLua.dropScriptCache();
+        for (const std::unique_ptr<LocalState>& state : mLocalStates)
+            state->mLua.dropScriptCache();
         mInputActions.clear(true);
         mInputTriggers.clear(true);
 
@@ -887,11 +1035,21 @@ namespace MWLua
         }
     }
 
+    LuaManager::LocalState::LocalState(const VFS::Manager* vfs, const LuaUtil::ScriptsConfiguration* conf,
+        GlobalScripts& globalScripts, MenuScripts& menuScripts)
+        : mLua(vfs, conf, createLuaStateSettings())
+        , mLuaEvents(globalScripts, menuScripts)
+    {
+    }
+
     void LuaManager::addAction(std::function<void()> action, std::string_view name)
     {
         if (mApplyingDelayedActions)
             throw std::runtime_error("DelayedAction is not allowed to create another DelayedAction");
-        mActionQueue.emplace_back(&mLua, std::move(action), name);
+        if (sUpdatingLocalState != nullptr)
+            sUpdatingLocalState->mActionQueue.emplace_back(&sUpdatingLocalState->mLua, std::move(action), name);
+        else
+            mActionQueue.emplace_back(&mLua, std::move(action), name);
     }
 
     void LuaManager::addTeleportPlayerAction(std::function<void()> action)
@@ -901,7 +1059,10 @@ namespace MWLua
 
     void LuaManager::reportStats(unsigned int frameNumber, osg::Stats& stats) const
     {
-        stats.setAttribute(frameNumber, "Lua UsedMemory", static_cast<double>(mLua.getTotalMemoryUsage()));
+        uint64_t usedMemory = mLua.getTotalMemoryUsage();
+        for (const std::unique_ptr<LocalState>& state : mLocalStates)
+            usedMemory += state->mLua.getTotalMemoryUsage();
+        stats.setAttribute(frameNumber, "Lua UsedMemory", static_cast<double>(usedMemory));
     }
 
     std::string LuaManager::formatResourceUsageStats() const
@@ -927,19 +1088,27 @@ namespace MWLua
                 out << (bytes / (1024 * 1024 * 1024)) << " GB";
         };
 
+        uint64_t totalMemoryUsage = mLua.getTotalMemoryUsage();
+        uint64_t smallAllocMemoryUsage = mLua.getSmallAllocMemoryUsage();
+        for (const std::unique_ptr<LocalState>& state : mLocalStates)
+        {
+            totalMemoryUsage += state->mLua.getTotalMemoryUsage();
+            smallAllocMemoryUsage += state->mLua.getSmallAllocMemoryUsage();
+        }
+
         const uint64_t smallAllocSize = Settings::lua().mSmallAllocMaxSize;
         out << "Total memory usage:";
-        outMemSize(mLua.getTotalMemoryUsage());
+        outMemSize(totalMemoryUsage);
         out << "\n";
         out << "LuaUtil::ScriptsContainer count: " << LuaUtil::ScriptsContainer::getInstanceCount() << "\n";
         out << "\n";
         out << "small alloc max size = " << smallAllocSize << " (section [Lua] in settings.cfg)\n";
         out << "Smaller values give more information for the profiler, but increase performance overhead.\n";
         out << "  Memory allocations <= " << smallAllocSize << " bytes:";
-        outMemSize(mLua.getSmallAllocMemoryUsage());
+        outMemSize(smallAllocMemoryUsage);
         out << " (not tracked)\n";
         out << "  Memory allocations >  " << smallAllocSize << " bytes:";
-        outMemSize(mLua.getTotalMemoryUsage() - mLua.getSmallAllocMemoryUsage());
+        outMemSize(totalMemoryUsage - smallAllocMemoryUsage);
         out << " (see the table below)\n\n";
 
         using Stats = LuaUtil::ScriptsContainer::ScriptStats;
@@ -1000,8 +1169,10 @@ namespace MWLua
             out << std::right;
             out << std::setw(valueW) << static_cast<int64_t>(activeStats[i].mAvgInstructionCount);
             outMemSize(static_cast<size_t>(activeStats[i].mMemoryUsage));
-            outMemSize(mLua.getMemoryUsageByScriptIndex(static_cast<unsigned>(i))
-                - static_cast<uint64_t>(activeStats[i].mMemoryUsage));
+            uint64_t scriptMemoryUsage = mLua.getMemoryUsageByScriptIndex(static_cast<unsigned>(i));
+            for (const std::unique_ptr<LocalState>& state : mLocalStates)
+                scriptMemoryUsage += state->mLua.getMemoryUsageByScriptIndex(static_cast<unsigned>(i));
+            outMemSize(scriptMemoryUsage - static_cast<uint64_t>(activeStats[i].mMemoryUsage));
 
             if (isGlobal)
                 out << std::setw(valueW * 2) << "NA (global script)";
@@ -1019,6 +1190,47 @@ namespace MWLua
             out << "\n";
         }
 
+        if (mProfiler.getCaptureDuration() != LuaUtil::Profiler::Clock::duration::zero())
+        {
+            out << "\n";
+            mProfiler.writeSummary(out, 30);
+        }
+
         return out.str();
     }
+
+    void LuaManager::startProfiler()
+    {
+        mProfiler.start();
+        if (LuaUtil::LuaState::isProfilerEnabled())
+            Log(Debug::Info) << "Lua profiler started";
+        else
+            Log(Debug::Info) << "Lua profiler started without call stack sampling, it requires [Lua] lua profiler";
+    }
+
+    void LuaManager::stopProfiler()
+    {
+        if (!mProfiler.isRunning())
+            return;
+        mProfiler.stop();
+
+        std::filesystem::path tracePath = mProfilerOutputPath;
+        tracePath += ".json";
+        std::ofstream trace(tracePath, std::ios::binary | std::ios::trunc);
+        mProfiler.writeChromeTrace(trace);
+
+        std::filesystem::path stacksPath = mProfilerOutputPath;
+        stacksPath += ".folded";
+        std::ofstream stacks(stacksPath, std::ios::binary | std::ios::trunc);
+        mProfiler.writeCollapsedStacks(stacks);
+
+        if (!trace || !stacks)
+            Log(Debug::Error) << "Failed to write Lua profiler capture to " << mProfilerOutputPath;
+        else
+            Log(Debug::Info) << "Lua profiler capture is written to " << tracePath << " and " << stacksPath;
+
+        std::ostringstream summary;
+        mProfiler.writeSummary(summary, 30);
+        Log(Debug::Info) << summary.str();
+    }
 }
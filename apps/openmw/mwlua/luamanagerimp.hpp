@@ -3,16 +3,20 @@
 
 #include <filesystem>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <set>
 
 #include <osg/Stats>
 
 #include <components/lua/inputactions.hpp>
 #include <components/lua/luastate.hpp>
+#include <components/lua/profiler.hpp>
 #include <components/lua/scripttracker.hpp>
 #include <components/lua/storage.hpp>
 #include <components/lua_ui/resources.hpp>
 #include <components/misc/color.hpp>
+#include <components/misc/jobsystem.hpp>
 
 #include "../mwbase/luamanager.hpp"
 #include "../mwbase/windowmanager.hpp"
@@ -164,7 +168,7 @@ namespace MWLua
         std::function<void(Arg)> wrapLuaCallback(const LuaUtil::Callback& c)
         {
             return [this, c](Arg arg) {
-                this->queueCallback(c, sol::main_object(this->mLua.unsafeState(), sol::in_place, arg));
+                this->queueCallback(c, sol::main_object(c.mFunc.lua_state(), sol::in_place, arg));
             };
         }
 
@@ -183,12 +187,21 @@ namespace MWLua
 
         bool isSynchronizedUpdateRunning() const { return mRunningSynchronizedUpdates; }
 
+        // Measures handlers of all scripts until stopProfiler is called. The capture is written to
+        // "<output path>.json" (Chrome trace) and "<output path>.folded" (collapsed stacks).
+        void setProfilerOutputPath(const std::filesystem::path& path) { mProfilerOutputPath = path; }
+        void startProfiler();
+        void stopProfiler();
+        bool isProfilerRunning() const { return mProfiler.isRunning(); }
+
     private:
         void initConfiguration(bool reload);
         LocalScripts* createLocalScripts(const MWWorld::Ptr& ptr,
             std::optional<LuaUtil::ScriptIdsWithInitializationData> autoStartConf = std::nullopt);
         void reloadAllScriptsImpl();
         void synchronizedUpdateUnsafe();
+        void updateLocalScripts(float dt);
+        void collectLocalStatesOutput();
 
         bool mInitialized = false;
         bool mGlobalScriptsStarted = false;
@@ -245,6 +258,32 @@ namespace MWLua
         };
         std::vector<DelayedAction> mActionQueue;
         std::optional<DelayedAction> mTeleportPlayerAction;
+
+        // Additional Lua state for local scripts of non-player objects. Scripts of each state are updated by a
+        // separate job, events and actions they send are moved to the main queues after the update in state order.
+        struct LocalState
+        {
+            LocalState(const VFS::Manager* vfs, const LuaUtil::ScriptsConfiguration* conf, GlobalScripts& globalScripts,
+                MenuScripts& menuScripts);
+
+            LuaUtil::LuaState mLua;
+            LuaEvents mLuaEvents;
+            std::map<std::string, sol::object> mPackages;
+            LuaUtil::ScriptTracker mScriptTracker;
+            std::vector<DelayedAction> mActionQueue;
+        };
+        LocalState* getLocalState(const MWWorld::Ptr& ptr) const;
+
+        // Not null while scripts of an additional state are updated by the current thread
+        static thread_local LocalState* sUpdatingLocalState;
+
+        std::vector<std::unique_ptr<LocalState>> mLocalStates;
+        // Active local scripts grouped by Lua state, the main state goes first
+        std::vector<std::vector<LocalScripts*>> mLocalScriptsByState;
+        // Local scripts of different Lua states are updated in parallel (see "local scripts threads" setting). Calls of
+        // all bindings hold this mutex meanwhile, so only Lua code runs in parallel.
+        std::recursive_mutex mEngineCallsMutex;
+        std::unique_ptr<Misc::JobSystem> mLocalScriptsJobs;
         std::vector<std::pair<std::string, MWGui::ShowInDialogueMode>> mUIMessages;
         std::vector<std::pair<std::string, Misc::Color>> mInGameConsoleMessages;
         std::optional<ObjectId> mDelayedUiModeChangedArg;
@@ -256,6 +295,9 @@ namespace MWLua
         LuaUtil::InputTrigger::Registry mInputTriggers;
 
         LuaUtil::ScriptTracker mScriptTracker;
+
+        LuaUtil::Profiler mProfiler;
+        std::filesystem::path mProfilerOutputPath = "lua_profile";
     };
 
 }
@@ -3,6 +3,7 @@
 #include <components/detournavigator/navigator.hpp>
 #include <components/detournavigator/navigatorutils.hpp>
 #include <components/lua/luastate.hpp>
+#include <components/lua/shapes/box.hpp>
 #include <components/misc/constants.hpp>
 #include <components/settings/values.hpp>
 
@@ -17,6 +18,8 @@
 #include "luamanagerimp.hpp"
 #include "objectlists.hpp"
 
+#include <cmath>
+#include <string_view>
 #include <vector>
 
 namespace
@@ -51,6 +54,18 @@ namespace
 
         return ignore;
     }
+
+    void checkFinite(float value, std::string_view name)
+    {
+        if (!std::isfinite(value))
+            throw std::runtime_error(std::string(name) + " must be finite");
+    }
+
+    void checkFinite(const osg::Vec3f& value, std::string_view name)
+    {
+        for (int i = 0; i < 3; ++i)
+            checkFinite(value[i], name);
+    }
 }
 
 namespace sol
@@ -200,6 +215,48 @@ namespace MWLua
         api["items"] = LObjectList{ objectLists->getItemsInScene() };
         api["players"] = LObjectList{ objectLists->getPlayers() };
 
+        api["OBJECT_LIST"]
+            = LuaUtil::makeStrictReadOnly(LuaUtil::tableFromPairs<std::string_view, ObjectListFlag>(lua,
+                {
+                    { "Activators", ObjectList_Activators },
+                    { "Actors", ObjectList_Actors },
+                    { "Containers", ObjectList_Containers },
+                    { "Doors", ObjectList_Doors },
+                    { "Items", ObjectList_Items },
+                    { "All", ObjectList_All },
+                }));
+
+        const auto getLists = [](const sol::optional<sol::table>& options) -> unsigned {
+            if (!options)
+                return ObjectList_All;
+            return options->get<sol::optional<unsigned>>("lists").value_or(ObjectList_All);
+        };
+
+        api["findObjectsInRadius"] = [objectLists, getLists](const osg::Vec3f& center, float radius,
+                                         const sol::optional<sol::table>& options) {
+            checkFinite(center, "center");
+            checkFinite(radius, "radius");
+            return LObjectList{ objectLists->findInRadius(center, radius, getLists(options)) };
+        };
+
+        api["findObjectsInBox"] = [objectLists, getLists](
+                                      const LuaUtil::Box& box, const sol::optional<sol::table>& options) {
+            checkFinite(box.mCenter, "box center");
+            checkFinite(box.mHalfSize, "box half size");
+            for (int i = 0; i < 4; ++i)
+                checkFinite(static_cast<float>(box.mRotation[i]), "box rotation");
+            return LObjectList{ objectLists->findInBox(box, getLists(options)) };
+        };
+
+        api["findObjectsInCone"] = [objectLists, getLists](const osg::Vec3f& apex, const osg::Vec3f& direction,
+                                       float angle, float range, const sol::optional<sol::table>& options) {
+            checkFinite(apex, "apex");
+            checkFinite(direction, "direction");
+            checkFinite(angle, "angle");
+            checkFinite(range, "range");
+            return LObjectList{ objectLists->findInCone(apex, direction, angle, range, getLists(options)) };
+        };
+
         api["NAVIGATOR_FLAGS"]
             = LuaUtil::makeStrictReadOnly(LuaUtil::tableFromPairs<std::string_view, DetourNavigator::Flag>(lua,
                 {
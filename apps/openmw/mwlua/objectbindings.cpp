@@ -339,8 +339,9 @@ namespace MWLua
             objectT[sol::meta_function::equal_to] = [](const ObjectT& a, const ObjectT& b) { return a.id() == b.id(); };
             objectT[sol::meta_function::to_string] = &ObjectT::toString;
             objectT["sendEvent"] = [context](const ObjectT& dest, std::string eventName, const sol::object& eventData) {
-                context.mLuaEvents->addLocalEvent(
-                    { dest.id(), std::move(eventName), LuaUtil::serialize(eventData, context.mSerializer) });
+                std::string data = context.mLuaEvents->takeBuffer();
+                LuaUtil::serialize(data, eventData, context.mSerializer);
+                context.mLuaEvents->addLocalEvent({ dest.id(), std::move(eventName), std::move(data) });
             };
 
             objectT["activateBy"] = [](const ObjectT& object, const ObjectT& actor) {
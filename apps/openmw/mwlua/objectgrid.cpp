@@ -0,0 +1,168 @@
+#include "objectgrid.hpp"
+
+#include <components/lua/shapes/box.hpp>
+
+#include <osg/Math>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace MWLua
+{
+    namespace
+    {
+        std::uint64_t makeKey(std::int64_t x, std::int64_t y)
+        {
+            return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(x)) << 32)
+                | static_cast<std::uint32_t>(y);
+        }
+    }
+
+    ObjectGrid::ObjectGrid(float cellSize)
+        : mCellSize(cellSize)
+    {
+    }
+
+    void ObjectGrid::clear()
+    {
+        // The grid is refilled every frame by mostly the same objects so keep the vectors of the cells that were
+        // used by the last fill
+        std::erase_if(mCells, [](const auto& cell) { return cell.second.empty(); });
+        for (auto& [key, entries] : mCells)
+            entries.clear();
+        mSize = 0;
+    }
+
+    std::int64_t ObjectGrid::getCellIndex(float value) const
+    {
+        constexpr float limit = static_cast<float>(std::numeric_limits<std::int32_t>::max());
+        return static_cast<std::int64_t>(std::clamp(std::floor(value / mCellSize), -limit, limit));
+    }
+
+    void ObjectGrid::add(ESM::RefNum id, const osg::Vec3f& position, unsigned flags)
+    {
+        mCells[makeKey(getCellIndex(position.x()), getCellIndex(position.y()))].push_back(
+            Entry{ .mId = id, .mPosition = position, .mFlags = flags });
+        ++mSize;
+    }
+
+    template <class Function>
+    void ObjectGrid::forEachInBounds(
+        const osg::Vec3f& min, const osg::Vec3f& max, unsigned flags, Function&& function) const
+    {
+        const auto visit = [&](const std::vector<Entry>& entries) {
+            for (const Entry& entry : entries)
+            {
+                if ((entry.mFlags & flags) == 0)
+                    continue;
+                const osg::Vec3f& p = entry.mPosition;
+                if (p.x() < min.x() || p.y() < min.y() || p.z() < min.z() || p.x() > max.x() || p.y() > max.y()
+                    || p.z() > max.z())
+                    continue;
+                function(entry);
+            }
+        };
+
+        const std::int64_t minX = getCellIndex(min.x());
+        const std::int64_t minY = getCellIndex(min.y());
+        const std::int64_t maxX = getCellIndex(max.x());
+        const std::int64_t maxY = getCellIndex(max.y());
+
+        // Large bounds cover more grid cells than there are occupied ones
+        if (static_cast<double>(maxX - minX + 1) * static_cast<double>(maxY - minY + 1)
+            > static_cast<double>(mCells.size()))
+        {
+            for (const auto& [key, entries] : mCells)
+                visit(entries);
+            return;
+        }
+
+        for (std::int64_t x = minX; x <= maxX; ++x)
+            for (std::int64_t y = minY; y <= maxY; ++y)
+            {
+                const auto it = mCells.find(makeKey(x, y));
+                if (it != mCells.end())
+                    visit(it->second);
+            }
+    }
+
+    void ObjectGrid::sortMatches(std::vector<Match>& matches, std::vector<ESM::RefNum>& result)
+    {
+        std::sort(matches.begin(), matches.end(), [](const Match& l, const Match& r) {
+            if (l.mDistance2 != r.mDistance2)
+                return l.mDistance2 < r.mDistance2;
+            return l.mId < r.mId;
+        });
+        result.clear();
+        result.reserve(matches.size());
+        for (const Match& match : matches)
+            result.push_back(match.mId);
+    }
+
+    void ObjectGrid::findInRadius(
+        const osg::Vec3f& center, float radius, unsigned flags, std::vector<ESM::RefNum>& result) const
+    {
+        std::vector<Match> matches;
+        if (radius >= 0)
+        {
+            const osg::Vec3f extent(radius, radius, radius);
+            const float radius2 = radius * radius;
+            forEachInBounds(center - extent, center + extent, flags, [&](const Entry& entry) {
+                const float distance2 = (entry.mPosition - center).length2();
+                if (distance2 <= radius2)
+                    matches.push_back(Match{ .mDistance2 = distance2, .mId = entry.mId });
+            });
+        }
+        sortMatches(matches, result);
+    }
+
+    void ObjectGrid::findInBox(const LuaUtil::Box& box, unsigned flags, std::vector<ESM::RefNum>& result) const
+    {
+        osg::Vec3f min(std::numeric_limits<float>::max(), std::numeric_limits<float>::max(),
+            std::numeric_limits<float>::max());
+        osg::Vec3f max = -min;
+        for (const osg::Vec3f& vertex : box.vertices())
+        {
+            for (int i = 0; i < 3; ++i)
+            {
+                min[i] = std::min(min[i], vertex[i]);
+                max[i] = std::max(max[i], vertex[i]);
+            }
+        }
+
+        const osg::Quat inverseRotation = box.mRotation.inverse();
+        const osg::Vec3f halfSize(
+            std::abs(box.mHalfSize.x()), std::abs(box.mHalfSize.y()), std::abs(box.mHalfSize.z()));
+        std::vector<Match> matches;
+        forEachInBounds(min, max, flags, [&](const Entry& entry) {
+            const osg::Vec3f offset = entry.mPosition - box.mCenter;
+            const osg::Vec3f local = inverseRotation * offset;
+            if (std::abs(local.x()) <= halfSize.x() && std::abs(local.y()) <= halfSize.y()
+                && std::abs(local.z()) <= halfSize.z())
+                matches.push_back(Match{ .mDistance2 = offset.length2(), .mId = entry.mId });
+        });
+        sortMatches(matches, result);
+    }
+
+    void ObjectGrid::findInCone(const osg::Vec3f& apex, const osg::Vec3f& direction, float halfAngle, float range,
+        unsigned flags, std::vector<ESM::RefNum>& result) const
+    {
+        std::vector<Match> matches;
+        osg::Vec3f axis = direction;
+        if (range >= 0 && axis.normalize() > 0)
+        {
+            const osg::Vec3f extent(range, range, range);
+            const float range2 = range * range;
+            const float cosHalfAngle = std::cos(std::clamp(halfAngle, 0.0f, osg::PIf));
+            forEachInBounds(apex - extent, apex + extent, flags, [&](const Entry& entry) {
+                const osg::Vec3f offset = entry.mPosition - apex;
+                const float distance2 = offset.length2();
+                if (distance2 > range2 || offset * axis < cosHalfAngle * std::sqrt(distance2))
+                    return;
+                matches.push_back(Match{ .mDistance2 = distance2, .mId = entry.mId });
+            });
+        }
+        sortMatches(matches, result);
+    }
+}
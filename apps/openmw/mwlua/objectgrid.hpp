@@ -0,0 +1,73 @@
+#ifndef MWLUA_OBJECTGRID_H
+#define MWLUA_OBJECTGRID_H
+
+#include <components/esm3/refnum.hpp>
+
+#include <osg/Vec3f>
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace LuaUtil
+{
+    class Box;
+}
+
+namespace MWLua
+{
+    /// @brief Positions of objects bucketed by a uniform grid in the horizontal plane.
+    /// @par Used to answer proximity queries of Lua scripts without iterating over all objects in the scene. Every
+    /// object has a set of flags and a query returns only the objects having any of the requested ones. Results are
+    /// sorted by distance to the query origin and then by id so they don't depend on the order of insertion.
+    class ObjectGrid
+    {
+    public:
+        explicit ObjectGrid(float cellSize);
+
+        void clear();
+
+        void add(ESM::RefNum id, const osg::Vec3f& position, unsigned flags);
+
+        std::size_t size() const { return mSize; }
+
+        /// Replace result by the objects within the sphere.
+        void findInRadius(
+            const osg::Vec3f& center, float radius, unsigned flags, std::vector<ESM::RefNum>& result) const;
+
+        /// Replace result by the objects inside of the box. Distance is measured to the box center.
+        void findInBox(const LuaUtil::Box& box, unsigned flags, std::vector<ESM::RefNum>& result) const;
+
+        /// Replace result by the objects within the range from the apex with the angle to the direction not
+        /// larger than halfAngle (radians).
+        void findInCone(const osg::Vec3f& apex, const osg::Vec3f& direction, float halfAngle, float range,
+            unsigned flags, std::vector<ESM::RefNum>& result) const;
+
+    private:
+        struct Entry
+        {
+            ESM::RefNum mId;
+            osg::Vec3f mPosition;
+            unsigned mFlags;
+        };
+
+        struct Match
+        {
+            float mDistance2;
+            ESM::RefNum mId;
+        };
+
+        std::int64_t getCellIndex(float value) const;
+
+        template <class Function>
+        void forEachInBounds(const osg::Vec3f& min, const osg::Vec3f& max, unsigned flags, Function&& function) const;
+
+        static void sortMatches(std::vector<Match>& matches, std::vector<ESM::RefNum>& result);
+
+        float mCellSize;
+        std::size_t mSize = 0;
+        std::unordered_map<std::uint64_t, std::vector<Entry>> mCells;
+    };
+}
+
+#endif // MWLUA_OBJECTGRID_H
@@ -19,6 +19,7 @@ namespace MWLua
         mContainersInScene.updateList();
         mDoorsInScene.updateList();
         mItemsInScene.updateList();
+        mGridChanged = true;
     }
 
     void ObjectLists::clear()
@@ -28,6 +29,8 @@ namespace MWLua
         mContainersInScene.clear();
         mDoorsInScene.clear();
         mItemsInScene.clear();
+        mGrid.clear();
+        mGridChanged = true;
     }
 
     ObjectLists::ObjectGroup* ObjectLists::chooseGroup(const MWWorld::Ptr& ptr)
@@ -94,4 +97,47 @@ namespace MWLua
         group.mSet.erase(getId(ptr));
         group.mChanged = true;
     }
+
+    const ObjectGrid& ObjectLists::getGrid() const
+    {
+        std::lock_guard lock(mGridMutex);
+        if (!mGridChanged)
+            return mGrid;
+        mGrid.clear();
+        const MWWorld::WorldModel& worldModel = *MWBase::Environment::get().getWorldModel();
+        for (const ObjectGroup* group :
+            { &mActivatorsInScene, &mActorsInScene, &mContainersInScene, &mDoorsInScene, &mItemsInScene })
+        {
+            for (ObjectId id : *group->mList)
+            {
+                const MWWorld::Ptr ptr = worldModel.getPtr(id);
+                if (!ptr.isEmpty())
+                    mGrid.add(id, ptr.getRefData().getPosition().asVec3(), group->mFlag);
+            }
+        }
+        mGridChanged = false;
+        return mGrid;
+    }
+
+    ObjectIdList ObjectLists::findInRadius(const osg::Vec3f& center, float radius, unsigned lists) const
+    {
+        ObjectIdList result = std::make_shared<std::vector<ObjectId>>();
+        getGrid().findInRadius(center, radius, lists, *result);
+        return result;
+    }
+
+    ObjectIdList ObjectLists::findInBox(const LuaUtil::Box& box, unsigned lists) const
+    {
+        ObjectIdList result = std::make_shared<std::vector<ObjectId>>();
+        getGrid().findInBox(box, lists, *result);
+        return result;
+    }
+
+    ObjectIdList ObjectLists::findInCone(const osg::Vec3f& apex, const osg::Vec3f& direction, float halfAngle,
+        float range, unsigned lists) const
+    {
+        ObjectIdList result = std::make_shared<std::vector<ObjectId>>();
+        getGrid().findInCone(apex, direction, halfAngle, range, lists, *result);
+        return result;
+    }
 }
@@ -1,13 +1,27 @@
 #ifndef MWLUA_OBJECTLISTS_H
 #define MWLUA_OBJECTLISTS_H
 
+#include <mutex>
 #include <set>
 
 #include "object.hpp"
+#include "objectgrid.hpp"
 
 namespace MWLua
 {
 
+    // Flags to select lists in spatial queries
+    enum ObjectListFlag : unsigned
+    {
+        ObjectList_Activators = 1 << 0,
+        ObjectList_Actors = 1 << 1,
+        ObjectList_Containers = 1 << 2,
+        ObjectList_Doors = 1 << 3,
+        ObjectList_Items = 1 << 4,
+        ObjectList_All = ObjectList_Activators | ObjectList_Actors | ObjectList_Containers | ObjectList_Doors
+            | ObjectList_Items,
+    };
+
     // ObjectLists is used to track lists of game objects like nearby.items, nearby.actors, etc.
     class ObjectLists
     {
@@ -22,6 +36,13 @@ namespace MWLua
         ObjectIdList getItemsInScene() const { return mItemsInScene.mList; }
         ObjectIdList getPlayers() const { return mPlayers; }
 
+        // Spatial queries over the selected lists, results are sorted by distance. Positions are taken once per frame
+        // when the first query is made. Thread safe if there are no concurrent calls of other functions.
+        ObjectIdList findInRadius(const osg::Vec3f& center, float radius, unsigned lists) const;
+        ObjectIdList findInBox(const LuaUtil::Box& box, unsigned lists) const;
+        ObjectIdList findInCone(const osg::Vec3f& apex, const osg::Vec3f& direction, float halfAngle, float range,
+            unsigned lists) const;
+
         void objectAddedToScene(const MWWorld::Ptr& ptr);
         void objectRemovedFromScene(const MWWorld::Ptr& ptr);
 
@@ -33,6 +54,7 @@ namespace MWLua
             void updateList();
             void clear();
 
+            const unsigned mFlag;
             bool mChanged = false;
             ObjectIdList mList = std::make_shared<std::vector<ObjectId>>();
             std::set<ObjectId> mSet;
@@ -42,12 +64,19 @@ namespace MWLua
         void addToGroup(ObjectGroup& group, const MWWorld::Ptr& ptr);
         void removeFromGroup(ObjectGroup& group, const MWWorld::Ptr& ptr);
 
-        ObjectGroup mActivatorsInScene;
-        ObjectGroup mActorsInScene;
-        ObjectGroup mContainersInScene;
-        ObjectGroup mDoorsInScene;
-        ObjectGroup mItemsInScene;
+        const ObjectGrid& getGrid() const;
+
+        ObjectGroup mActivatorsInScene{ ObjectList_Activators };
+        ObjectGroup mActorsInScene{ ObjectList_Actors };
+        ObjectGroup mContainersInScene{ ObjectList_Containers };
+        ObjectGroup mDoorsInScene{ ObjectList_Doors };
+        ObjectGroup mItemsInScene{ ObjectList_Items };
         ObjectIdList mPlayers = std::make_shared<std::vector<ObjectId>>();
+
+        // Built from the lists by the first spatial query after update
+        mutable std::mutex mGridMutex;
+        mutable ObjectGrid mGrid{ 2048 };
+        mutable bool mGridChanged = true;
     };
 
 }
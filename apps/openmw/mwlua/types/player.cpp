@@ -420,7 +420,9 @@ namespace MWLua
         };
         player["sendMenuEvent"] = [context](const Object& object, std::string eventName, const sol::object& eventData) {
             verifyPlayer(object);
-            context.mLuaEvents->addMenuEvent({ std::move(eventName), LuaUtil::serialize(eventData) });
+            std::string data = context.mLuaEvents->takeBuffer();
+            LuaUtil::serialize(data, eventData);
+            context.mLuaEvents->addMenuEvent({ std::move(eventName), std::move(data) });
         };
 
         player["getCrimeLevel"] = [](const Object& o) -> int {
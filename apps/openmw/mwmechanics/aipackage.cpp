@@ -121,6 +121,11 @@ bool MWMechanics::AiPackage::pathTo(const MWWorld::Ptr& actor, const osg::Vec3f&
 
     mLastDestinationTolerance = destTolerance;
 
+    // Actor keeps following the previous path until the requested one is found
+    if (mPathFinder.takePathResult(actor) && !mPathFinder.getPath().empty()
+        && distance(dest, mPathFinder.getPath().back()) > 100)
+        mPathFinder.addPointToPath(dest);
+
     const float distToTarget = distance(position, dest);
     const bool isDestReached = (distToTarget <= destTolerance);
     const bool actorCanMoveByZ = canActorMoveByZAxis(actor);
@@ -145,12 +150,12 @@ bool MWMechanics::AiPackage::pathTo(const MWWorld::Ptr& actor, const osg::Vec3f&
                     = world->getStore().get<ESM::Pathgrid>().search(*actor.getCell()->getCell());
                 const DetourNavigator::Flags navigatorFlags = getNavigatorFlags(actor);
                 const DetourNavigator::AreaCosts areaCosts = getAreaCosts(actor, navigatorFlags);
-                mPathFinder.buildLimitedPath(actor, position, dest, getPathGridGraph(pathgrid), agentBounds,
+                mPathFinder.requestLimitedPath(actor, position, dest, getPathGridGraph(pathgrid), agentBounds,
                     navigatorFlags, areaCosts, endTolerance, pathType);
                 mRotateOnTheRunChecks = 3;
 
                 // give priority to go directly on target if there is minimal opportunity
-                if (destInLOS && mPathFinder.getPath().size() > 1)
+                if (destInLOS && !mPathFinder.hasPathRequest() && mPathFinder.getPath().size() > 1)
                 {
                     // get point just before dest
                     auto pPointBeforeDest = mPathFinder.getPath().rbegin() + 1;
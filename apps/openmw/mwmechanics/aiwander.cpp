@@ -652,9 +652,9 @@ namespace MWMechanics
         const PathgridGraph& pathgridGraph = getPathGridGraph(pathgrid);
 
         const Misc::CoordinateConverter converter = Misc::makeCoordinateConverter(cell);
-        std::deque<ESM::Pathgrid::Point> path
-            = pathgridGraph.aStarSearch(Misc::getClosestPoint(*pathgrid, converter.toLocalVec3(start)),
-                Misc::getClosestPoint(*pathgrid, converter.toLocalVec3(randomAllowedPosition)));
+        std::vector<ESM::Pathgrid::Point> path;
+        pathgridGraph.aStarSearch(Misc::getClosestPoint(*pathgrid, converter.toLocalVec3(start)),
+            Misc::getClosestPoint(*pathgrid, converter.toLocalVec3(randomAllowedPosition)), path);
 
         // Choose a different position and delete this one from possible positions because it is uncreachable:
         if (path.empty())
@@ -664,11 +664,9 @@ namespace MWMechanics
         }
 
         // Drop nearest pathgrid point.
-        path.pop_front();
-
-        std::vector<osg::Vec3f> checkpoints(path.size());
-        for (std::size_t i = 0; i < path.size(); ++i)
-            checkpoints[i] = Misc::Convert::makeOsgVec3f(converter.toWorldPoint(path[i]));
+        std::vector<osg::Vec3f> checkpoints(path.size() - 1);
+        for (std::size_t i = 0; i < checkpoints.size(); ++i)
+            checkpoints[i] = Misc::Convert::makeOsgVec3f(converter.toWorldPoint(path[i + 1]));
 
         const DetourNavigator::AgentBounds agentBounds = world.getPathfindingAgentBounds(actor);
         const DetourNavigator::Flags flags = getNavigatorFlags(actor);
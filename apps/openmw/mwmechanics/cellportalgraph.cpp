@@ -0,0 +1,249 @@
+#include "cellportalgraph.hpp"
+
+#include <components/misc/constants.hpp>
+#include <components/misc/convert.hpp>
+#include <components/misc/coordinateconverter.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <map>
+#include <optional>
+#include <queue>
+#include <tuple>
+#include <utility>
+
+namespace MWMechanics
+{
+    namespace
+    {
+        // Pathgrid points are placed by modders so there is no exact rule. Points of adjacent cells closer than this
+        // are assumed to be reachable from each other.
+        constexpr float maxPortalLength = 1024;
+
+        constexpr float cellSize = static_cast<float>(Constants::CellSizeInUnits);
+
+        osg::Vec2i getCellPosition(const osg::Vec3f& position)
+        {
+            return osg::Vec2i(static_cast<int>(std::floor(position.x() / cellSize)),
+                static_cast<int>(std::floor(position.y() / cellSize)));
+        }
+
+        std::size_t getClosestPoint(const std::vector<osg::Vec3f>& points, const osg::Vec3f& position)
+        {
+            std::size_t result = 0;
+            float minDistance = std::numeric_limits<float>::max();
+            for (std::size_t i = 0; i < points.size(); ++i)
+            {
+                const float distance = (points[i] - position).length2();
+                if (distance < minDistance)
+                {
+                    minDistance = distance;
+                    result = i;
+                }
+            }
+            return result;
+        }
+
+        // Distance from the point to the border with the neighbour cell shifted by the direction
+        float getDistanceToBorder(const osg::Vec3f& point, const osg::Vec2i& cell, const osg::Vec2i& direction)
+        {
+            if (direction.x() > 0)
+                return (cell.x() + 1) * cellSize - point.x();
+            if (direction.x() < 0)
+                return point.x() - cell.x() * cellSize;
+            if (direction.y() > 0)
+                return (cell.y() + 1) * cellSize - point.y();
+            return point.y() - cell.y() * cellSize;
+        }
+
+        using NodeId = std::tuple<int, int, std::size_t>;
+
+        NodeId makeNodeId(const osg::Vec2i& cell, std::size_t point)
+        {
+            return NodeId(cell.x(), cell.y(), point);
+        }
+
+        struct NodeState
+        {
+            float mCost = 0;
+            std::optional<NodeId> mParent;
+            osg::Vec3f mPortal;
+            bool mClosed = false;
+        };
+    }
+
+    CellPortalGraph::CellPortalGraph(GetPathgrid getPathgrid, std::size_t maxSearchNodes)
+        : mGetPathgrid(std::move(getPathgrid))
+        , mMaxSearchNodes(maxSearchNodes)
+    {
+    }
+
+    CellPortalGraph::~CellPortalGraph() = default;
+
+    CellPortalGraph::Cell& CellPortalGraph::getCell(const osg::Vec2i& position)
+    {
+        const auto it = mCells.find(position);
+        if (it != mCells.end())
+            return it->second;
+
+        Cell& cell = mCells[position];
+        const ESM::Pathgrid* const pathgrid = mGetPathgrid(position.x(), position.y());
+        if (pathgrid == nullptr || pathgrid->mPoints.empty())
+            return cell;
+
+        const Misc::CoordinateConverter converter(
+            position.x() * Constants::CellSizeInUnits, position.y() * Constants::CellSizeInUnits);
+        cell.mGraph = std::make_unique<PathgridGraph>(*pathgrid);
+        cell.mPoints.reserve(pathgrid->mPoints.size());
+        for (const ESM::Pathgrid::Point& point : pathgrid->mPoints)
+            cell.mPoints.push_back(Misc::Convert::makeOsgVec3f(converter.toWorldPoint(point)));
+        return cell;
+    }
+
+    const CellPortalGraph::Cell& CellPortalGraph::getCellWithPortals(const osg::Vec2i& position)
+    {
+        Cell& cell = getCell(position);
+        if (cell.mHasPortals)
+            return cell;
+
+        cell.mHasPortals = true;
+
+        if (cell.mGraph == nullptr)
+            return cell;
+
+        const osg::Vec2i directions[] = { { 1, 0 }, { -1, 0 }, { 0, 1 }, { 0, -1 } };
+
+        for (const osg::Vec2i& direction : directions)
+        {
+            const osg::Vec2i otherPosition = position + direction;
+            const Cell& other = getCell(otherPosition);
+            if (other.mGraph == nullptr)
+                continue;
+
+            // Keep only the shortest portal for each pair of pathgrid components
+            std::map<std::pair<int, int>, Portal> portals;
+
+            for (std::size_t i = 0; i < cell.mPoints.size(); ++i)
+            {
+                if (getDistanceToBorder(cell.mPoints[i], position, direction) > maxPortalLength)
+                    continue;
+                for (std::size_t j = 0; j < other.mPoints.size(); ++j)
+                {
+                    const float length = (cell.mPoints[i] - other.mPoints[j]).length();
+                    if (length > maxPortalLength)
+                        continue;
+                    const std::pair components(cell.mGraph->getComponentId(i), other.mGraph->getComponentId(j));
+                    const auto it = portals.find(components);
+                    if (it != portals.end() && it->second.mLength <= length)
+                        continue;
+                    portals.insert_or_assign(components,
+                        Portal{
+                            .mPoint = i,
+                            .mOtherCell = otherPosition,
+                            .mOtherPoint = j,
+                            .mLength = length,
+                            .mPosition = (cell.mPoints[i] + other.mPoints[j]) / 2,
+                        });
+                }
+            }
+
+            for (const auto& [components, portal] : portals)
+                cell.mPortals.push_back(portal);
+        }
+
+        return cell;
+    }
+
+    bool CellPortalGraph::findRoute(const osg::Vec3f& start, const osg::Vec3f& end, std::vector<osg::Vec3f>& route)
+    {
+        route.clear();
+
+        const osg::Vec2i startCellPosition = getCellPosition(start);
+        const osg::Vec2i endCellPosition = getCellPosition(end);
+
+        const Cell& endCell = getCell(endCellPosition);
+        if (endCell.mGraph == nullptr)
+            return false;
+        const std::size_t endPoint = getClosestPoint(endCell.mPoints, end);
+
+        const Cell& startCell = getCellWithPortals(startCellPosition);
+        if (startCell.mGraph == nullptr)
+            return false;
+        const std::size_t startPoint = getClosestPoint(startCell.mPoints, start);
+
+        const auto isGoal = [&](const osg::Vec2i& cell, std::size_t point) {
+            return cell == endCellPosition && getCell(cell).mGraph->isPointConnected(point, endPoint);
+        };
+
+        if (isGoal(startCellPosition, startPoint))
+            return true;
+
+        const auto heuristic = [&](const osg::Vec3f& position) { return (end - position).length(); };
+
+        using OpenNode = std::pair<float, NodeId>;
+        std::priority_queue<OpenNode, std::vector<OpenNode>, std::greater<OpenNode>> open;
+        std::map<NodeId, NodeState> states;
+
+        const NodeId startNode = makeNodeId(startCellPosition, startPoint);
+        states.emplace(startNode, NodeState{});
+        open.emplace(heuristic(startCell.mPoints[startPoint]), startNode);
+
+        std::optional<NodeId> goal;
+        std::size_t expanded = 0;
+
+        while (!open.empty())
+        {
+            const NodeId nodeId = open.top().second;
+            open.pop();
+
+            NodeState& state = states[nodeId];
+            if (state.mClosed)
+                continue;
+            state.mClosed = true;
+
+            const osg::Vec2i cellPosition(std::get<0>(nodeId), std::get<1>(nodeId));
+            const std::size_t point = std::get<2>(nodeId);
+
+            if (isGoal(cellPosition, point))
+            {
+                goal = nodeId;
+                break;
+            }
+
+            if (++expanded > mMaxSearchNodes)
+                return false;
+
+            const float cost = state.mCost;
+            const Cell& cell = getCellWithPortals(cellPosition);
+
+            for (const Portal& portal : cell.mPortals)
+            {
+                if (!cell.mGraph->isPointConnected(point, portal.mPoint))
+                    continue;
+                const Cell& other = getCell(portal.mOtherCell);
+                const float nextCost
+                    = cost + (cell.mPoints[portal.mPoint] - cell.mPoints[point]).length() + portal.mLength;
+                const NodeId nextId = makeNodeId(portal.mOtherCell, portal.mOtherPoint);
+                const auto [it, inserted] = states.try_emplace(nextId);
+                if (it->second.mClosed || (!inserted && it->second.mCost <= nextCost))
+                    continue;
+                it->second.mCost = nextCost;
+                it->second.mParent = nodeId;
+                it->second.mPortal = portal.mPosition;
+                open.emplace(nextCost + heuristic(other.mPoints[portal.mOtherPoint]), nextId);
+            }
+        }
+
+        if (!goal.has_value())
+            return false;
+
+        for (auto it = states.find(*goal); it->second.mParent.has_value(); it = states.find(*it->second.mParent))
+            route.push_back(it->second.mPortal);
+
+        std::reverse(route.begin(), route.end());
+
+        return true;
+    }
+}
@@ -0,0 +1,67 @@
+#ifndef GAME_MWMECHANICS_CELLPORTALGRAPH_H
+#define GAME_MWMECHANICS_CELLPORTALGRAPH_H
+
+#include "pathgrid.hpp"
+
+#include <osg/Vec2i>
+#include <osg/Vec3f>
+
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <memory>
+#include <vector>
+
+namespace MWMechanics
+{
+    /// @brief Coarse graph over exterior cells to route actors to destinations beyond the loaded navmesh area.
+    /// @par Nodes are pathgrid points of exterior cells. A portal connects the closest points of each pair of pathgrid
+    /// components of two adjacent cells when they are close enough to each other. Points of a cell are connected when
+    /// they belong to the same pathgrid component. Portals of a cell are found when a route passes the cell for the
+    /// first time and then reused. Cells without pathgrid are not passable.
+    class CellPortalGraph
+    {
+    public:
+        /// Returns pathgrid of exterior cell with given grid coordinates or nullptr.
+        using GetPathgrid = std::function<const ESM::Pathgrid*(int cellX, int cellY)>;
+
+        explicit CellPortalGraph(GetPathgrid getPathgrid, std::size_t maxSearchNodes);
+
+        ~CellPortalGraph();
+
+        /// Fills route with positions of portals to pass on the way from start to end in world coordinates. Route is
+        /// empty when both are connected within the same cell. Returns false if there is no route or the search
+        /// reached the nodes limit.
+        bool findRoute(const osg::Vec3f& start, const osg::Vec3f& end, std::vector<osg::Vec3f>& route);
+
+        std::size_t getCellsCount() const { return mCells.size(); }
+
+    private:
+        struct Portal
+        {
+            std::size_t mPoint;
+            osg::Vec2i mOtherCell;
+            std::size_t mOtherPoint;
+            float mLength;
+            osg::Vec3f mPosition;
+        };
+
+        struct Cell
+        {
+            std::unique_ptr<PathgridGraph> mGraph;
+            std::vector<osg::Vec3f> mPoints; // world coordinates
+            std::vector<Portal> mPortals;
+            bool mHasPortals = false;
+        };
+
+        GetPathgrid mGetPathgrid;
+        std::size_t mMaxSearchNodes;
+        std::map<osg::Vec2i, Cell> mCells;
+
+        Cell& getCell(const osg::Vec2i& position);
+
+        const Cell& getCellWithPortals(const osg::Vec2i& position);
+    };
+}
+
+#endif
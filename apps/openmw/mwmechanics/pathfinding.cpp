@@ -1,7 +1,9 @@
 #include "pathfinding.hpp"
 
+#include <algorithm>
 #include <iterator>
 #include <limits>
+#include <vector>
 
 #include <osg/io_utils>
 
@@ -11,6 +13,7 @@
 #include <components/misc/coordinateconverter.hpp>
 #include <components/misc/math.hpp>
 #include <components/misc/pathgridutils.hpp>
+#include <components/settings/values.hpp>
 
 #include "../mwbase/environment.hpp"
 #include "../mwbase/world.hpp"
@@ -19,8 +22,10 @@
 
 #include "../mwworld/cellstore.hpp"
 #include "../mwworld/class.hpp"
+#include "../mwworld/esmstore.hpp"
 
 #include "actorutil.hpp"
+#include "cellportalgraph.hpp"
 #include "pathgrid.hpp"
 
 namespace
@@ -115,6 +120,39 @@ namespace
                 && std::abs((position.value() - start).length2() - (end - start).length2()) <= 1;
         }
     };
+
+    DetourNavigator::Status handleNavigatorStatus(const MWWorld::ConstPtr& actor, DetourNavigator::Status status,
+        const osg::Vec3f& startPoint, const osg::Vec3f& endPoint, DetourNavigator::Flags flags,
+        MWMechanics::PathType pathType)
+    {
+        if (pathType == MWMechanics::PathType::Partial && status == DetourNavigator::Status::PartialPath)
+            return DetourNavigator::Status::Success;
+
+        if (status != DetourNavigator::Status::Success)
+        {
+            Log(Debug::Debug) << "Build path by navigator error: \"" << DetourNavigator::getMessage(status)
+                              << "\" for \"" << actor.getClass().getName(actor) << "\" (" << actor.getBase()
+                              << ") from " << startPoint << " to " << endPoint << " with flags ("
+                              << DetourNavigator::WriteFlags{ flags } << ")";
+        }
+
+        return status;
+    }
+
+    MWMechanics::CellPortalGraph& getCellPortalGraph()
+    {
+        // static cache is OK for now, pathgrids can never change during runtime
+        static MWMechanics::CellPortalGraph graph(
+            [](int cellX, int cellY) -> const ESM::Pathgrid* {
+                const MWWorld::ESMStore& store = *MWBase::Environment::get().getESMStore();
+                const ESM::Cell* const cell = store.get<ESM::Cell>().search(cellX, cellY);
+                if (cell == nullptr)
+                    return nullptr;
+                return store.get<ESM::Pathgrid>().search(*cell);
+            },
+            Settings::navigator().mMaxCellPortalGraphSearchNodes);
+        return graph;
+    }
 }
 
 namespace MWMechanics
@@ -228,7 +266,8 @@ namespace MWMechanics
         }
         else
         {
-            auto path = pathgridGraph.aStarSearch(startNode, endNode.first);
+            thread_local std::vector<ESM::Pathgrid::Point> path;
+            pathgridGraph.aStarSearch(startNode, endNode.first, path);
 
             // If nearest path node is in opposite direction from second, remove it from path.
             // Especially useful for wandering actors, if the nearest node is blocked for some reason.
@@ -252,12 +291,12 @@ namespace MWMechanics
                     bool isPathClear
                         = !MWBase::Environment::get().getWorld()->getRayCasting()->castRay(from, to, mask).mHit;
                     if (isPathClear)
-                        path.pop_front();
+                        path.erase(path.begin());
                 }
             }
 
             // convert supplied path to world coordinates
-            std::transform(path.begin(), path.end(), out, [&](ESM::Pathgrid::Point& point) {
+            std::transform(path.begin(), path.end(), out, [&](ESM::Pathgrid::Point point) {
                 converter.toWorld(point);
                 return Misc::Convert::makeOsgVec3f(point);
             });
@@ -354,6 +393,7 @@ namespace MWMechanics
 
     void PathFinder::buildStraightPath(const osg::Vec3f& endPoint)
     {
+        cancelPathRequest();
         mPath.clear();
         mPath.push_back(endPoint);
         mConstructed = true;
@@ -364,6 +404,7 @@ namespace MWMechanics
         const DetourNavigator::AreaCosts& areaCosts, float endTolerance, PathType pathType,
         std::span<const osg::Vec3f> checkpoints)
     {
+        cancelPathRequest();
         mPath.clear();
 
         // If it's not possible to build path over navmesh due to disabled navmesh generation fallback to straight path
@@ -384,6 +425,7 @@ namespace MWMechanics
         const DetourNavigator::Flags flags, const DetourNavigator::AreaCosts& areaCosts, float endTolerance,
         PathType pathType, std::span<const osg::Vec3f> checkpoints)
     {
+        cancelPathRequest();
         mPath.clear();
         mCell = actor.getCell();
 
@@ -397,6 +439,16 @@ namespace MWMechanics
                 mPath.clear();
         }
 
+        buildPathFallback(actor, status, startPoint, endPoint, pathgridGraph, agentBounds, flags, areaCosts,
+            endTolerance, pathType, checkpoints);
+    }
+
+    void PathFinder::buildPathFallback(const MWWorld::ConstPtr& actor, DetourNavigator::Status status,
+        const osg::Vec3f& startPoint, const osg::Vec3f& endPoint, const PathgridGraph& pathgridGraph,
+        const DetourNavigator::AgentBounds& agentBounds, const DetourNavigator::Flags flags,
+        const DetourNavigator::AreaCosts& areaCosts, float endTolerance, PathType pathType,
+        std::span<const osg::Vec3f> checkpoints)
+    {
         if (status != DetourNavigator::Status::NavMeshNotFound && mPath.empty()
             && (flags & DetourNavigator::Flag_usePathgrid) == 0)
         {
@@ -427,24 +479,112 @@ namespace MWMechanics
         const DetourNavigator::Status status = DetourNavigator::findPath(
             navigator, agentBounds, startPoint, endPoint, flags, areaCosts, endTolerance, checkpoints, out);
 
-        if (pathType == PathType::Partial && status == DetourNavigator::Status::PartialPath)
-            return DetourNavigator::Status::Success;
-
-        if (status != DetourNavigator::Status::Success)
-        {
-            Log(Debug::Debug) << "Build path by navigator error: \"" << DetourNavigator::getMessage(status)
-                              << "\" for \"" << actor.getClass().getName(actor) << "\" (" << actor.getBase()
-                              << ") from " << startPoint << " to " << endPoint << " with flags ("
-                              << DetourNavigator::WriteFlags{ flags } << ")";
-        }
-
-        return status;
+        return handleNavigatorStatus(actor, status, startPoint, endPoint, flags, pathType);
     }
 
     void PathFinder::buildLimitedPath(const MWWorld::ConstPtr& actor, const osg::Vec3f& startPoint,
         const osg::Vec3f& endPoint, const PathgridGraph& pathgridGraph, const DetourNavigator::AgentBounds& agentBounds,
         const DetourNavigator::Flags flags, const DetourNavigator::AreaCosts& areaCosts, float endTolerance,
         PathType pathType)
+    {
+        const osg::Vec3f end = getLimitedEndPoint(actor, startPoint, endPoint);
+        buildPath(actor, startPoint, end, pathgridGraph, agentBounds, flags, areaCosts, endTolerance, pathType);
+    }
+
+    void PathFinder::requestLimitedPath(const MWWorld::ConstPtr& actor, const osg::Vec3f& startPoint,
+        const osg::Vec3f& endPoint, const PathgridGraph& pathgridGraph, const DetourNavigator::AgentBounds& agentBounds,
+        const DetourNavigator::Flags flags, const DetourNavigator::AreaCosts& areaCosts, float endTolerance,
+        PathType pathType)
+    {
+        cancelPathRequest();
+
+        DetourNavigator::AsyncPathFinder* const asyncPathFinder
+            = MWBase::Environment::get().getWorld()->getAsyncPathFinder();
+
+        // Pathgrid is used for water and flying creatures so there is nothing to find asynchronously
+        if (asyncPathFinder == nullptr || actor.getClass().isPureWaterCreature(actor)
+            || actor.getClass().isPureFlyingCreature(actor))
+            return buildLimitedPath(
+                actor, startPoint, endPoint, pathgridGraph, agentBounds, flags, areaCosts, endTolerance, pathType);
+
+        const osg::Vec3f end = getLimitedEndPoint(actor, startPoint, endPoint);
+
+        const DetourNavigator::PathRequestId id = asyncPathFinder->request(DetourNavigator::PathRequest{
+            .mAgentBounds = agentBounds,
+            .mStart = startPoint,
+            .mEnd = end,
+            .mIncludeFlags = flags,
+            .mAreaCosts = areaCosts,
+            .mEndTolerance = endTolerance,
+        });
+
+        mPathRequest = PathRequest{
+            .mId = id,
+            .mStartPoint = startPoint,
+            .mEndPoint = end,
+            .mPathgridGraph = &pathgridGraph,
+            .mAgentBounds = agentBounds,
+            .mFlags = flags,
+            .mAreaCosts = areaCosts,
+            .mEndTolerance = endTolerance,
+            .mPathType = pathType,
+        };
+    }
+
+    bool PathFinder::takePathResult(const MWWorld::ConstPtr& actor)
+    {
+        if (!mPathRequest.has_value())
+            return false;
+
+        DetourNavigator::AsyncPathFinder* const asyncPathFinder
+            = MWBase::Environment::get().getWorld()->getAsyncPathFinder();
+
+        if (asyncPathFinder == nullptr)
+        {
+            mPathRequest.reset();
+            return false;
+        }
+
+        std::optional<DetourNavigator::PathResult> result = asyncPathFinder->takeResult(mPathRequest->mId);
+
+        if (!result.has_value())
+        {
+            // Result is dropped when it is not taken in time
+            if (!asyncPathFinder->isPending(mPathRequest->mId))
+                mPathRequest.reset();
+            return false;
+        }
+
+        const PathRequest request = std::move(*mPathRequest);
+        mPathRequest.reset();
+
+        mPath.clear();
+        mCell = actor.getCell();
+
+        const DetourNavigator::Status status = handleNavigatorStatus(
+            actor, result->mStatus, request.mStartPoint, request.mEndPoint, request.mFlags, request.mPathType);
+
+        if (status == DetourNavigator::Status::Success)
+            mPath.assign(result->mPath.begin(), result->mPath.end());
+
+        buildPathFallback(actor, status, request.mStartPoint, request.mEndPoint, *request.mPathgridGraph,
+            request.mAgentBounds, request.mFlags, request.mAreaCosts, request.mEndTolerance, request.mPathType, {});
+
+        return true;
+    }
+
+    void PathFinder::cancelPathRequest()
+    {
+        if (!mPathRequest.has_value())
+            return;
+        if (DetourNavigator::AsyncPathFinder* const asyncPathFinder
+            = MWBase::Environment::get().getWorld()->getAsyncPathFinder())
+            asyncPathFinder->cancel(mPathRequest->mId);
+        mPathRequest.reset();
+    }
+
+    osg::Vec3f PathFinder::getLimitedEndPoint(
+        const MWWorld::ConstPtr& actor, const osg::Vec3f& startPoint, const osg::Vec3f& endPoint) const
     {
         const auto navigator = MWBase::Environment::get().getWorld()->getNavigator();
         const auto maxDistance
@@ -452,9 +592,23 @@ namespace MWMechanics
         const auto startToEnd = endPoint - startPoint;
         const auto distance = startToEnd.length();
         if (distance <= maxDistance)
-            return buildPath(
-                actor, startPoint, endPoint, pathgridGraph, agentBounds, flags, areaCosts, endTolerance, pathType);
-        const auto end = startPoint + startToEnd * maxDistance / distance;
-        buildPath(actor, startPoint, end, pathgridGraph, agentBounds, flags, areaCosts, endTolerance, pathType);
+            return endPoint;
+        const osg::Vec3f limitedEndPoint = startPoint + startToEnd * maxDistance / distance;
+
+        const MWWorld::CellStore& cell = *actor.getCell();
+        if (Settings::navigator().mMaxCellPortalGraphSearchNodes == 0 || !cell.isExterior()
+            || cell.getCell()->getWorldSpace() != ESM::Cell::sDefaultWorldspaceId)
+            return limitedEndPoint;
+
+        thread_local std::vector<osg::Vec3f> route;
+        if (!getCellPortalGraph().findRoute(startPoint, endPoint, route) || route.empty())
+            return limitedEndPoint;
+
+        // Head to the farthest cell border crossing within the navmesh area or towards the first one
+        const auto isReachable = [&](const osg::Vec3f& v) { return (v - startPoint).length() <= maxDistance; };
+        if (const auto it = std::find_if(route.rbegin(), route.rend(), isReachable); it != route.rend())
+            return *it;
+        const osg::Vec3f startToPortal = route.front() - startPoint;
+        return startPoint + startToPortal * maxDistance / startToPortal.length();
     }
 }
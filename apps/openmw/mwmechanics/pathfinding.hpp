@@ -4,11 +4,14 @@
 #include <cassert>
 #include <deque>
 #include <iterator>
+#include <optional>
 #include <span>
 
 #include <osg/Vec3f>
 
+#include <components/detournavigator/agentbounds.hpp>
 #include <components/detournavigator/areatype.hpp>
+#include <components/detournavigator/asyncpathfinder.hpp>
 #include <components/detournavigator/flags.hpp>
 #include <components/detournavigator/status.hpp>
 
@@ -19,11 +22,6 @@ namespace MWWorld
     class Ptr;
 }
 
-namespace DetourNavigator
-{
-    struct AgentBounds;
-}
-
 namespace MWMechanics
 {
     class PathgridGraph;
@@ -99,6 +97,7 @@ namespace MWMechanics
             mConstructed = false;
             mPath.clear();
             mCell = nullptr;
+            cancelPathRequest();
         }
 
         void buildStraightPath(const osg::Vec3f& endPoint);
@@ -118,6 +117,18 @@ namespace MWMechanics
             const DetourNavigator::Flags flags, const DetourNavigator::AreaCosts& areaCosts, float endTolerance,
             PathType pathType);
 
+        /// Same as buildLimitedPath but finds path over navmesh asynchronously when it is possible. Current path is
+        /// kept until takePathResult replaces it.
+        void requestLimitedPath(const MWWorld::ConstPtr& actor, const osg::Vec3f& startPoint,
+            const osg::Vec3f& endPoint, const PathgridGraph& pathgridGraph,
+            const DetourNavigator::AgentBounds& agentBounds, const DetourNavigator::Flags flags,
+            const DetourNavigator::AreaCosts& areaCosts, float endTolerance, PathType pathType);
+
+        bool hasPathRequest() const { return mPathRequest.has_value(); }
+
+        /// Replaces current path with the requested one if it is found. Returns true if path is replaced.
+        bool takePathResult(const MWWorld::ConstPtr& actor);
+
         /// Remove front point if exist and within tolerance
         void update(const osg::Vec3f& position, float pointTolerance, float destinationTolerance,
             UpdateFlags updateFlags, const DetourNavigator::AgentBounds& agentBounds, DetourNavigator::Flags pathFlags);
@@ -144,9 +155,34 @@ namespace MWMechanics
         }
 
     private:
+        struct PathRequest
+        {
+            DetourNavigator::PathRequestId mId;
+            osg::Vec3f mStartPoint;
+            osg::Vec3f mEndPoint;
+            const PathgridGraph* mPathgridGraph;
+            DetourNavigator::AgentBounds mAgentBounds;
+            DetourNavigator::Flags mFlags;
+            DetourNavigator::AreaCosts mAreaCosts;
+            float mEndTolerance;
+            PathType mPathType;
+        };
+
         bool mConstructed = false;
         std::deque<osg::Vec3f> mPath;
         const MWWorld::CellStore* mCell = nullptr;
+        std::optional<PathRequest> mPathRequest;
+
+        void cancelPathRequest();
+
+        osg::Vec3f getLimitedEndPoint(
+            const MWWorld::ConstPtr& actor, const osg::Vec3f& startPoint, const osg::Vec3f& endPoint) const;
+
+        void buildPathFallback(const MWWorld::ConstPtr& actor, DetourNavigator::Status status,
+            const osg::Vec3f& startPoint, const osg::Vec3f& endPoint, const PathgridGraph& pathgridGraph,
+            const DetourNavigator::AgentBounds& agentBounds, const DetourNavigator::Flags flags,
+            const DetourNavigator::AreaCosts& areaCosts, float endTolerance, PathType pathType,
+            std::span<const osg::Vec3f> checkpoints);
 
         void buildPathByPathgridImpl(const osg::Vec3f& startPoint, const osg::Vec3f& endPoint,
             const PathgridGraph& pathgridGraph, std::back_insert_iterator<std::deque<osg::Vec3f>> out);
@@ -1,8 +1,8 @@
 #include "pathgrid.hpp"
 
 #include <algorithm>
-#include <list>
-#include <set>
+#include <functional>
+#include <utility>
 
 namespace
 {
@@ -45,6 +45,36 @@ namespace
     }
 
     constexpr size_t NoIndex = static_cast<size_t>(-1);
+
+    // Search buffers are reused by the following searches on the same thread. Instead of resetting the buffers each
+    // search increments the generation and values with other generation are considered unset.
+    struct AStarState
+    {
+        unsigned mGeneration = 0;
+        std::vector<unsigned> mVisited; // gScore and parent are set
+        std::vector<unsigned> mClosed;
+        std::vector<float> mGScore;
+        std::vector<size_t> mParent;
+        std::vector<std::pair<float, size_t>> mOpenSet; // binary heap by fScore
+
+        void reset(size_t graphSize)
+        {
+            if (mVisited.size() < graphSize)
+            {
+                mVisited.resize(graphSize, 0);
+                mClosed.resize(graphSize, 0);
+                mGScore.resize(graphSize);
+                mParent.resize(graphSize);
+            }
+            if (++mGeneration == 0)
+            {
+                std::fill(mVisited.begin(), mVisited.end(), 0);
+                std::fill(mClosed.begin(), mClosed.end(), 0);
+                mGeneration = 1;
+            }
+            mOpenSet.clear();
+        }
+    };
 }
 
 namespace MWMechanics
@@ -214,101 +244,90 @@ namespace MWMechanics
      * Uses mGraph which has pre-computed costs for allowed edges.  It is assumed
      * that mGraph is already constructed.
      *
-     * Should be possible to make this MT safe.
+     * Search buffers are thread local so it is MT safe and doesn't allocate
+     * memory once buffers are big enough.
      *
-     * Returns path which may be empty.  path contains pathgrid points in local
+     * Output path may be empty.  path contains pathgrid points in local
      * cell coordinates (indoors) or world coordinates (external).
      *
      * Input params:
      *   start, goal - pathgrid point indexes (for this cell)
      *
      * Variables:
-     *   openset - point indexes to be traversed, lowest cost at the front
-     *   closedset - point indexes already traversed
+     *   openset - binary heap of point indexes to be traversed, lowest cost at the front,
+     *             may contain outdated entries for already closed points
+     *   closed - point indexes already traversed
      *   gScore - past accumulated costs vector indexed by point index
-     *   fScore - future estimated costs vector indexed by point index
      *
      * TODO: An interesting exercise might be to cache the paths created for a
      *       start/goal pair.  To cache the results the paths need to be in
      *       pathgrid points form (currently they are converted to world
      *       coordinates).  Essentially trading speed w/ memory.
      */
-    std::deque<ESM::Pathgrid::Point> PathgridGraph::aStarSearch(const size_t start, const size_t goal) const
+    void PathgridGraph::aStarSearch(
+        const size_t start, const size_t goal, std::vector<ESM::Pathgrid::Point>& path) const
     {
-        std::deque<ESM::Pathgrid::Point> path;
+        path.clear();
         if (!isPointConnected(start, goal))
         {
-            return path; // there is no path, return an empty path
+            return; // there is no path, return an empty path
         }
 
-        size_t graphSize = mGraph.size();
-        std::vector<float> gScore(graphSize, -1);
-        std::vector<float> fScore(graphSize, -1);
-        std::vector<size_t> graphParent(graphSize, NoIndex);
-
-        // gScore & fScore keep costs for each pathgrid point in mPoints
-        gScore[start] = 0;
-        fScore[start] = costAStar(mPathgrid->mPoints[start], mPathgrid->mPoints[goal]);
+        thread_local AStarState state;
+        state.reset(mGraph.size());
+        const unsigned generation = state.mGeneration;
+        const auto compare = std::greater<std::pair<float, size_t>>();
 
-        std::list<size_t> openset;
-        std::set<size_t> closedset;
-        openset.push_back(start);
+        state.mVisited[start] = generation;
+        state.mGScore[start] = 0;
+        state.mParent[start] = NoIndex;
+        state.mOpenSet.emplace_back(costAStar(mPathgrid->mPoints[start], mPathgrid->mPoints[goal]), start);
 
-        size_t current = start;
+        bool found = false;
 
-        while (!openset.empty())
+        while (!state.mOpenSet.empty())
         {
-            current = openset.front(); // front has the lowest cost
-            openset.pop_front();
+            std::pop_heap(state.mOpenSet.begin(), state.mOpenSet.end(), compare);
+            const size_t current = state.mOpenSet.back().second; // front has the lowest cost
+            state.mOpenSet.pop_back();
+
+            if (state.mClosed[current] == generation)
+                continue; // outdated entry
 
             if (current == goal)
+            {
+                found = true;
                 break;
+            }
 
-            closedset.insert(current); // remember we've been here
+            state.mClosed[current] = generation; // remember we've been here
 
             // check all edges for the current point index
             for (const auto& edge : mGraph[current].edges)
             {
-                if (!closedset.contains(edge.index))
+                const size_t dest = edge.index;
+                if (state.mClosed[dest] == generation)
+                    continue; // traversed this edge destination already, try the next edge
+                const float tentativeG = state.mGScore[current] + edge.cost;
+                if (state.mVisited[dest] != generation || tentativeG < state.mGScore[dest])
                 {
-                    // not in closedset - i.e. have not traversed this edge destination
-                    size_t dest = edge.index;
-                    float tentativeG = gScore[current] + edge.cost;
-                    bool isInOpenSet = std::find(openset.begin(), openset.end(), dest) != openset.end();
-                    if (!isInOpenSet || tentativeG < gScore[dest])
-                    {
-                        graphParent[dest] = current;
-                        gScore[dest] = tentativeG;
-                        fScore[dest] = tentativeG + costAStar(mPathgrid->mPoints[dest], mPathgrid->mPoints[goal]);
-                        if (!isInOpenSet)
-                        {
-                            // add this edge to openset, lowest cost goes to the front
-                            // TODO: if this causes performance problems a hash table may help
-                            auto it = openset.begin();
-                            for (; it != openset.end(); ++it)
-                            {
-                                if (fScore[*it] > fScore[dest])
-                                    break;
-                            }
-                            openset.insert(it, dest);
-                        }
-                    }
-                } // if in closedset, i.e. traversed this edge already, try the next edge
+                    state.mVisited[dest] = generation;
+                    state.mParent[dest] = current;
+                    state.mGScore[dest] = tentativeG;
+                    const float fScore = tentativeG + costAStar(mPathgrid->mPoints[dest], mPathgrid->mPoints[goal]);
+                    state.mOpenSet.emplace_back(fScore, dest);
+                    std::push_heap(state.mOpenSet.begin(), state.mOpenSet.end(), compare);
+                }
             }
         }
 
-        if (current != goal)
-            return path; // for some reason couldn't build a path
+        if (!found)
+            return; // for some reason couldn't build a path
 
         // reconstruct path to return, using local coordinates
-        while (graphParent[current] != NoIndex)
-        {
-            path.push_front(mPathgrid->mPoints[current]);
-            current = graphParent[current];
-        }
+        for (size_t current = goal; current != NoIndex; current = state.mParent[current])
+            path.push_back(mPathgrid->mPoints[current]);
 
-        // add first node to path explicitly
-        path.push_front(mPathgrid->mPoints[start]);
-        return path;
+        std::reverse(path.begin(), path.end());
     }
 }
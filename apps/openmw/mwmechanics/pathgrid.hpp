@@ -1,7 +1,7 @@
 #ifndef GAME_MWMECHANICS_PATHGRID_H
 #define GAME_MWMECHANICS_PATHGRID_H
 
-#include <deque>
+#include <vector>
 
 #include <components/esm3/loadpgrd.hpp>
 
@@ -23,15 +23,18 @@ namespace MWMechanics
         // from start point) both start and end are pathgrid point indexes
         bool isPointConnected(const size_t start, const size_t end) const;
 
+        // returns id of the group of strongly connected points the point belongs to
+        int getComponentId(const size_t index) const { return mGraph[index].componentId; }
+
         // get neighbouring nodes for index node and put them to "nodes" vector
         void getNeighbouringPoints(const size_t index, ESM::Pathgrid::PointList& nodes) const;
 
         // the input parameters are pathgrid point indexes
         // the output list is in local (internal cells) or world (external
-        // cells) coordinates
+        // cells) coordinates, it is cleared before the search to reuse its memory
         //
         // NOTE: if start equals end an empty path is returned
-        std::deque<ESM::Pathgrid::Point> aStarSearch(const size_t start, const size_t end) const;
+        void aStarSearch(const size_t start, const size_t end, std::vector<ESM::Pathgrid::Point>& path) const;
 
         static const PathgridGraph sEmpty;
 
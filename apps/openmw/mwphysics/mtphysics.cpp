@@ -16,7 +16,6 @@
 
 #include "components/debug/debuglog.hpp"
 #include "components/misc/convert.hpp"
-#include <components/misc/barrier.hpp>
 #include <components/settings/values.hpp>
 
 #include "../mwmechanics/actorutil.hpp"
@@ -35,6 +34,7 @@
 #include "object.hpp"
 #include "physicssystem.hpp"
 #include "projectile.hpp"
+#include "regionbroadphase.hpp"
 
 namespace MWPhysics
 {
@@ -150,6 +150,8 @@ namespace
             const Impl& mImpl;
             std::shared_mutex& mCollisionWorldMutex;
             const MWPhysics::LockingPolicy mLockingPolicy;
+            // Keeps objects found by queries alive until the simulation is done when set
+            MWPhysics::RegionBroadphase* mRegionBroadphase = nullptr;
 
             template <class Ptr, class FrameData>
             void operator()(MWPhysics::SimulationImpl<Ptr, FrameData>& sim) const
@@ -162,6 +164,7 @@ namespace
                 // possible deadlock. Ptr destructor also acquires mCollisionWorldMutex.
                 const std::pair arg(std::move(ptr), frameData);
                 const Lock<std::shared_mutex> lock(mCollisionWorldMutex, mLockingPolicy);
+                const MWPhysics::RegionBroadphase::Pin pin(mRegionBroadphase);
                 mImpl(arg);
             }
         };
@@ -343,77 +346,19 @@ namespace MWPhysics
         }
     }
 
-    class PhysicsTaskScheduler::WorkersSync
-    {
-    public:
-        void waitForWorkers()
-        {
-            std::unique_lock lock(mWorkersDoneMutex);
-            if (mFrameCounter != mWorkersFrameCounter)
-                mWorkersDone.wait(lock);
-        }
-
-        void wakeUpWorkers()
-        {
-            const std::lock_guard lock(mHasJobMutex);
-            ++mFrameCounter;
-            mHasJob.notify_all();
-        }
-
-        void stopWorkers()
-        {
-            const std::lock_guard lock(mHasJobMutex);
-            mShouldStop = true;
-            mHasJob.notify_all();
-        }
-
-        void workIsDone()
-        {
-            const std::lock_guard lock(mWorkersDoneMutex);
-            ++mWorkersFrameCounter;
-            mWorkersDone.notify_all();
-        }
-
-        template <class F>
-        void runWorker(F&& f) noexcept
-        {
-            std::size_t lastFrame = 0;
-            std::unique_lock lock(mHasJobMutex);
-            while (!mShouldStop)
-            {
-                mHasJob.wait(lock, [&] { return mShouldStop || mFrameCounter != lastFrame; });
-                lastFrame = mFrameCounter;
-                lock.unlock();
-                f();
-                lock.lock();
-            }
-        }
-
-    private:
-        std::size_t mWorkersFrameCounter = 0;
-        std::condition_variable mWorkersDone;
-        std::mutex mWorkersDoneMutex;
-        std::condition_variable mHasJob;
-        bool mShouldStop = false;
-        std::size_t mFrameCounter = 0;
-        std::mutex mHasJobMutex;
-    };
-
-    PhysicsTaskScheduler::PhysicsTaskScheduler(
-        float physicsDt, btCollisionWorld* collisionWorld, MWRender::DebugDrawer* debugDrawer)
+    PhysicsTaskScheduler::PhysicsTaskScheduler(float physicsDt, btCollisionWorld* collisionWorld,
+        MWRender::DebugDrawer* debugDrawer, RegionBroadphase* regionBroadphase)
         : mDefaultPhysicsDt(physicsDt)
         , mPhysicsDt(physicsDt)
         , mTimeAccum(0.f)
         , mCollisionWorld(collisionWorld)
         , mDebugDrawer(debugDrawer)
+        , mRegionBroadphase(regionBroadphase)
         , mLockingPolicy(detectLockingPolicy())
         , mNumThreads(getNumThreads(mLockingPolicy))
-        , mNumJobs(0)
         , mRemainingSteps(0)
         , mLOSCacheExpiry(Settings::physics().mLineofsightKeepInactiveCache)
         , mAdvanceSimulation(false)
-        , mNextJob(0)
-        , mNextLOS(0)
         , mFrameNumber(0)
         , mTimer(osg::Timer::instance())
         , mPrevStepCount(1)
@@ -424,38 +369,24 @@ namespace MWPhysics
         , mTimeBegin(0)
         , mTimeEnd(0)
         , mFrameStart(0)
-        , mWorkersSync(mNumThreads >= 1 ? std::make_unique<WorkersSync>() : nullptr)
+        , mJobSystem(std::make_unique<Misc::JobSystem>(mNumThreads))
     {
         if (mNumThreads >= 1)
-        {
             Log(Debug::Info) << "Using " << mNumThreads << " async physics threads";
-            for (unsigned i = 0; i < mNumThreads; ++i)
-                mThreads.emplace_back([&] { worker(); });
-        }
         else
-        {
             mLOSCacheExpiry = 0;
-        }
-
-        mPreStepBarrier = std::make_unique<Misc::Barrier>(mNumThreads);
-
-        mPostStepBarrier = std::make_unique<Misc::Barrier>(mNumThreads);
-
-        mPostSimBarrier = std::make_unique<Misc::Barrier>(mNumThreads);
     }
 
     PhysicsTaskScheduler::~PhysicsTaskScheduler()
     {
-        waitForWorkers();
+        try
         {
-            MaybeExclusiveLock lock(mSimulationMutex, mLockingPolicy);
-            mNumJobs = 0;
-            mRemainingSteps = 0;
+            waitForWorkers();
+        }
+        catch (const std::exception& e)
+        {
+            Log(Debug::Error) << "Physics simulation failed: " << e.what();
         }
-        if (mWorkersSync != nullptr)
-            mWorkersSync->stopWorkers();
-        for (auto& thread : mThreads)
-            thread.join();
     }
 
     std::tuple<unsigned, float> PhysicsTaskScheduler::calculateStepConfig(float timeAccum) const
@@ -511,8 +442,11 @@ namespace MWPhysics
 
         waitForWorkers();
         prepareWork(timeAccum, simulations, frameStart, frameNumber, stats);
-        if (mWorkersSync != nullptr)
-            mWorkersSync->wakeUpWorkers();
+        if (mNumThreads != 0)
+            mJobSystem->run(mSimulationGroup, [this] {
+                std::shared_lock lock(mSimulationMutex);
+                doSimulation();
+            });
     }
 
     void PhysicsTaskScheduler::prepareWork(float& timeAccum, std::vector<Simulation>& simulations,
@@ -550,9 +484,6 @@ namespace MWPhysics
         mPhysicsDt = newDelta;
         mSimulations = &simulations;
         mAdvanceSimulation = (mRemainingSteps != 0);
-        mNumJobs = static_cast<int>(mSimulations->size());
-        mNextLOS.store(0, std::memory_order_relaxed);
-        mNextJob.store(0, std::memory_order_release);
 
         if (mAdvanceSimulation)
             mWorldFrameData = std::make_unique<WorldFrameData>();
@@ -653,14 +584,17 @@ namespace MWPhysics
     void PhysicsTaskScheduler::addCollisionObject(
         btCollisionObject* collisionObject, int collisionFilterGroup, int collisionFilterMask)
     {
-        MaybeExclusiveLock lock(mCollisionWorldMutex, mLockingPolicy);
+        // Region broadphase locks only the region of the object
+        MaybeExclusiveLock lock(
+            mRegionBroadphase != nullptr ? mCollisionObjectsMutex : mCollisionWorldMutex, mLockingPolicy);
         mCollisionObjects.insert(collisionObject);
         mCollisionWorld->addCollisionObject(collisionObject, collisionFilterGroup, collisionFilterMask);
     }
 
     void PhysicsTaskScheduler::removeCollisionObject(btCollisionObject* collisionObject)
     {
-        MaybeExclusiveLock lock(mCollisionWorldMutex, mLockingPolicy);
+        MaybeExclusiveLock lock(
+            mRegionBroadphase != nullptr ? mCollisionObjectsMutex : mCollisionWorldMutex, mLockingPolicy);
         mCollisionObjects.erase(collisionObject);
         mCollisionWorld->removeCollisionObject(collisionObject);
     }
@@ -698,11 +632,8 @@ namespace MWPhysics
     void PhysicsTaskScheduler::refreshLOSCache()
     {
         MaybeSharedLock lock(mLOSCacheMutex, mLockingPolicy);
-        int job = 0;
-        int numLOS = static_cast<int>(mLOSCache.size());
-        while ((job = mNextLOS.fetch_add(1, std::memory_order_relaxed)) < numLOS)
-        {
-            auto& req = mLOSCache[job];
+        mJobSystem->parallelFor(mLOSCache.size(), [this](std::size_t index) {
+            auto& req = mLOSCache[index];
             auto actorPtr1 = req.mActors[0].lock();
             auto actorPtr2 = req.mActors[1].lock();
 
@@ -710,7 +641,7 @@ namespace MWPhysics
                 req.mStale = true;
             else
                 req.mResult = hasLineOfSight(actorPtr1.get(), actorPtr2.get());
-        }
+        });
     }
 
     void PhysicsTaskScheduler::updateAabbs()
@@ -744,14 +675,6 @@ namespace MWPhysics
         }
     }
 
-    void PhysicsTaskScheduler::worker()
-    {
-        mWorkersSync->runWorker([this] {
-            std::shared_lock lock(mSimulationMutex);
-            doSimulation();
-        });
-    }
-
     void PhysicsTaskScheduler::updateActorsPositions()
     {
         const Visitors::UpdatePosition impl{ mCollisionWorld };
@@ -780,20 +703,20 @@ namespace MWPhysics
 
     void PhysicsTaskScheduler::doSimulation()
     {
+        // Steps depend on each other, only simulations within a single step are spread over the job system
         while (mRemainingSteps)
         {
-            mPreStepBarrier->wait([this] { afterPreStep(); });
-            int job = 0;
+            preStep();
             const Visitors::Move impl{ mPhysicsDt, mCollisionWorld, *mWorldFrameData };
-            const Visitors::WithLockedPtr<Visitors::Move, MaybeLock> vis{ impl, mCollisionWorldMutex, mLockingPolicy };
-            while ((job = mNextJob.fetch_add(1, std::memory_order_relaxed)) < mNumJobs)
-                std::visit(vis, (*mSimulations)[job]);
-
-            mPostStepBarrier->wait([this] { afterPostStep(); });
+            const Visitors::WithLockedPtr<Visitors::Move, MaybeLock> vis{ impl, mCollisionWorldMutex, mLockingPolicy,
+                mRegionBroadphase };
+            mJobSystem->parallelFor(
+                mSimulations->size(), [&](std::size_t index) { std::visit(vis, (*mSimulations)[index]); });
+            postStep();
         }
 
         refreshLOSCache();
-        mPostSimBarrier->wait([this] { afterPostSim(); });
+        postSim();
     }
 
     void PhysicsTaskScheduler::updateStats(osg::Timer_t frameStart, unsigned int frameNumber, osg::Stats& stats)
@@ -814,6 +737,7 @@ namespace MWPhysics
     void PhysicsTaskScheduler::debugDraw()
     {
         MaybeSharedLock lock(mCollisionWorldMutex, mLockingPolicy);
+        MaybeSharedLock objectsLock(mCollisionObjectsMutex, mLockingPolicy);
         mDebugDrawer->step();
     }
 
@@ -837,29 +761,28 @@ namespace MWPhysics
         mUpdateAabb.clear();
     }
 
-    void PhysicsTaskScheduler::afterPreStep()
+    void PhysicsTaskScheduler::preStep()
     {
         updateAabbs();
         if (!mRemainingSteps)
             return;
         const Visitors::PreStep impl{ mCollisionWorld };
         const Visitors::WithLockedPtr<Visitors::PreStep, MaybeExclusiveLock> vis{ impl, mCollisionWorldMutex,
-            mLockingPolicy };
+            mLockingPolicy, mRegionBroadphase };
         for (auto& sim : *mSimulations)
             std::visit(vis, sim);
     }
 
-    void PhysicsTaskScheduler::afterPostStep()
+    void PhysicsTaskScheduler::postStep()
     {
         if (mRemainingSteps)
         {
             --mRemainingSteps;
             updateActorsPositions();
         }
-        mNextJob.store(0, std::memory_order_release);
     }
 
-    void PhysicsTaskScheduler::afterPostSim()
+    void PhysicsTaskScheduler::postSim()
     {
         {
             MaybeExclusiveLock lock(mLOSCacheMutex, mLockingPolicy);
@@ -868,8 +791,6 @@ namespace MWPhysics
                 mLOSCache.end());
         }
         mTimeEnd = mTimer->tick();
-        if (mWorkersSync != nullptr)
-            mWorkersSync->workIsDone();
     }
 
     void PhysicsTaskScheduler::syncWithMainThread()
@@ -883,15 +804,15 @@ namespace MWPhysics
         mSimulations = nullptr;
     }
 
-    // Attempt to acquire unique lock on mSimulationMutex while not all worker
-    // threads are holding shared lock but will have to may lead to a deadlock because
+    // Attempt to acquire unique lock on mSimulationMutex while the simulation job
+    // is not holding shared lock yet but will have to may lead to a deadlock because
     // C++ standard does not guarantee priority for exclusive and shared locks
     // for std::shared_mutex. For example microsoft STL implementation points out
     // for the absence of such priority:
     // https://docs.microsoft.com/en-us/windows/win32/sync/slim-reader-writer--srw--locks
+    // The calling thread executes queued simulation jobs while waiting.
     void PhysicsTaskScheduler::waitForWorkers()
     {
-        if (mWorkersSync != nullptr)
-            mWorkersSync->waitForWorkers();
+        mJobSystem->wait(mSimulationGroup);
     }
 }
@@ -1,13 +1,10 @@
 #ifndef OPENMW_MWPHYSICS_MTPHYSICS_H
 #define OPENMW_MWPHYSICS_MTPHYSICS_H
 
-#include <atomic>
-#include <condition_variable>
 #include <memory>
 #include <optional>
 #include <set>
 #include <shared_mutex>
-#include <thread>
 #include <unordered_set>
 
 #include <BulletCollision/CollisionDispatch/btCollisionWorld.h>
@@ -15,14 +12,10 @@
 #include <osg/Timer>
 
 #include "components/misc/budgetmeasurement.hpp"
+#include "components/misc/jobsystem.hpp"
 #include "physicssystem.hpp"
 #include "ptrholder.hpp"
 
-namespace Misc
-{
-    class Barrier;
-}
-
 namespace MWRender
 {
     class DebugDrawer;
@@ -30,6 +23,8 @@ namespace MWRender
 
 namespace MWPhysics
 {
+    class RegionBroadphase;
+
     enum class LockingPolicy
     {
         NoLocks,
@@ -40,7 +35,9 @@ namespace MWPhysics
     class PhysicsTaskScheduler
     {
     public:
-        PhysicsTaskScheduler(float physicsDt, btCollisionWorld* collisionWorld, MWRender::DebugDrawer* debugDrawer);
+        /// @param regionBroadphase broadphase of the collisionWorld when it's split into regions, nullptr otherwise
+        PhysicsTaskScheduler(float physicsDt, btCollisionWorld* collisionWorld, MWRender::DebugDrawer* debugDrawer,
+            RegionBroadphase* regionBroadphase);
         ~PhysicsTaskScheduler();
 
         /// @brief move actors taking into account desired movements and collisions
@@ -73,10 +70,7 @@ namespace MWPhysics
                                     // ~PhysicsTaskScheduler()
 
     private:
-        class WorkersSync;
-
         void doSimulation();
-        void worker();
         void updateActorsPositions();
         bool hasLineOfSight(const Actor* actor1, const Actor* actor2);
         void refreshLOSCache();
@@ -84,9 +78,9 @@ namespace MWPhysics
         void updatePtrAabb(const std::shared_ptr<PtrHolder>& ptr);
         void updateStats(osg::Timer_t frameStart, unsigned int frameNumber, osg::Stats& stats);
         std::tuple<unsigned, float> calculateStepConfig(float timeAccum) const;
-        void afterPreStep();
-        void afterPostStep();
-        void afterPostSim();
+        void preStep();
+        void postStep();
+        void postSim();
         void syncWithMainThread();
         void waitForWorkers();
         void prepareWork(float& timeAccum, std::vector<Simulation>& simulations, osg::Timer_t frameStart,
@@ -100,26 +94,20 @@ namespace MWPhysics
         float mTimeAccum;
         btCollisionWorld* mCollisionWorld;
         MWRender::DebugDrawer* mDebugDrawer;
+        RegionBroadphase* mRegionBroadphase;
         std::vector<LOSRequest> mLOSCache;
         std::set<std::weak_ptr<PtrHolder>, std::owner_less<std::weak_ptr<PtrHolder>>> mUpdateAabb;
 
-        // TODO: use std::experimental::flex_barrier or std::barrier once it becomes a thing
-        std::unique_ptr<Misc::Barrier> mPreStepBarrier;
-        std::unique_ptr<Misc::Barrier> mPostStepBarrier;
-        std::unique_ptr<Misc::Barrier> mPostSimBarrier;
-
         LockingPolicy mLockingPolicy;
         unsigned mNumThreads;
-        int mNumJobs;
         unsigned mRemainingSteps;
         int mLOSCacheExpiry;
         bool mAdvanceSimulation;
-        std::atomic<int> mNextJob;
-        std::atomic<int> mNextLOS;
-        std::vector<std::thread> mThreads;
 
         mutable std::shared_mutex mSimulationMutex;
         mutable std::shared_mutex mCollisionWorldMutex;
+        // Guards the list of collision objects when adding or removing them doesn't lock the whole world
+        mutable std::shared_mutex mCollisionObjectsMutex;
         mutable std::shared_mutex mLOSCacheMutex;
         mutable std::mutex mUpdateAabbMutex;
 
@@ -135,7 +123,9 @@ namespace MWPhysics
         osg::Timer_t mTimeEnd;
         osg::Timer_t mFrameStart;
 
-        std::unique_ptr<WorkersSync> mWorkersSync;
+        Misc::JobGroup mSimulationGroup;
+        // Declared last to finish all jobs before other members are destroyed
+        std::unique_ptr<Misc::JobSystem> mJobSystem;
     };
 
 }
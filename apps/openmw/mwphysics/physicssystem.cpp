@@ -22,6 +22,7 @@
 #include <components/debug/debuglog.hpp>
 #include <components/esm3/loadgmst.hpp>
 #include <components/esm3/loadmgef.hpp>
+#include <components/misc/constants.hpp>
 #include <components/misc/convert.hpp>
 #include <components/misc/resourcehelpers.hpp>
 #include <components/misc/strings/conversion.hpp>
@@ -55,6 +56,7 @@
 #include "mtphysics.hpp"
 #include "object.hpp"
 #include "projectile.hpp"
+#include "regionbroadphase.hpp"
 
 namespace
 {
@@ -109,7 +111,17 @@ namespace MWPhysics
 
         mCollisionConfiguration = std::make_unique<btDefaultCollisionConfiguration>();
         mDispatcher = std::make_unique<btCollisionDispatcher>(mCollisionConfiguration.get());
-        mBroadphase = std::make_unique<btDbvtBroadphase>();
+        RegionBroadphase* regionBroadphase = nullptr;
+        if (const int regionSize = Settings::physics().mBroadphaseRegionSize; regionSize > 0)
+        {
+            auto broadphase = std::make_unique<RegionBroadphase>(
+                static_cast<btScalar>(regionSize) * static_cast<btScalar>(Constants::CellSizeInUnits));
+            regionBroadphase = broadphase.get();
+            mBroadphase = std::move(broadphase);
+            Log(Debug::Info) << "Using physics broadphase regions of " << regionSize << " cells";
+        }
+        else
+            mBroadphase = std::make_unique<btDbvtBroadphase>();
 
         mCollisionWorld
             = std::make_unique<btCollisionWorld>(mDispatcher.get(), mBroadphase.get(), mCollisionConfiguration.get());
@@ -131,7 +143,8 @@ namespace MWPhysics
         }
 
         mDebugDrawer = std::make_unique<MWRender::DebugDrawer>(mParentNode, mCollisionWorld.get(), mDebugDrawEnabled);
-        mTaskScheduler = std::make_unique<PhysicsTaskScheduler>(mPhysicsDt, mCollisionWorld.get(), mDebugDrawer.get());
+        mTaskScheduler = std::make_unique<PhysicsTaskScheduler>(
+            mPhysicsDt, mCollisionWorld.get(), mDebugDrawer.get(), regionBroadphase);
     }
 
     PhysicsSystem::~PhysicsSystem()
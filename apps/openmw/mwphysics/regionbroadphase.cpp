@@ -0,0 +1,388 @@
+#include "regionbroadphase.hpp"
+
+#include <BulletCollision/BroadphaseCollision/btDbvtBroadphase.h>
+#include <BulletCollision/CollisionDispatch/btCollisionObject.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <condition_variable>
+#include <limits>
+#include <mutex>
+
+namespace MWPhysics
+{
+    namespace
+    {
+        // New readers wait for pending writers so a stream of queries can't starve moving objects. A thread
+        // having other regions locked for reading doesn't wait for pending writers, otherwise it could deadlock with
+        // a writer waiting for it to unlock one of these regions. Writers never lock more than one region at the
+        // same time.
+        class RegionMutex
+        {
+        public:
+            void lock_shared()
+            {
+                std::unique_lock lock(mMutex);
+                mUnlocked.wait(lock, [&] { return !mWriter && mPendingWriters == 0; });
+                ++mReaders;
+            }
+
+            void lockSharedIgnoringPendingWriters()
+            {
+                std::unique_lock lock(mMutex);
+                mUnlocked.wait(lock, [&] { return !mWriter; });
+                ++mReaders;
+            }
+
+            void unlock_shared()
+            {
+                const std::lock_guard lock(mMutex);
+                if (--mReaders == 0)
+                    mUnlocked.notify_all();
+            }
+
+            void lock()
+            {
+                std::unique_lock lock(mMutex);
+                ++mPendingWriters;
+                mUnlocked.wait(lock, [&] { return !mWriter && mReaders == 0; });
+                --mPendingWriters;
+                mWriter = true;
+            }
+
+            void unlock()
+            {
+                const std::lock_guard lock(mMutex);
+                mWriter = false;
+                mUnlocked.notify_all();
+            }
+
+        private:
+            std::mutex mMutex;
+            std::condition_variable mUnlocked;
+            std::size_t mReaders = 0;
+            std::size_t mPendingWriters = 0;
+            bool mWriter = false;
+        };
+
+        thread_local RegionBroadphase::Pin* sPin = nullptr;
+
+        int getRegionIndex(double value)
+        {
+            if (std::isnan(value))
+                return 0;
+            constexpr double min = std::numeric_limits<int>::min();
+            constexpr double max = std::numeric_limits<int>::max();
+            return static_cast<int>(std::clamp(std::floor(value), min, max));
+        }
+
+        bool isFinite(const btVector3& value)
+        {
+            return std::isfinite(value.x()) && std::isfinite(value.y()) && std::isfinite(value.z());
+        }
+
+        // Region trees store the outer proxy as a client object of the inner one
+        struct AabbCallback final : btBroadphaseAabbCallback
+        {
+            btBroadphaseAabbCallback& mImpl;
+
+            explicit AabbCallback(btBroadphaseAabbCallback& impl)
+                : mImpl(impl)
+            {
+            }
+
+            bool process(const btBroadphaseProxy* proxy) override
+            {
+                return mImpl.process(static_cast<const btBroadphaseProxy*>(proxy->m_clientObject));
+            }
+        };
+
+        struct RayCallback final : btBroadphaseRayCallback
+        {
+            btBroadphaseRayCallback& mImpl;
+
+            explicit RayCallback(btBroadphaseRayCallback& impl)
+                : mImpl(impl)
+            {
+                m_rayDirectionInverse = impl.m_rayDirectionInverse;
+                std::copy(std::begin(impl.m_signs), std::end(impl.m_signs), std::begin(m_signs));
+                m_lambda_max = impl.m_lambda_max;
+            }
+
+            bool process(const btBroadphaseProxy* proxy) override
+            {
+                const bool result = mImpl.process(static_cast<const btBroadphaseProxy*>(proxy->m_clientObject));
+                // Closest hit callbacks shorten the ray to skip further subtrees
+                m_lambda_max = mImpl.m_lambda_max;
+                return result;
+            }
+        };
+    }
+
+    struct RegionBroadphase::Region
+    {
+        btDbvtBroadphase mBroadphase;
+        RegionMutex mMutex;
+
+        explicit Region(btOverlappingPairCache* pairCache)
+            : mBroadphase(pairCache)
+        {
+        }
+    };
+
+    struct RegionBroadphase::Proxy : btBroadphaseProxy
+    {
+        int mShapeType;
+        Region* mRegion = nullptr;
+        btBroadphaseProxy* mInner = nullptr;
+
+        explicit Proxy(const btVector3& aabbMin, const btVector3& aabbMax, int shapeType, void* userPtr,
+            int collisionFilterGroup, int collisionFilterMask)
+            : btBroadphaseProxy(aabbMin, aabbMax, userPtr, collisionFilterGroup, collisionFilterMask)
+            , mShapeType(shapeType)
+        {
+        }
+    };
+
+    RegionBroadphase::Pin::Pin(RegionBroadphase* broadphase)
+        : mBroadphase(broadphase)
+    {
+        if (mBroadphase == nullptr)
+            return;
+        assert(sPin == nullptr);
+        sPin = this;
+    }
+
+    RegionBroadphase::Pin::~Pin()
+    {
+        if (mBroadphase == nullptr)
+            return;
+        for (Region* region : mRegions)
+            region->mMutex.unlock_shared();
+        sPin = nullptr;
+    }
+
+    RegionBroadphase::RegionBroadphase(btScalar regionSize)
+        : mRegionSize(regionSize)
+        , mGlobalRegion(std::make_unique<Region>(&mPairCache))
+    {
+        assert(mRegionSize > 0);
+    }
+
+    RegionBroadphase::~RegionBroadphase() = default;
+
+    btBroadphaseProxy* RegionBroadphase::createProxy(const btVector3& aabbMin, const btVector3& aabbMax,
+        int shapeType, void* userPtr, int collisionFilterGroup, int collisionFilterMask, btDispatcher* dispatcher)
+    {
+        auto proxy
+            = std::make_unique<Proxy>(aabbMin, aabbMax, shapeType, userPtr, collisionFilterGroup, collisionFilterMask);
+        proxy->m_uniqueId = ++mNextProxyId;
+        // Bullet query callbacks read the handle from the collision object. Other threads may find the object before
+        // btCollisionWorld sets the returned proxy.
+        static_cast<btCollisionObject*>(userPtr)->setBroadphaseHandle(proxy.get());
+        insert(*proxy, dispatcher);
+        return proxy.release();
+    }
+
+    void RegionBroadphase::destroyProxy(btBroadphaseProxy* proxy, btDispatcher* dispatcher)
+    {
+        std::unique_ptr<Proxy> value(static_cast<Proxy*>(proxy));
+        remove(*value, dispatcher);
+    }
+
+    void RegionBroadphase::setAabb(
+        btBroadphaseProxy* proxy, const btVector3& aabbMin, const btVector3& aabbMax, btDispatcher* dispatcher)
+    {
+        Proxy& value = *static_cast<Proxy*>(proxy);
+        Region& region = getRegion(aabbMin, aabbMax);
+        if (&region == value.mRegion)
+        {
+            const std::lock_guard lock(region.mMutex);
+            value.m_aabbMin = aabbMin;
+            value.m_aabbMax = aabbMax;
+            region.mBroadphase.setAabb(value.mInner, aabbMin, aabbMax, dispatcher);
+            return;
+        }
+        // Move to the other region one lock at a time, the object is invisible for a moment in between
+        remove(value, dispatcher);
+        value.m_aabbMin = aabbMin;
+        value.m_aabbMax = aabbMax;
+        insert(value, dispatcher);
+    }
+
+    void RegionBroadphase::getAabb(btBroadphaseProxy* proxy, btVector3& aabbMin, btVector3& aabbMax) const
+    {
+        aabbMin = proxy->m_aabbMin;
+        aabbMax = proxy->m_aabbMax;
+    }
+
+    void RegionBroadphase::rayTest(const btVector3& rayFrom, const btVector3& rayTo,
+        btBroadphaseRayCallback& rayCallback, const btVector3& aabbMin, const btVector3& aabbMax)
+    {
+        btVector3 queryMin = rayFrom;
+        btVector3 queryMax = rayFrom;
+        queryMin.setMin(rayTo);
+        queryMax.setMax(rayTo);
+        RayCallback callback(rayCallback);
+        forEachRegion(queryMin + aabbMin, queryMax + aabbMax,
+            [&](Region& region) { region.mBroadphase.rayTest(rayFrom, rayTo, callback, aabbMin, aabbMax); });
+    }
+
+    void RegionBroadphase::aabbTest(
+        const btVector3& aabbMin, const btVector3& aabbMax, btBroadphaseAabbCallback& callback)
+    {
+        AabbCallback wrapper(callback);
+        forEachRegion(
+            aabbMin, aabbMax, [&](Region& region) { region.mBroadphase.aabbTest(aabbMin, aabbMax, wrapper); });
+    }
+
+    void RegionBroadphase::calculateOverlappingPairs(btDispatcher* dispatcher)
+    {
+        // Doesn't produce pairs but lets region trees rebalance
+        const auto update = [&](Region& region) {
+            const std::lock_guard lock(region.mMutex);
+            region.mBroadphase.calculateOverlappingPairs(dispatcher);
+        };
+        update(*mGlobalRegion);
+        std::vector<Region*> regions;
+        {
+            const std::shared_lock lock(mRegionsMutex);
+            regions.reserve(mRegions.size());
+            for (const auto& [key, region] : mRegions)
+                regions.push_back(region.get());
+        }
+        for (Region* region : regions)
+            update(*region);
+    }
+
+    void RegionBroadphase::getBroadphaseAabb(btVector3& aabbMin, btVector3& aabbMax) const
+    {
+        aabbMin.setValue(BT_LARGE_FLOAT, BT_LARGE_FLOAT, BT_LARGE_FLOAT);
+        aabbMax.setValue(-BT_LARGE_FLOAT, -BT_LARGE_FLOAT, -BT_LARGE_FLOAT);
+        const auto merge = [&](Region& region) {
+            btVector3 regionMin;
+            btVector3 regionMax;
+            const std::shared_lock lock(region.mMutex);
+            region.mBroadphase.getBroadphaseAabb(regionMin, regionMax);
+            aabbMin.setMin(regionMin);
+            aabbMax.setMax(regionMax);
+        };
+        merge(*mGlobalRegion);
+        std::vector<Region*> regions;
+        {
+            const std::shared_lock lock(mRegionsMutex);
+            regions.reserve(mRegions.size());
+            for (const auto& [key, region] : mRegions)
+                regions.push_back(region.get());
+        }
+        for (Region* region : regions)
+            merge(*region);
+    }
+
+    std::size_t RegionBroadphase::getRegionsCount() const
+    {
+        const std::shared_lock lock(mRegionsMutex);
+        return mRegions.size() + 1;
+    }
+
+    RegionBroadphase::Region& RegionBroadphase::getRegion(const btVector3& aabbMin, const btVector3& aabbMax)
+    {
+        if (!isFinite(aabbMin) || !isFinite(aabbMax) || aabbMax.x() - aabbMin.x() > mRegionSize
+            || aabbMax.y() - aabbMin.y() > mRegionSize)
+            return *mGlobalRegion;
+        const btVector3 center = (aabbMin + aabbMax) * btScalar(0.5);
+        const std::pair key(getRegionIndex(center.x() / mRegionSize), getRegionIndex(center.y() / mRegionSize));
+        {
+            const std::shared_lock lock(mRegionsMutex);
+            if (const auto it = mRegions.find(key); it != mRegions.end())
+                return *it->second;
+        }
+        const std::lock_guard lock(mRegionsMutex);
+        std::unique_ptr<Region>& region = mRegions[key];
+        if (region == nullptr)
+            region = std::make_unique<Region>(&mPairCache);
+        return *region;
+    }
+
+    std::vector<RegionBroadphase::Region*> RegionBroadphase::getRegions(
+        const btVector3& aabbMin, const btVector3& aabbMax) const
+    {
+        // An object from region with index i is within [(i - 0.5) * size, (i + 1.5) * size] by each axis
+        const double size = mRegionSize;
+        const auto getMin = [&](btScalar value) { return getRegionIndex(std::ceil(value / size - 1.5)); };
+        const auto getMax = [&](btScalar value) { return getRegionIndex(value / size + 0.5); };
+        const int minX = getMin(aabbMin.x());
+        const int maxX = getMax(aabbMax.x());
+        const int minY = getMin(aabbMin.y());
+        const int maxY = getMax(aabbMax.y());
+
+        std::vector<Region*> result;
+        const std::shared_lock lock(mRegionsMutex);
+        if (!isFinite(aabbMin) || !isFinite(aabbMax))
+        {
+            result.reserve(mRegions.size());
+            for (const auto& [key, region] : mRegions)
+                result.push_back(region.get());
+            return result;
+        }
+        if (minX > maxX || minY > maxY)
+            return result;
+        const double cells = (static_cast<double>(maxX) - minX + 1) * (static_cast<double>(maxY) - minY + 1);
+        if (cells <= static_cast<double>(mRegions.size()))
+        {
+            for (int x = minX; x <= maxX; ++x)
+                for (int y = minY; y <= maxY; ++y)
+                    if (const auto it = mRegions.find(std::pair(x, y)); it != mRegions.end())
+                        result.push_back(it->second.get());
+            return result;
+        }
+        for (const auto& [key, region] : mRegions)
+            if (minX <= key.first && key.first <= maxX && minY <= key.second && key.second <= maxY)
+                result.push_back(region.get());
+        return result;
+    }
+
+    template <class Function>
+    void RegionBroadphase::forEachRegion(const btVector3& aabbMin, const btVector3& aabbMax, Function&& function)
+    {
+        Pin* const pin = sPin != nullptr && sPin->mBroadphase == this ? sPin : nullptr;
+        const auto visit = [&](Region& region) {
+            if (pin == nullptr)
+            {
+                const std::shared_lock lock(region.mMutex);
+                function(region);
+                return;
+            }
+            if (std::find(pin->mRegions.begin(), pin->mRegions.end(), &region) == pin->mRegions.end())
+            {
+                if (pin->mRegions.empty())
+                    region.mMutex.lock_shared();
+                else
+                    region.mMutex.lockSharedIgnoringPendingWriters();
+                pin->mRegions.push_back(&region);
+            }
+            function(region);
+        };
+        visit(*mGlobalRegion);
+        for (Region* region : getRegions(aabbMin, aabbMax))
+            visit(*region);
+    }
+
+    void RegionBroadphase::insert(Proxy& proxy, btDispatcher* dispatcher)
+    {
+        Region& region = getRegion(proxy.m_aabbMin, proxy.m_aabbMax);
+        const std::lock_guard lock(region.mMutex);
+        proxy.mInner = region.mBroadphase.createProxy(proxy.m_aabbMin, proxy.m_aabbMax, proxy.mShapeType, &proxy,
+            proxy.m_collisionFilterGroup, proxy.m_collisionFilterMask, dispatcher);
+        proxy.mRegion = &region;
+    }
+
+    void RegionBroadphase::remove(Proxy& proxy, btDispatcher* dispatcher)
+    {
+        const std::lock_guard lock(proxy.mRegion->mMutex);
+        proxy.mRegion->mBroadphase.destroyProxy(proxy.mInner, dispatcher);
+        proxy.mInner = nullptr;
+        proxy.mRegion = nullptr;
+    }
+}
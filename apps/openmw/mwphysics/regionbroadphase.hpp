@@ -0,0 +1,107 @@
+#ifndef OPENMW_MWPHYSICS_REGIONBROADPHASE_H
+#define OPENMW_MWPHYSICS_REGIONBROADPHASE_H
+
+#include <BulletCollision/BroadphaseCollision/btBroadphaseInterface.h>
+#include <BulletCollision/BroadphaseCollision/btOverlappingPairCache.h>
+
+#include <atomic>
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <shared_mutex>
+#include <utility>
+#include <vector>
+
+namespace MWPhysics
+{
+    /// @brief Broadphase splitting the world into square regions with own dynamic AABB tree and lock each.
+    /// @par An object belongs to the region containing the center of its AABB. Objects larger than a region go to the
+    /// global region checked by all queries. Adding, removing or moving an object locks only its region so streaming
+    /// cells doesn't stall queries made in other regions.
+    /// @par Queries made by a thread having a Pin keep all touched regions locked for reading until the Pin is
+    /// destroyed. This keeps objects found by one query alive for the following ones.
+    /// @note Overlapping pairs are not tracked, btCollisionWorld without dynamics doesn't use them.
+    /// @note Callbacks get the proxies returned by createProxy. All methods are thread safe.
+    class RegionBroadphase final : public btBroadphaseInterface
+    {
+        struct Region;
+
+    public:
+        class Pin
+        {
+        public:
+            /// Does nothing when broadphase is nullptr. Only one Pin per thread may exist at the same time. The thread
+            /// must not add, remove or move objects while having a Pin.
+            explicit Pin(RegionBroadphase* broadphase);
+
+            ~Pin();
+
+            Pin(const Pin&) = delete;
+            Pin& operator=(const Pin&) = delete;
+
+        private:
+            RegionBroadphase* mBroadphase;
+            std::vector<Region*> mRegions;
+
+            friend class RegionBroadphase;
+        };
+
+        explicit RegionBroadphase(btScalar regionSize);
+
+        ~RegionBroadphase() override;
+
+        btBroadphaseProxy* createProxy(const btVector3& aabbMin, const btVector3& aabbMax, int shapeType,
+            void* userPtr, int collisionFilterGroup, int collisionFilterMask, btDispatcher* dispatcher) override;
+
+        void destroyProxy(btBroadphaseProxy* proxy, btDispatcher* dispatcher) override;
+
+        void setAabb(btBroadphaseProxy* proxy, const btVector3& aabbMin, const btVector3& aabbMax,
+            btDispatcher* dispatcher) override;
+
+        void getAabb(btBroadphaseProxy* proxy, btVector3& aabbMin, btVector3& aabbMax) const override;
+
+        void rayTest(const btVector3& rayFrom, const btVector3& rayTo, btBroadphaseRayCallback& rayCallback,
+            const btVector3& aabbMin = btVector3(0, 0, 0), const btVector3& aabbMax = btVector3(0, 0, 0)) override;
+
+        void aabbTest(const btVector3& aabbMin, const btVector3& aabbMax, btBroadphaseAabbCallback& callback) override;
+
+        void calculateOverlappingPairs(btDispatcher* dispatcher) override;
+
+        btOverlappingPairCache* getOverlappingPairCache() override { return &mPairCache; }
+
+        const btOverlappingPairCache* getOverlappingPairCache() const override { return &mPairCache; }
+
+        void getBroadphaseAabb(btVector3& aabbMin, btVector3& aabbMax) const override;
+
+        void printStats() override {}
+
+        btScalar getRegionSize() const { return mRegionSize; }
+
+        /// Number of regions ever used by objects including the global one.
+        std::size_t getRegionsCount() const;
+
+    private:
+        struct Proxy;
+
+        const btScalar mRegionSize;
+        btNullPairCache mPairCache;
+        std::unique_ptr<Region> mGlobalRegion;
+        mutable std::shared_mutex mRegionsMutex;
+        // Regions are never removed to allow using them without holding mRegionsMutex
+        std::map<std::pair<int, int>, std::unique_ptr<Region>> mRegions;
+        std::atomic_int mNextProxyId{ 0 };
+
+        Region& getRegion(const btVector3& aabbMin, const btVector3& aabbMax);
+
+        std::vector<Region*> getRegions(const btVector3& aabbMin, const btVector3& aabbMax) const;
+
+        template <class Function>
+        void forEachRegion(const btVector3& aabbMin, const btVector3& aabbMax, Function&& function);
+
+        void insert(Proxy& proxy, btDispatcher* dispatcher);
+
+        void remove(Proxy& proxy, btDispatcher* dispatcher);
+    };
+}
+
+#endif
@@ -378,7 +378,6 @@ namespace MWRender
         osg::Vec2f minBound = (center - osg::Vec2f(size / 2.f, size / 2.f));
         osg::Vec2f maxBound = (center + osg::Vec2f(size / 2.f, size / 2.f));
         DensityCalculator calculator(mDensity);
-        ESM::ReadersCache readers;
         osg::Vec2i startCell = osg::Vec2i(static_cast<int>(std::floor(center.x() - size / 2.f)),
             static_cast<int>(std::floor(center.y() - size / 2.f)));
         for (int cellX = startCell.x(); cellX < startCell.x() + size; ++cellX)
@@ -395,7 +394,7 @@ namespace MWRender
                 for (size_t i = 0; i < cell.mContextList.size(); ++i)
                 {
                     const std::size_t index = static_cast<std::size_t>(cell.mContextList[i].index);
-                    const ESM::ReadersCache::BusyItem reader = readers.get(index);
+                    const ESM::ReadersCache::BusyItem reader = mReaders.get(index);
                     cell.restore(*reader, i);
                     ESM::CellRef ref;
                     bool deleted = false;
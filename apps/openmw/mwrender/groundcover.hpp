@@ -2,6 +2,7 @@
 #define OPENMW_MWRENDER_GROUNDCOVER_H
 
 #include <components/esm3/loadcell.hpp>
+#include <components/esm3/readerscache.hpp>
 #include <components/resource/scenemanager.hpp>
 #include <components/terrain/quadtreeworld.hpp>
 #include <components/vfs/pathutil.hpp>
@@ -54,6 +55,8 @@ namespace MWRender
         osg::ref_ptr<osg::StateSet> mStateset;
         osg::ref_ptr<osg::Program> mProgramTemplate;
         const MWWorld::GroundcoverStore& mGroundcoverStore;
+        // Shared by the threads creating chunks to keep content files open between chunks
+        ESM::ReadersCache mReaders;
 
         osg::ref_ptr<osg::Node> createChunk(InstanceMap& instances, const osg::Vec2f& center);
         void collectInstances(InstanceMap& instances, float size, const osg::Vec2f& center);
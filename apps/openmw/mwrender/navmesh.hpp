@@ -1,6 +1,7 @@
 #ifndef OPENMW_MWRENDER_NAVMESH_H
 #define OPENMW_MWRENDER_NAVMESH_H
 
+#include <components/detournavigator/guardednavmeshcacheitem.hpp>
 #include <components/detournavigator/tileposition.hpp>
 #include <components/detournavigator/version.hpp>
 #include <components/misc/guarded.hpp>
@@ -44,8 +45,8 @@ namespace MWRender
 
         bool toggle();
 
-        void update(const std::shared_ptr<Misc::ScopeGuarded<DetourNavigator::NavMeshCacheItem>>& navMesh,
-            std::size_t id, const DetourNavigator::Settings& settings);
+        void update(const std::shared_ptr<DetourNavigator::GuardedNavMeshCacheItem>& navMesh, std::size_t id,
+            const DetourNavigator::Settings& settings);
 
         void reset();
 
@@ -545,10 +545,9 @@ namespace MWRender
         }
 
         std::map<ESM::RefNum, PagedCellRef> collectESM3References(
-            float size, const osg::Vec2i& startCell, const MWWorld::ESMStore& store)
+            float size, const osg::Vec2i& startCell, const MWWorld::ESMStore& store, ESM::ReadersCache& readers)
         {
             std::map<ESM::RefNum, PagedCellRef> refs;
-            ESM::ReadersCache readers;
             for (int cellX = startCell.x(); cellX < startCell.x() + size; ++cellX)
             {
                 for (int cellY = startCell.y(); cellY < startCell.y() + size; ++cellY)
@@ -664,7 +663,7 @@ namespace MWRender
 
         if (mWorldspace == ESM::Cell::sDefaultWorldspaceId)
         {
-            refs = collectESM3References(size, startCell, store);
+            refs = collectESM3References(size, startCell, store, mReaders);
         }
         else
         {
@@ -1,6 +1,7 @@
 #ifndef OPENMW_MWRENDER_OBJECTPAGING_H
 #define OPENMW_MWRENDER_OBJECTPAGING_H
 
+#include <components/esm3/readerscache.hpp>
 #include <components/esm3/refnum.hpp>
 #include <components/resource/resourcemanager.hpp>
 #include <components/terrain/quadtreeworld.hpp>
@@ -55,6 +56,8 @@ namespace MWRender
         float mMinSize;
         float mMinSizeMergeFactor;
         float mMinSizeCostMultiplier;
+        // Shared by the threads creating chunks to keep content files open between chunks
+        ESM::ReadersCache mReaders;
 
         std::mutex mRefTrackerMutex;
         struct RefTracker
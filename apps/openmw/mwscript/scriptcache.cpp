@@ -0,0 +1,103 @@
+#include "scriptcache.hpp"
+
+#include <components/compiler/extensions.hpp>
+#include <components/esm3/loadscpt.hpp>
+#include <components/files/cachefile.hpp>
+#include <components/files/conversion.hpp>
+#include <components/files/hash.hpp>
+#include <components/version/version.hpp>
+
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <string_view>
+
+namespace MWScript
+{
+    namespace
+    {
+        constexpr std::uint32_t scriptCacheMagic = 0x4353574d; // MWSC
+        constexpr std::uint32_t scriptCacheVersion = 1;
+        constexpr char localTypes[] = { 's', 'l', 'f' };
+
+        ScriptHash getHash(std::string_view name, const std::string& value)
+        {
+            std::istringstream stream(value);
+            return Files::getHash(name, stream);
+        }
+    }
+
+    ScriptHash getScriptSourceHash(const ESM::Script& script)
+    {
+        return getHash(script.mId.getRefIdString(), script.mScriptText);
+    }
+
+    ScriptHash makeScriptCacheKey(
+        const Compiler::Extensions& extensions, const std::vector<std::filesystem::path>& contentFiles)
+    {
+        // Opcodes are assigned by the build, keywords are listed to detect differently registered extensions
+        std::ostringstream key;
+        key << Version::getVersion() << ' ' << Version::getCommitHash() << '\n';
+        std::vector<std::string> keywords;
+        extensions.listKeywords(keywords);
+        for (const std::string& keyword : keywords)
+            key << keyword << '\n';
+        for (const std::filesystem::path& path : contentFiles)
+            key << Files::pathToUnicodeString(path.filename()) << ' ' << std::filesystem::file_size(path) << ' '
+                << std::filesystem::last_write_time(path).time_since_epoch().count() << '\n';
+        return getHash("script cache key", key.str());
+    }
+
+    std::optional<CachedScripts> readScriptCache(const std::filesystem::path& path, const ScriptHash& key)
+    {
+        std::ifstream stream(path, std::ios::binary);
+        if (!stream.is_open())
+            return std::nullopt;
+        if (Files::readValue<std::uint32_t>(stream) != scriptCacheMagic
+            || Files::readValue<std::uint32_t>(stream) != scriptCacheVersion)
+            return std::nullopt;
+        if (Files::readValue<std::uint64_t>(stream) != key[0] || Files::readValue<std::uint64_t>(stream) != key[1])
+            return std::nullopt;
+        CachedScripts scripts;
+        const std::uint64_t count = Files::readValue<std::uint64_t>(stream);
+        scripts.reserve(static_cast<std::size_t>(count));
+        for (std::uint64_t i = 0; i < count; ++i)
+        {
+            ESM::RefId id = ESM::RefId::deserializeText(Files::readString(stream));
+            CachedScript& script = scripts[id];
+            script.mSourceHash[0] = Files::readValue<std::uint64_t>(stream);
+            script.mSourceHash[1] = Files::readValue<std::uint64_t>(stream);
+            for (const char type : localTypes)
+                for (const std::string& name : Files::readStrings(stream))
+                    script.mLocals.declare(type, name);
+            script.mProgram.mInstructions = Files::readValues<Interpreter::Type_Code>(stream);
+            script.mProgram.mIntegers = Files::readValues<Interpreter::Type_Integer>(stream);
+            script.mProgram.mFloats = Files::readValues<Interpreter::Type_Float>(stream);
+            script.mProgram.mStrings = Files::readStrings(stream);
+        }
+        return scripts;
+    }
+
+    void writeScriptCache(const std::filesystem::path& path, const ScriptHash& key, const CachedScripts& scripts)
+    {
+        Files::writeCacheFile(path, [&](std::ostream& stream) {
+            Files::writeValue(stream, scriptCacheMagic);
+            Files::writeValue(stream, scriptCacheVersion);
+            Files::writeValue(stream, key[0]);
+            Files::writeValue(stream, key[1]);
+            Files::writeValue(stream, static_cast<std::uint64_t>(scripts.size()));
+            for (const auto& [id, script] : scripts)
+            {
+                Files::writeString(stream, id.serializeText());
+                Files::writeValue(stream, script.mSourceHash[0]);
+                Files::writeValue(stream, script.mSourceHash[1]);
+                for (const char type : localTypes)
+                    Files::writeStrings(stream, script.mLocals.get(type));
+                Files::writeValues(stream, script.mProgram.mInstructions);
+                Files::writeValues(stream, script.mProgram.mIntegers);
+                Files::writeValues(stream, script.mProgram.mFloats);
+                Files::writeStrings(stream, script.mProgram.mStrings);
+            }
+        });
+    }
+}
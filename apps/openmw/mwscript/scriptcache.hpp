@@ -0,0 +1,53 @@
+#ifndef GAME_SCRIPT_SCRIPTCACHE_H
+#define GAME_SCRIPT_SCRIPTCACHE_H
+
+#include <components/compiler/locals.hpp>
+#include <components/esm/refid.hpp>
+#include <components/interpreter/program.hpp>
+
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+namespace ESM
+{
+    class Script;
+}
+
+namespace Compiler
+{
+    class Extensions;
+}
+
+namespace MWScript
+{
+    using ScriptHash = std::array<std::uint64_t, 2>;
+
+    /// Compiled script together with the hash of the source it was compiled from.
+    struct CachedScript
+    {
+        ScriptHash mSourceHash;
+        Interpreter::Program mProgram;
+        Compiler::Locals mLocals;
+    };
+
+    using CachedScripts = std::unordered_map<ESM::RefId, CachedScript>;
+
+    ScriptHash getScriptSourceHash(const ESM::Script& script);
+
+    /// Compiled code depends on the opcodes of the extensions and on the records of the content files the compiler
+    /// looks up (global variables, object ids and local variables of other scripts), so all of them form the key.
+    /// Content files are identified by name, size and last write time.
+    ScriptHash makeScriptCacheKey(
+        const Compiler::Extensions& extensions, const std::vector<std::filesystem::path>& contentFiles);
+
+    /// @return Cached scripts if they were written with the same key, std::nullopt otherwise.
+    std::optional<CachedScripts> readScriptCache(const std::filesystem::path& path, const ScriptHash& key);
+
+    void writeScriptCache(const std::filesystem::path& path, const ScriptHash& key, const CachedScripts& scripts);
+}
+
+#endif
@@ -1,8 +1,10 @@
 #include "scriptmanagerimp.hpp"
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <exception>
+#include <optional>
 #include <sstream>
 
 #include <components/debug/debuglog.hpp>
@@ -10,8 +12,11 @@
 #include <components/esm/refid.hpp>
 #include <components/esm3/loadscpt.hpp>
 
+#include <components/misc/jobsystem.hpp>
 #include <components/misc/strings/lower.hpp>
 
+#include <components/settings/values.hpp>
+
 #include <components/compiler/context.hpp>
 #include <components/compiler/exception.hpp>
 #include <components/compiler/quickfileparser.hpp>
@@ -19,42 +24,31 @@
 
 #include "../mwworld/esmstore.hpp"
 
+#include "compilercontext.hpp"
 #include "extensions.hpp"
 #include "interpretercontext.hpp"
 
 namespace MWScript
 {
-    ScriptManager::ScriptManager(const MWWorld::ESMStore& store, Compiler::Context& compilerContext, int warningsMode)
-        : mErrorHandler()
-        , mStore(store)
-        , mCompilerContext(compilerContext)
-        , mParser(mErrorHandler, mCompilerContext)
-        , mGlobalScripts(store)
-    {
-        installOpcodes(mInterpreter);
-
-        mErrorHandler.setWarningsMode(warningsMode);
-    }
-
-    bool ScriptManager::compile(const ESM::RefId& name)
+    namespace
     {
-        mParser.reset();
-        mErrorHandler.reset();
-
-        if (const ESM::Script* script = mStore.get<ESM::Script>().find(name))
+        std::optional<CachedScript> compileScript(const ESM::Script& script, Compiler::StreamErrorHandler& errorHandler,
+            Compiler::FileParser& parser, const Compiler::Extensions* extensions)
         {
-            mErrorHandler.setContext(script->mId.getRefIdString());
+            parser.reset();
+            errorHandler.reset();
+            errorHandler.setContext(script.mId.getRefIdString());
 
             bool success = true;
             try
             {
-                std::istringstream input(script->mScriptText);
+                std::istringstream input(script.mScriptText);
 
-                Compiler::Scanner scanner(mErrorHandler, input, mCompilerContext.getExtensions());
+                Compiler::Scanner scanner(errorHandler, input, extensions);
 
-                scanner.scan(mParser);
+                scanner.scan(parser);
 
-                if (!mErrorHandler.isGood())
+                if (!errorHandler.isGood())
                     success = false;
             }
             catch (const Compiler::SourceException&)
@@ -70,12 +64,107 @@ namespace MWScript
 
             if (!success)
             {
-                Log(Debug::Error) << "Error: script compiling failed: " << name;
+                Log(Debug::Error) << "Error: script compiling failed: " << script.mId;
+                return std::nullopt;
+            }
+
+            return CachedScript{
+                .mSourceHash = getScriptSourceHash(script),
+                .mProgram = parser.getProgram(),
+                .mLocals = parser.getLocals(),
+            };
+        }
+    }
+
+    ScriptManager::ScriptManager(const MWWorld::ESMStore& store, Compiler::Context& compilerContext, int warningsMode)
+        : mErrorHandler()
+        , mStore(store)
+        , mCompilerContext(compilerContext)
+        , mParser(mErrorHandler, mCompilerContext)
+        , mWarningsMode(warningsMode)
+        , mGlobalScripts(store)
+    {
+        installOpcodes(mInterpreter);
+
+        mErrorHandler.setWarningsMode(warningsMode);
+    }
+
+    void ScriptManager::loadCache(const std::filesystem::path& path, const ScriptHash& key)
+    {
+        mCachePath = path;
+        mCacheKey = key;
+        mCacheChanged = false;
+        mCache.clear();
+
+        try
+        {
+            if (std::optional<CachedScripts> cache = readScriptCache(path, key))
+                mCache = std::move(*cache);
+        }
+        catch (const std::exception& e)
+        {
+            Log(Debug::Warning) << "Failed to read compiled scripts cache " << path << ": " << e.what();
+        }
+
+        const std::size_t size = mCache.size();
+        std::erase_if(mCache, [&](const auto& v) {
+            const ESM::Script* script = mStore.get<ESM::Script>().search(v.first);
+            return script == nullptr || getScriptSourceHash(*script) != v.second.mSourceHash;
+        });
+        mCacheChanged = mCache.size() != size;
+
+        Log(Debug::Verbose) << "Using " << mCache.size() << " compiled scripts from cache " << path;
+    }
+
+    void ScriptManager::saveCache()
+    {
+        if (mCachePath.empty() || !mCacheChanged)
+            return;
+
+        try
+        {
+            writeScriptCache(mCachePath, mCacheKey, mCache);
+            mCacheChanged = false;
+        }
+        catch (const std::exception& e)
+        {
+            Log(Debug::Warning) << "Failed to write compiled scripts cache " << mCachePath << ": " << e.what();
+        }
+    }
+
+    void ScriptManager::addCompiledScript(const ESM::RefId& name, const CachedScript& script)
+    {
+        Interpreter::Program program = script.mProgram;
+        std::vector<Interpreter::PreparedInstruction> instructions = mInterpreter.prepare(program);
+        mScripts.emplace(name, CompiledScript(std::move(program), std::move(instructions), script.mLocals));
+    }
+
+    void ScriptManager::addToCache(const ESM::RefId& name, CachedScript&& script)
+    {
+        if (mCachePath.empty())
+            return;
+
+        mCache.insert_or_assign(name, std::move(script));
+        mCacheChanged = true;
+    }
+
+    bool ScriptManager::compile(const ESM::RefId& name)
+    {
+        if (const ESM::Script* script = mStore.get<ESM::Script>().find(name))
+        {
+            if (const auto it = mCache.find(name); it != mCache.end())
+            {
+                addCompiledScript(name, it->second);
+                return true;
             }
 
-            if (success)
+            std::optional<CachedScript> compiled
+                = compileScript(*script, mErrorHandler, mParser, mCompilerContext.getExtensions());
+
+            if (compiled.has_value())
             {
-                mScripts.emplace(name, CompiledScript(mParser.getProgram(), mParser.getLocals()));
+                addCompiledScript(name, *compiled);
+                addToCache(name, std::move(*compiled));
 
                 return true;
             }
@@ -94,7 +183,7 @@ namespace MWScript
             if (!compile(name))
             {
                 // failed -> ignore script from now on.
-                mScripts.emplace(name, CompiledScript({}, Compiler::Locals()));
+                mScripts.emplace(name, CompiledScript({}, {}, Compiler::Locals()));
                 return false;
             }
 
@@ -109,7 +198,7 @@ namespace MWScript
         {
             try
             {
-                mInterpreter.run(iter->second.mProgram, interpreterContext);
+                mInterpreter.run(iter->second.mProgram, iter->second.mInstructions, interpreterContext);
                 return true;
             }
             catch (const MissingImplicitRefError& e)
@@ -141,14 +230,53 @@ namespace MWScript
         int count = 0;
         int success = 0;
 
+        std::vector<const ESM::Script*> scripts;
+
         for (auto& script : mStore.get<ESM::Script>())
         {
             ++count;
 
-            if (compile(script.mId))
-                ++success;
+            if (mCache.contains(script.mId))
+            {
+                if (compile(script.mId))
+                    ++success;
+            }
+            else
+                scripts.push_back(&script);
         }
 
+        std::vector<std::optional<CachedScript>> compiled(scripts.size());
+
+        {
+            Misc::JobSystem jobSystem(static_cast<std::size_t>(Settings::general().mScriptCompilingThreads));
+            std::atomic<std::size_t> next{ 0 };
+
+            // Each job has own compiler context, error handler and parser and takes scripts until none are left
+            jobSystem.parallelFor(jobSystem.getThreadCount() + 1, [&](std::size_t /*job*/) {
+                CompilerContext compilerContext(CompilerContext::Type_Full);
+                compilerContext.setExtensions(mCompilerContext.getExtensions());
+                Compiler::StreamErrorHandler errorHandler;
+                errorHandler.setWarningsMode(mWarningsMode);
+                Compiler::FileParser parser(errorHandler, compilerContext);
+
+                for (std::size_t i = next++; i < scripts.size(); i = next++)
+                    compiled[i] = compileScript(*scripts[i], errorHandler, parser, compilerContext.getExtensions());
+            });
+        }
+
+        for (std::size_t i = 0; i < scripts.size(); ++i)
+        {
+            if (!compiled[i].has_value())
+                continue;
+
+            ++success;
+
+            addCompiledScript(scripts[i]->mId, *compiled[i]);
+            addToCache(scripts[i]->mId, std::move(*compiled[i]));
+        }
+
+        saveCache();
+
         return std::make_pair(count, success);
     }
 
@@ -162,6 +290,15 @@ namespace MWScript
         }
 
         {
+            auto iter = mCache.find(name);
+
+            if (iter != mCache.end())
+                return iter->second.mLocals;
+        }
+
+        {
+            const std::lock_guard lock(mOtherLocalsMutex);
+
             auto iter = mOtherLocals.find(name);
 
             if (iter != mOtherLocals.end())
@@ -172,11 +309,14 @@ namespace MWScript
         {
             Compiler::Locals locals;
 
-            const Compiler::ContextOverride override(mErrorHandler, name.getRefIdString() + "[local variables]");
+            // Scripts may be compiled on multiple threads, so don't share the error handler
+            Compiler::StreamErrorHandler errorHandler;
+            errorHandler.setWarningsMode(mWarningsMode);
+            errorHandler.setContext(name.getRefIdString() + "[local variables]");
 
             std::istringstream stream(script->mScriptText);
-            Compiler::QuickFileParser parser(mErrorHandler, mCompilerContext, locals);
-            Compiler::Scanner scanner(mErrorHandler, stream, mCompilerContext.getExtensions());
+            Compiler::QuickFileParser parser(errorHandler, mCompilerContext, locals);
+            Compiler::Scanner scanner(errorHandler, stream, mCompilerContext.getExtensions());
             try
             {
                 scanner.scan(parser);
@@ -192,6 +332,8 @@ namespace MWScript
                 locals.clear();
             }
 
+            const std::lock_guard lock(mOtherLocalsMutex);
+
             auto iter = mOtherLocals.emplace(name, locals).first;
 
             return iter->second;
@@ -1,9 +1,12 @@
 #ifndef GAME_SCRIPT_SCRIPTMANAGER_H
 #define GAME_SCRIPT_SCRIPTMANAGER_H
 
+#include <filesystem>
 #include <map>
+#include <mutex>
 #include <set>
 #include <string>
+#include <vector>
 
 #include <components/compiler/fileparser.hpp>
 #include <components/compiler/streamerrorhandler.hpp>
@@ -16,6 +19,7 @@
 #include "../mwbase/scriptmanager.hpp"
 
 #include "globalscripts.hpp"
+#include "scriptcache.hpp"
 
 namespace MWWorld
 {
@@ -42,15 +46,19 @@ namespace MWScript
         Compiler::Context& mCompilerContext;
         Compiler::FileParser mParser;
         Interpreter::Interpreter mInterpreter;
+        int mWarningsMode;
 
         struct CompiledScript
         {
             Interpreter::Program mProgram;
+            std::vector<Interpreter::PreparedInstruction> mInstructions;
             Compiler::Locals mLocals;
             std::set<ESM::RefId> mInactive;
 
-            explicit CompiledScript(Interpreter::Program&& program, const Compiler::Locals& locals)
+            explicit CompiledScript(Interpreter::Program&& program,
+                std::vector<Interpreter::PreparedInstruction>&& instructions, const Compiler::Locals& locals)
                 : mProgram(std::move(program))
+                , mInstructions(std::move(instructions))
                 , mLocals(locals)
             {
             }
@@ -59,10 +67,25 @@ namespace MWScript
         std::unordered_map<ESM::RefId, CompiledScript> mScripts;
         GlobalScripts mGlobalScripts;
         std::unordered_map<ESM::RefId, Compiler::Locals> mOtherLocals;
+        std::mutex mOtherLocalsMutex;
+        CachedScripts mCache;
+        std::filesystem::path mCachePath;
+        ScriptHash mCacheKey{};
+        bool mCacheChanged = false;
+
+        void addCompiledScript(const ESM::RefId& name, const CachedScript& script);
+
+        void addToCache(const ESM::RefId& name, CachedScript&& script);
 
     public:
         ScriptManager(const MWWorld::ESMStore& store, Compiler::Context& compilerContext, int warningsMode);
 
+        /// Use compiled scripts stored in the file written with the same key and store newly compiled scripts there
+        /// on saveCache.
+        void loadCache(const std::filesystem::path& path, const ScriptHash& key);
+
+        void saveCache();
+
         void clear() override;
 
         bool run(const ESM::RefId& name, Interpreter::Context& interpreterContext) override;
@@ -73,11 +96,11 @@ namespace MWScript
         /// \return Success?
 
         std::pair<int, int> compileAll() override;
-        ///< Compile all scripts
+        ///< Compile all scripts using "script compiling threads" worker threads
         /// \return count, success
 
         const Compiler::Locals& getLocals(const ESM::RefId& name) override;
-        ///< Return locals for script \a name.
+        ///< Return locals for script \a name. Thread safe while no script is being added.
 
         GlobalScripts& getGlobalScripts() override;
 
@@ -1029,43 +1029,47 @@ namespace MWSound
         return ret;
     }
 
-    std::pair<Sound_Handle, size_t> OpenALOutput::loadSound(VFS::Path::NormalizedView fname)
+    DecodedSound OpenALOutput::decodeSound(VFS::Path::NormalizedView fname)
     {
-        getALError();
-
-        std::vector<char> data;
-        ALenum format = AL_NONE;
-        int srate = 0;
+        DecodedSound result;
 
         try
         {
             DecoderPtr decoder = mManager.getDecoder();
             decoder->open(Misc::ResourceHelpers::correctSoundPath(fname, *decoder->mResourceMgr));
-
-            ChannelConfig chans;
-            SampleType type;
-            decoder->getInfo(&srate, &chans, &type);
-            format = getALFormat(chans, type);
-            if (format)
-                decoder->readAll(data);
+            decoder->getInfo(&result.mSampleRate, &result.mChannelConfig, &result.mSampleType);
+            decoder->readAll(result.mData);
         }
         catch (std::exception& e)
         {
             Log(Debug::Error) << "Failed to load audio from " << fname << ": " << e.what();
+            result.mData.clear();
         }
 
-        if (data.empty())
+        return result;
+    }
+
+    std::pair<Sound_Handle, size_t> OpenALOutput::loadSound(DecodedSound&& sound)
+    {
+        getALError();
+
+        ALenum format = AL_NONE;
+        int srate = sound.mSampleRate;
+        if (!sound.mData.empty())
+            format = getALFormat(sound.mChannelConfig, sound.mSampleType);
+
+        if (format == AL_NONE)
         {
             // If we failed to get any usable audio, substitute with silence.
             format = AL_FORMAT_MONO8;
             srate = 8000;
-            data.assign(8000, -128);
+            sound.mData.assign(8000, -128);
         }
 
         ALint size;
         ALuint buf = 0;
         alGenBuffers(1, &buf);
-        alBufferData(buf, format, data.data(), static_cast<ALsizei>(data.size()), srate);
+        alBufferData(buf, format, sound.mData.data(), static_cast<ALsizei>(sound.mData.size()), srate);
         alGetBufferi(buf, AL_SIZE, &size);
         if (getALError() != AL_NO_ERROR)
         {
@@ -1077,6 +1081,11 @@ namespace MWSound
         return std::make_pair(MAKE_PTRID(buf), size);
     }
 
+    std::pair<Sound_Handle, size_t> OpenALOutput::loadSound(VFS::Path::NormalizedView fname)
+    {
+        return loadSound(decodeSound(fname));
+    }
+
     size_t OpenALOutput::unloadSound(Sound_Handle data)
     {
         ALuint buffer = GET_PTRID(data);
@@ -88,6 +88,8 @@ namespace MWSound
 
         std::vector<std::string> enumerateHrtf() override;
 
+        DecodedSound decodeSound(VFS::Path::NormalizedView fname) override;
+        std::pair<Sound_Handle, size_t> loadSound(DecodedSound&& sound) override;
         std::pair<Sound_Handle, size_t> loadSound(VFS::Path::NormalizedView fname) override;
         size_t unloadSound(Sound_Handle data) override;
 
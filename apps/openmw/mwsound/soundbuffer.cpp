@@ -47,6 +47,12 @@ namespace MWSound
         , mBufferCacheMin(
               std::min(static_cast<std::size_t>(Settings::sound().mBufferCacheMin) * 1024 * 1024, mBufferCacheMax))
     {
+        const int threads = Settings::sound().mAsyncLoadingThreads;
+        if (threads > 0)
+        {
+            mDecodeJobs = std::make_unique<Misc::JobSystem>(static_cast<std::size_t>(threads));
+            Log(Debug::Info) << "Decoding sounds in " << threads << " threads";
+        }
     }
 
     SoundBufferPool::~SoundBufferPool()
@@ -78,12 +84,51 @@ namespace MWSound
         return nullptr;
     }
 
+    SoundBuffer* SoundBufferPool::search(const ESM::RefId& soundId) const
+    {
+        const auto it = mBufferNameMap.find(soundId);
+        if (it == mBufferNameMap.end())
+            return nullptr;
+        return it->second;
+    }
+
+    SoundBuffer* SoundBufferPool::search(VFS::Path::NormalizedView fileName) const
+    {
+        const auto it = mBufferFileNameMap.find(fileName);
+        if (it == mBufferFileNameMap.end())
+            return nullptr;
+        return it->second;
+    }
+
     SoundBuffer* SoundBufferPool::loadSfx(SoundBuffer* sfx)
     {
         if (sfx->getHandle() != nullptr)
             return sfx;
 
-        auto [handle, size] = mOutput->loadSound(sfx->getResourceName());
+        return addLoaded(sfx, mOutput->loadSound(sfx->getResourceName()));
+    }
+
+    SoundBuffer* SoundBufferPool::loadSfxAsync(SoundBuffer* sfx)
+    {
+        if (mDecodeJobs == nullptr)
+            return loadSfx(sfx);
+
+        if (sfx->getHandle() != nullptr || sfx->mLoading)
+            return sfx;
+
+        sfx->mLoading = true;
+        mDecodeJobs->run(mDecodeGroup, [this, sfx] {
+            DecodedSound sound = mOutput->decodeSound(sfx->getResourceName());
+            const std::lock_guard lock(mDecodedMutex);
+            mDecoded.push_back(DecodedBuffer{ sfx, std::move(sound) });
+        });
+
+        return sfx;
+    }
+
+    SoundBuffer* SoundBufferPool::addLoaded(SoundBuffer* sfx, std::pair<Sound_Handle, size_t> loaded, bool pin)
+    {
+        auto [handle, size] = loaded;
         if (handle == nullptr)
             return {};
 
@@ -96,12 +141,18 @@ namespace MWSound
             if (!mUnusedBuffers.empty() && mBufferCacheSize > mBufferCacheMax)
                 Log(Debug::Warning) << "No unused sound buffers to free, using " << mBufferCacheSize << " bytes!";
         }
-        mUnusedBuffers.push_front(sfx);
+        if (pin && sfx->mUses == 0)
+        {
+            sfx->mPinned = true;
+            mPinnedBuffers.push_back(sfx);
+        }
+        else
+            mUnusedBuffers.push_front(sfx);
 
         return sfx;
     }
 
-    SoundBuffer* SoundBufferPool::load(const ESM::RefId& soundId)
+    SoundBuffer* SoundBufferPool::find(const ESM::RefId& soundId)
     {
         if (mBufferNameMap.empty())
         {
@@ -114,45 +165,94 @@ namespace MWSound
                 insertSound(sound.mId, sound);
         }
 
-        SoundBuffer* sfx;
         const auto it = mBufferNameMap.find(soundId);
         if (it != mBufferNameMap.end())
-            sfx = it->second;
-        else
-        {
-            const ESM::Sound* sound = MWBase::Environment::get().getESMStore()->get<ESM::Sound>().search(soundId);
-            if (sound == nullptr)
-                return {};
-            sfx = insertSound(soundId, *sound);
-        }
+            return it->second;
 
-        return loadSfx(sfx);
+        const ESM::Sound* sound = MWBase::Environment::get().getESMStore()->get<ESM::Sound>().search(soundId);
+        if (sound == nullptr)
+            return {};
+        return insertSound(soundId, *sound);
     }
 
-    SoundBuffer* SoundBufferPool::load(VFS::Path::NormalizedView fileName)
+    SoundBuffer* SoundBufferPool::find(VFS::Path::NormalizedView fileName)
     {
-        SoundBuffer* sfx;
         const auto it = mBufferFileNameMap.find(fileName);
         if (it != mBufferFileNameMap.end())
-            sfx = it->second;
-        else
-            sfx = insertSound(fileName);
+            return it->second;
+        return insertSound(fileName);
+    }
 
+    SoundBuffer* SoundBufferPool::load(const ESM::RefId& soundId)
+    {
+        SoundBuffer* const sfx = find(soundId);
+        if (sfx == nullptr)
+            return {};
         return loadSfx(sfx);
     }
 
+    SoundBuffer* SoundBufferPool::load(VFS::Path::NormalizedView fileName)
+    {
+        return loadSfx(find(fileName));
+    }
+
+    SoundBuffer* SoundBufferPool::loadAsync(const ESM::RefId& soundId)
+    {
+        SoundBuffer* const sfx = find(soundId);
+        if (sfx == nullptr)
+            return {};
+        return loadSfxAsync(sfx);
+    }
+
+    SoundBuffer* SoundBufferPool::loadAsync(VFS::Path::NormalizedView fileName)
+    {
+        return loadSfxAsync(find(fileName));
+    }
+
+    void SoundBufferPool::update()
+    {
+        if (mDecodeJobs == nullptr)
+            return;
+
+        {
+            const std::lock_guard lock(mDecodedMutex);
+            std::swap(mDecoded, mLoading);
+        }
+
+        for (DecodedBuffer& decoded : mLoading)
+        {
+            SoundBuffer* const sfx = decoded.mSfx;
+            sfx->mLoading = false;
+            // The sound could be loaded synchronously meanwhile
+            if (sfx->getHandle() == nullptr)
+                addLoaded(sfx, mOutput->loadSound(std::move(decoded.mSound)), true);
+        }
+
+        mLoading.clear();
+    }
+
     void SoundBufferPool::clear()
     {
+        if (mDecodeJobs != nullptr)
+        {
+            mDecodeJobs->wait(mDecodeGroup);
+            const std::lock_guard lock(mDecodedMutex);
+            mDecoded.clear();
+        }
+
         for (auto& sfx : mSoundBuffers)
         {
             if (sfx.mHandle)
                 mOutput->unloadSound(sfx.mHandle);
             sfx.mHandle = nullptr;
+            sfx.mLoading = false;
+            sfx.mPinned = false;
         }
 
         mBufferFileNameMap.clear();
         mBufferNameMap.clear();
         mUnusedBuffers.clear();
+        mPinnedBuffers.clear();
     }
 
     SoundBuffer* SoundBufferPool::insertSound(VFS::Path::NormalizedView fileName)
@@ -232,5 +332,17 @@ namespace MWSound
 
             mUnusedBuffers.pop_back();
         }
+
+        // Prefer to keep preloaded buffers until they are played but don't let them exceed the limit
+        while (!mPinnedBuffers.empty() && mBufferCacheSize > mBufferCacheMax)
+        {
+            SoundBuffer* const pinned = mPinnedBuffers.front();
+
+            mBufferCacheSize -= mOutput->unloadSound(pinned->getHandle());
+            pinned->mHandle = nullptr;
+            pinned->mPinned = false;
+
+            mPinnedBuffers.pop_front();
+        }
     }
 }
@@ -3,9 +3,13 @@
 
 #include <algorithm>
 #include <deque>
+#include <memory>
+#include <mutex>
 #include <unordered_map>
+#include <vector>
 
 #include <components/esm/refid.hpp>
+#include <components/misc/jobsystem.hpp>
 #include <components/vfs/pathutil.hpp>
 
 #include "soundoutput.hpp"
@@ -59,6 +63,9 @@ namespace MWSound
         float mMaxDist;
         Sound_Handle mHandle = nullptr;
         std::size_t mUses = 0;
+        bool mLoading = false;
+        // Loaded in background and not used yet
+        bool mPinned = false;
 
         friend class SoundBufferPool;
     };
@@ -87,13 +94,36 @@ namespace MWSound
         // Lookup for a sound by file name, and ensure it's ready for use.
         SoundBuffer* load(VFS::Path::NormalizedView fileName);
 
+        /// Lookup a soundId for its sound data, and start loading it in background when async loading is enabled.
+        /// The returned sound is not ready for use while isLoading is true.
+        SoundBuffer* loadAsync(const ESM::RefId& soundId);
+
+        /// Lookup for a sound by file name, and start loading it in background when async loading is enabled.
+        /// The returned sound is not ready for use while isLoading is true.
+        SoundBuffer* loadAsync(VFS::Path::NormalizedView fileName);
+
+        /// Lookup a soundId for its sound data whether it's ready for use or not
+        SoundBuffer* search(const ESM::RefId& soundId) const;
+
+        /// Lookup a sound by file name for its sound data whether it's ready for use or not
+        SoundBuffer* search(VFS::Path::NormalizedView fileName) const;
+
+        bool isAsync() const { return mDecodeJobs != nullptr; }
+
+        bool isLoading(const SoundBuffer& sfx) const { return sfx.mLoading; }
+
+        /// Make sounds decoded in background ready for use, to be called from the main thread.
+        void update();
+
         void use(SoundBuffer& sfx)
         {
             if (sfx.mUses++ == 0)
             {
-                const auto it = std::find(mUnusedBuffers.begin(), mUnusedBuffers.end(), &sfx);
-                if (it != mUnusedBuffers.end())
-                    mUnusedBuffers.erase(it);
+                std::deque<SoundBuffer*>& buffers = sfx.mPinned ? mPinnedBuffers : mUnusedBuffers;
+                sfx.mPinned = false;
+                const auto it = std::find(buffers.begin(), buffers.end(), &sfx);
+                if (it != buffers.end())
+                    buffers.erase(it);
             }
         }
 
@@ -106,7 +136,18 @@ namespace MWSound
         void clear();
 
     private:
+        struct DecodedBuffer
+        {
+            SoundBuffer* mSfx;
+            DecodedSound mSound;
+        };
+
+        SoundBuffer* find(const ESM::RefId& soundId);
+        SoundBuffer* find(VFS::Path::NormalizedView fileName);
+
         SoundBuffer* loadSfx(SoundBuffer* sfx);
+        SoundBuffer* loadSfxAsync(SoundBuffer* sfx);
+        SoundBuffer* addLoaded(SoundBuffer* sfx, std::pair<Sound_Handle, size_t> loaded, bool pin = false);
 
         SoundOutput* mOutput;
         std::deque<SoundBuffer> mSoundBuffers;
@@ -117,6 +158,15 @@ namespace MWSound
         std::size_t mBufferCacheSize = 0;
         // NOTE: unused buffers are stored in front-newest order.
         std::deque<SoundBuffer*> mUnusedBuffers;
+        // NOTE: buffers loaded in background are kept until their first use in oldest-front order, unless the
+        // cache can't fit into the max size without evicting them.
+        std::deque<SoundBuffer*> mPinnedBuffers;
+        std::mutex mDecodedMutex;
+        std::vector<DecodedBuffer> mDecoded;
+        std::vector<DecodedBuffer> mLoading;
+        Misc::JobGroup mDecodeGroup;
+        // Declared last to finish decoding before anything else is destroyed
+        std::unique_ptr<Misc::JobSystem> mDecodeJobs;
 
         SoundBuffer* insertSound(const ESM::RefId& soundId, const ESM::Sound& sound);
         SoundBuffer* insertSound(const ESM::RefId& soundId, const ESM4::Sound& sound);
@@ -4,10 +4,14 @@
 #include <map>
 #include <numeric>
 #include <sstream>
+#include <unordered_set>
 
 #include <osg/Matrixf>
 
 #include <components/debug/debuglog.hpp>
+#include <components/esm3/loadcrea.hpp>
+#include <components/esm3/loadregn.hpp>
+#include <components/esm3/loadsndg.hpp>
 #include <components/misc/resourcehelpers.hpp>
 #include <components/misc/rng.hpp>
 #include <components/settings/values.hpp>
@@ -41,6 +45,8 @@ namespace MWSound
         constexpr float sSfxFadeInDuration = 1.0f;
         constexpr float sSfxFadeOutDuration = 1.0f;
         constexpr float sSoundCullDistance = 2000.f;
+        // Sounds decoded later are not played to avoid them being noticeably out of sync
+        constexpr float sMaxPendingSoundAge = 0.25f;
 
         WaterSoundUpdaterSettings makeWaterSoundUpdaterSettings()
         {
@@ -495,10 +501,21 @@ namespace MWSound
         if (!mVFS->exists(fileName))
             return nullptr;
 
-        SoundBuffer* const sfx = mSoundBuffers.load(fileName);
+        SoundBuffer* const sfx = loadSoundBuffer(fileName, mode);
         if (!sfx)
             return nullptr;
 
+        if (sfx->getHandle() == nullptr)
+        {
+            addPendingSound({ .mSfx = sfx,
+                .mVolume = volume,
+                .mPitch = pitch,
+                .mType = type,
+                .mMode = mode,
+                .mOffset = offset });
+            return nullptr;
+        }
+
         return playSound(sfx, volume, pitch, type, mode, offset);
     }
 
@@ -508,10 +525,21 @@ namespace MWSound
         if (!mOutput->isInitialized())
             return nullptr;
 
-        SoundBuffer* sfx = mSoundBuffers.load(soundId);
+        SoundBuffer* sfx = loadSoundBuffer(soundId, mode);
         if (!sfx)
             return nullptr;
 
+        if (sfx->getHandle() == nullptr)
+        {
+            addPendingSound({ .mSfx = sfx,
+                .mVolume = volume,
+                .mPitch = pitch,
+                .mType = type,
+                .mMode = mode,
+                .mOffset = offset });
+            return nullptr;
+        }
+
         return playSound(sfx, volume, pitch, type, mode, offset);
     }
 
@@ -576,10 +604,22 @@ namespace MWSound
             return nullptr;
 
         // Look up the sound in the ESM data
-        SoundBuffer* sfx = mSoundBuffers.load(soundId);
+        SoundBuffer* sfx = loadSoundBuffer(soundId, mode);
         if (!sfx)
             return nullptr;
 
+        if (sfx->getHandle() == nullptr)
+        {
+            addPendingSound({ .mSfx = sfx,
+                .mPtr = ptr,
+                .mVolume = volume,
+                .mPitch = pitch,
+                .mType = type,
+                .mMode = mode,
+                .mOffset = offset });
+            return nullptr;
+        }
+
         return playSound3D(ptr, sfx, volume, pitch, type, mode, offset);
     }
 
@@ -593,10 +633,22 @@ namespace MWSound
         if (!mVFS->exists(fileName))
             return nullptr;
 
-        SoundBuffer* const sfx = mSoundBuffers.load(fileName);
+        SoundBuffer* const sfx = loadSoundBuffer(fileName, mode);
         if (!sfx)
             return nullptr;
 
+        if (sfx->getHandle() == nullptr)
+        {
+            addPendingSound({ .mSfx = sfx,
+                .mPtr = ptr,
+                .mVolume = volume,
+                .mPitch = pitch,
+                .mType = type,
+                .mMode = mode,
+                .mOffset = offset });
+            return nullptr;
+        }
+
         return playSound3D(ptr, sfx, volume, pitch, type, mode, offset);
     }
 
@@ -607,10 +659,28 @@ namespace MWSound
             return nullptr;
 
         // Look up the sound in the ESM data
-        SoundBuffer* sfx = mSoundBuffers.load(soundId);
+        SoundBuffer* sfx = loadSoundBuffer(soundId, mode);
         if (!sfx)
             return nullptr;
 
+        if (sfx->getHandle() == nullptr)
+        {
+            addPendingSound({ .mSfx = sfx,
+                .mPos = initialPos,
+                .mVolume = volume,
+                .mPitch = pitch,
+                .mType = type,
+                .mMode = mode,
+                .mOffset = offset });
+            return nullptr;
+        }
+
+        return playSound3D(initialPos, sfx, volume, pitch, type, mode, offset);
+    }
+
+    Sound* SoundManager::playSound3D(const osg::Vec3f& initialPos, SoundBuffer* sfx, float volume, float pitch,
+        Type type, PlayMode mode, float offset)
+    {
         const float squaredDist = (mListenerPos - initialPos).length2();
 
         SoundPtr sound = getSoundRef();
@@ -635,6 +705,76 @@ namespace MWSound
         return result;
     }
 
+    SoundBuffer* SoundManager::loadSoundBuffer(const ESM::RefId& soundId, PlayMode mode)
+    {
+        if (mode & PlayMode::Loop)
+            return mSoundBuffers.load(soundId);
+        return mSoundBuffers.loadAsync(soundId);
+    }
+
+    SoundBuffer* SoundManager::loadSoundBuffer(VFS::Path::NormalizedView fileName, PlayMode mode)
+    {
+        if (mode & PlayMode::Loop)
+            return mSoundBuffers.load(fileName);
+        return mSoundBuffers.loadAsync(fileName);
+    }
+
+    void SoundManager::addPendingSound(PendingSound&& sound)
+    {
+        // Only one copy of given sound can be played at time on an object, so replace previous request
+        if (!sound.mPos.has_value())
+        {
+            const auto it = std::find_if(mPendingSounds.begin(), mPendingSounds.end(), [&](const PendingSound& v) {
+                return v.mSfx == sound.mSfx && v.mPtr.mRef == sound.mPtr.mRef;
+            });
+            if (it != mPendingSounds.end())
+            {
+                *it = std::move(sound);
+                return;
+            }
+        }
+        mPendingSounds.push_back(std::move(sound));
+    }
+
+    void SoundManager::updatePendingSounds(float duration)
+    {
+        if (mPendingSounds.empty())
+            return;
+
+        std::vector<PendingSound> ready;
+        for (auto it = mPendingSounds.begin(); it != mPendingSounds.end();)
+        {
+            it->mAge += duration;
+            if (it->mSfx->getHandle() != nullptr)
+            {
+                ready.push_back(std::move(*it));
+                it = mPendingSounds.erase(it);
+            }
+            else if (!mSoundBuffers.isLoading(*it->mSfx) || it->mAge > sMaxPendingSoundAge)
+                it = mPendingSounds.erase(it);
+            else
+                ++it;
+        }
+
+        for (const PendingSound& sound : ready)
+        {
+            if (sound.mPos.has_value())
+                playSound3D(*sound.mPos, sound.mSfx, sound.mVolume, sound.mPitch, sound.mType, sound.mMode,
+                    sound.mOffset);
+            else if (sound.mPtr.isEmpty())
+                playSound(sound.mSfx, sound.mVolume, sound.mPitch, sound.mType, sound.mMode, sound.mOffset);
+            else if (!remove3DSoundAtDistance(sound.mMode, sound.mPtr))
+                playSound3D(sound.mPtr, sound.mSfx, sound.mVolume, sound.mPitch, sound.mType, sound.mMode,
+                    sound.mOffset);
+        }
+    }
+
+    bool SoundManager::hasPendingSound(SoundBuffer* sfx, const MWWorld::ConstPtr& ptr) const
+    {
+        return std::any_of(mPendingSounds.begin(), mPendingSounds.end(),
+            [&](const PendingSound& v) { return v.mSfx == sfx && v.mPtr.mRef == ptr.mRef; });
+    }
+
     void SoundManager::stopSound(Sound* sound)
     {
         if (sound)
@@ -643,6 +783,9 @@ namespace MWSound
 
     void SoundManager::stopSound(SoundBuffer* sfx, const MWWorld::ConstPtr& ptr)
     {
+        std::erase_if(mPendingSounds,
+            [&](const PendingSound& v) { return v.mSfx == sfx && v.mPtr.mRef == ptr.mRef && !v.mPos.has_value(); });
+
         SoundMap::iterator snditer = mActiveSounds.find(ptr.mRef);
         if (snditer != mActiveSounds.end())
         {
@@ -659,7 +802,7 @@ namespace MWSound
         if (!mOutput->isInitialized())
             return;
 
-        SoundBuffer* sfx = mSoundBuffers.lookup(soundId);
+        SoundBuffer* sfx = mSoundBuffers.search(soundId);
         if (!sfx)
             return;
 
@@ -671,7 +814,7 @@ namespace MWSound
         if (!mOutput->isInitialized())
             return;
 
-        SoundBuffer* const sfx = mSoundBuffers.lookup(fileName);
+        SoundBuffer* const sfx = mSoundBuffers.search(fileName);
         if (!sfx)
             return;
 
@@ -680,6 +823,9 @@ namespace MWSound
 
     void SoundManager::stopSound3D(const MWWorld::ConstPtr& ptr)
     {
+        std::erase_if(
+            mPendingSounds, [&](const PendingSound& v) { return v.mPtr.mRef == ptr.mRef && !v.mPos.has_value(); });
+
         SoundMap::iterator snditer = mActiveSounds.find(ptr.mRef);
         if (snditer != mActiveSounds.end())
         {
@@ -696,6 +842,10 @@ namespace MWSound
 
     void SoundManager::stopSound(const MWWorld::CellStore* cell)
     {
+        std::erase_if(mPendingSounds, [&](const PendingSound& v) {
+            return !v.mPtr.isEmpty() && v.mPtr.mRef != MWMechanics::getPlayer().mRef && v.mPtr.mCell == cell;
+        });
+
         for (auto& [ref, sound] : mActiveSounds)
         {
             if (ref != nullptr && ref != MWMechanics::getPlayer().mRef && sound.mCell == cell)
@@ -736,12 +886,16 @@ namespace MWSound
 
     bool SoundManager::getSoundPlaying(const MWWorld::ConstPtr& ptr, VFS::Path::NormalizedView fileName) const
     {
+        SoundBuffer* const sfx = mSoundBuffers.search(fileName);
+        if (!sfx)
+            return false;
+
+        if (hasPendingSound(sfx, ptr))
+            return true;
+
         SoundMap::const_iterator snditer = mActiveSounds.find(ptr.mRef);
         if (snditer != mActiveSounds.end())
         {
-            SoundBuffer* const sfx = mSoundBuffers.lookup(fileName);
-            if (!sfx)
-                return false;
 
             return std::find_if(snditer->second.mList.cbegin(), snditer->second.mList.cend(),
                        [this, sfx](const SoundBufferRefPair& snd) -> bool {
@@ -754,12 +908,16 @@ namespace MWSound
 
     bool SoundManager::getSoundPlaying(const MWWorld::ConstPtr& ptr, const ESM::RefId& soundId) const
     {
+        SoundBuffer* sfx = mSoundBuffers.search(soundId);
+        if (!sfx)
+            return false;
+
+        if (hasPendingSound(sfx, ptr))
+            return true;
+
         SoundMap::const_iterator snditer = mActiveSounds.find(ptr.mRef);
         if (snditer != mActiveSounds.end())
         {
-            SoundBuffer* sfx = mSoundBuffers.lookup(soundId);
-            if (!sfx)
-                return false;
 
             return std::find_if(snditer->second.mList.cbegin(), snditer->second.mList.cend(),
                        [this, sfx](const SoundBufferRefPair& snd) -> bool {
@@ -1099,6 +1257,8 @@ namespace MWSound
                 streamMusic(MWSound::titleMusic, MWSound::MusicType::Normal);
         }
 
+        mSoundBuffers.update();
+        updatePendingSounds(duration);
         updateSounds(duration);
         if (state != MWBase::StateManager::State_NoGame)
         {
@@ -1174,6 +1334,51 @@ namespace MWSound
 
         if (const auto it = mActiveSaySounds.find(old.mRef); it != mActiveSaySounds.end())
             it->second.mCell = updated.mCell;
+
+        for (PendingSound& sound : mPendingSounds)
+            if (sound.mPtr.mRef == old.mRef)
+                sound.mPtr = updated;
+    }
+
+    void SoundManager::preloadSounds(const MWWorld::CellStore& cell)
+    {
+        if (!mOutput->isInitialized() || !mSoundBuffers.isAsync())
+            return;
+
+        const MWWorld::ESMStore& store = *MWBase::Environment::get().getESMStore();
+
+        if (const ESM::Region* region = store.get<ESM::Region>().search(cell.getCell()->getRegion()))
+            for (const ESM::Region::SoundRef& sound : region->mSoundList)
+                mSoundBuffers.loadAsync(sound.mSound);
+
+        std::unordered_set<ESM::RefId> creatures;
+        const auto addCreature = [&](const ESM::Creature& creature) {
+            creatures.insert(creature.mOriginal.empty() ? creature.mId : creature.mOriginal);
+        };
+
+        // References are not loaded yet for a cell being preloaded, only their ids are known
+        if (cell.getState() == MWWorld::CellStore::State_Loaded)
+        {
+            cell.forEachConst([&](const MWWorld::ConstPtr& ptr) {
+                if (ptr.getType() == ESM::Creature::sRecordId)
+                    addCreature(*ptr.get<ESM::Creature>()->mBase);
+                return true;
+            });
+        }
+        else if (cell.getState() == MWWorld::CellStore::State_Preloaded)
+        {
+            const MWWorld::Store<ESM::Creature>& creatureStore = store.get<ESM::Creature>();
+            for (const ESM::RefId& id : cell.getPreloadedIds())
+                if (const ESM::Creature* creature = creatureStore.search(id))
+                    addCreature(*creature);
+        }
+
+        if (creatures.empty())
+            return;
+
+        for (const ESM::SoundGenerator& soundGenerator : store.get<ESM::SoundGenerator>())
+            if (creatures.contains(soundGenerator.mCreature))
+                mSoundBuffers.loadAsync(soundGenerator.mSound);
     }
 
     // Default readAll implementation, for decoders that can't do anything
@@ -1278,6 +1483,7 @@ namespace MWSound
             }
         }
         mActiveSounds.clear();
+        mPendingSounds.clear();
         mUnderwaterSound = nullptr;
         mNearWaterSound = nullptr;
 
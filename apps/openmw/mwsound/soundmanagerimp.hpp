@@ -3,9 +3,11 @@
 
 #include <map>
 #include <memory>
+#include <optional>
 #include <string>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include <components/fallback/fallback.hpp>
 #include <components/misc/objectpool.hpp>
@@ -82,6 +84,23 @@ namespace MWSound
         SaySoundMap mSaySoundsQueue;
         SaySoundMap mActiveSaySounds;
 
+        // Sound waiting for its buffer to be decoded in background
+        struct PendingSound
+        {
+            SoundBuffer* mSfx;
+            // Empty for sounds without an object
+            MWWorld::ConstPtr mPtr;
+            std::optional<osg::Vec3f> mPos;
+            float mVolume;
+            float mPitch;
+            Type mType;
+            PlayMode mMode;
+            float mOffset;
+            float mAge = 0;
+        };
+
+        std::vector<PendingSound> mPendingSounds;
+
         typedef std::vector<StreamPtr> TrackList;
         TrackList mActiveTracks;
 
@@ -131,6 +150,16 @@ namespace MWSound
             PlayMode mode = PlayMode::Normal, float offset = 0);
         Sound* playSound3D(const MWWorld::ConstPtr& ptr, SoundBuffer* sfx, float volume, float pitch, Type type,
             PlayMode mode, float offset);
+        Sound* playSound3D(const osg::Vec3f& initialPos, SoundBuffer* sfx, float volume, float pitch, Type type,
+            PlayMode mode, float offset);
+
+        // Looping sounds are usually kept by the caller to be stopped later so they are loaded immediately
+        SoundBuffer* loadSoundBuffer(const ESM::RefId& soundId, PlayMode mode);
+        SoundBuffer* loadSoundBuffer(VFS::Path::NormalizedView fileName, PlayMode mode);
+
+        void addPendingSound(PendingSound&& sound);
+        void updatePendingSounds(float duration);
+        bool hasPendingSound(SoundBuffer* sfx, const MWWorld::ConstPtr& ptr) const;
 
         void updateSounds(float duration);
         void updateRegionSound(float duration);
@@ -288,6 +317,8 @@ namespace MWSound
 
         void updatePtr(const MWWorld::ConstPtr& old, const MWWorld::ConstPtr& updated) override;
 
+        void preloadSounds(const MWWorld::CellStore& cell) override;
+
         void clear() override;
     };
 }
@@ -9,6 +9,7 @@
 #include <components/vfs/pathutil.hpp>
 
 #include "../mwbase/soundmanager.hpp"
+#include "sounddecoder.hpp"
 
 namespace MWSound
 {
@@ -30,6 +31,15 @@ namespace MWSound
 
     using HrtfMode = Settings::HrtfMode;
 
+    // Sample data of a whole sound file to be loaded into a sound buffer
+    struct DecodedSound
+    {
+        std::vector<char> mData;
+        int mSampleRate = 0;
+        ChannelConfig mChannelConfig = ChannelConfig_Mono;
+        SampleType mSampleType = SampleType_UInt8;
+    };
+
     class SoundOutput
     {
         SoundManager& mManager;
@@ -40,6 +50,9 @@ namespace MWSound
 
         virtual std::vector<std::string> enumerateHrtf() = 0;
 
+        // Can be called from any thread, empty data is returned on failure
+        virtual DecodedSound decodeSound(VFS::Path::NormalizedView fname) = 0;
+        virtual std::pair<Sound_Handle, size_t> loadSound(DecodedSound&& sound) = 0;
         virtual std::pair<Sound_Handle, size_t> loadSound(VFS::Path::NormalizedView fname) = 0;
         virtual size_t unloadSound(Sound_Handle data) = 0;
 
@@ -23,6 +23,8 @@
 #include <components/terrain/world.hpp>
 #include <components/vfs/manager.hpp>
 
+#include "../mwbase/environment.hpp"
+#include "../mwbase/soundmanager.hpp"
 #include "../mwrender/landmanager.hpp"
 
 #include "cellstore.hpp"
@@ -288,6 +290,8 @@ namespace MWWorld
 
         mPreloadCells.emplace(&cell, PreloadEntry(timestamp, item));
         ++mAdded;
+
+        MWBase::Environment::get().getSoundManager()->preloadSounds(cell);
     }
 
     void CellPreloader::notifyLoaded(CellStore* cell)
@@ -0,0 +1,135 @@
+#include "cellrefcache.hpp"
+
+#include <components/esm3/readerscache.hpp>
+#include <components/files/cachefile.hpp>
+#include <components/files/constrainedfilestream.hpp>
+#include <components/files/conversion.hpp>
+#include <components/files/hash.hpp>
+
+#include <algorithm>
+#include <fstream>
+#include <ostream>
+#include <string_view>
+
+namespace MWWorld
+{
+    namespace
+    {
+        constexpr std::uint32_t cellRefCacheMagic = 0x46455243; // CREF
+        constexpr std::uint32_t cellRefCacheVersion = 2;
+
+        void writeContent(std::ostream& stream, const std::vector<ContentFile>& content)
+        {
+            Files::writeValue(stream, static_cast<std::uint64_t>(content.size()));
+            for (const ContentFile& file : content)
+            {
+                Files::writeValue(stream, static_cast<std::uint64_t>(file.mIndex));
+                Files::writeString(stream, file.mName);
+                Files::writeValue(stream, file.mSize);
+                Files::writeValue(stream, file.mModified);
+                Files::writeValue(stream, file.mHash[0]);
+                Files::writeValue(stream, file.mHash[1]);
+            }
+        }
+
+        std::vector<ContentFile> readContent(std::istream& stream)
+        {
+            std::vector<ContentFile> content(Files::readValue<std::uint64_t>(stream));
+            for (ContentFile& file : content)
+            {
+                file.mIndex = static_cast<std::size_t>(Files::readValue<std::uint64_t>(stream));
+                file.mName = Files::readString(stream);
+                file.mSize = Files::readValue<std::uint64_t>(stream);
+                file.mModified = Files::readValue<std::int64_t>(stream);
+                file.mHash[0] = Files::readValue<std::uint64_t>(stream);
+                file.mHash[1] = Files::readValue<std::uint64_t>(stream);
+            }
+            return content;
+        }
+    }
+
+    std::vector<ContentFile> getContentFiles(const std::vector<std::size_t>& indices, const ESM::ReadersCache& readers)
+    {
+        std::vector<ContentFile> result;
+        result.reserve(indices.size());
+        for (const std::size_t index : indices)
+        {
+            const std::filesystem::path path = readers.getName(index);
+            const auto modified = std::filesystem::last_write_time(path).time_since_epoch().count();
+            result.push_back(ContentFile{
+                .mIndex = index,
+                .mName = Files::pathToUnicodeString(path.filename()),
+                .mSize = static_cast<std::uint64_t>(std::filesystem::file_size(path)),
+                .mModified = static_cast<std::int64_t>(modified),
+            });
+        }
+        return result;
+    }
+
+    void hashContentFiles(std::vector<ContentFile>& content, const ESM::ReadersCache& readers)
+    {
+        for (ContentFile& file : content)
+        {
+            const Files::IStreamPtr stream = Files::openConstrainedFileStream(readers.getName(file.mIndex));
+            file.mHash = Files::getHash(file.mName, *stream);
+        }
+    }
+
+    bool haveSameStamps(const std::vector<ContentFile>& l, const std::vector<ContentFile>& r)
+    {
+        return std::equal(l.begin(), l.end(), r.begin(), r.end(), [](const ContentFile& a, const ContentFile& b) {
+            return a.mIndex == b.mIndex && a.mName == b.mName && a.mSize == b.mSize && a.mModified == b.mModified;
+        });
+    }
+
+    bool haveSameHashes(const std::vector<ContentFile>& l, const std::vector<ContentFile>& r)
+    {
+        return std::equal(l.begin(), l.end(), r.begin(), r.end(), [](const ContentFile& a, const ContentFile& b) {
+            return a.mIndex == b.mIndex && a.mName == b.mName && a.mHash == b.mHash;
+        });
+    }
+
+    std::optional<CellRefCache> readCellRefCache(const std::filesystem::path& path)
+    {
+        std::ifstream stream(path, std::ios::binary);
+        if (!stream.is_open())
+            return std::nullopt;
+        if (Files::readValue<std::uint32_t>(stream) != cellRefCacheMagic
+            || Files::readValue<std::uint32_t>(stream) != cellRefCacheVersion)
+            return std::nullopt;
+        CellRefCache cache;
+        cache.mContent = readContent(stream);
+        CellRefSummary& summary = cache.mSummary;
+        const std::uint64_t refCounts = Files::readValue<std::uint64_t>(stream);
+        summary.mRefCount.reserve(static_cast<std::size_t>(refCounts));
+        for (std::uint64_t i = 0; i < refCounts; ++i)
+        {
+            ESM::RefId id = ESM::RefId::deserializeText(Files::readString(stream));
+            summary.mRefCount.emplace(std::move(id), Files::readValue<std::int32_t>(stream));
+        }
+        const std::uint64_t keyIds = Files::readValue<std::uint64_t>(stream);
+        summary.mKeyIds.reserve(static_cast<std::size_t>(keyIds));
+        for (std::uint64_t i = 0; i < keyIds; ++i)
+            summary.mKeyIds.push_back(ESM::RefId::deserializeText(Files::readString(stream)));
+        return cache;
+    }
+
+    void writeCellRefCache(
+        const std::filesystem::path& path, const std::vector<ContentFile>& content, const CellRefSummary& summary)
+    {
+        Files::writeCacheFile(path, [&](std::ostream& stream) {
+            Files::writeValue(stream, cellRefCacheMagic);
+            Files::writeValue(stream, cellRefCacheVersion);
+            writeContent(stream, content);
+            Files::writeValue(stream, static_cast<std::uint64_t>(summary.mRefCount.size()));
+            for (const auto& [id, count] : summary.mRefCount)
+            {
+                Files::writeString(stream, id.serializeText());
+                Files::writeValue(stream, static_cast<std::int32_t>(count));
+            }
+            Files::writeValue(stream, static_cast<std::uint64_t>(summary.mKeyIds.size()));
+            for (const ESM::RefId& id : summary.mKeyIds)
+                Files::writeString(stream, id.serializeText());
+        });
+    }
+}
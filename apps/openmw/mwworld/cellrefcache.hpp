@@ -0,0 +1,63 @@
+#ifndef GAME_MWWORLD_CELLREFCACHE_H
+#define GAME_MWWORLD_CELLREFCACHE_H
+
+#include <components/esm/refid.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace ESM
+{
+    class ReadersCache;
+}
+
+namespace MWWorld
+{
+    /// Data collected from the references of all cells in the loaded content files.
+    struct CellRefSummary
+    {
+        std::unordered_map<ESM::RefId, int> mRefCount;
+        std::vector<ESM::RefId> mKeyIds;
+    };
+
+    /// Content file defining cells. Hash is computed only when size or modification time differs from the cached
+    /// ones, to detect files that were touched without changing them.
+    struct ContentFile
+    {
+        std::size_t mIndex;
+        std::string mName;
+        std::uint64_t mSize = 0;
+        std::int64_t mModified = 0;
+        std::array<std::uint64_t, 2> mHash{};
+    };
+
+    struct CellRefCache
+    {
+        std::vector<ContentFile> mContent;
+        CellRefSummary mSummary;
+    };
+
+    /// Get name, size and modification time of content files with given indices opened by the readers at least once.
+    std::vector<ContentFile> getContentFiles(const std::vector<std::size_t>& indices, const ESM::ReadersCache& readers);
+
+    void hashContentFiles(std::vector<ContentFile>& content, const ESM::ReadersCache& readers);
+
+    bool haveSameStamps(const std::vector<ContentFile>& l, const std::vector<ContentFile>& r);
+
+    bool haveSameHashes(const std::vector<ContentFile>& l, const std::vector<ContentFile>& r);
+
+    /// @return std::nullopt if there is no cache or it has a different format.
+    std::optional<CellRefCache> readCellRefCache(const std::filesystem::path& path);
+
+    /// Content files have to be hashed.
+    void writeCellRefCache(
+        const std::filesystem::path& path, const std::vector<ContentFile>& content, const CellRefSummary& summary);
+}
+
+#endif
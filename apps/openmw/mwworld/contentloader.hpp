@@ -15,6 +15,10 @@ namespace MWWorld
     {
         virtual ~ContentLoader() = default;
 
+        /// Announce a file to be loaded later by load() to let the loader read it ahead on other threads.
+        /// All files have to be announced before the first load() call.
+        virtual void prepare(const std::filesystem::path& /*filepath*/, int /*index*/) {}
+
         virtual void load(const std::filesystem::path& filepath, int& index, Loading::Listener* listener) = 0;
     };
 
@@ -0,0 +1,118 @@
+#include "dialogueinfoindex.hpp"
+
+#include <components/esm3/loaddial.hpp>
+#include <components/misc/strings/algorithm.hpp>
+
+#include <algorithm>
+#include <iterator>
+
+namespace MWWorld
+{
+    DialogueInfoIndex::DialogueInfoIndex(const ESM::Dialogue& dialogue)
+        : mDialogue(&dialogue)
+    {
+        const auto addToPartition = [](Partition& partition, const ESM::RefId& value, std::uint32_t position) {
+            if (value.empty())
+                partition.mAny.push_back(position);
+            else
+                partition.mByValue[value].push_back(position);
+        };
+
+        std::unordered_map<ESM::RefId, Positions> cells;
+
+        mInfos.reserve(dialogue.mInfo.size());
+
+        for (const ESM::DialInfo& info : dialogue.mInfo)
+        {
+            const std::uint32_t position = static_cast<std::uint32_t>(mInfos.size());
+            mInfos.push_back(&info);
+
+            addToPartition(mActors, info.mActor, position);
+            addToPartition(mRaces, info.mRace, position);
+            addToPartition(mClasses, info.mClass, position);
+
+            // Faction-less infos require an actor without faction which is queried with an empty id
+            if (info.mFactionLess)
+                mFactions.mByValue[ESM::RefId()].push_back(position);
+            else
+                addToPartition(mFactions, info.mFaction, position);
+
+            if (info.mCell.empty())
+                mAnyCell.push_back(position);
+            else
+                cells[info.mCell].push_back(position);
+        }
+
+        mCells.assign(std::make_move_iterator(cells.begin()), std::make_move_iterator(cells.end()));
+    }
+
+    void DialogueInfoIndex::getCandidates(const Query& query, std::vector<const ESM::DialInfo*>& candidates) const
+    {
+        // Sorted positions of the infos matching each condition that is used by any info
+        std::vector<Positions> matching;
+
+        const auto addMatching = [&](const Partition& partition, const ESM::RefId& value, bool includeAny) {
+            if (includeAny && partition.mByValue.empty())
+                return;
+            Positions& positions = matching.emplace_back();
+            const auto it = partition.mByValue.find(value);
+            if (it == partition.mByValue.end())
+            {
+                if (includeAny)
+                    positions = partition.mAny;
+                return;
+            }
+            if (!includeAny)
+            {
+                positions = it->second;
+                return;
+            }
+            positions.reserve(partition.mAny.size() + it->second.size());
+            std::merge(partition.mAny.begin(), partition.mAny.end(), it->second.begin(), it->second.end(),
+                std::back_inserter(positions));
+        };
+
+        addMatching(mActors, query.mActor, !query.mCreature);
+
+        if (!query.mCreature)
+        {
+            addMatching(mRaces, query.mRace, true);
+            addMatching(mClasses, query.mClass, true);
+            addMatching(mFactions, query.mFaction, true);
+        }
+
+        if (!mCells.empty())
+        {
+            Positions& positions = matching.emplace_back(mAnyCell);
+            for (const auto& [cell, cellPositions] : mCells)
+                if (Misc::StringUtils::ciStartsWith(query.mCell, cell.getRefIdString()))
+                    positions.insert(positions.end(), cellPositions.begin(), cellPositions.end());
+            std::sort(positions.begin(), positions.end());
+        }
+
+        candidates.clear();
+
+        if (matching.empty())
+        {
+            candidates = mInfos;
+            return;
+        }
+
+        // Start from the most selective condition to keep intermediate results small
+        std::sort(matching.begin(), matching.end(),
+            [](const Positions& l, const Positions& r) { return l.size() < r.size(); });
+
+        Positions result = std::move(matching.front());
+        Positions buffer;
+        for (auto it = matching.begin() + 1; it != matching.end() && !result.empty(); ++it)
+        {
+            buffer.clear();
+            std::set_intersection(result.begin(), result.end(), it->begin(), it->end(), std::back_inserter(buffer));
+            std::swap(result, buffer);
+        }
+
+        candidates.reserve(result.size());
+        for (const std::uint32_t position : result)
+            candidates.push_back(mInfos[position]);
+    }
+}
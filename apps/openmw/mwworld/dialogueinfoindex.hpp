@@ -0,0 +1,69 @@
+#ifndef GAME_MWWORLD_DIALOGUEINFOINDEX_H
+#define GAME_MWWORLD_DIALOGUEINFOINDEX_H
+
+#include <components/esm/refid.hpp>
+
+#include <cstdint>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace ESM
+{
+    struct DialInfo;
+    struct Dialogue;
+}
+
+namespace MWWorld
+{
+    /// @brief Infos of a dialogue grouped by their speaker id, race, class, faction and cell conditions.
+    /// @par Used to skip infos that can't be said by an actor before evaluating their conditions one by one. Each
+    /// group is a sorted list of info positions in the dialogue so candidates are found by merging and intersecting
+    /// them and keep the dialogue order.
+    class DialogueInfoIndex
+    {
+    public:
+        struct Query
+        {
+            ESM::RefId mActor;
+            // Creatures have only infos specific to their id, other speaker conditions are ignored
+            bool mCreature = false;
+            ESM::RefId mRace;
+            ESM::RefId mClass;
+            // Empty for an actor without faction
+            ESM::RefId mFaction;
+            std::string_view mCell;
+        };
+
+        explicit DialogueInfoIndex(const ESM::Dialogue& dialogue);
+
+        /// Replace candidates by the infos that may match the query in the dialogue order. The rest of the info
+        /// conditions still has to be checked.
+        void getCandidates(const Query& query, std::vector<const ESM::DialInfo*>& candidates) const;
+
+        const ESM::Dialogue& getDialogue() const { return *mDialogue; }
+
+    private:
+        using Positions = std::vector<std::uint32_t>;
+
+        struct Partition
+        {
+            // Infos without this condition
+            Positions mAny;
+            std::unordered_map<ESM::RefId, Positions> mByValue;
+        };
+
+        const ESM::Dialogue* mDialogue;
+        std::vector<const ESM::DialInfo*> mInfos;
+        Partition mActors;
+        Partition mRaces;
+        Partition mClasses;
+        Partition mFactions;
+        Positions mAnyCell;
+        // Cell conditions match cells with names starting with the value so they can't be looked up by value
+        std::vector<std::pair<ESM::RefId, Positions>> mCells;
+    };
+}
+
+#endif
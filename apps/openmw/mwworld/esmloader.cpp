@@ -1,7 +1,9 @@
 #include "esmloader.hpp"
 #include "esmstore.hpp"
 
+#include <algorithm>
 #include <fstream>
+#include <stdexcept>
 
 #include <components/esm/format.hpp>
 #include <components/esm3/esmreader.hpp>
@@ -11,6 +13,7 @@
 #include <components/files/openfile.hpp>
 #include <components/misc/strings/lower.hpp>
 #include <components/resource/resourcesystem.hpp>
+#include <components/toutf8/toutf8.hpp>
 
 #include "../mwbase/environment.hpp"
 
@@ -18,8 +21,9 @@ namespace MWWorld
 {
 
     EsmLoader::EsmLoader(MWWorld::ESMStore& store, ESM::ReadersCache& readers, ToUTF8::Utf8Encoder* encoder,
-        std::vector<int>& esmVersions)
-        : mReaders(readers)
+        std::vector<int>& esmVersions, std::size_t threads)
+        : mThreadCount(threads)
+        , mReaders(readers)
         , mStore(store)
         , mEncoder(encoder)
         , mDialogue(nullptr) // A content file containing INFO records without a DIAL record appends them to the
@@ -28,8 +32,99 @@ namespace MWWorld
     {
     }
 
+    EsmLoader::~EsmLoader()
+    {
+        {
+            const std::lock_guard lock(mMutex);
+            mStopping = true;
+        }
+        mCondition.notify_all();
+        for (std::thread& thread : mThreads)
+            thread.join();
+    }
+
+    void EsmLoader::prepare(const std::filesystem::path& filepath, int index)
+    {
+        if (mThreadCount == 0)
+            return;
+        if (!mThreads.empty())
+            throw std::logic_error("Content files can't be prepared after loading is started");
+        PreparedFile& file = mPreparedFiles.emplace_back();
+        file.mPath = filepath;
+        file.mIndex = index;
+        file.mFuture = file.mPromise.get_future();
+        mPreparedIndices.emplace(index, mPreparedFiles.size() - 1);
+    }
+
+    void EsmLoader::run()
+    {
+        while (true)
+        {
+            std::size_t next = 0;
+            {
+                std::unique_lock lock(mMutex);
+                // Limit the number of files read ahead to bound memory used by the staged records
+                mCondition.wait(lock, [&] {
+                    return mStopping || mNextPrepared >= mPreparedFiles.size()
+                        || mNextPrepared < mLoaded + 2 * mThreadCount;
+                });
+                if (mStopping || mNextPrepared >= mPreparedFiles.size())
+                    return;
+                next = mNextPrepared++;
+            }
+            PreparedFile& file = mPreparedFiles[next];
+            try
+            {
+                file.mPromise.set_value(stage(file.mPath, file.mIndex));
+            }
+            catch (...)
+            {
+                file.mPromise.set_exception(std::current_exception());
+            }
+        }
+    }
+
+    std::unique_ptr<ESMStore::StagedRecords> EsmLoader::stage(const std::filesystem::path& filepath, int index) const
+    {
+        auto stream = Files::openBinaryInputFileStream(filepath);
+        if (ESM::readFormat(*stream) != ESM::Format::Tes3)
+            return nullptr;
+        stream->seekg(0);
+
+        // Utf8Encoder is not thread safe
+        std::optional<ToUTF8::Utf8Encoder> encoder;
+        if (mEncoder != nullptr)
+            encoder.emplace(mEncoder->getStatelessEncoder());
+
+        ESM::ESMReader reader;
+        reader.setEncoder(encoder.has_value() ? &*encoder : nullptr);
+        reader.setIndex(index);
+        reader.open(std::move(stream), filepath);
+        return mStore.stage(reader);
+    }
+
+    std::unique_ptr<ESMStore::StagedRecords> EsmLoader::takeStaged(int index)
+    {
+        const auto it = mPreparedIndices.find(index);
+        if (it == mPreparedIndices.end())
+            return nullptr;
+
+        if (mThreads.empty())
+            for (std::size_t i = 0, n = std::min(mThreadCount, mPreparedFiles.size()); i < n; ++i)
+                mThreads.emplace_back([this] { run(); });
+
+        {
+            const std::lock_guard lock(mMutex);
+            ++mLoaded;
+        }
+        mCondition.notify_all();
+
+        return mPreparedFiles[it->second].mFuture.get();
+    }
+
     void EsmLoader::load(const std::filesystem::path& filepath, int& index, Loading::Listener* listener)
     {
+        std::unique_ptr<ESMStore::StagedRecords> staged = takeStaged(index);
 
         auto stream = Files::openBinaryInputFileStream(filepath);
         const ESM::Format format = ESM::readFormat(*stream);
@@ -55,7 +150,10 @@ namespace MWWorld
                   "Please run the launcher to fix this issue.");
 
                 mESMVersions[index] = reader->getVer();
-                mStore.load(*reader, listener, mDialogue);
+                if (staged != nullptr)
+                    mStore.load(*reader, *staged, listener, mDialogue);
+                else
+                    mStore.load(*reader, listener, mDialogue);
 
                 if (!mMasterFileFormat.has_value()
                     && (Misc::StringUtils::ciEndsWith(reader->getName().u8string(), u8".esm")
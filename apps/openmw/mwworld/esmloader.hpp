@@ -1,11 +1,18 @@
 #ifndef ESMLOADER_HPP
 #define ESMLOADER_HPP
 
+#include <condition_variable>
+#include <cstddef>
+#include <future>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <optional>
+#include <thread>
 #include <vector>
 
 #include "contentloader.hpp"
+#include "esmstore.hpp"
 
 namespace ToUTF8
 {
@@ -20,19 +27,46 @@ namespace ESM
 
 namespace MWWorld
 {
-
-    class ESMStore;
-
     struct EsmLoader : public ContentLoader
     {
+        /// @param threads Number of threads reading prepared content files ahead of load(), 0 to read files only
+        /// in load().
         explicit EsmLoader(MWWorld::ESMStore& store, ESM::ReadersCache& readers, ToUTF8::Utf8Encoder* encoder,
-            std::vector<int>& esmVersions);
+            std::vector<int>& esmVersions, std::size_t threads = 0);
+
+        ~EsmLoader();
 
         std::optional<int> getMasterFileFormat() const { return mMasterFileFormat; }
 
+        void prepare(const std::filesystem::path& filepath, int index) override;
+
         void load(const std::filesystem::path& filepath, int& index, Loading::Listener* listener) override;
 
     private:
+        struct PreparedFile
+        {
+            std::filesystem::path mPath;
+            int mIndex;
+            std::promise<std::unique_ptr<ESMStore::StagedRecords>> mPromise;
+            std::future<std::unique_ptr<ESMStore::StagedRecords>> mFuture;
+        };
+
+        const std::size_t mThreadCount;
+        std::vector<PreparedFile> mPreparedFiles;
+        std::map<int, std::size_t> mPreparedIndices;
+        std::mutex mMutex;
+        std::condition_variable mCondition;
+        std::size_t mNextPrepared = 0;
+        std::size_t mLoaded = 0;
+        bool mStopping = false;
+        std::vector<std::thread> mThreads;
+
+        void run();
+
+        std::unique_ptr<ESMStore::StagedRecords> stage(const std::filesystem::path& filepath, int index) const;
+
+        std::unique_ptr<ESMStore::StagedRecords> takeStaged(int index);
+
         ESM::ReadersCache& mReaders;
         MWWorld::ESMStore& mStore;
         ToUTF8::Utf8Encoder* mEncoder;
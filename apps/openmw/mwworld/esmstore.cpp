@@ -2,6 +2,8 @@
 
 #include <algorithm>
 #include <fstream>
+#include <optional>
+#include <set>
 #include <tuple>
 
 #include <components/debug/debuglog.hpp>
@@ -20,6 +22,8 @@
 
 #include "../mwmechanics/spelllist.hpp"
 
+#include "cellrefcache.hpp"
+
 namespace
 {
     struct Ref
@@ -75,6 +79,45 @@ namespace
         }
     }
 
+    std::vector<std::size_t> getCellContentFiles(const MWWorld::Store<ESM::Cell>& cells)
+    {
+        std::set<std::size_t> indices;
+        const auto addIndices = [&](const ESM::Cell& cell) {
+            for (const ESM::ESM_Context& context : cell.mContextList)
+                indices.insert(static_cast<std::size_t>(context.index));
+        };
+        for (auto it = cells.intBegin(); it != cells.intEnd(); ++it)
+            addIndices(*it);
+        for (auto it = cells.extBegin(); it != cells.extEnd(); ++it)
+            addIndices(*it);
+        return std::vector<std::size_t>(indices.begin(), indices.end());
+    }
+
+    MWWorld::CellRefSummary collectCellRefs(const MWWorld::Store<ESM::Cell>& cells, ESM::ReadersCache& readers)
+    {
+        std::vector<Ref> refs;
+        std::set<ESM::RefId> keyIDs;
+        std::vector<ESM::RefId> refIDs;
+        for (auto it = cells.intBegin(); it != cells.intEnd(); ++it)
+            readRefs(*it, refs, refIDs, keyIDs, readers);
+        for (auto it = cells.extBegin(); it != cells.extEnd(); ++it)
+            readRefs(*it, refs, refIDs, keyIDs, readers);
+        MWWorld::CellRefSummary result;
+        const auto lessByRefNum = [](const Ref& l, const Ref& r) { return l.mRefNum < r.mRefNum; };
+        std::stable_sort(refs.begin(), refs.end(), lessByRefNum);
+        const auto equalByRefNum = [](const Ref& l, const Ref& r) { return l.mRefNum == r.mRefNum; };
+        const auto incrementRefCount = [&](const Ref& value) {
+            if (value.mRefID != deletedRefID)
+            {
+                ESM::RefId& refId = refIDs[value.mRefID];
+                ++result.mRefCount[std::move(refId)];
+            }
+        };
+        Misc::forEachUnique(refs.rbegin(), refs.rend(), equalByRefNum, incrementRefCount);
+        result.mKeyIds.assign(keyIDs.begin(), keyIDs.end());
+        return result;
+    }
+
     const ESM::RefId& getDefaultClass(const MWWorld::Store<ESM::Class>& classes)
     {
         auto it = classes.begin();
@@ -394,7 +437,21 @@ namespace MWWorld
         // Loop through all records
         while (esm.hasMoreRecs())
         {
-            ESM::NAME n = esm.getRecName();
+            loadRecord(esm, dialogue);
+            if (listener != nullptr)
+                listener->setProgress(::EsmLoader::fileProgress * esm.getFileOffset() / esm.getFileSize());
+        }
+    }
+
+    std::unique_ptr<ESMStore::StagedRecords> ESMStore::stage(ESM::ESMReader& esm)
+    {
+        auto staged = std::make_unique<StagedRecords>();
+        staged->mFileSize = esm.getFileSize();
+
+        while (esm.hasMoreRecs())
+        {
+            const std::size_t offset = esm.getFileOffset();
+            const ESM::NAME n = esm.getRecName();
             esm.getRecHeader();
             if (esm.getRecordFlags() & ESM::FLAG_Ignored)
             {
@@ -402,69 +459,122 @@ namespace MWWorld
                 continue;
             }
 
-            // Look up the record type.
-            ESM::RecNameInts recName = static_cast<ESM::RecNameInts>(n.toInt());
-            const auto& it = mStoreImp->mRecNameToStore.find(recName);
+            DynamicStore* store = nullptr;
+            std::function<RecordId()> insert;
+            const auto it = mStoreImp->mRecNameToStore.find(static_cast<ESM::RecNameInts>(n.toInt()));
+            if (it != mStoreImp->mRecNameToStore.end())
+            {
+                store = it->second;
+                insert = store->stage(esm);
+            }
+            if (insert == nullptr)
+                esm.skipRecord();
+
+            staged->mRecords.push_back(StagedRecords::Record{ offset, store, std::move(insert) });
+        }
+
+        return staged;
+    }
 
-            if (it == mStoreImp->mRecNameToStore.end())
+    void ESMStore::load(
+        ESM::ESMReader& esm, StagedRecords& staged, Loading::Listener* listener, ESM::Dialogue*& dialogue)
+    {
+        if (listener != nullptr)
+            listener->setProgressRange(::EsmLoader::fileProgress);
+
+        for (StagedRecords::Record& record : staged.mRecords)
+        {
+            if (record.mInsert == nullptr)
             {
-                if (recName == ESM::REC_INFO)
-                {
-                    if (dialogue)
-                    {
-                        dialogue->readInfo(esm);
-                    }
-                    else
-                    {
-                        Log(Debug::Error) << "Error: info record without dialog";
-                        esm.skipRecord();
-                    }
-                }
-                else if (n.toInt() == ESM::REC_MGEF)
-                {
-                    getWritable<ESM::MagicEffect>().load(esm);
-                }
-                else if (n.toInt() == ESM::REC_SKIL)
-                {
-                    getWritable<ESM::Skill>().load(esm);
-                }
-                else if (n.toInt() == ESM::REC_FILT || n.toInt() == ESM::REC_DBGP)
-                {
-                    // ignore project file only records
-                    esm.skipRecord();
-                }
-                else if (n.toInt() == ESM::REC_LUAL)
-                {
-                    ESM::LuaScriptsCfg cfg;
-                    cfg.load(esm);
-                    cfg.adjustRefNums(esm);
-                    mLuaContent.push_back(std::move(cfg));
-                }
-                else
-                {
-                    throw std::runtime_error("Unknown record: " + n.toString());
-                }
+                if (esm.getFileOffset() != record.mOffset)
+                    esm.seekRecord(record.mOffset);
+                loadRecord(esm, dialogue);
             }
             else
             {
-                RecordId id = it->second->load(esm);
+                const RecordId id = record.mInsert();
                 if (id.mIsDeleted)
                 {
-                    it->second->eraseStatic(id.mId);
+                    record.mStore->eraseStatic(id.mId);
                     continue;
                 }
+                dialogue = nullptr;
+            }
+            if (listener != nullptr)
+                listener->setProgress(::EsmLoader::fileProgress * record.mOffset / staged.mFileSize);
+        }
+    }
 
-                if (n.toInt() == ESM::REC_DIAL)
+    void ESMStore::loadRecord(ESM::ESMReader& esm, ESM::Dialogue*& dialogue)
+    {
+        ESM::NAME n = esm.getRecName();
+        esm.getRecHeader();
+        if (esm.getRecordFlags() & ESM::FLAG_Ignored)
+        {
+            esm.skipRecord();
+            return;
+        }
+
+        // Look up the record type.
+        ESM::RecNameInts recName = static_cast<ESM::RecNameInts>(n.toInt());
+        const auto& it = mStoreImp->mRecNameToStore.find(recName);
+
+        if (it == mStoreImp->mRecNameToStore.end())
+        {
+            if (recName == ESM::REC_INFO)
+            {
+                if (dialogue)
                 {
-                    dialogue = const_cast<ESM::Dialogue*>(getWritable<ESM::Dialogue>().find(id.mId));
+                    dialogue->readInfo(esm);
                 }
                 else
                 {
-                    dialogue = nullptr;
+                    Log(Debug::Error) << "Error: info record without dialog";
+                    esm.skipRecord();
                 }
             }
-            if (listener != nullptr)
-                listener->setProgress(::EsmLoader::fileProgress * esm.getFileOffset() / esm.getFileSize());
+            else if (n.toInt() == ESM::REC_MGEF)
+            {
+                getWritable<ESM::MagicEffect>().load(esm);
+            }
+            else if (n.toInt() == ESM::REC_SKIL)
+            {
+                getWritable<ESM::Skill>().load(esm);
+            }
+            else if (n.toInt() == ESM::REC_FILT || n.toInt() == ESM::REC_DBGP)
+            {
+                // ignore project file only records
+                esm.skipRecord();
+            }
+            else if (n.toInt() == ESM::REC_LUAL)
+            {
+                ESM::LuaScriptsCfg cfg;
+                cfg.load(esm);
+                cfg.adjustRefNums(esm);
+                mLuaContent.push_back(std::move(cfg));
+            }
+            else
+            {
+                throw std::runtime_error("Unknown record: " + n.toString());
+            }
+        }
+        else
+        {
+            RecordId id = it->second->load(esm);
+            if (id.mIsDeleted)
+            {
+                it->second->eraseStatic(id.mId);
+                return;
+            }
+
+            if (n.toInt() == ESM::REC_DIAL)
+            {
+                dialogue = const_cast<ESM::Dialogue*>(getWritable<ESM::Dialogue>().find(id.mId));
+            }
+            else
+            {
+                dialogue = nullptr;
+            }
         }
     }
 
@@ -551,39 +661,77 @@ namespace MWWorld
         }
     }
 
-    void ESMStore::validateRecords(ESM::ReadersCache& readers)
+    void ESMStore::validateRecords(ESM::ReadersCache& readers, const std::filesystem::path& cacheDir)
     {
         validate();
-        countAllCellRefsAndMarkKeys(readers);
+        countAllCellRefsAndMarkKeys(readers, cacheDir);
     }
 
-    void ESMStore::countAllCellRefsAndMarkKeys(ESM::ReadersCache& readers)
+    void ESMStore::countAllCellRefsAndMarkKeys(ESM::ReadersCache& readers, const std::filesystem::path& cacheDir)
     {
         // TODO: We currently need to read entire files here again.
         // We should consider consolidating or deferring this reading.
         if (!mRefCount.empty())
             return;
-        std::vector<Ref> refs;
-        std::set<ESM::RefId> keyIDs;
-        std::vector<ESM::RefId> refIDs;
         const Store<ESM::Cell>& cells = get<ESM::Cell>();
-        for (auto it = cells.intBegin(); it != cells.intEnd(); ++it)
-            readRefs(*it, refs, refIDs, keyIDs, readers);
-        for (auto it = cells.extBegin(); it != cells.extEnd(); ++it)
-            readRefs(*it, refs, refIDs, keyIDs, readers);
-        const auto lessByRefNum = [](const Ref& l, const Ref& r) { return l.mRefNum < r.mRefNum; };
-        std::stable_sort(refs.begin(), refs.end(), lessByRefNum);
-        const auto equalByRefNum = [](const Ref& l, const Ref& r) { return l.mRefNum == r.mRefNum; };
-        const auto incrementRefCount = [&](const Ref& value) {
-            if (value.mRefID != deletedRefID)
+
+        std::filesystem::path cachePath;
+        std::vector<ContentFile> content;
+        std::optional<CellRefSummary> summary;
+        bool hashed = false;
+        bool writeCache = false;
+        if (!cacheDir.empty())
+        {
+            cachePath = cacheDir / "cellrefs.bin";
+            writeCache = true;
+            try
             {
-                ESM::RefId& refId = refIDs[value.mRefID];
-                ++mRefCount[std::move(refId)];
+                // Hashing all content files costs about as much as reading the references so it is done only when
+                // the files have a different size or modification time
+                content = getContentFiles(getCellContentFiles(cells), readers);
+                std::optional<CellRefCache> cache = readCellRefCache(cachePath);
+                if (cache.has_value() && haveSameStamps(cache->mContent, content))
+                {
+                    summary = std::move(cache->mSummary);
+                    writeCache = false;
+                }
+                else if (cache.has_value())
+                {
+                    hashContentFiles(content, readers);
+                    hashed = true;
+                    if (haveSameHashes(cache->mContent, content))
+                        summary = std::move(cache->mSummary);
+                }
             }
-        };
-        Misc::forEachUnique(refs.rbegin(), refs.rend(), equalByRefNum, incrementRefCount);
+            catch (const std::exception& e)
+            {
+                Log(Debug::Warning) << "Failed to read cell references cache " << cachePath << ": " << e.what();
+                writeCache = false;
+            }
+        }
+
+        if (summary.has_value())
+            Log(Debug::Verbose) << "Using cell references cache " << cachePath;
+        else
+            summary = collectCellRefs(cells, readers);
+
+        if (writeCache)
+        {
+            try
+            {
+                if (!hashed)
+                    hashContentFiles(content, readers);
+                writeCellRefCache(cachePath, content, *summary);
+            }
+            catch (const std::exception& e)
+            {
+                Log(Debug::Warning) << "Failed to write cell references cache " << cachePath << ": " << e.what();
+            }
+        }
+
+        mRefCount = std::move(summary->mRefCount);
         auto& store = getWritable<ESM::Miscellaneous>().mStatic;
-        for (const auto& id : keyIDs)
+        for (const auto& id : summary->mKeyIds)
         {
             auto it = store.find(id);
             if (it != store.end())
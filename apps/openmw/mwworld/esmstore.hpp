@@ -2,6 +2,7 @@
 #define OPENMW_MWWORLD_ESMSTORE_H
 
 #include <filesystem>
+#include <functional>
 #include <memory>
 #include <stdexcept>
 #include <tuple>
@@ -174,13 +175,15 @@ namespace MWWorld
         /// Validate entries in store after setup
         void validate();
 
-        void countAllCellRefsAndMarkKeys(ESM::ReadersCache& readers);
+        void countAllCellRefsAndMarkKeys(ESM::ReadersCache& readers, const std::filesystem::path& cacheDir);
 
         template <class T>
         void removeMissingObjects(Store<T>& store);
 
         void setIdType(const ESM::RefId& id, ESM::RecNameInts type);
 
+        void loadRecord(ESM::ESMReader& esm, ESM::Dialogue*& dialogue);
+
         using LuaContent = std::variant<ESM::LuaScriptsCfg, // data from an omwaddon
             std::filesystem::path>; // path to an omwscripts file
         std::vector<LuaContent> mLuaContent;
@@ -215,9 +218,32 @@ namespace MWWorld
         /// Validate entries in store after loading a save
         void validateDynamic();
 
+        /// Records of a content file read by stage() to be added to the store by load() in the content files order.
+        struct StagedRecords
+        {
+            struct Record
+            {
+                std::size_t mOffset;
+                DynamicStore* mStore;
+                // Empty for records loaded in order with the main reader
+                std::function<RecordId()> mInsert;
+            };
+
+            std::size_t mFileSize = 0;
+            std::vector<Record> mRecords;
+        };
+
         void load(ESM::ESMReader& esm, Loading::Listener* listener, ESM::Dialogue*& dialogue);
         void loadESM4(ESM4::Reader& esm, Loading::Listener* listener);
 
+        /// Read records of the content file into a staging buffer without modifying the store.
+        /// @note May be called from any thread while the main thread loads other content files.
+        std::unique_ptr<StagedRecords> stage(ESM::ESMReader& esm);
+
+        /// Add records read by stage() with the same effect as load(). Records which can't be staged are read
+        /// using the given reader.
+        void load(ESM::ESMReader& esm, StagedRecords& staged, Loading::Listener* listener, ESM::Dialogue*& dialogue);
+
         template <class T>
         const Store<T>& get() const
         {
@@ -284,7 +310,9 @@ namespace MWWorld
         // This method must be called once, after loading all master/plugin files. This can only be done
         //  from the outside, so it must be public.
         void setUp();
-        void validateRecords(ESM::ReadersCache& readers);
+        /// @param cacheDir When not empty, reference counts are stored there and reused while content files are the
+        /// same instead of reading all cell references again.
+        void validateRecords(ESM::ReadersCache& readers, const std::filesystem::path& cacheDir = {});
 
         size_t countSavedGameRecords() const;
 
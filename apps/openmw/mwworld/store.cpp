@@ -1,5 +1,6 @@
 #include "store.hpp"
 
+#include <functional>
 #include <iterator>
 #include <sstream>
 #include <stdexcept>
@@ -211,14 +212,7 @@ namespace MWWorld
             bool isDeleted = false;
             record.load(esm, isDeleted);
 
-            std::pair<typename Static::iterator, bool> inserted = mStatic.insert_or_assign(record.mId, record);
-            if (inserted.second)
-                mShared.push_back(&inserted.first->second);
-
-            if constexpr (std::is_same_v<Id, ESM::RefId>)
-                return RecordId(record.mId, isDeleted);
-            else
-                return RecordId();
+            return insertLoaded(std::move(record), isDeleted);
         }
         else
         {
@@ -229,6 +223,37 @@ namespace MWWorld
         }
     }
 
+    template <class T, class Id>
+    std::function<RecordId()> TypedDynamicStore<T, Id>::stage(ESM::ESMReader& esm)
+    {
+        if constexpr (!ESM::isESM4Rec(T::sRecordId))
+        {
+            T record;
+            bool isDeleted = false;
+            record.load(esm, isDeleted);
+
+            return [this, record = std::move(record), isDeleted]() mutable {
+                return insertLoaded(std::move(record), isDeleted);
+            };
+        }
+        else
+            return {};
+    }
+
+    template <class T, class Id>
+    RecordId TypedDynamicStore<T, Id>::insertLoaded(T&& record, bool isDeleted)
+    {
+        const Id id = record.mId;
+        std::pair<typename Static::iterator, bool> inserted = mStatic.insert_or_assign(id, std::move(record));
+        if (inserted.second)
+            mShared.push_back(&inserted.first->second);
+
+        if constexpr (std::is_same_v<Id, ESM::RefId>)
+            return RecordId(id, isDeleted);
+        else
+            return RecordId();
+    }
+
     template <class T, class Id>
     void TypedDynamicStore<T, Id>::setUp()
     {
@@ -1055,6 +1080,10 @@ namespace MWWorld
         std::sort(mShared.begin(), mShared.end(),
             [](const ESM::Dialogue* l, const ESM::Dialogue* r) -> bool { return l->mId < r->mId; });
 
+        mInfoIndices.clear();
+        for (const auto& [id, dial] : mStatic)
+            mInfoIndices.emplace(id, DialogueInfoIndex(dial));
+
         mKeywordSearchModFlag = true;
     }
 
@@ -1079,6 +1108,15 @@ namespace MWWorld
         return ptr;
     }
 
+    const DialogueInfoIndex* Store<ESM::Dialogue>::searchInfoIndex(const ESM::RefId& id) const
+    {
+        const auto it = mInfoIndices.find(id);
+        if (it != mInfoIndices.end())
+            return &it->second;
+
+        return nullptr;
+    }
+
     typename Store<ESM::Dialogue>::iterator Store<ESM::Dialogue>::begin() const
     {
         return mShared.begin();
@@ -1123,6 +1161,7 @@ namespace MWWorld
     {
         if (eraseFromMap(mStatic, id))
             mKeywordSearchModFlag = true;
+        mInfoIndices.erase(id);
 
         return true;
     }
@@ -1,6 +1,7 @@
 #ifndef OPENMW_MWWORLD_STORE_H
 #define OPENMW_MWWORLD_STORE_H
 
+#include <functional>
 #include <map>
 #include <memory>
 #include <set>
@@ -27,6 +28,8 @@
 #include <components/misc/rng.hpp>
 #include <components/misc/strings/algorithm.hpp>
 
+#include "dialogueinfoindex.hpp"
+
 namespace ESM
 {
     struct LandTexture;
@@ -71,6 +74,12 @@ namespace MWWorld
         virtual size_t getDynamicSize() const { return 0; }
         virtual RecordId load(ESM::ESMReader& esm) = 0;
 
+        /// Read a record to add it to the store later by calling the returned function, which has the same effect as
+        /// load(). Returns an empty function without reading the record if records have to be loaded in order by
+        /// load().
+        /// @note Doesn't modify the store so may be called from any thread while the store is used by the main thread.
+        virtual std::function<RecordId()> stage(ESM::ESMReader& esm) { return {}; }
+
         virtual bool eraseStatic(const Id& id) { return false; }
         virtual void clearDynamic() {}
 
@@ -199,6 +208,8 @@ namespace MWWorld
 
         friend class ESMStore;
 
+        RecordId insertLoaded(T&& record, bool isDeleted);
+
     public:
         TypedDynamicStore();
         TypedDynamicStore(const TypedDynamicStore<T, Id>& orig);
@@ -241,6 +252,7 @@ namespace MWWorld
         bool erase(const T& item);
 
         RecordId load(ESM::ESMReader& esm) override;
+        std::function<RecordId()> stage(ESM::ESMReader& esm) override;
         void write(ESM::ESMWriter& writer, Loading::Listener& progress) const override;
         RecordId read(ESM::ESMReader& reader, bool overrideOnly = false) override;
     };
@@ -508,6 +520,7 @@ namespace MWWorld
         /// for heads/hairs in the character creation)
         /// @warning ESM::Dialogue Store currently implements a sorted order for unknown reasons.
         std::vector<ESM::Dialogue*> mShared;
+        std::unordered_map<ESM::RefId, DialogueInfoIndex> mInfoIndices;
 
         mutable bool mKeywordSearchModFlag{ true };
 
@@ -521,6 +534,9 @@ namespace MWWorld
         const ESM::Dialogue* search(const ESM::RefId& id) const;
         const ESM::Dialogue* find(const ESM::RefId& id) const;
 
+        /// Return index of the infos of dialogue \a id built on setUp or nullptr.
+        const DialogueInfoIndex* searchInfoIndex(const ESM::RefId& id) const;
+
         iterator begin() const;
         iterator end() const;
 
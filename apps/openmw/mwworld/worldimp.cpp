@@ -46,6 +46,7 @@
 #include <components/sceneutil/workqueue.hpp>
 
 #include <components/detournavigator/agentbounds.hpp>
+#include <components/detournavigator/asyncpathfinder.hpp>
 #include <components/detournavigator/debug.hpp>
 #include <components/detournavigator/navigator.hpp>
 #include <components/detournavigator/settings.hpp>
@@ -189,6 +190,14 @@ namespace MWWorld
             mLoaders.emplace(std::move(extension), &loader);
         }
 
+        void prepare(const std::filesystem::path& filepath, int index) override
+        {
+            const auto it
+                = mLoaders.find(Misc::StringUtils::lowerCase(Files::pathToUnicodeString(filepath.extension())));
+            if (it != mLoaders.end())
+                it->second->prepare(filepath, index);
+        }
+
         void load(const std::filesystem::path& filepath, int& index, Loading::Listener* listener) override
         {
             const auto it
@@ -262,7 +271,8 @@ namespace MWWorld
     }
 
     void World::loadData(const Files::Collections& fileCollections, const std::vector<std::string>& contentFiles,
-        const std::vector<std::string>& groundcoverFiles, ToUTF8::Utf8Encoder* encoder, Loading::Listener* listener)
+        const std::vector<std::string>& groundcoverFiles, ToUTF8::Utf8Encoder* encoder,
+        const std::filesystem::path& contentCacheDir, Loading::Listener* listener)
     {
         mContentFiles = contentFiles;
         mESMVersions.resize(mContentFiles.size(), -1);
@@ -274,7 +284,7 @@ namespace MWWorld
         fillGlobalVariables();
 
         mStore.setUp();
-        mStore.validateRecords(mReaders);
+        mStore.validateRecords(mReaders, contentCacheDir);
         mStore.movePlayerRecord();
 
         mSwimHeightScale = mStore.get<ESM::GameSetting>().find("fSwimHeightScale")->mValue.getFloat();
@@ -290,6 +300,9 @@ namespace MWWorld
             auto navigatorSettings = DetourNavigator::makeSettingsFromSettingsManager(maxRecastLogLevel);
             navigatorSettings.mRecast.mSwimHeightScale = mSwimHeightScale;
             mNavigator = DetourNavigator::makeNavigator(navigatorSettings, mUserDataPath);
+            if (navigatorSettings.mAsyncPathFinderThreads > 0)
+                mAsyncPathFinder = std::make_unique<DetourNavigator::AsyncPathFinder>(
+                    *mNavigator, navigatorSettings.mAsyncPathFinderThreads);
         }
         else
         {
@@ -1643,6 +1656,9 @@ namespace MWWorld
 
         updateNavigator();
 
+        if (mAsyncPathFinder != nullptr)
+            mAsyncPathFinder->update();
+
         mPlayer->update();
 
         mPhysics->debugDraw();
@@ -2845,7 +2861,8 @@ namespace MWWorld
         ToUTF8::Utf8Encoder* encoder, Loading::Listener* listener)
     {
         GameContentLoader gameContentLoader;
-        EsmLoader esmLoader(mStore, mReaders, encoder, mESMVersions);
+        EsmLoader esmLoader(mStore, mReaders, encoder, mESMVersions,
+            static_cast<std::size_t>(Settings::general().mContentLoadingThreads));
 
         gameContentLoader.addLoader(".esm", esmLoader);
         gameContentLoader.addLoader(".esp", esmLoader);
@@ -2856,6 +2873,13 @@ namespace MWWorld
         OMWScriptsLoader omwScriptsLoader(mStore);
         gameContentLoader.addLoader(".omwscripts", omwScriptsLoader);
 
+        for (std::size_t i = 0; i < content.size(); ++i)
+        {
+            const Files::MultiDirCollection& col = fileCollections.getCollection(Misc::getFileExtension(content[i]));
+            if (col.doesExist(content[i]))
+                gameContentLoader.prepare(col.getPath(content[i]), static_cast<int>(i));
+        }
+
         int idx = 0;
         for (const std::string& file : content)
         {
@@ -3775,6 +3799,11 @@ namespace MWWorld
         return mNavigator.get();
     }
 
+    DetourNavigator::AsyncPathFinder* World::getAsyncPathFinder() const
+    {
+        return mAsyncPathFinder.get();
+    }
+
     void World::updateActorPath(const MWWorld::ConstPtr& actor, const std::deque<osg::Vec3f>& path,
         const DetourNavigator::AgentBounds& agentBounds, const osg::Vec3f& start, const osg::Vec3f& end) const
     {
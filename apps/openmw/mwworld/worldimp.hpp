@@ -101,6 +101,7 @@ namespace MWWorld
         std::unique_ptr<MWWorld::Player> mPlayer;
         std::unique_ptr<MWPhysics::PhysicsSystem> mPhysics;
         std::unique_ptr<DetourNavigator::Navigator> mNavigator;
+        std::unique_ptr<DetourNavigator::AsyncPathFinder> mAsyncPathFinder;
         std::unique_ptr<MWRender::RenderingManager> mRendering;
         std::unique_ptr<MWWorld::Scene> mWorldScene;
         std::unique_ptr<MWWorld::WeatherManager> mWeatherManager;
@@ -198,7 +199,7 @@ namespace MWWorld
 
         void loadData(const Files::Collections& fileCollections, const std::vector<std::string>& contentFiles,
             const std::vector<std::string>& groundcoverFiles, ToUTF8::Utf8Encoder* encoder,
-            Loading::Listener* listener);
+            const std::filesystem::path& contentCacheDir, Loading::Listener* listener);
 
         // Must be called after `loadData`.
         void init(Debug::Level maxRecastLogLevel, osgViewer::Viewer* viewer, osg::ref_ptr<osg::Group> rootNode,
@@ -648,6 +649,8 @@ namespace MWWorld
 
         DetourNavigator::Navigator* getNavigator() const override;
 
+        DetourNavigator::AsyncPathFinder* getAsyncPathFinder() const override;
+
         void updateActorPath(const MWWorld::ConstPtr& actor, const std::deque<osg::Vec3f>& path,
             const DetourNavigator::AgentBounds& agentBounds, const osg::Vec3f& start,
             const osg::Vec3f& end) const override;
@@ -68,6 +68,10 @@ namespace OpenMW
             "load a save game file on game startup (specify an absolute filename or a filename relative to the current "
             "working directory)");
 
+        addOption("lua-profile", bpo::value<Files::MaybeQuotedPath>()->default_value(Files::MaybeQuotedPath(), ""),
+            "profile Lua handlers from game startup to exit and write the capture to <path>.json (Chrome trace) and "
+            "<path>.folded (collapsed stacks for flame graphs)");
+
         addOption("skip-menu", bpo::value<bool>()->implicit_value(true)->default_value(false),
             "skip main menu on game startup");
 
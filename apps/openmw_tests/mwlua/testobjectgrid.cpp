@@ -0,0 +1,112 @@
+#include "apps/openmw/mwlua/objectgrid.hpp"
+
+#include <components/lua/shapes/box.hpp>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <osg/Math>
+
+#include <vector>
+
+namespace
+{
+    using namespace testing;
+    using namespace MWLua;
+
+    constexpr unsigned actor = 1 << 0;
+    constexpr unsigned item = 1 << 1;
+
+    ESM::RefNum makeId(std::uint32_t index)
+    {
+        return ESM::RefNum{ .mIndex = index, .mContentFile = 0 };
+    }
+
+    struct ObjectGridTest : Test
+    {
+        ObjectGrid mGrid{ 100 };
+        std::vector<ESM::RefNum> mResult;
+    };
+
+    TEST_F(ObjectGridTest, findInRadiusShouldReturnObjectsWithinRadiusSortedByDistance)
+    {
+        mGrid.add(makeId(1), osg::Vec3f(90, 0, 0), actor);
+        mGrid.add(makeId(2), osg::Vec3f(-30, 40, 0), actor);
+        mGrid.add(makeId(3), osg::Vec3f(0, 0, 101), actor);
+        mGrid.add(makeId(4), osg::Vec3f(1000, 1000, 0), actor);
+        mGrid.findInRadius(osg::Vec3f(0, 0, 0), 100, actor, mResult);
+        EXPECT_THAT(mResult, ElementsAre(makeId(2), makeId(1)));
+    }
+
+    TEST_F(ObjectGridTest, findInRadiusShouldFindObjectsInNeighbourCells)
+    {
+        mGrid.add(makeId(1), osg::Vec3f(-1, -1, 0), actor);
+        mGrid.add(makeId(2), osg::Vec3f(199, 1, 0), actor);
+        mGrid.findInRadius(osg::Vec3f(99, 0, 0), 101, actor, mResult);
+        EXPECT_THAT(mResult, ElementsAre(makeId(1), makeId(2)));
+    }
+
+    TEST_F(ObjectGridTest, findInRadiusShouldOrderObjectsWithSameDistanceById)
+    {
+        mGrid.add(makeId(3), osg::Vec3f(10, 0, 0), actor);
+        mGrid.add(makeId(1), osg::Vec3f(-10, 0, 0), actor);
+        mGrid.add(makeId(2), osg::Vec3f(0, 10, 0), actor);
+        mGrid.findInRadius(osg::Vec3f(0, 0, 0), 50, actor, mResult);
+        EXPECT_THAT(mResult, ElementsAre(makeId(1), makeId(2), makeId(3)));
+    }
+
+    TEST_F(ObjectGridTest, findInRadiusShouldFilterByFlags)
+    {
+        mGrid.add(makeId(1), osg::Vec3f(0, 0, 0), actor);
+        mGrid.add(makeId(2), osg::Vec3f(1, 0, 0), item);
+        mGrid.findInRadius(osg::Vec3f(0, 0, 0), 10, item, mResult);
+        EXPECT_THAT(mResult, ElementsAre(makeId(2)));
+        mGrid.findInRadius(osg::Vec3f(0, 0, 0), 10, actor | item, mResult);
+        EXPECT_THAT(mResult, ElementsAre(makeId(1), makeId(2)));
+    }
+
+    TEST_F(ObjectGridTest, findInRadiusShouldHandleRadiusLargerThanGrid)
+    {
+        mGrid.add(makeId(1), osg::Vec3f(-5000, 0, 0), actor);
+        mGrid.add(makeId(2), osg::Vec3f(3000, 3000, 0), actor);
+        mGrid.findInRadius(osg::Vec3f(0, 0, 0), 1e9f, actor, mResult);
+        EXPECT_THAT(mResult, ElementsAre(makeId(2), makeId(1)));
+    }
+
+    TEST_F(ObjectGridTest, clearShouldRemoveAllObjects)
+    {
+        mGrid.add(makeId(1), osg::Vec3f(0, 0, 0), actor);
+        mGrid.clear();
+        EXPECT_EQ(mGrid.size(), 0);
+        mGrid.findInRadius(osg::Vec3f(0, 0, 0), 10, actor, mResult);
+        EXPECT_THAT(mResult, IsEmpty());
+    }
+
+    TEST_F(ObjectGridTest, findInBoxShouldSupportRotatedBox)
+    {
+        mGrid.add(makeId(1), osg::Vec3f(0, 90, 0), actor);
+        mGrid.add(makeId(2), osg::Vec3f(90, 0, 0), actor);
+        mGrid.add(makeId(3), osg::Vec3f(0, 0, 0), actor);
+        const LuaUtil::Box box(osg::Vec3f(0, 0, 0), osg::Vec3f(100, 10, 10), osg::Quat(osg::PI_2, osg::Z_AXIS));
+        mGrid.findInBox(box, actor, mResult);
+        EXPECT_THAT(mResult, ElementsAre(makeId(3), makeId(1)));
+    }
+
+    TEST_F(ObjectGridTest, findInConeShouldReturnObjectsWithinAngleAndRange)
+    {
+        mGrid.add(makeId(1), osg::Vec3f(0, 100, 0), actor);
+        mGrid.add(makeId(2), osg::Vec3f(40, 100, 0), actor);
+        mGrid.add(makeId(3), osg::Vec3f(100, 100, 0), actor);
+        mGrid.add(makeId(4), osg::Vec3f(0, -100, 0), actor);
+        mGrid.add(makeId(5), osg::Vec3f(0, 300, 0), actor);
+        mGrid.findInCone(osg::Vec3f(0, 0, 0), osg::Vec3f(0, 2, 0), osg::DegreesToRadians(30.0f), 200, actor, mResult);
+        EXPECT_THAT(mResult, ElementsAre(makeId(1), makeId(2)));
+    }
+
+    TEST_F(ObjectGridTest, findInConeShouldReturnNothingForZeroDirection)
+    {
+        mGrid.add(makeId(1), osg::Vec3f(0, 100, 0), actor);
+        mGrid.findInCone(osg::Vec3f(0, 0, 0), osg::Vec3f(0, 0, 0), osg::PIf, 200, actor, mResult);
+        EXPECT_THAT(mResult, IsEmpty());
+    }
+}
@@ -0,0 +1,108 @@
+#include "apps/openmw/mwmechanics/cellportalgraph.hpp"
+
+#include <osg/io_utils>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <limits>
+#include <map>
+#include <utility>
+#include <vector>
+
+namespace
+{
+    using namespace testing;
+    using namespace MWMechanics;
+
+    ESM::Pathgrid makePathgrid(
+        const std::vector<ESM::Pathgrid::Point>& points, const std::vector<std::pair<std::size_t, std::size_t>>& edges)
+    {
+        ESM::Pathgrid result;
+        result.blank();
+        result.mPoints = points;
+        for (const auto& [v0, v1] : edges)
+        {
+            result.mEdges.push_back(ESM::Pathgrid::Edge{ v0, v1 });
+            result.mEdges.push_back(ESM::Pathgrid::Edge{ v1, v0 });
+        }
+        return result;
+    }
+
+    struct MWMechanicsCellPortalGraphTest : Test
+    {
+        std::map<std::pair<int, int>, ESM::Pathgrid> mPathgrids;
+        std::size_t mMaxSearchNodes = std::numeric_limits<std::size_t>::max();
+
+        MWMechanicsCellPortalGraphTest()
+        {
+            mPathgrids.emplace(std::pair(0, 0),
+                makePathgrid({ { 4096, 4096, 0 }, { 8000, 4096, 0 } }, { { 0, 1 } }));
+            mPathgrids.emplace(std::pair(1, 0),
+                makePathgrid({ { 200, 4096, 0 }, { 4096, 4096, 0 }, { 8000, 4096, 0 } }, { { 0, 1 }, { 1, 2 } }));
+            mPathgrids.emplace(std::pair(2, 0), makePathgrid({ { 200, 4096, 0 }, { 4096, 4096, 0 } }, { { 0, 1 } }));
+        }
+
+        CellPortalGraph makeGraph()
+        {
+            return CellPortalGraph(
+                [&](int cellX, int cellY) -> const ESM::Pathgrid* {
+                    const auto it = mPathgrids.find(std::pair(cellX, cellY));
+                    if (it == mPathgrids.end())
+                        return nullptr;
+                    return &it->second;
+                },
+                mMaxSearchNodes);
+        }
+    };
+
+    TEST_F(MWMechanicsCellPortalGraphTest, find_route_should_return_portals_between_cells)
+    {
+        CellPortalGraph graph = makeGraph();
+        std::vector<osg::Vec3f> route;
+        ASSERT_TRUE(graph.findRoute(osg::Vec3f(4096, 4096, 0), osg::Vec3f(2 * 8192 + 4096, 4096, 0), route));
+        EXPECT_THAT(route, ElementsAre(osg::Vec3f(8196, 4096, 0), osg::Vec3f(16388, 4096, 0)));
+    }
+
+    TEST_F(MWMechanicsCellPortalGraphTest, find_route_should_return_empty_route_for_points_in_the_same_cell)
+    {
+        CellPortalGraph graph = makeGraph();
+        std::vector<osg::Vec3f> route{ osg::Vec3f() };
+        ASSERT_TRUE(graph.findRoute(osg::Vec3f(4096, 4096, 0), osg::Vec3f(8000, 4096, 0), route));
+        EXPECT_THAT(route, IsEmpty());
+    }
+
+    TEST_F(MWMechanicsCellPortalGraphTest, find_route_should_fail_when_cell_on_the_way_has_no_pathgrid)
+    {
+        mPathgrids.erase(std::pair(1, 0));
+        CellPortalGraph graph = makeGraph();
+        std::vector<osg::Vec3f> route;
+        EXPECT_FALSE(graph.findRoute(osg::Vec3f(4096, 4096, 0), osg::Vec3f(2 * 8192 + 4096, 4096, 0), route));
+        EXPECT_THAT(route, IsEmpty());
+    }
+
+    TEST_F(MWMechanicsCellPortalGraphTest, find_route_should_fail_when_pathgrid_on_the_way_is_not_connected)
+    {
+        mPathgrids.insert_or_assign(std::pair(1, 0),
+            makePathgrid({ { 200, 4096, 0 }, { 4096, 4096, 0 }, { 8000, 4096, 0 } }, { { 0, 1 } }));
+        CellPortalGraph graph = makeGraph();
+        std::vector<osg::Vec3f> route;
+        EXPECT_FALSE(graph.findRoute(osg::Vec3f(4096, 4096, 0), osg::Vec3f(2 * 8192 + 4096, 4096, 0), route));
+    }
+
+    TEST_F(MWMechanicsCellPortalGraphTest, find_route_should_fail_when_search_nodes_limit_is_reached)
+    {
+        mMaxSearchNodes = 1;
+        CellPortalGraph graph = makeGraph();
+        std::vector<osg::Vec3f> route;
+        EXPECT_FALSE(graph.findRoute(osg::Vec3f(4096, 4096, 0), osg::Vec3f(2 * 8192 + 4096, 4096, 0), route));
+    }
+
+    TEST_F(MWMechanicsCellPortalGraphTest, find_route_should_load_only_cells_near_the_route)
+    {
+        CellPortalGraph graph = makeGraph();
+        std::vector<osg::Vec3f> route;
+        ASSERT_TRUE(graph.findRoute(osg::Vec3f(4096, 4096, 0), osg::Vec3f(2 * 8192 + 4096, 4096, 0), route));
+        EXPECT_LE(graph.getCellsCount(), 10);
+    }
+}
@@ -0,0 +1,138 @@
+#include "apps/openmw/mwphysics/regionbroadphase.hpp"
+
+#include <BulletCollision/CollisionDispatch/btCollisionDispatcher.h>
+#include <BulletCollision/CollisionDispatch/btCollisionObject.h>
+#include <BulletCollision/CollisionDispatch/btCollisionWorld.h>
+#include <BulletCollision/CollisionDispatch/btDefaultCollisionConfiguration.h>
+#include <BulletCollision/CollisionShapes/btBoxShape.h>
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <vector>
+
+namespace
+{
+    using namespace testing;
+    using namespace MWPhysics;
+
+    struct CountAabbCallback final : btBroadphaseAabbCallback
+    {
+        std::vector<const btBroadphaseProxy*> mProxies;
+
+        bool process(const btBroadphaseProxy* proxy) override
+        {
+            mProxies.push_back(proxy);
+            return true;
+        }
+    };
+
+    struct MWPhysicsRegionBroadphaseTest : Test
+    {
+        const btScalar mRegionSize = 100;
+        btDefaultCollisionConfiguration mConfiguration;
+        btCollisionDispatcher mDispatcher{ &mConfiguration };
+        RegionBroadphase mBroadphase{ mRegionSize };
+        btCollisionWorld mWorld{ &mDispatcher, &mBroadphase, &mConfiguration };
+        btBoxShape mSmallShape{ btVector3(10, 10, 10) };
+        btBoxShape mLargeShape{ btVector3(1000, 1000, 10) };
+        std::vector<std::unique_ptr<btCollisionObject>> mObjects;
+
+        ~MWPhysicsRegionBroadphaseTest()
+        {
+            for (const auto& object : mObjects)
+                if (object->getBroadphaseHandle() != nullptr)
+                    mWorld.removeCollisionObject(object.get());
+        }
+
+        btCollisionObject& add(btCollisionShape& shape, const btVector3& position)
+        {
+            auto object = std::make_unique<btCollisionObject>();
+            object->setCollisionShape(&shape);
+            object->setWorldTransform(btTransform(btMatrix3x3::getIdentity(), position));
+            mWorld.addCollisionObject(object.get());
+            return *mObjects.emplace_back(std::move(object));
+        }
+
+        int countRayHits(const btVector3& from, const btVector3& to)
+        {
+            btCollisionWorld::AllHitsRayResultCallback callback(from, to);
+            mWorld.rayTest(from, to, callback);
+            return callback.m_collisionObjects.size();
+        }
+    };
+
+    TEST_F(MWPhysicsRegionBroadphaseTest, shouldPutObjectsIntoRegionsByPosition)
+    {
+        add(mSmallShape, btVector3(0, 0, 0));
+        add(mSmallShape, btVector3(50, 50, 0));
+        add(mSmallShape, btVector3(350, 0, 0));
+        EXPECT_EQ(mBroadphase.getRegionsCount(), 3);
+    }
+
+    TEST_F(MWPhysicsRegionBroadphaseTest, shouldPutObjectsLargerThanRegionIntoGlobalRegion)
+    {
+        add(mLargeShape, btVector3(0, 0, 0));
+        EXPECT_EQ(mBroadphase.getRegionsCount(), 1);
+    }
+
+    TEST_F(MWPhysicsRegionBroadphaseTest, rayTestShouldFindObjectsInAllRegionsAlongRay)
+    {
+        add(mSmallShape, btVector3(0, 0, 0));
+        add(mSmallShape, btVector3(350, 0, 0));
+        add(mSmallShape, btVector3(350, 350, 0));
+        add(mLargeShape, btVector3(0, 0, -100));
+        EXPECT_EQ(countRayHits(btVector3(-100, 0, 0), btVector3(500, 0, 0)), 2);
+        EXPECT_EQ(countRayHits(btVector3(350, 350, 100), btVector3(350, 350, -200)), 2);
+    }
+
+    TEST_F(MWPhysicsRegionBroadphaseTest, closestRayTestShouldReturnNearestObject)
+    {
+        add(mSmallShape, btVector3(0, 0, 0));
+        const btCollisionObject& nearest = add(mSmallShape, btVector3(350, 0, 0));
+        const btVector3 from(500, 0, 0);
+        const btVector3 to(-500, 0, 0);
+        btCollisionWorld::ClosestRayResultCallback callback(from, to);
+        mWorld.rayTest(from, to, callback);
+        ASSERT_TRUE(callback.hasHit());
+        EXPECT_EQ(callback.m_collisionObject, &nearest);
+    }
+
+    TEST_F(MWPhysicsRegionBroadphaseTest, aabbTestShouldFindObjectCrossingRegionBorder)
+    {
+        const btCollisionObject& object = add(mSmallShape, btVector3(95, 0, 0));
+        CountAabbCallback callback;
+        mBroadphase.aabbTest(btVector3(101, -1, -1), btVector3(103, 1, 1), callback);
+        ASSERT_EQ(callback.mProxies.size(), 1);
+        EXPECT_EQ(callback.mProxies[0], object.getBroadphaseHandle());
+    }
+
+    TEST_F(MWPhysicsRegionBroadphaseTest, movedObjectShouldBeFoundInNewRegion)
+    {
+        btCollisionObject& object = add(mSmallShape, btVector3(0, 0, 0));
+        object.setWorldTransform(btTransform(btMatrix3x3::getIdentity(), btVector3(1000, 0, 0)));
+        mWorld.updateSingleAabb(&object);
+        EXPECT_EQ(countRayHits(btVector3(-50, 0, 0), btVector3(50, 0, 0)), 0);
+        EXPECT_EQ(countRayHits(btVector3(950, 0, 0), btVector3(1050, 0, 0)), 1);
+    }
+
+    TEST_F(MWPhysicsRegionBroadphaseTest, removedObjectShouldNotBeFound)
+    {
+        btCollisionObject& object = add(mSmallShape, btVector3(0, 0, 0));
+        mWorld.removeCollisionObject(&object);
+        EXPECT_EQ(countRayHits(btVector3(-50, 0, 0), btVector3(50, 0, 0)), 0);
+    }
+
+    TEST_F(MWPhysicsRegionBroadphaseTest, pinShouldUnlockRegionsWhenDestroyed)
+    {
+        add(mSmallShape, btVector3(0, 0, 0));
+        add(mSmallShape, btVector3(350, 0, 0));
+        {
+            const RegionBroadphase::Pin pin(&mBroadphase);
+            EXPECT_EQ(countRayHits(btVector3(-100, 0, 0), btVector3(500, 0, 0)), 2);
+            EXPECT_EQ(countRayHits(btVector3(-100, 0, 0), btVector3(500, 0, 0)), 2);
+        }
+        add(mSmallShape, btVector3(50, 0, 0));
+        EXPECT_EQ(countRayHits(btVector3(-100, 0, 0), btVector3(500, 0, 0)), 3);
+    }
+}
@@ -0,0 +1,73 @@
+#include "apps/openmw/mwscript/scriptcache.hpp"
+
+#include <components/testing/util.hpp>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <stdexcept>
+
+namespace
+{
+    using namespace testing;
+    using namespace MWScript;
+
+    struct ScriptCacheTest : Test
+    {
+        const std::filesystem::path mPath = TestingOpenMW::outputFilePath("scripts.bin");
+        const ScriptHash mKey{ 1, 2 };
+        const ESM::RefId mId = ESM::RefId::stringRefId("script");
+        CachedScripts mScripts;
+
+        ScriptCacheTest()
+        {
+            std::filesystem::remove(mPath);
+            CachedScript& script = mScripts[mId];
+            script.mSourceHash = { 3, 4 };
+            script.mProgram.mInstructions = { 0x1, 0x2000005, 0xc4000000 };
+            script.mProgram.mIntegers = { 42, -13 };
+            script.mProgram.mFloats = { 0.5f };
+            script.mProgram.mStrings = { "player", "" };
+            script.mLocals.declare('s', "counter");
+            script.mLocals.declare('f', "timer");
+            script.mLocals.declare('f', "speed");
+        }
+    };
+
+    TEST_F(ScriptCacheTest, readShouldReturnNulloptForMissingFile)
+    {
+        EXPECT_FALSE(readScriptCache(mPath, mKey).has_value());
+    }
+
+    TEST_F(ScriptCacheTest, readShouldReturnWrittenScriptsForSameKey)
+    {
+        writeScriptCache(mPath, mKey, mScripts);
+        const std::optional<CachedScripts> result = readScriptCache(mPath, mKey);
+        ASSERT_TRUE(result.has_value());
+        ASSERT_EQ(result->size(), 1);
+        const CachedScript& expected = mScripts.at(mId);
+        const CachedScript& script = result->at(mId);
+        EXPECT_EQ(script.mSourceHash, expected.mSourceHash);
+        EXPECT_EQ(script.mProgram.mInstructions, expected.mProgram.mInstructions);
+        EXPECT_EQ(script.mProgram.mIntegers, expected.mProgram.mIntegers);
+        EXPECT_EQ(script.mProgram.mFloats, expected.mProgram.mFloats);
+        EXPECT_EQ(script.mProgram.mStrings, expected.mProgram.mStrings);
+        EXPECT_THAT(script.mLocals.get('s'), ElementsAre("counter"));
+        EXPECT_THAT(script.mLocals.get('l'), IsEmpty());
+        EXPECT_THAT(script.mLocals.get('f'), ElementsAre("timer", "speed"));
+    }
+
+    TEST_F(ScriptCacheTest, readShouldReturnNulloptForDifferentKey)
+    {
+        writeScriptCache(mPath, mKey, mScripts);
+        EXPECT_FALSE(readScriptCache(mPath, ScriptHash{ 1, 3 }).has_value());
+    }
+
+    TEST_F(ScriptCacheTest, readShouldThrowExceptionForTruncatedFile)
+    {
+        writeScriptCache(mPath, mKey, mScripts);
+        std::filesystem::resize_file(mPath, std::filesystem::file_size(mPath) - 1);
+        EXPECT_THROW(readScriptCache(mPath, mKey), std::runtime_error);
+    }
+}
@@ -1,7 +1,12 @@
 #include <gtest/gtest.h>
 
 #include <array>
+#include <span>
 #include <sstream>
+#include <stdexcept>
+#include <vector>
+
+#include <components/compiler/generator.hpp>
 
 #include "testutils.hpp"
 
@@ -60,6 +65,17 @@ namespace
             mInterpreter.run(script.mProgram, context);
         }
 
+        std::vector<Interpreter::PreparedInstruction> prepare(const Interpreter::Program& program) const
+        {
+            return mInterpreter.prepare(program);
+        }
+
+        void run(const Interpreter::Program& program, std::span<const Interpreter::PreparedInstruction> instructions,
+            TestInterpreterContext& context)
+        {
+            mInterpreter.run(program, instructions, context);
+        }
+
         template <typename T, typename... TArgs>
         void installOpcode(int code, TArgs&&... args)
         {
@@ -614,6 +630,42 @@ End)mwscript";
         }
     }
 
+    TEST_F(MWScriptTest, mwscript_test_math_prepared)
+    {
+        if (const auto script = compile(sScript3))
+        {
+            const std::vector<Interpreter::PreparedInstruction> instructions = prepare(script->mProgram);
+            ASSERT_EQ(instructions.size(), script->mProgram.mInstructions.size());
+            TestInterpreterContext context;
+            TestInterpreterContext preparedContext;
+            for (int i = 1; i < 1000; ++i)
+            {
+                context.setLocalShort(0, i);
+                run(*script, context);
+                preparedContext.setLocalShort(0, i);
+                run(script->mProgram, instructions, preparedContext);
+                for (int j = 0; j < 5; ++j)
+                    EXPECT_EQ(preparedContext.getLocalShort(j), context.getLocalShort(j)) << i << " " << j;
+            }
+        }
+        else
+        {
+            FAIL();
+        }
+    }
+
+    TEST_F(MWScriptTest, mwscript_test_prepared_unknown_opcode_should_throw_only_when_executed)
+    {
+        Interpreter::Program program;
+        program.mInstructions.push_back(Compiler::Generator::segment5(0x3ffffff));
+        const std::vector<Interpreter::PreparedInstruction> instructions = prepare(program);
+        TestInterpreterContext context;
+        EXPECT_THROW(run(program, instructions, context), std::runtime_error);
+
+        program.mInstructions.insert(program.mInstructions.begin(), Compiler::Generator::segment5(20)); // return
+        EXPECT_NO_THROW(run(program, prepare(program), context));
+    }
+
     TEST_F(MWScriptTest, mwscript_test_forum_thread)
     {
         registerExtensions();
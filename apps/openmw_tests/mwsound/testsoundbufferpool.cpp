@@ -0,0 +1,222 @@
+#include "apps/openmw/mwbase/environment.hpp"
+#include "apps/openmw/mwsound/soundbuffer.hpp"
+#include "apps/openmw/mwsound/soundmanagerimp.hpp"
+#include "apps/openmw/mwworld/esmstore.hpp"
+
+#include <components/esm3/loadgmst.hpp>
+#include <components/settings/values.hpp>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <set>
+#include <thread>
+
+namespace
+{
+    using namespace testing;
+    using namespace MWSound;
+
+    constexpr std::size_t bufferSize = 1024 * 1024;
+
+    class FakeSoundOutput final : public SoundOutput
+    {
+    public:
+        explicit FakeSoundOutput(SoundManager& manager)
+            : SoundOutput(manager)
+        {
+            mInitialized = true;
+        }
+
+        std::set<std::string> mDecoded;
+        std::map<std::string, std::size_t> mLoaded;
+        std::thread::id mDecodeThread;
+
+    private:
+        std::mutex mMutex;
+
+        std::vector<std::string> enumerate() override { return {}; }
+        bool init(const std::string&, const std::string&, HrtfMode) override { return true; }
+        void deinit() override {}
+        std::vector<std::string> enumerateHrtf() override { return {}; }
+
+        DecodedSound decodeSound(VFS::Path::NormalizedView fname) override
+        {
+            const std::lock_guard lock(mMutex);
+            mDecoded.emplace(fname.value());
+            mDecodeThread = std::this_thread::get_id();
+            DecodedSound result;
+            result.mData.assign(fname.value().begin(), fname.value().end());
+            return result;
+        }
+
+        std::pair<Sound_Handle, size_t> loadSound(DecodedSound&& sound) override
+        {
+            return load(std::string(sound.mData.begin(), sound.mData.end()));
+        }
+
+        std::pair<Sound_Handle, size_t> loadSound(VFS::Path::NormalizedView fname) override
+        {
+            return load(std::string(fname.value()));
+        }
+
+        size_t unloadSound(Sound_Handle data) override
+        {
+            const auto it = mLoaded.find(*static_cast<const std::string*>(data));
+            const std::size_t size = it->second;
+            mLoaded.erase(it);
+            return size;
+        }
+
+        std::pair<Sound_Handle, size_t> load(std::string&& name)
+        {
+            const auto it = mLoaded.emplace(std::move(name), bufferSize).first;
+            return { const_cast<std::string*>(&it->first), it->second };
+        }
+
+        bool playSound(Sound*, Sound_Handle, float) override { return false; }
+        bool playSound3D(Sound*, Sound_Handle, float) override { return false; }
+        void finishSound(Sound*) override {}
+        bool isSoundPlaying(Sound*) override { return false; }
+        void updateSound(Sound*) override {}
+
+        bool streamSound(DecoderPtr, Stream*, bool) override { return false; }
+        bool streamSound3D(DecoderPtr, Stream*, bool) override { return false; }
+        void finishStream(Stream*) override {}
+        double getStreamDelay(Stream*) override { return 0; }
+        float getStreamOffset(Stream*) override { return 0; }
+        float getStreamLoudness(Stream*) override { return 0; }
+        bool isStreamPlaying(Stream*) override { return false; }
+        void updateStream(Stream*) override {}
+
+        void startUpdate() override {}
+        void finishUpdate() override {}
+
+        void updateListener(const osg::Vec3f&, const osg::Vec3f&, const osg::Vec3f&, const osg::Vec3f&,
+            MWSound::Environment) override
+        {
+        }
+
+        void pauseSounds(int) override {}
+        void resumeSounds(int) override {}
+
+        void pauseActiveDevice() override {}
+        void resumeActiveDevice() override {}
+    };
+
+    struct SoundBufferPoolTest : Test
+    {
+        MWBase::Environment mEnvironment;
+        MWWorld::ESMStore mStore;
+        SoundManager mManager{ nullptr, false };
+        FakeSoundOutput mOutput{ mManager };
+
+        SoundBufferPoolTest()
+        {
+            for (const char* name : { "fAudioDefaultMinDistance", "fAudioDefaultMaxDistance", "fAudioMinDistanceMult",
+                     "fAudioMaxDistanceMult" })
+            {
+                ESM::GameSetting setting;
+                setting.mId = ESM::RefId::stringRefId(name);
+                setting.mValue = ESM::Variant(1.0f);
+                mStore.insertStatic(setting);
+            }
+            mEnvironment.setESMStore(mStore);
+
+            Settings::sound().mAsyncLoadingThreads.set(1);
+            Settings::sound().mBufferCacheMin.set(1);
+            Settings::sound().mBufferCacheMax.set(2);
+        }
+
+        ~SoundBufferPoolTest()
+        {
+            Settings::sound().mAsyncLoadingThreads.reset();
+            Settings::sound().mBufferCacheMin.reset();
+            Settings::sound().mBufferCacheMax.reset();
+        }
+
+        static void waitForLoading(SoundBufferPool& pool, const SoundBuffer& sfx)
+        {
+            const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+            while (pool.isLoading(sfx) && std::chrono::steady_clock::now() < deadline)
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                pool.update();
+            }
+            ASSERT_FALSE(pool.isLoading(sfx));
+        }
+    };
+
+    TEST_F(SoundBufferPoolTest, loadAsyncShouldDecodeInBackgroundAndUploadOnUpdate)
+    {
+        SoundBufferPool pool(mOutput);
+        ASSERT_TRUE(pool.isAsync());
+
+        const VFS::Path::Normalized name("sound/a.wav");
+        SoundBuffer* const sfx = pool.loadAsync(name);
+        ASSERT_NE(sfx, nullptr);
+        EXPECT_EQ(pool.lookup(name), nullptr);
+
+        waitForLoading(pool, *sfx);
+
+        EXPECT_EQ(pool.lookup(name), sfx);
+        EXPECT_THAT(mOutput.mDecoded, ElementsAre("sound/a.wav"));
+        EXPECT_NE(mOutput.mDecodeThread, std::this_thread::get_id());
+        EXPECT_THAT(mOutput.mLoaded, ElementsAre(Pair("sound/a.wav", bufferSize)));
+    }
+
+    TEST_F(SoundBufferPoolTest, preloadedBufferShouldNotBeEvictedBeforeFirstUse)
+    {
+        SoundBufferPool pool(mOutput);
+
+        SoundBuffer* const played = pool.load(VFS::Path::Normalized("sound/played.wav"));
+        ASSERT_NE(played, nullptr);
+        pool.use(*played);
+        pool.release(*played);
+
+        SoundBuffer* const first = pool.loadAsync(VFS::Path::Normalized("sound/first.wav"));
+        ASSERT_NE(first, nullptr);
+        waitForLoading(pool, *first);
+
+        SoundBuffer* const second = pool.loadAsync(VFS::Path::Normalized("sound/second.wav"));
+        ASSERT_NE(second, nullptr);
+        waitForLoading(pool, *second);
+
+        EXPECT_EQ(played->getHandle(), nullptr);
+        EXPECT_NE(first->getHandle(), nullptr);
+        EXPECT_NE(second->getHandle(), nullptr);
+
+        pool.use(*first);
+        pool.release(*first);
+
+        SoundBuffer* const third = pool.loadAsync(VFS::Path::Normalized("sound/third.wav"));
+        ASSERT_NE(third, nullptr);
+        waitForLoading(pool, *third);
+
+        EXPECT_EQ(first->getHandle(), nullptr);
+        EXPECT_NE(second->getHandle(), nullptr);
+        EXPECT_NE(third->getHandle(), nullptr);
+    }
+
+    TEST_F(SoundBufferPoolTest, preloadedBuffersShouldNotExceedMaxCacheSize)
+    {
+        SoundBufferPool pool(mOutput);
+
+        std::vector<SoundBuffer*> buffers;
+        for (const char* name : { "sound/a.wav", "sound/b.wav", "sound/c.wav" })
+        {
+            SoundBuffer* const sfx = pool.loadAsync(VFS::Path::Normalized(name));
+            ASSERT_NE(sfx, nullptr);
+            waitForLoading(pool, *sfx);
+            buffers.push_back(sfx);
+        }
+
+        EXPECT_EQ(buffers[0]->getHandle(), nullptr);
+        EXPECT_NE(buffers[1]->getHandle(), nullptr);
+        EXPECT_NE(buffers[2]->getHandle(), nullptr);
+        EXPECT_THAT(mOutput.mLoaded, SizeIs(2));
+    }
+}
@@ -0,0 +1,84 @@
+#include "apps/openmw/mwworld/cellrefcache.hpp"
+
+#include <components/testing/util.hpp>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <filesystem>
+
+namespace
+{
+    using namespace testing;
+    using namespace MWWorld;
+
+    struct CellRefCacheTest : Test
+    {
+        const std::filesystem::path mPath = TestingOpenMW::outputFilePath("cellrefs.bin");
+        const std::vector<ContentFile> mContent{
+            ContentFile{ .mIndex = 0, .mName = "Morrowind.esm", .mSize = 10, .mModified = 20, .mHash = { 1, 2 } },
+            ContentFile{ .mIndex = 2, .mName = "Tribunal.esm", .mSize = 30, .mModified = 40, .mHash = { 3, 4 } },
+        };
+        CellRefSummary mSummary;
+
+        CellRefCacheTest()
+        {
+            std::filesystem::remove(mPath);
+            mSummary.mRefCount[ESM::RefId::stringRefId("chargen boat")] = 1;
+            mSummary.mRefCount[ESM::RefId::stringRefId("gold_001")] = 42;
+            mSummary.mKeyIds.push_back(ESM::RefId::stringRefId("key_chest"));
+        }
+    };
+
+    TEST_F(CellRefCacheTest, readShouldReturnNulloptForMissingFile)
+    {
+        EXPECT_FALSE(readCellRefCache(mPath).has_value());
+    }
+
+    TEST_F(CellRefCacheTest, readShouldReturnWrittenContentAndSummary)
+    {
+        writeCellRefCache(mPath, mContent, mSummary);
+        const std::optional<CellRefCache> result = readCellRefCache(mPath);
+        ASSERT_TRUE(result.has_value());
+        EXPECT_TRUE(haveSameStamps(result->mContent, mContent));
+        EXPECT_TRUE(haveSameHashes(result->mContent, mContent));
+        EXPECT_EQ(result->mSummary.mRefCount, mSummary.mRefCount);
+        EXPECT_EQ(result->mSummary.mKeyIds, mSummary.mKeyIds);
+    }
+
+    TEST_F(CellRefCacheTest, haveSameStampsShouldCompareSizeAndModificationTime)
+    {
+        std::vector<ContentFile> content = mContent;
+        content[1].mHash[0] = 5;
+        EXPECT_TRUE(haveSameStamps(content, mContent));
+        content[1].mModified = 41;
+        EXPECT_FALSE(haveSameStamps(content, mContent));
+        content = mContent;
+        content[0].mSize = 11;
+        EXPECT_FALSE(haveSameStamps(content, mContent));
+    }
+
+    TEST_F(CellRefCacheTest, haveSameHashesShouldIgnoreModificationTime)
+    {
+        std::vector<ContentFile> content = mContent;
+        content[1].mModified = 41;
+        EXPECT_TRUE(haveSameHashes(content, mContent));
+        content[1].mHash[0] = 5;
+        EXPECT_FALSE(haveSameHashes(content, mContent));
+    }
+
+    TEST_F(CellRefCacheTest, shouldNotMatchDifferentContentFiles)
+    {
+        std::vector<ContentFile> content = mContent;
+        content.pop_back();
+        EXPECT_FALSE(haveSameStamps(content, mContent));
+        EXPECT_FALSE(haveSameHashes(content, mContent));
+    }
+
+    TEST_F(CellRefCacheTest, readShouldThrowExceptionForTruncatedFile)
+    {
+        writeCellRefCache(mPath, mContent, mSummary);
+        std::filesystem::resize_file(mPath, std::filesystem::file_size(mPath) - 1);
+        EXPECT_THROW(readCellRefCache(mPath), std::runtime_error);
+    }
+}
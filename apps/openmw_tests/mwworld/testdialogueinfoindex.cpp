@@ -0,0 +1,121 @@
+#include "apps/openmw/mwworld/dialogueinfoindex.hpp"
+
+#include <components/esm3/loaddial.hpp>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <string_view>
+#include <vector>
+
+namespace
+{
+    using namespace testing;
+    using namespace MWWorld;
+
+    struct DialogueInfoIndexTest : Test
+    {
+        ESM::Dialogue mDialogue;
+        std::vector<const ESM::DialInfo*> mCandidates;
+        DialogueInfoIndex::Query mQuery{
+            .mActor = ESM::RefId::stringRefId("fargoth"),
+            .mCreature = false,
+            .mRace = ESM::RefId::stringRefId("wood elf"),
+            .mClass = ESM::RefId::stringRefId("commoner"),
+            .mFaction = ESM::RefId(),
+            .mCell = "Seyda Neen, Arrille's Tradehouse",
+        };
+
+        DialogueInfoIndexTest() { mDialogue.blank(); }
+
+        ESM::DialInfo& addInfo(std::string_view id)
+        {
+            ESM::DialInfo& info = mDialogue.mInfo.emplace_back();
+            info.blank();
+            info.mId = ESM::RefId::stringRefId(id);
+            return info;
+        }
+
+        std::vector<ESM::RefId> getCandidateIds()
+        {
+            DialogueInfoIndex(mDialogue).getCandidates(mQuery, mCandidates);
+            std::vector<ESM::RefId> result;
+            for (const ESM::DialInfo* info : mCandidates)
+                result.push_back(info->mId);
+            return result;
+        }
+    };
+
+    TEST_F(DialogueInfoIndexTest, getCandidatesShouldReturnAllInfosInOrderWithoutConditions)
+    {
+        addInfo("b");
+        addInfo("a");
+        addInfo("c");
+        EXPECT_THAT(getCandidateIds(),
+            ElementsAre(ESM::RefId::stringRefId("b"), ESM::RefId::stringRefId("a"), ESM::RefId::stringRefId("c")));
+    }
+
+    TEST_F(DialogueInfoIndexTest, getCandidatesShouldSkipInfosForOtherSpeakers)
+    {
+        addInfo("other actor").mActor = ESM::RefId::stringRefId("hrisskar flat-foot");
+        addInfo("same actor").mActor = ESM::RefId::stringRefId("fargoth");
+        addInfo("other race").mRace = ESM::RefId::stringRefId("dark elf");
+        addInfo("same race").mRace = ESM::RefId::stringRefId("wood elf");
+        addInfo("other class").mClass = ESM::RefId::stringRefId("warrior");
+        addInfo("same class").mClass = ESM::RefId::stringRefId("commoner");
+        addInfo("other faction").mFaction = ESM::RefId::stringRefId("hlaalu");
+        addInfo("any");
+        EXPECT_THAT(getCandidateIds(),
+            ElementsAre(ESM::RefId::stringRefId("same actor"), ESM::RefId::stringRefId("same race"),
+                ESM::RefId::stringRefId("same class"), ESM::RefId::stringRefId("any")));
+    }
+
+    TEST_F(DialogueInfoIndexTest, getCandidatesShouldMatchFactionLessInfosOnlyForActorWithoutFaction)
+    {
+        ESM::DialInfo& factionLess = addInfo("faction less");
+        factionLess.mFaction = ESM::RefId::stringRefId("FFFF");
+        factionLess.mFactionLess = true;
+        addInfo("faction").mFaction = ESM::RefId::stringRefId("hlaalu");
+        EXPECT_THAT(getCandidateIds(), ElementsAre(ESM::RefId::stringRefId("faction less")));
+        mQuery.mFaction = ESM::RefId::stringRefId("Hlaalu");
+        EXPECT_THAT(getCandidateIds(), ElementsAre(ESM::RefId::stringRefId("faction")));
+    }
+
+    TEST_F(DialogueInfoIndexTest, getCandidatesShouldMatchCellByPrefix)
+    {
+        addInfo("other cell").mCell = ESM::RefId::stringRefId("Balmora");
+        addInfo("cell prefix").mCell = ESM::RefId::stringRefId("seyda neen");
+        addInfo("same cell").mCell = ESM::RefId::stringRefId("Seyda Neen, Arrille's Tradehouse");
+        addInfo("longer cell").mCell = ESM::RefId::stringRefId("Seyda Neen, Arrille's Tradehouse, Upstairs");
+        EXPECT_THAT(getCandidateIds(),
+            ElementsAre(ESM::RefId::stringRefId("cell prefix"), ESM::RefId::stringRefId("same cell")));
+    }
+
+    TEST_F(DialogueInfoIndexTest, getCandidatesShouldReturnOnlyInfosForCreatureId)
+    {
+        mQuery.mCreature = true;
+        mQuery.mActor = ESM::RefId::stringRefId("mudcrab");
+        addInfo("any");
+        addInfo("creature").mActor = ESM::RefId::stringRefId("mudcrab");
+        ESM::DialInfo& creatureWithRace = addInfo("creature with race");
+        creatureWithRace.mActor = ESM::RefId::stringRefId("mudcrab");
+        creatureWithRace.mRace = ESM::RefId::stringRefId("dark elf");
+        addInfo("race").mRace = ESM::RefId::stringRefId("dark elf");
+        EXPECT_THAT(getCandidateIds(),
+            ElementsAre(ESM::RefId::stringRefId("creature"), ESM::RefId::stringRefId("creature with race")));
+    }
+
+    TEST_F(DialogueInfoIndexTest, getCandidatesShouldIntersectAllConditions)
+    {
+        ESM::DialInfo& matching = addInfo("matching");
+        matching.mRace = ESM::RefId::stringRefId("wood elf");
+        matching.mCell = ESM::RefId::stringRefId("Seyda Neen");
+        ESM::DialInfo& otherCell = addInfo("other cell");
+        otherCell.mRace = ESM::RefId::stringRefId("wood elf");
+        otherCell.mCell = ESM::RefId::stringRefId("Balmora");
+        ESM::DialInfo& otherRace = addInfo("other race");
+        otherRace.mRace = ESM::RefId::stringRefId("dark elf");
+        otherRace.mCell = ESM::RefId::stringRefId("Seyda Neen");
+        EXPECT_THAT(getCandidateIds(), ElementsAre(ESM::RefId::stringRefId("matching")));
+    }
+}
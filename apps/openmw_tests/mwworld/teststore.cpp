@@ -342,6 +342,46 @@ TYPED_TEST_P(StoreTest, delete_test)
     }
 }
 
+/// Tests loading of records read ahead by another reader.
+TYPED_TEST_P(StoreTest, staged_load_test)
+{
+    using RecordType = TypeParam;
+
+    for (const ESM::FormatVersion formatVersion : getFormats())
+    {
+        SCOPED_TRACE("FormatVersion: " + std::to_string(formatVersion));
+        const ESM::RefId recordId = ESM::RefId::stringRefId("foobar");
+
+        RecordType record;
+        if constexpr (hasBlankFunction<RecordType>)
+            record.blank();
+        record.mId = recordId;
+
+        ESM::ESMReader reader;
+        ESM::Dialogue* dialogue = nullptr;
+        MWWorld::ESMStore esmStore;
+
+        const auto loadStaged = [&](bool deleted) {
+            ESM::ESMReader stagingReader;
+            stagingReader.open(getEsmFile(record, deleted, formatVersion), "filename");
+            const std::unique_ptr<MWWorld::ESMStore::StagedRecords> staged = esmStore.stage(stagingReader);
+            reader.open(getEsmFile(record, deleted, formatVersion), "filename");
+            esmStore.load(reader, *staged, &dummyListener, dialogue);
+        };
+
+        loadStaged(false); // master file inserts a record
+        loadStaged(true); // now a plugin deletes it
+        record.mModel = "the_new_model";
+        loadStaged(false); // now another plugin inserts it again with changed data
+        esmStore.setUp();
+
+        EXPECT_EQ(esmStore.get<RecordType>().getSize(), 1);
+        const RecordType* result = esmStore.get<RecordType>().search(recordId);
+        ASSERT_NE(result, nullptr);
+        EXPECT_EQ(result->mModel, "the_new_model");
+    }
+}
+
 template <typename T>
 static unsigned int hasSameRecordId(const MWWorld::Store<T>& store, ESM::RecNameInts recName)
 {
@@ -581,7 +621,7 @@ namespace
         RecordTypesTest, StoreSaveLoadTest, typename AsTestingTypes<RecordTypesWithSave>::Type);
 }
 
-REGISTER_TYPED_TEST_SUITE_P(StoreTest, overwrite_test, delete_test);
+REGISTER_TYPED_TEST_SUITE_P(StoreTest, overwrite_test, delete_test, staged_load_test);
 
 static_assert(std::tuple_size_v<RecordTypesWithModel> == 19);
 
@@ -2,6 +2,7 @@
 
 #include <algorithm>
 #include <cassert>
+#include <chrono>
 #include <cstring>
 #include <format>
 #include <istream>
@@ -14,6 +15,7 @@
 #include <components/vfs/pathutil.hpp>
 
 #include "ba2file.hpp"
+#include "decompressionpool.hpp"
 #include "memorystream.hpp"
 
 namespace Bsa
@@ -601,44 +603,65 @@ namespace Bsa
         size_t headerSize = (header.ddspf.fourCC == ESM::fourCC("DX10") ? sizeof(DDSHeaderDX10) : sizeof(DDSHeader));
 
         size_t textureSize = sizeof(uint32_t) + headerSize; //"DDS " + header
-        uint32_t maxPackedChunkSize = 0;
+        std::vector<size_t> chunkOffsets;
+        chunkOffsets.reserve(fileRecord.texturesChunks.size());
         for (const auto& textureChunk : fileRecord.texturesChunks)
         {
+            chunkOffsets.push_back(textureSize);
             textureSize += textureChunk.size;
-            maxPackedChunkSize = std::max(textureChunk.packedSize, maxPackedChunkSize);
         }
 
         auto memoryStreamPtr = std::make_unique<MemoryInputStream>(textureSize);
         char* buff = memoryStreamPtr->getRawData();
-        std::vector<char> inputBuffer(maxPackedChunkSize);
 
         uint32_t dds = ESM::fourCC("DDS ");
         buff = (char*)std::memcpy(buff, &dds, sizeof(uint32_t)) + sizeof(uint32_t);
         std::memcpy(buff, &header, headerSize);
 
-        size_t offset = sizeof(uint32_t) + headerSize;
-        // append chunks
-        for (const auto& c : fileRecord.texturesChunks)
-        {
+        // append chunks, each chunk is independent so they are decompressed in parallel when a pool is set
+        const auto readChunk = [&](std::size_t index) {
+            const auto& c = fileRecord.texturesChunks[index];
+            char* const output = memoryStreamPtr->getRawData() + chunkOffsets[index];
             const uint32_t inputSize = c.packedSize != 0 ? c.packedSize : c.size;
-            Files::IStreamPtr streamPtr = Files::openConstrainedFileStream(mFilepath, c.offset, inputSize);
+            // Read chunks directly from the mapped archive when possible
+            std::vector<char> inputBuffer;
+            const char* input = getMappedData(c.offset, inputSize);
+            if (input == nullptr)
+            {
+                Files::IStreamPtr streamPtr = Files::openConstrainedFileStream(mFilepath, c.offset, inputSize);
+                char* destination = output;
+                if (c.packedSize != 0)
+                {
+                    inputBuffer.resize(inputSize);
+                    destination = inputBuffer.data();
+                }
+                streamPtr->read(destination, inputSize);
+                input = destination;
+            }
             if (c.packedSize != 0)
             {
-                streamPtr->read(inputBuffer.data(), c.packedSize);
+                const auto start = std::chrono::steady_clock::now();
                 uLongf destSize = static_cast<uLongf>(c.size);
-                int ec = ::uncompress(reinterpret_cast<Bytef*>(memoryStreamPtr->getRawData() + offset), &destSize,
-                    reinterpret_cast<Bytef*>(inputBuffer.data()), static_cast<uLong>(c.packedSize));
+                int ec = ::uncompress(reinterpret_cast<Bytef*>(output), &destSize,
+                    reinterpret_cast<const Bytef*>(input), static_cast<uLong>(c.packedSize));
 
                 if (ec != Z_OK)
                     fail("zlib uncompress failed: " + std::string(::zError(ec)));
+                if (mDecompressionPool != nullptr)
+                    mDecompressionPool->addStats(c.packedSize, c.size, std::chrono::steady_clock::now() - start);
             }
             // uncompressed chunk
-            else
+            else if (input != output)
             {
-                streamPtr->read(memoryStreamPtr->getRawData() + offset, c.size);
+                std::memcpy(output, input, c.size);
             }
-            offset += c.size;
-        }
+        };
+
+        if (mDecompressionPool != nullptr)
+            mDecompressionPool->parallelFor(fileRecord.texturesChunks.size(), readChunk);
+        else
+            for (std::size_t i = 0; i < fileRecord.texturesChunks.size(); ++i)
+                readChunk(i);
 
         return std::make_unique<Files::StreamWithBuffer<MemoryInputStream>>(std::move(memoryStreamPtr));
     }
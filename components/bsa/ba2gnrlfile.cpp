@@ -2,6 +2,7 @@
 
 #include <algorithm>
 #include <cassert>
+#include <chrono>
 #include <format>
 #include <fstream>
 
@@ -13,6 +14,7 @@
 #include <components/vfs/pathutil.hpp>
 
 #include "ba2file.hpp"
+#include "decompressionpool.hpp"
 #include "memorystream.hpp"
 
 namespace Bsa
@@ -174,22 +176,36 @@ namespace Bsa
     Files::IStreamPtr BA2GNRLFile::getFile(const FileRecord& fileRecord)
     {
         const uint32_t inputSize = fileRecord.packedSize ? fileRecord.packedSize : fileRecord.size;
-        Files::IStreamPtr streamPtr = Files::openConstrainedFileStream(mFilepath, fileRecord.offset, inputSize);
+        const char* const mappedData = getMappedData(fileRecord.offset, inputSize);
+        // Stored files are returned as a view of the mapped archive without copying
+        if (mappedData != nullptr && !fileRecord.packedSize)
+            return makeMappedStream(mappedData, fileRecord.size);
         auto memoryStreamPtr = std::make_unique<MemoryInputStream>(fileRecord.size);
         if (fileRecord.packedSize)
         {
-            std::vector<char> buffer(inputSize);
-            streamPtr->read(buffer.data(), inputSize);
+            std::vector<char> buffer;
+            const char* input = mappedData;
+            if (input == nullptr)
+            {
+                buffer.resize(inputSize);
+                Files::openConstrainedFileStream(mFilepath, fileRecord.offset, inputSize)
+                    ->read(buffer.data(), inputSize);
+                input = buffer.data();
+            }
+            const auto start = std::chrono::steady_clock::now();
             uLongf destSize = static_cast<uLongf>(fileRecord.size);
             int ec = ::uncompress(reinterpret_cast<Bytef*>(memoryStreamPtr->getRawData()), &destSize,
-                reinterpret_cast<Bytef*>(buffer.data()), static_cast<uLong>(buffer.size()));
+                reinterpret_cast<const Bytef*>(input), static_cast<uLong>(inputSize));
 
             if (ec != Z_OK)
                 fail("zlib uncompress failed: " + std::string(::zError(ec)));
+            if (mDecompressionPool != nullptr)
+                mDecompressionPool->addStats(inputSize, fileRecord.size, std::chrono::steady_clock::now() - start);
         }
         else
         {
-            streamPtr->read(memoryStreamPtr->getRawData(), fileRecord.size);
+            Files::openConstrainedFileStream(mFilepath, fileRecord.offset, inputSize)
+                ->read(memoryStreamPtr->getRawData(), fileRecord.size);
         }
         return std::make_unique<Files::StreamWithBuffer<MemoryInputStream>>(std::move(memoryStreamPtr));
     }
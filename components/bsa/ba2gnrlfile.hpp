@@ -40,6 +40,7 @@ namespace Bsa
         using BSAFile::getList;
         using BSAFile::getPath;
         using BSAFile::open;
+        using BSAFile::setDecompressionPool;
 
         BA2GNRLFile();
         virtual ~BA2GNRLFile();
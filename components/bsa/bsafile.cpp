@@ -35,10 +35,26 @@
 
 #include <components/esm/fourcc.hpp>
 #include <components/files/constrainedfilestream.hpp>
+#include <components/files/memorystream.hpp>
+#include <components/files/streamwithbuffer.hpp>
 #include <components/files/utils.hpp>
 
 using namespace Bsa;
 
+namespace
+{
+    struct MappedBuffer final : Files::MemBuf
+    {
+        std::shared_ptr<const Platform::File::ScopedMapping> mMapping;
+
+        MappedBuffer(std::shared_ptr<const Platform::File::ScopedMapping> mapping, const char* data, std::size_t size)
+            : Files::MemBuf(data, size)
+            , mMapping(std::move(mapping))
+        {
+        }
+    };
+}
+
 /// Error handling
 [[noreturn]] void BSAFile::fail(const std::string& msg) const
 {
@@ -265,8 +281,14 @@ void BSAFile::open(const std::filesystem::path& file)
     mFilepath = file;
     if (std::filesystem::exists(file))
     {
-        std::ifstream input(mFilepath, std::ios_base::binary);
-        readHeader(input);
+        {
+            std::ifstream input(mFilepath, std::ios_base::binary);
+            readHeader(input);
+        }
+        const Platform::File::ScopedHandle handle = Platform::File::open(mFilepath);
+        Platform::File::ScopedMapping mapping(Platform::File::map(handle));
+        if (!mapping.empty())
+            mMapping = std::make_shared<const Platform::File::ScopedMapping>(std::move(mapping));
         mIsLoaded = true;
     }
     else
@@ -287,11 +309,27 @@ void Bsa::BSAFile::close()
 
     mFiles.clear();
     mStringBuf.clear();
+    mMapping = nullptr;
     mIsLoaded = false;
 }
 
+const char* Bsa::BSAFile::getMappedData(std::size_t offset, std::size_t size) const
+{
+    if (mMapping == nullptr || offset > mMapping->size() || size > mMapping->size() - offset)
+        return nullptr;
+    return mMapping->data() + offset;
+}
+
+Files::IStreamPtr Bsa::BSAFile::makeMappedStream(const char* data, std::size_t size) const
+{
+    auto buffer = std::make_unique<MappedBuffer>(mMapping, data, size);
+    return std::make_unique<Files::StreamWithBuffer<MappedBuffer>>(std::move(buffer));
+}
+
 Files::IStreamPtr Bsa::BSAFile::getFile(const FileStruct* file)
 {
+    if (const char* data = getMappedData(file->mOffset, file->mFileSize))
+        return makeMappedStream(data, file->mFileSize);
     return Files::openConstrainedFileStream(mFilepath, file->mOffset, file->mFileSize);
 }
 
@@ -300,6 +338,10 @@ void Bsa::BSAFile::addFile(const std::string& filename, std::istream& file)
     if (!mIsLoaded)
         fail("Unable to add file " + filename + " the archive is not opened");
 
+    // The archive is going to be modified so the mapped view becomes invalid. Streams returned before keep their
+    // own reference to it.
+    mMapping = nullptr;
+
     auto newStartOfDataBuffer = 12 + (12 + 8) * (mFiles.size() + 1) + mStringBuf.size() + filename.size() + 1;
     if (mFiles.empty())
         std::filesystem::resize_file(mFilepath, newStartOfDataBuffer);
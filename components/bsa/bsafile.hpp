@@ -27,14 +27,17 @@
 #include <cstdint>
 #include <filesystem>
 #include <iosfwd>
+#include <memory>
 #include <string>
 #include <vector>
 
 #include <components/files/conversion.hpp>
 #include <components/files/istreamptr.hpp>
+#include <components/platform/file.hpp>
 
 namespace Bsa
 {
+    class DecompressionPool;
 
     enum class BsaVersion : std::uint32_t
     {
@@ -92,6 +95,20 @@ namespace Bsa
         /// Used for error messages
         std::filesystem::path mFilepath;
 
+        /// Read-only view of the whole archive, null if the archive can't be mapped or is being modified. Shared with
+        /// the streams returned by makeMappedStream so they stay valid after the archive is closed.
+        std::shared_ptr<const Platform::File::ScopedMapping> mMapping;
+
+        /// Returns pointer to the archive data at given offset if it is mapped into memory and the range is valid.
+        /// Otherwise returns nullptr.
+        const char* getMappedData(std::size_t offset, std::size_t size) const;
+
+        /// Returns a stream reading the data returned by getMappedData. The stream keeps the mapping alive.
+        Files::IStreamPtr makeMappedStream(const char* data, std::size_t size) const;
+
+        /// Used to split decompression of large files into parallel jobs and to collect stats, may be nullptr
+        DecompressionPool* mDecompressionPool = nullptr;
+
         /// Error handling
         [[noreturn]] void fail(const std::string& msg) const;
 
@@ -144,6 +161,12 @@ namespace Bsa
             return mFilepath;
         }
 
+        /// Set the pool used to decompress files. The pool must outlive the archive or be reset to nullptr.
+        void setDecompressionPool(DecompressionPool* pool)
+        {
+            mDecompressionPool = pool;
+        }
+
         // checks version of BSA from file header
         static BsaVersion detectVersion(const std::filesystem::path& filePath);
     };
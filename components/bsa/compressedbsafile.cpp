@@ -27,6 +27,8 @@
 #include <algorithm>
 #include <cassert>
 #include <cerrno>
+#include <chrono>
+#include <cstring>
 #include <format>
 #include <istream>
 #include <system_error>
@@ -40,6 +42,7 @@
 #include <components/misc/pathhelpers.hpp>
 #include <components/vfs/pathutil.hpp>
 
+#include "decompressionpool.hpp"
 #include "memorystream.hpp"
 
 namespace Bsa
@@ -262,12 +265,61 @@ namespace Bsa
         fail("Add file is not implemented for compressed BSA: " + filename);
     }
 
+    bool CompressedBSAFile::isCompressed(const FileRecord& fileRecord) const
+    {
+        const std::uint32_t size = fileRecord.mSize & (~FileSizeFlag_Compression);
+        return (fileRecord.mSize != size) == ((mHeader.mFlags & ArchiveFlag_Compress) == 0);
+    }
+
+    void CompressedBSAFile::decompress(const FileRecord& fileRecord, const char* input, std::size_t inputSize,
+        char* output, std::size_t outputSize) const
+    {
+        const auto start = std::chrono::steady_clock::now();
+        const std::size_t statsInputSize = inputSize;
+        const std::size_t statsOutputSize = outputSize;
+        if (mHeader.mVersion != Version_SSE)
+        {
+            uLongf destSize = static_cast<uLongf>(outputSize);
+            int ec = ::uncompress(reinterpret_cast<Bytef*>(output), &destSize, reinterpret_cast<const Bytef*>(input),
+                static_cast<uLong>(inputSize));
+
+            if (ec != Z_OK)
+            {
+                std::string message = "zlib uncompress failed for file ";
+                message.append(fileRecord.mName.begin(), fileRecord.mName.end());
+                message += ": ";
+                message += ::zError(ec);
+                fail(message);
+            }
+        }
+        else
+        {
+            LZ4F_decompressionContext_t context = nullptr;
+            LZ4F_createDecompressionContext(&context, LZ4F_VERSION);
+            LZ4F_decompressOptions_t options = {};
+            LZ4F_errorCode_t errorCode
+                = LZ4F_decompress(context, output, &outputSize, input, &inputSize, &options);
+            if (LZ4F_isError(errorCode))
+                fail("LZ4 decompression error (file " + Files::pathToUnicodeString(mFilepath)
+                    + "): " + LZ4F_getErrorName(errorCode));
+            errorCode = LZ4F_freeDecompressionContext(context);
+            if (LZ4F_isError(errorCode))
+                fail("LZ4 decompression error (file " + Files::pathToUnicodeString(mFilepath)
+                    + "): " + LZ4F_getErrorName(errorCode));
+        }
+        if (mDecompressionPool != nullptr)
+            mDecompressionPool->addStats(
+                statsInputSize, statsOutputSize, std::chrono::steady_clock::now() - start);
+    }
+
     Files::IStreamPtr CompressedBSAFile::getFile(const FileRecord& fileRecord)
     {
         size_t size = fileRecord.mSize & (~FileSizeFlag_Compression);
+        if (const char* data = getMappedData(fileRecord.mOffset, size))
+            return getMappedFile(fileRecord, data, size);
         size_t resultSize = size;
         Files::IStreamPtr streamPtr = Files::openConstrainedFileStream(mFilepath, fileRecord.mOffset, size);
-        bool compressed = (fileRecord.mSize != size) == ((mHeader.mFlags & ArchiveFlag_Compress) == 0);
+        const bool compressed = isCompressed(fileRecord);
         if ((mHeader.mFlags & ArchiveFlag_EmbeddedNames) != 0)
         {
             // Skip over the embedded file name
@@ -287,37 +339,7 @@ namespace Bsa
         {
             std::vector<char> buffer(size);
             streamPtr->read(buffer.data(), size);
-
-            if (mHeader.mVersion != Version_SSE)
-            {
-                uLongf destSize = static_cast<uLongf>(resultSize);
-                int ec = ::uncompress(reinterpret_cast<Bytef*>(memoryStreamPtr->getRawData()), &destSize,
-                    reinterpret_cast<Bytef*>(buffer.data()), static_cast<uLong>(buffer.size()));
-
-                if (ec != Z_OK)
-                {
-                    std::string message = "zlib uncompress failed for file ";
-                    message.append(fileRecord.mName.begin(), fileRecord.mName.end());
-                    message += ": ";
-                    message += ::zError(ec);
-                    fail(message);
-                }
-            }
-            else
-            {
-                LZ4F_decompressionContext_t context = nullptr;
-                LZ4F_createDecompressionContext(&context, LZ4F_VERSION);
-                LZ4F_decompressOptions_t options = {};
-                LZ4F_errorCode_t errorCode = LZ4F_decompress(
-                    context, memoryStreamPtr->getRawData(), &resultSize, buffer.data(), &size, &options);
-                if (LZ4F_isError(errorCode))
-                    fail("LZ4 decompression error (file " + Files::pathToUnicodeString(mFilepath)
-                        + "): " + LZ4F_getErrorName(errorCode));
-                errorCode = LZ4F_freeDecompressionContext(context);
-                if (LZ4F_isError(errorCode))
-                    fail("LZ4 decompression error (file " + Files::pathToUnicodeString(mFilepath)
-                        + "): " + LZ4F_getErrorName(errorCode));
-            }
+            decompress(fileRecord, buffer.data(), buffer.size(), memoryStreamPtr->getRawData(), resultSize);
         }
         else
         {
@@ -327,6 +349,35 @@ namespace Bsa
         return std::make_unique<Files::StreamWithBuffer<MemoryInputStream>>(std::move(memoryStreamPtr));
     }
 
+    Files::IStreamPtr CompressedBSAFile::getMappedFile(const FileRecord& fileRecord, const char* data, std::size_t size)
+    {
+        if ((mHeader.mFlags & ArchiveFlag_EmbeddedNames) != 0)
+        {
+            // Skip over the embedded file name
+            const std::size_t length = (size == 0 ? 0 : static_cast<std::uint8_t>(data[0])) + sizeof(uint8_t);
+            if (length > size)
+                fail("Embedded file name is out of file bounds");
+            data += length;
+            size -= length;
+        }
+
+        // Stored files are returned as a view of the mapped archive without copying
+        if (!isCompressed(fileRecord))
+            return makeMappedStream(data, size);
+
+        std::uint32_t resultSize = 0;
+        if (size < sizeof(resultSize))
+            fail("Compressed file size is out of file bounds");
+        std::memcpy(&resultSize, data, sizeof(resultSize));
+        data += sizeof(resultSize);
+        size -= sizeof(resultSize);
+
+        // Decompress directly from the mapped archive into the result buffer
+        auto memoryStreamPtr = std::make_unique<MemoryInputStream>(resultSize);
+        decompress(fileRecord, data, size, memoryStreamPtr->getRawData(), resultSize);
+        return std::make_unique<Files::StreamWithBuffer<MemoryInputStream>>(std::move(memoryStreamPtr));
+    }
+
     std::uint64_t CompressedBSAFile::generateHash(std::string_view str, std::string_view extension)
     {
         if (str.empty())
@@ -113,12 +113,17 @@ namespace Bsa
         /// \brief Normalizes given filename or folder and generates format-compatible hash.
         static std::uint64_t generateHash(std::string_view stem, std::string_view extension);
         Files::IStreamPtr getFile(const FileRecord& fileRecord);
+        Files::IStreamPtr getMappedFile(const FileRecord& fileRecord, const char* data, std::size_t size);
+        bool isCompressed(const FileRecord& fileRecord) const;
+        void decompress(const FileRecord& fileRecord, const char* input, std::size_t inputSize, char* output,
+            std::size_t outputSize) const;
 
     public:
         using BSAFile::getFilename;
         using BSAFile::getList;
         using BSAFile::getPath;
         using BSAFile::open;
+        using BSAFile::setDecompressionPool;
 
         CompressedBSAFile() = default;
         virtual ~CompressedBSAFile() = default;
@@ -0,0 +1,141 @@
+#include "decompressionpool.hpp"
+
+#include <algorithm>
+#include <exception>
+#include <memory>
+
+namespace Bsa
+{
+    namespace
+    {
+        struct ParallelForState
+        {
+            std::function<void(std::size_t)> mFunction;
+            std::size_t mCount;
+            std::atomic<std::size_t> mNext{ 0 };
+            std::size_t mDone = 0;
+            std::exception_ptr mException;
+            std::mutex mMutex;
+            std::condition_variable mFinished;
+
+            // Processes indices until none are left and notifies the waiting thread when everything is done
+            void process()
+            {
+                std::size_t done = 0;
+                std::exception_ptr exception;
+                while (true)
+                {
+                    const std::size_t index = mNext.fetch_add(1, std::memory_order_relaxed);
+                    if (index >= mCount)
+                        break;
+                    try
+                    {
+                        mFunction(index);
+                    }
+                    catch (...)
+                    {
+                        if (exception == nullptr)
+                            exception = std::current_exception();
+                    }
+                    ++done;
+                }
+                if (done == 0)
+                    return;
+                const std::lock_guard lock(mMutex);
+                if (mException == nullptr)
+                    mException = exception;
+                mDone += done;
+                if (mDone == mCount)
+                    mFinished.notify_all();
+            }
+        };
+    }
+
+    DecompressionPool::DecompressionPool(std::size_t threads)
+    {
+        mThreads.reserve(threads);
+        for (std::size_t i = 0; i < threads; ++i)
+            mThreads.emplace_back([this] { run(); });
+    }
+
+    DecompressionPool::~DecompressionPool()
+    {
+        {
+            const std::lock_guard lock(mMutex);
+            mStopping = true;
+        }
+        mHasJob.notify_all();
+        for (std::thread& thread : mThreads)
+            thread.join();
+    }
+
+    void DecompressionPool::parallelFor(std::size_t count, const std::function<void(std::size_t)>& function)
+    {
+        if (count == 0)
+            return;
+        if (count == 1 || mThreads.empty())
+        {
+            for (std::size_t i = 0; i < count; ++i)
+                function(i);
+            return;
+        }
+
+        // Workers may still hold the state after the calling thread has finished all the work
+        auto state = std::make_shared<ParallelForState>();
+        state->mFunction = function;
+        state->mCount = count;
+
+        const std::size_t helpers = std::min(count - 1, mThreads.size());
+        {
+            const std::lock_guard lock(mMutex);
+            for (std::size_t i = 0; i < helpers; ++i)
+                mQueue.emplace_back([state] { state->process(); });
+        }
+        if (helpers == 1)
+            mHasJob.notify_one();
+        else
+            mHasJob.notify_all();
+
+        state->process();
+
+        std::unique_lock lock(state->mMutex);
+        state->mFinished.wait(lock, [&] { return state->mDone == state->mCount; });
+        if (state->mException != nullptr)
+            std::rethrow_exception(state->mException);
+    }
+
+    void DecompressionPool::addStats(std::size_t inputSize, std::size_t outputSize, std::chrono::nanoseconds time)
+    {
+        mJobs.fetch_add(1, std::memory_order_relaxed);
+        mInputBytes.fetch_add(inputSize, std::memory_order_relaxed);
+        mOutputBytes.fetch_add(outputSize, std::memory_order_relaxed);
+        mTime.fetch_add(time.count(), std::memory_order_relaxed);
+    }
+
+    DecompressionStats DecompressionPool::getStats() const
+    {
+        return DecompressionStats{
+            .mJobs = mJobs.load(std::memory_order_relaxed),
+            .mInputBytes = mInputBytes.load(std::memory_order_relaxed),
+            .mOutputBytes = mOutputBytes.load(std::memory_order_relaxed),
+            .mTime = std::chrono::nanoseconds(mTime.load(std::memory_order_relaxed)),
+        };
+    }
+
+    void DecompressionPool::run()
+    {
+        while (true)
+        {
+            std::function<void()> job;
+            {
+                std::unique_lock lock(mMutex);
+                mHasJob.wait(lock, [&] { return mStopping || !mQueue.empty(); });
+                if (mQueue.empty())
+                    return;
+                job = std::move(mQueue.front());
+                mQueue.pop_front();
+            }
+            job();
+        }
+    }
+}
@@ -0,0 +1,66 @@
+#ifndef OPENMW_COMPONENTS_BSA_DECOMPRESSIONPOOL_H
+#define OPENMW_COMPONENTS_BSA_DECOMPRESSIONPOOL_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Bsa
+{
+    struct DecompressionStats
+    {
+        std::uint64_t mJobs = 0;
+        std::uint64_t mInputBytes = 0;
+        std::uint64_t mOutputBytes = 0;
+        std::chrono::nanoseconds mTime{ 0 };
+    };
+
+    /// @brief Fixed size thread pool used to decompress archive entries.
+    /// @par Archives split large entries (e.g. multi chunk BA2 textures) into independent jobs running on the pool.
+    /// @note All methods are thread safe.
+    class DecompressionPool
+    {
+    public:
+        explicit DecompressionPool(std::size_t threads);
+
+        /// Finishes all queued jobs and joins the worker threads.
+        ~DecompressionPool();
+
+        DecompressionPool(const DecompressionPool&) = delete;
+        DecompressionPool& operator=(const DecompressionPool&) = delete;
+
+        std::size_t getThreadCount() const { return mThreads.size(); }
+
+        /// Call function for each index in [0, count) using both the worker threads and the calling thread and return
+        /// when all calls are finished. Can be called from a worker thread. The first thrown exception is rethrown
+        /// after all started calls are finished.
+        void parallelFor(std::size_t count, const std::function<void(std::size_t)>& function);
+
+        /// Account single decompression of inputSize bytes into outputSize bytes that took given time.
+        void addStats(std::size_t inputSize, std::size_t outputSize, std::chrono::nanoseconds time);
+
+        DecompressionStats getStats() const;
+
+    private:
+        std::mutex mMutex;
+        std::condition_variable mHasJob;
+        std::deque<std::function<void()>> mQueue;
+        bool mStopping = false;
+        std::vector<std::thread> mThreads;
+        std::atomic<std::uint64_t> mJobs{ 0 };
+        std::atomic<std::uint64_t> mInputBytes{ 0 };
+        std::atomic<std::uint64_t> mOutputBytes{ 0 };
+        std::atomic<std::int64_t> mTime{ 0 };
+
+        void run();
+    };
+}
+
+#endif
@@ -19,7 +19,9 @@
 #include <boost/geometry.hpp>
 
 #include <algorithm>
+#include <cmath>
 #include <format>
+#include <limits>
 #include <optional>
 #include <set>
 #include <tuple>
@@ -34,6 +36,11 @@ namespace DetourNavigator
             return std::abs(lhs.x() - rhs.x()) + std::abs(lhs.y() - rhs.y());
         }
 
+        double getDistance(const TilePosition& lhs, const TilePosition& rhs)
+        {
+            return std::hypot(static_cast<double>(lhs.x() - rhs.x()), static_cast<double>(lhs.y() - rhs.y()));
+        }
+
         bool isAbsentTileTooClose(const TilePosition& position, int distance,
             const std::set<std::tuple<AgentBounds, TilePosition>>& pushedTiles,
             const std::set<std::tuple<AgentBounds, TilePosition>>& presentTiles,
@@ -65,6 +72,11 @@ namespace DetourNavigator
                 settings.mRecast, settings.mWriteToNavMeshDb);
         }
 
+        // Reading tiles for multiple jobs by a single query reduces number of round trips to the db
+        constexpr std::size_t maxDbReadingJobsBatchSize = 64;
+
+        constexpr std::size_t maxDbReadingRangeAreaPerJob = 4;
+
         std::size_t getNextJobId()
         {
             static std::atomic_size_t nextJobId{ 1 };
@@ -128,6 +140,7 @@ namespace DetourNavigator
         , mNavMeshCacheItem(std::move(navMeshCacheItem))
         , mWorldspace(worldspace)
         , mChangedTile(changedTile)
+        , mCreateTime(std::chrono::steady_clock::now())
         , mProcessTime(processTime)
         , mChangeType(changeType)
     {
@@ -155,15 +168,37 @@ namespace DetourNavigator
         ++mSize;
     }
 
-    std::optional<JobIt> SpatialJobQueue::pop(TilePosition playerTile)
+    std::optional<JobIt> SpatialJobQueue::pop(TilePosition playerTile, TilePosition predictedPlayerTile)
     {
+        if (mIndex.empty())
+            return std::nullopt;
+
         const IndexPoint point(playerTile.x(), playerTile.y());
-        const auto it = mIndex.qbegin(boost::geometry::index::nearest(point, 1));
+        const double predictedDistance = getDistance(playerTile, predictedPlayerTile);
+        std::optional<IndexValue> best;
+        double bestCost = std::numeric_limits<double>::max();
+
+        // Tiles come ordered by distance to the player. A tile at distance d can't have a cost less than
+        // 2 * d - predictedDistance by the triangle inequality so no better tile can be found further.
+        for (auto it = mIndex.qbegin(boost::geometry::index::nearest(point, static_cast<unsigned>(mIndex.size())));
+             it != mIndex.qend(); ++it)
+        {
+            const TilePosition& tile = it->second->first;
+            const double distance = getDistance(tile, playerTile);
+            if (2 * distance - predictedDistance >= bestCost)
+                break;
+            const double cost = distance + getDistance(tile, predictedPlayerTile);
+            if (cost < bestCost)
+            {
+                best = *it;
+                bestCost = cost;
+            }
+        }
 
-        if (it == mIndex.qend())
+        if (!best.has_value())
             return std::nullopt;
 
-        const UpdatingMap::iterator mapIt = it->second;
+        const UpdatingMap::iterator mapIt = best->second;
         std::deque<JobIt>& tileJobs = mapIt->second;
         JobIt result = tileJobs.front();
         tileJobs.pop_front();
@@ -172,8 +207,8 @@ namespace DetourNavigator
 
         if (tileJobs.empty())
         {
+            mIndex.remove(*best);
             mValues.erase(mapIt);
-            mIndex.remove(*it);
         }
 
         return result;
@@ -231,7 +266,8 @@ namespace DetourNavigator
         mUpdating.push(job);
     }
 
-    std::optional<JobIt> JobQueue::pop(TilePosition playerTile, std::chrono::steady_clock::time_point now)
+    std::optional<JobIt> JobQueue::pop(
+        TilePosition playerTile, TilePosition predictedPlayerTile, std::chrono::steady_clock::time_point now)
     {
         if (!mRemoving.empty())
         {
@@ -240,7 +276,7 @@ namespace DetourNavigator
             return result;
         }
 
-        if (const std::optional<JobIt> result = mUpdating.pop(playerTile))
+        if (const std::optional<JobIt> result = mUpdating.pop(playerTile, predictedPlayerTile))
             return result;
 
         if (mDelayed.empty() || mDelayed.front()->mProcessTime > now)
@@ -279,6 +315,7 @@ namespace DetourNavigator
         , mOffMeshConnectionsManager(offMeshConnectionsManager)
         , mShouldStop()
         , mNavMeshTilesCache(settings.mMaxNavMeshTilesCacheSize)
+        , mRasterizedRecastMeshCache(settings.mMaxRasterizedRecastMeshCacheSize)
         , mDbWorker(makeDbWorker(*this, std::move(db), mSettings))
     {
         for (std::size_t i = 0; i < mSettings.get().mAsyncNavMeshUpdaterThreads; ++i)
@@ -343,7 +380,23 @@ namespace DetourNavigator
         lock.unlock();
 
         if (playerTileChanged && mDbWorker != nullptr)
-            mDbWorker->update(playerTile);
+            mDbWorker->update(playerTile, getPredictedPlayerTile(playerTile));
+    }
+
+    void AsyncNavMeshUpdater::setPredictedPlayerTile(const std::optional<TilePosition>& value)
+    {
+        {
+            auto locked = mPredictedPlayerTile.lock();
+            if (*locked == value)
+                return;
+            *locked = value;
+        }
+
+        if (mDbWorker != nullptr)
+        {
+            const TilePosition playerTile = *mPlayerTile.lockConst();
+            mDbWorker->update(playerTile, value.value_or(playerTile));
+        }
     }
 
     void AsyncNavMeshUpdater::wait(WaitConditionType waitConditionType, Loading::Listener* listener)
@@ -437,6 +490,8 @@ namespace DetourNavigator
             result.mJobs = mJobs.size();
             result.mWaiting = mWaiting.getStats();
             result.mPushed = mPushed.size();
+            result.mQueueLatency = mQueueLatency;
+            result.mTotalLatency = mTotalLatency;
         }
         result.mProcessing = mProcessingTiles.lockConst()->size();
         if (mDbWorker != nullptr)
@@ -577,8 +632,7 @@ namespace DetourNavigator
                 return JobStatus::MemoryCacheMiss;
             }
 
-            preparedNavMeshData = prepareNavMeshTileData(
-                *recastMesh, job.mWorldspace, job.mChangedTile, job.mAgentBounds, mSettings.get().mRecast);
+            preparedNavMeshData = makePreparedNavMeshData(job, *recastMesh);
 
             if (preparedNavMeshData == nullptr)
             {
@@ -629,8 +683,7 @@ namespace DetourNavigator
 
         if (preparedNavMeshData == nullptr)
         {
-            preparedNavMeshData = prepareNavMeshTileData(
-                *job.mRecastMesh, job.mWorldspace, job.mChangedTile, job.mAgentBounds, mSettings.get().mRecast);
+            preparedNavMeshData = makePreparedNavMeshData(job, *job.mRecastMesh);
             generatedNavMeshData = true;
         }
 
@@ -664,6 +717,25 @@ namespace DetourNavigator
         return result;
     }
 
+    std::unique_ptr<PreparedNavMeshData> AsyncNavMeshUpdater::makePreparedNavMeshData(
+        const Job& job, const RecastMesh& recastMesh)
+    {
+        const Settings& settings = mSettings.get();
+
+        if (settings.mMaxRasterizedRecastMeshCacheSize == 0)
+            return prepareNavMeshTileData(
+                recastMesh, job.mWorldspace, job.mChangedTile, job.mAgentBounds, settings.mRecast);
+
+        const std::shared_ptr<const RasterizedRecastMesh> rasterizedRecastMesh
+            = mRasterizedRecastMeshCache.get(job.mWorldspace, job.mChangedTile, recastMesh, settings.mRecast);
+
+        if (rasterizedRecastMesh == nullptr)
+            return nullptr;
+
+        return prepareNavMeshTileData(
+            *rasterizedRecastMesh, recastMesh, job.mWorldspace, job.mChangedTile, job.mAgentBounds, settings.mRecast);
+    }
+
     JobStatus AsyncNavMeshUpdater::handleUpdateNavMeshStatus(UpdateNavMeshStatus status, const Job& job,
         const GuardedNavMeshCacheItem& navMeshCacheItem, const RecastMesh& recastMesh)
     {
@@ -717,7 +789,7 @@ namespace DetourNavigator
 
         JobIt job = mJobs.end();
 
-        if (const std::optional<JobIt> nextJob = mWaiting.pop(playerTile))
+        if (const std::optional<JobIt> nextJob = mWaiting.pop(playerTile, getPredictedPlayerTile(playerTile)))
             job = *nextJob;
 
         if (job == mJobs.end())
@@ -736,8 +808,13 @@ namespace DetourNavigator
             return mJobs.end();
         }
 
+        const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+
+        if (job->mState == JobState::Initial)
+            mQueueLatency.add(now - job->mCreateTime);
+
         if (job->mChangeType == ChangeType::update)
-            mLastUpdates[getAgentAndTile(*job)] = std::chrono::steady_clock::now();
+            mLastUpdates[getAgentAndTile(*job)] = now;
         mPushed.erase(getAgentAndTile(*job));
 
         return job;
@@ -768,6 +845,11 @@ namespace DetourNavigator
         return mJobs.size();
     }
 
+    TilePosition AsyncNavMeshUpdater::getPredictedPlayerTile(const TilePosition& playerTile) const
+    {
+        return mPredictedPlayerTile.lockConst()->value_or(playerTile);
+    }
+
     void AsyncNavMeshUpdater::cleanupLastUpdates() noexcept
     {
         const auto now = std::chrono::steady_clock::now();
@@ -795,6 +877,7 @@ namespace DetourNavigator
     {
         Log(Debug::Debug) << "Removing job " << job->mId << " by thread=" << std::this_thread::get_id();
         const std::lock_guard lock(mMutex);
+        mTotalLatency.add(std::chrono::steady_clock::now() - job->mCreateTime);
         mJobs.erase(job);
     }
 
@@ -808,7 +891,7 @@ namespace DetourNavigator
         mHasJob.notify_all();
     }
 
-    std::optional<JobIt> DbJobQueue::pop()
+    std::vector<JobIt> DbJobQueue::pop(std::size_t maxReadingJobs)
     {
         std::unique_lock lock(mMutex);
 
@@ -816,25 +899,33 @@ namespace DetourNavigator
 
         mHasJob.wait(lock, hasJob);
 
+        std::vector<JobIt> result;
+
         if (mShouldStop)
-            return std::nullopt;
+            return result;
 
-        if (const std::optional<JobIt> job = mReading.pop(mPlayerTile))
-            return job;
+        while (result.size() < maxReadingJobs)
+        {
+            const std::optional<JobIt> job = mReading.pop(mPlayerTile, mPredictedPlayerTile);
+            if (!job.has_value())
+                break;
+            result.push_back(*job);
+        }
 
-        if (mWriting.empty())
-            return std::nullopt;
+        if (!result.empty() || mWriting.empty())
+            return result;
 
-        const JobIt job = mWriting.front();
+        result.push_back(mWriting.front());
         mWriting.pop_front();
 
-        return job;
+        return result;
     }
 
-    void DbJobQueue::update(TilePosition playerTile)
+    void DbJobQueue::update(TilePosition playerTile, TilePosition predictedPlayerTile)
     {
         const std::lock_guard lock(mMutex);
         mPlayerTile = playerTile;
+        mPredictedPlayerTile = predictedPlayerTile;
     }
 
     void DbJobQueue::stop()
@@ -901,8 +992,8 @@ namespace DetourNavigator
         {
             try
             {
-                if (const auto job = mQueue.pop())
-                    processJob(*job);
+                if (const std::vector<JobIt> jobs = mQueue.pop(maxDbReadingJobsBatchSize); !jobs.empty())
+                    processJobs(jobs);
             }
             catch (const std::exception& e)
             {
@@ -911,110 +1002,197 @@ namespace DetourNavigator
         }
     }
 
-    void DbWorker::processJob(JobIt job)
+    void DbWorker::processJobs(const std::vector<JobIt>& jobs)
     {
-        const auto process = [&](auto f) {
+        if (jobs.size() == 1 && isWritingDbJob(*jobs.front()))
+        {
+            const JobIt job = jobs.front();
             try
             {
-                f(job);
+                processWritingJob(job);
             }
             catch (const std::exception& e)
             {
                 Log(Debug::Error) << "DbWorker exception while processing job " << job->mId << ": " << e.what();
-                if (mWriteToDb)
-                {
-                    const std::string_view message(e.what());
-                    if (message.find("database or disk is full") != std::string_view::npos)
-                    {
-                        mWriteToDb = false;
-                        Log(Debug::Warning)
-                            << "Writes to navmeshdb are disabled because file size limit is reached or disk is full";
-                    }
-                    else if (message.find("database is locked") != std::string_view::npos)
-                    {
-                        mWriteToDb = false;
-                        Log(Debug::Warning)
-                            << "Writes to navmeshdb are disabled to avoid concurrent writes from multiple processes";
-                    }
-                    else if (message.find("UNIQUE constraint failed: tiles.tile_id") != std::string_view::npos)
-                    {
-                        Log(Debug::Warning) << "Found duplicate navmeshdb tile_id, please report the "
-                                               "issue to https://gitlab.com/OpenMW/openmw/-/issues, attach openmw.log: "
-                                            << mNextTileId;
-                        try
-                        {
-                            mNextTileId = TileId(mDb->getMaxTileId() + 1);
-                            Log(Debug::Info) << "Updated navmeshdb tile_id to: " << mNextTileId;
-                        }
-                        catch (const std::exception& exception)
-                        {
-                            mWriteToDb = false;
-                            Log(Debug::Warning) << "Failed to update next tile_id, writes to navmeshdb are disabled: "
-                                                << exception.what();
-                        }
-                    }
-                }
+                handleException(e);
             }
-        };
-
-        if (isWritingDbJob(*job))
-        {
-            process([&](JobIt it) { processWritingJob(it); });
             mUpdater.removeJob(job);
             return;
         }
 
-        process([&](JobIt it) { processReadingJob(it); });
-        job->mState = JobState::WithDbResult;
-        mUpdater.enqueueJob(job);
+        processReadingJobs(jobs);
+
+        for (const JobIt job : jobs)
+        {
+            job->mState = JobState::WithDbResult;
+            mUpdater.enqueueJob(job);
+        }
     }
 
-    void DbWorker::processReadingJob(JobIt job)
+    void DbWorker::handleException(const std::exception& exception)
     {
-        ++mGetTileCount;
+        if (!mWriteToDb)
+            return;
+        const std::string_view message(exception.what());
+        if (message.find("database or disk is full") != std::string_view::npos)
+        {
+            mWriteToDb = false;
+            Log(Debug::Warning)
+                << "Writes to navmeshdb are disabled because file size limit is reached or disk is full";
+        }
+        else if (message.find("database is locked") != std::string_view::npos)
+        {
+            mWriteToDb = false;
+            Log(Debug::Warning)
+                << "Writes to navmeshdb are disabled to avoid concurrent writes from multiple processes";
+        }
+        else if (message.find("UNIQUE constraint failed: tiles.tile_id") != std::string_view::npos)
+        {
+            Log(Debug::Warning) << "Found duplicate navmeshdb tile_id, please report the "
+                                   "issue to https://gitlab.com/OpenMW/openmw/-/issues, attach openmw.log: "
+                                << mNextTileId;
+            try
+            {
+                mNextTileId = TileId(mDb->getMaxTileId() + 1);
+                Log(Debug::Info) << "Updated navmeshdb tile_id to: " << mNextTileId;
+            }
+            catch (const std::exception& e)
+            {
+                mWriteToDb = false;
+                Log(Debug::Warning) << "Failed to update next tile_id, writes to navmeshdb are disabled: " << e.what();
+            }
+        }
+    }
 
-        Log(Debug::Debug) << "Processing db read job " << job->mId;
+    void DbWorker::processReadingJobs(const std::vector<JobIt>& jobs)
+    {
+        std::vector<JobIt> prepared;
+        prepared.reserve(jobs.size());
 
-        if (job->mInput.empty())
+        for (const JobIt job : jobs)
         {
-            Log(Debug::Debug) << "Serializing input for job " << job->mId;
-            if (mWriteToDb)
+            ++mGetTileCount;
+
+            Log(Debug::Debug) << "Processing db read job " << job->mId;
+
+            try
             {
-                const auto objects = makeDbRefGeometryObjects(job->mRecastMesh->getMeshSources(),
-                    [&](const MeshSource& v) { return resolveMeshSource(*mDb, v, mNextShapeId); });
-                job->mInput = serialize(mRecastSettings, job->mAgentBounds, *job->mRecastMesh, objects);
+                if (prepareReadingJob(*job))
+                    prepared.push_back(job);
             }
-            else
+            catch (const std::exception& e)
             {
-                struct HandleResult
-                {
-                    const RecastSettings& mRecastSettings;
-                    Job& mJob;
+                Log(Debug::Error) << "DbWorker exception while processing job " << job->mId << ": " << e.what();
+                handleException(e);
+            }
+        }
 
-                    bool operator()(const std::vector<DbRefGeometryObject>& objects) const
-                    {
-                        mJob.mInput = serialize(mRecastSettings, mJob.mAgentBounds, *mJob.mRecastMesh, objects);
-                        return true;
-                    }
+        if (prepared.empty())
+            return;
 
-                    bool operator()(const MeshSource& meshSource) const
-                    {
-                        Log(Debug::Debug) << "No object for mesh source (fileName=\"" << meshSource.mShape->mFileName
-                                          << "\", areaType=" << meshSource.mAreaType
-                                          << ", fileHash=" << Misc::StringUtils::toHex(meshSource.mShape->mFileHash)
-                                          << ") for job " << mJob.mId;
-                        return false;
-                    }
-                };
+        std::stable_sort(prepared.begin(), prepared.end(),
+            [](const JobIt& lhs, const JobIt& rhs) { return lhs->mWorldspace < rhs->mWorldspace; });
+
+        try
+        {
+            Sqlite3::Transaction transaction = mDb->startTransaction(Sqlite3::TransactionMode::Deferred);
 
-                const auto result = makeDbRefGeometryObjects(job->mRecastMesh->getMeshSources(),
-                    [&](const MeshSource& v) { return resolveMeshSource(*mDb, v); });
-                if (!std::visit(HandleResult{ mRecastSettings, *job }, result))
-                    return;
+            for (auto begin = prepared.begin(); begin != prepared.end();)
+            {
+                const ESM::RefId worldspace = (*begin)->mWorldspace;
+                const auto end = std::find_if(
+                    begin, prepared.end(), [&](const JobIt& job) { return job->mWorldspace != worldspace; });
+                readTilesData(std::span<const JobIt>(begin, end));
+                begin = end;
             }
+
+            transaction.commit();
         }
+        catch (const std::exception& e)
+        {
+            Log(Debug::Error) << "DbWorker exception while reading tiles for " << prepared.size()
+                              << " jobs: " << e.what();
+            handleException(e);
+        }
+    }
+
+    bool DbWorker::prepareReadingJob(Job& job)
+    {
+        if (!job.mInput.empty())
+            return true;
+
+        Log(Debug::Debug) << "Serializing input for job " << job.mId;
+
+        if (mWriteToDb)
+        {
+            const auto objects = makeDbRefGeometryObjects(job.mRecastMesh->getMeshSources(),
+                [&](const MeshSource& v) { return resolveMeshSource(*mDb, v, mNextShapeId); });
+            job.mInput = serialize(mRecastSettings, job.mAgentBounds, *job.mRecastMesh, objects);
+            return true;
+        }
+
+        struct HandleResult
+        {
+            const RecastSettings& mRecastSettings;
+            Job& mJob;
+
+            bool operator()(const std::vector<DbRefGeometryObject>& objects) const
+            {
+                mJob.mInput = serialize(mRecastSettings, mJob.mAgentBounds, *mJob.mRecastMesh, objects);
+                return true;
+            }
+
+            bool operator()(const MeshSource& meshSource) const
+            {
+                Log(Debug::Debug) << "No object for mesh source (fileName=\"" << meshSource.mShape->mFileName
+                                  << "\", areaType=" << meshSource.mAreaType
+                                  << ", fileHash=" << Misc::StringUtils::toHex(meshSource.mShape->mFileHash)
+                                  << ") for job " << mJob.mId;
+                return false;
+            }
+        };
+
+        const auto result = makeDbRefGeometryObjects(
+            job.mRecastMesh->getMeshSources(), [&](const MeshSource& v) { return resolveMeshSource(*mDb, v); });
+        return std::visit(HandleResult{ mRecastSettings, job }, result);
+    }
+
+    void DbWorker::readTilesData(std::span<const JobIt> jobs)
+    {
+        const ESM::RefId worldspace = jobs.front()->mWorldspace;
+
+        TilesPositionsRange range{ jobs.front()->mChangedTile, jobs.front()->mChangedTile + TilePosition(1, 1) };
+        for (const JobIt& job : jobs)
+        {
+            range.mBegin.x() = std::min(range.mBegin.x(), job->mChangedTile.x());
+            range.mBegin.y() = std::min(range.mBegin.y(), job->mChangedTile.y());
+            range.mEnd.x() = std::max(range.mEnd.x(), job->mChangedTile.x() + 1);
+            range.mEnd.y() = std::max(range.mEnd.y(), job->mChangedTile.y() + 1);
+        }
+
+        const std::size_t area = static_cast<std::size_t>(range.mEnd.x() - range.mBegin.x())
+            * static_cast<std::size_t>(range.mEnd.y() - range.mBegin.y());
+
+        // Reading a sparse range fetches too many tiles not needed by any job
+        if (jobs.size() == 1 || area > jobs.size() * maxDbReadingRangeAreaPerJob)
+        {
+            for (const JobIt& job : jobs)
+                job->mCachedTileData = mDb->getTileData(worldspace, job->mChangedTile, job->mInput);
+            return;
+        }
+
+        Log(Debug::Debug) << "Reading db tiles for " << jobs.size() << " jobs in range (" << range.mBegin << ")-("
+                          << range.mEnd << ")";
+
+        std::vector<TileInputAt> inputs;
+        inputs.reserve(jobs.size());
+        for (const JobIt& job : jobs)
+            inputs.push_back(TileInputAt{ .mTilePosition = job->mChangedTile, .mInput = &job->mInput });
+
+        std::vector<std::optional<TileData>> tiles = mDb->getTilesData(worldspace, range, inputs);
 
-        job->mCachedTileData = mDb->getTileData(job->mWorldspace, job->mChangedTile, job->mInput);
+        for (std::size_t i = 0; i < jobs.size(); ++i)
+            jobs[i]->mCachedTileData = std::move(tiles[i]);
     }
 
     void DbWorker::processWritingJob(JobIt job)
@@ -8,6 +8,7 @@
 #include "navmeshdb.hpp"
 #include "navmeshtilescache.hpp"
 #include "offmeshconnectionsmanager.hpp"
+#include "rasterizedrecastmeshcache.hpp"
 #include "sharednavmeshcacheitem.hpp"
 #include "stats.hpp"
 #include "tilecachedrecastmeshmanager.hpp"
@@ -27,6 +28,7 @@
 #include <mutex>
 #include <optional>
 #include <set>
+#include <span>
 #include <thread>
 #include <tuple>
 
@@ -52,6 +54,7 @@ namespace DetourNavigator
         const std::weak_ptr<GuardedNavMeshCacheItem> mNavMeshCacheItem;
         const ESM::RefId mWorldspace;
         const TilePosition mChangedTile;
+        const std::chrono::steady_clock::time_point mCreateTime;
         std::chrono::steady_clock::time_point mProcessTime;
         ChangeType mChangeType;
         JobState mState = JobState::Initial;
@@ -76,7 +79,11 @@ namespace DetourNavigator
 
         void push(JobIt job);
 
-        std::optional<JobIt> pop(TilePosition playerTile);
+        std::optional<JobIt> pop(TilePosition playerTile) { return pop(playerTile, playerTile); }
+
+        /// Pops a job for a tile with minimal sum of distances to the player and the predicted player tiles. Jobs for
+        /// tiles along the player movement direction go first.
+        std::optional<JobIt> pop(TilePosition playerTile, TilePosition predictedPlayerTile);
 
         void update(TilePosition playerTile, int maxTiles, std::vector<JobIt>& removing);
 
@@ -109,7 +116,13 @@ namespace DetourNavigator
         void push(JobIt job, std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now());
 
         std::optional<JobIt> pop(
-            TilePosition playerTile, std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now());
+            TilePosition playerTile, std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now())
+        {
+            return pop(playerTile, playerTile, now);
+        }
+
+        std::optional<JobIt> pop(TilePosition playerTile, TilePosition predictedPlayerTile,
+            std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now());
 
         void update(TilePosition playerTile, int maxTiles,
             std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now());
@@ -134,9 +147,10 @@ namespace DetourNavigator
     public:
         void push(JobIt job);
 
-        std::optional<JobIt> pop();
+        /// Waits for jobs and returns up to maxReadingJobs reading jobs nearest to the player or a single writing job.
+        std::vector<JobIt> pop(std::size_t maxReadingJobs);
 
-        void update(TilePosition playerTile);
+        void update(TilePosition playerTile, TilePosition predictedPlayerTile);
 
         void stop();
 
@@ -148,6 +162,7 @@ namespace DetourNavigator
         SpatialJobQueue mReading;
         std::deque<JobIt> mWriting;
         TilePosition mPlayerTile;
+        TilePosition mPredictedPlayerTile;
         bool mShouldStop = false;
     };
 
@@ -165,7 +180,10 @@ namespace DetourNavigator
 
         void enqueueJob(JobIt job);
 
-        void update(TilePosition playerTile) { mQueue.update(playerTile); }
+        void update(TilePosition playerTile, TilePosition predictedPlayerTile)
+        {
+            mQueue.update(playerTile, predictedPlayerTile);
+        }
 
         void stop();
 
@@ -184,11 +202,17 @@ namespace DetourNavigator
 
         inline void run() noexcept;
 
-        inline void processJob(JobIt job);
+        inline void processJobs(const std::vector<JobIt>& jobs);
 
-        inline void processReadingJob(JobIt job);
+        inline void processReadingJobs(const std::vector<JobIt>& jobs);
+
+        inline bool prepareReadingJob(Job& job);
+
+        inline void readTilesData(std::span<const JobIt> jobs);
 
         inline void processWritingJob(JobIt job);
+
+        inline void handleException(const std::exception& exception);
     };
 
     class AsyncNavMeshUpdater
@@ -202,6 +226,10 @@ namespace DetourNavigator
             const TilePosition& playerTile, ESM::RefId worldspace,
             const std::map<TilePosition, ChangeType>& changedTiles);
 
+        /// Jobs for tiles between the player and the predicted player tile are processed first. Player tile is used
+        /// when nullopt.
+        void setPredictedPlayerTile(const std::optional<TilePosition>& value);
+
         void wait(WaitConditionType waitConditionType, Loading::Listener* listener);
 
         void stop();
@@ -225,13 +253,17 @@ namespace DetourNavigator
         JobQueue mWaiting;
         std::set<std::tuple<AgentBounds, TilePosition>> mPushed;
         Misc::ScopeGuarded<TilePosition> mPlayerTile;
+        Misc::ScopeGuarded<std::optional<TilePosition>> mPredictedPlayerTile;
         NavMeshTilesCache mNavMeshTilesCache;
+        RasterizedRecastMeshCache mRasterizedRecastMeshCache;
         Misc::ScopeGuarded<std::set<std::tuple<AgentBounds, TilePosition>>> mProcessingTiles;
         std::map<std::tuple<AgentBounds, TilePosition>, std::chrono::steady_clock::time_point> mLastUpdates;
         std::set<std::tuple<AgentBounds, TilePosition>> mPresentTiles;
         std::vector<std::thread> mThreads;
         std::unique_ptr<DbWorker> mDbWorker;
         std::atomic_size_t mDbGetTileHits{ 0 };
+        LatencyHistogram mQueueLatency;
+        LatencyHistogram mTotalLatency;
 
         void process() noexcept;
 
@@ -241,6 +273,9 @@ namespace DetourNavigator
 
         inline JobStatus processJobWithDbResult(Job& job, GuardedNavMeshCacheItem& navMeshCacheItem);
 
+        inline std::unique_ptr<PreparedNavMeshData> makePreparedNavMeshData(
+            const Job& job, const RecastMesh& recastMesh);
+
         inline JobStatus handleUpdateNavMeshStatus(UpdateNavMeshStatus status, const Job& job,
             const GuardedNavMeshCacheItem& navMeshCacheItem, const RecastMesh& recastMesh);
 
@@ -254,6 +289,8 @@ namespace DetourNavigator
 
         inline std::size_t getTotalJobs() const;
 
+        inline TilePosition getPredictedPlayerTile(const TilePosition& playerTile) const;
+
         inline void cleanupLastUpdates() noexcept;
 
         inline void waitUntilJobsDoneForNotPresentTiles(Loading::Listener* listener);
@@ -0,0 +1,153 @@
+#include "asyncpathfinder.hpp"
+
+#include "findsmoothpath.hpp"
+#include "navigator.hpp"
+#include "navmeshcacheitem.hpp"
+#include "settings.hpp"
+#include "settingsutils.hpp"
+
+#include <components/debug/debuglog.hpp>
+#include <components/misc/guarded.hpp>
+
+#include <DetourNavMeshQuery.h>
+
+#include <algorithm>
+#include <iterator>
+#include <memory>
+#include <span>
+
+namespace DetourNavigator
+{
+    namespace
+    {
+        constexpr std::size_t maxResultAge = 10;
+
+        struct NavMeshQuery
+        {
+            std::weak_ptr<GuardedNavMeshCacheItem> mNavMesh;
+            dtNavMeshQuery mImpl;
+        };
+
+        // dtNavMeshQuery uses internal buffers so each thread needs own object for each navmesh
+        const dtNavMeshQuery* getNavMeshQuery(
+            const SharedNavMeshCacheItem& navMesh, const dtNavMesh& impl, int maxNodes)
+        {
+            thread_local std::vector<std::unique_ptr<NavMeshQuery>> queries;
+            std::erase_if(queries, [](const std::unique_ptr<NavMeshQuery>& v) { return v->mNavMesh.expired(); });
+            const auto sameNavMesh = [&](const std::unique_ptr<NavMeshQuery>& v) {
+                return !v->mNavMesh.owner_before(navMesh) && !navMesh.owner_before(v->mNavMesh);
+            };
+            if (const auto it = std::find_if(queries.begin(), queries.end(), sameNavMesh); it != queries.end())
+                return &(*it)->mImpl;
+            auto query = std::make_unique<NavMeshQuery>();
+            query->mNavMesh = navMesh;
+            if (!dtStatusSucceed(query->mImpl.init(&impl, maxNodes)))
+                return nullptr;
+            return &queries.emplace_back(std::move(query))->mImpl;
+        }
+    }
+
+    AsyncPathFinder::AsyncPathFinder(const Navigator& navigator, std::size_t threads)
+        : mNavigator(navigator)
+        , mJobSystem(threads)
+    {
+    }
+
+    AsyncPathFinder::~AsyncPathFinder() = default;
+
+    PathRequestId AsyncPathFinder::request(const PathRequest& request)
+    {
+        const std::lock_guard lock(mMutex);
+        const PathRequestId id = mNextId++;
+        mBatch.emplace_back(id, request);
+        mItems.emplace(id, Item{ .mUpdate = mUpdate, .mResult = std::nullopt });
+        return id;
+    }
+
+    void AsyncPathFinder::cancel(PathRequestId id)
+    {
+        const std::lock_guard lock(mMutex);
+        mItems.erase(id);
+        std::erase_if(mBatch, [&](const auto& v) { return v.first == id; });
+    }
+
+    bool AsyncPathFinder::isPending(PathRequestId id) const
+    {
+        const std::lock_guard lock(mMutex);
+        const auto it = mItems.find(id);
+        return it != mItems.end() && !it->second.mResult.has_value();
+    }
+
+    std::optional<PathResult> AsyncPathFinder::takeResult(PathRequestId id)
+    {
+        const std::lock_guard lock(mMutex);
+        const auto it = mItems.find(id);
+        if (it == mItems.end() || !it->second.mResult.has_value())
+            return std::nullopt;
+        std::optional<PathResult> result = std::move(it->second.mResult);
+        mItems.erase(it);
+        return result;
+    }
+
+    void AsyncPathFinder::update()
+    {
+        std::vector<std::pair<PathRequestId, PathRequest>> batch;
+        {
+            const std::lock_guard lock(mMutex);
+            ++mUpdate;
+            std::erase_if(mItems, [&](const auto& v) {
+                return v.second.mResult.has_value() && v.second.mUpdate + maxResultAge < mUpdate;
+            });
+            batch.swap(mBatch);
+        }
+        std::map<AgentBounds, SharedNavMeshCacheItem> navMeshes;
+        for (auto& [id, request] : batch)
+        {
+            auto navMesh = navMeshes.find(request.mAgentBounds);
+            if (navMesh == navMeshes.end())
+                navMesh = navMeshes.emplace(request.mAgentBounds, mNavigator.getNavMesh(request.mAgentBounds)).first;
+            mJobSystem.post([this, id = id, navMesh = navMesh->second, request = std::move(request)] {
+                process(id, navMesh, request);
+            });
+        }
+    }
+
+    void AsyncPathFinder::process(PathRequestId id, const SharedNavMeshCacheItem& navMesh, const PathRequest& request)
+    {
+        PathResult result{ .mStatus = Status::NavMeshNotFound, .mPath = {} };
+        if (navMesh != nullptr)
+        {
+            try
+            {
+                const Settings& settings = mNavigator.getSettings();
+                const auto locked = navMesh->lockShared();
+                const dtNavMeshQuery* const query
+                    = getNavMeshQuery(navMesh, locked->getImpl(), settings.mDetour.mMaxNavMeshQueryNodes);
+                if (query == nullptr)
+                {
+                    result.mStatus = Status::InitNavMeshQueryFailed;
+                }
+                else
+                {
+                    auto out = std::back_inserter(result.mPath);
+                    FromNavMeshCoordinatesIterator outTransform(out, settings.mRecast);
+                    result.mStatus = findSmoothPath(*query,
+                        toNavMeshCoordinates(settings.mRecast, request.mAgentBounds.mHalfExtents),
+                        toNavMeshCoordinates(settings.mRecast, request.mStart),
+                        toNavMeshCoordinates(settings.mRecast, request.mEnd), request.mIncludeFlags,
+                        request.mAreaCosts, settings.mDetour, request.mEndTolerance,
+                        ToNavMeshCoordinatesSpan(std::span<const osg::Vec3f>(), settings.mRecast), outTransform);
+                }
+            }
+            catch (const std::exception& e)
+            {
+                Log(Debug::Warning) << "Failed to find path asynchronously: " << e.what();
+                result.mStatus = Status::FindPathOverPolygonsFailed;
+                result.mPath.clear();
+            }
+        }
+        const std::lock_guard lock(mMutex);
+        if (const auto it = mItems.find(id); it != mItems.end())
+            it->second.mResult = std::move(result);
+    }
+}
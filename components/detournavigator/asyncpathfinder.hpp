@@ -0,0 +1,88 @@
+#ifndef OPENMW_COMPONENTS_DETOURNAVIGATOR_ASYNCPATHFINDER_H
+#define OPENMW_COMPONENTS_DETOURNAVIGATOR_ASYNCPATHFINDER_H
+
+#include "agentbounds.hpp"
+#include "areatype.hpp"
+#include "flags.hpp"
+#include "sharednavmeshcacheitem.hpp"
+#include "status.hpp"
+
+#include <components/misc/jobsystem.hpp>
+
+#include <osg/Vec3f>
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace DetourNavigator
+{
+    struct Navigator;
+
+    struct PathRequest
+    {
+        AgentBounds mAgentBounds;
+        osg::Vec3f mStart;
+        osg::Vec3f mEnd;
+        Flags mIncludeFlags;
+        AreaCosts mAreaCosts;
+        float mEndTolerance;
+    };
+
+    struct PathResult
+    {
+        Status mStatus;
+        std::vector<osg::Vec3f> mPath;
+    };
+
+    using PathRequestId = std::uint64_t;
+
+    /// @brief Finds paths over navmesh on worker threads.
+    /// @par Requests added between update calls are dispatched together by the update. Each worker thread uses own
+    /// dtNavMeshQuery per navmesh and holds a shared lock on the navmesh so queries run in parallel with each other
+    /// but not with the navmesh changes. Results not taken within a few updates are dropped.
+    /// @note All methods are supposed to be called from the same thread.
+    class AsyncPathFinder
+    {
+    public:
+        explicit AsyncPathFinder(const Navigator& navigator, std::size_t threads);
+
+        ~AsyncPathFinder();
+
+        PathRequestId request(const PathRequest& request);
+
+        void cancel(PathRequestId id);
+
+        /// Returns true if request is known and result is not ready yet.
+        bool isPending(PathRequestId id) const;
+
+        /// Returns result and forgets the request if result is ready.
+        std::optional<PathResult> takeResult(PathRequestId id);
+
+        /// Starts processing requests added since the previous call.
+        void update();
+
+    private:
+        struct Item
+        {
+            std::size_t mUpdate = 0;
+            std::optional<PathResult> mResult;
+        };
+
+        const Navigator& mNavigator;
+        mutable std::mutex mMutex;
+        PathRequestId mNextId = 0;
+        std::size_t mUpdate = 0;
+        std::vector<std::pair<PathRequestId, PathRequest>> mBatch;
+        std::map<PathRequestId, Item> mItems;
+        Misc::JobSystem mJobSystem;
+
+        void process(PathRequestId id, const SharedNavMeshCacheItem& navMesh, const PathRequest& request);
+    };
+}
+
+#endif
@@ -1,9 +1,11 @@
 #ifndef OPENMW_COMPONENTS_DETOURNAVIGATOR_GUARDEDNAVMESHCACHEITEM_H
 #define OPENMW_COMPONENTS_DETOURNAVIGATOR_GUARDEDNAVMESHCACHEITEM_H
 
+#include <shared_mutex>
+
 namespace Misc
 {
-    template <class T>
+    template <class T, class Mutex>
     class ScopeGuarded;
 }
 
@@ -11,7 +13,7 @@ namespace DetourNavigator
 {
     class NavMeshCacheItem;
 
-    using GuardedNavMeshCacheItem = Misc::ScopeGuarded<NavMeshCacheItem>;
+    using GuardedNavMeshCacheItem = Misc::ScopeGuarded<NavMeshCacheItem, std::shared_mutex>;
 }
 
 #endif
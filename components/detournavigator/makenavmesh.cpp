@@ -120,6 +120,11 @@ namespace DetourNavigator
             return static_cast<int>(std::ceil(getRadius(settings, agentBounds) / settings.mCellSize));
         }
 
+        int getWalkableClimb(const RecastSettings& settings)
+        {
+            return static_cast<int>(std::floor(getMaxClimb(settings) / settings.mCellHeight));
+        }
+
         struct RecastParams
         {
             float mSampleDist = 0;
@@ -135,7 +140,7 @@ namespace DetourNavigator
             RecastParams result;
 
             result.mWalkableHeight = getWalkableHeight(settings, agentBounds);
-            result.mWalkableClimb = static_cast<int>(std::floor(getMaxClimb(settings) / settings.mCellHeight));
+            result.mWalkableClimb = getWalkableClimb(settings);
             result.mWalkableRadius = getWalkableRadius(settings, agentBounds);
             result.mMaxEdgeLen
                 = static_cast<int>(std::round(static_cast<float>(settings.mMaxEdgeLen) / settings.mCellSize));
@@ -309,6 +314,40 @@ namespace DetourNavigator
                     context, realTileBounds, recastMesh.getFlatHeightfields(), settings, params, solid);
         }
 
+        [[nodiscard]] bool rasterizeAgentIndependentTriangles(RecastContext& context, const TilePosition& tilePosition,
+            const RecastMesh& recastMesh, const RecastSettings& settings, const RecastParams& params,
+            rcHeightfield& solid)
+        {
+            const TileBounds realTileBounds = makeRealTileBoundsWithBorder(settings, tilePosition);
+            return rasterizeTriangles(context, recastMesh.getMesh(), settings, params, solid)
+                && rasterizeTriangles(context, recastMesh.getHeightfields(), settings, params, solid)
+                && rasterizeTriangles(
+                    context, realTileBounds, recastMesh.getFlatHeightfields(), settings, params, solid);
+        }
+
+        [[nodiscard]] bool copySpans(RecastContext& context, const rcHeightfield& source, int shift,
+            const RecastParams& params, rcHeightfield& solid)
+        {
+            for (int y = 0; y < source.height; ++y)
+            {
+                for (int x = 0; x < source.width; ++x)
+                {
+                    for (const rcSpan* span = source.spans[x + y * source.width]; span != nullptr; span = span->next)
+                    {
+                        const int min = static_cast<int>(span->smin) + shift;
+                        if (min > RC_SPAN_MAX_HEIGHT)
+                            break;
+                        const int max = std::min(static_cast<int>(span->smax) + shift, RC_SPAN_MAX_HEIGHT);
+                        if (!rcAddSpan(&context, solid, x, y, static_cast<unsigned short>(min),
+                                static_cast<unsigned short>(max), static_cast<unsigned char>(span->area),
+                                params.mWalkableClimb))
+                            return false;
+                    }
+                }
+            }
+            return true;
+        }
+
         bool isValidWalkableHeight(int value)
         {
             return value >= 3;
@@ -476,8 +515,7 @@ namespace DetourNavigator
             return true;
         }
 
-        std::pair<float, float> getBoundsByZ(
-            const RecastMesh& recastMesh, float agentHalfExtentsZ, const RecastSettings& settings)
+        std::pair<float, float> getBoundsByZ(const RecastMesh& recastMesh)
         {
             float minZ = 0;
             float maxZ = 0;
@@ -489,13 +527,6 @@ namespace DetourNavigator
                 maxZ = std::max(maxZ, vertices[i + 2]);
             }
 
-            for (const CellWater& water : recastMesh.getWater())
-            {
-                const float swimLevel = getSwimLevel(settings, water.mWater.mLevel, agentHalfExtentsZ);
-                minZ = std::min(minZ, swimLevel);
-                maxZ = std::max(maxZ, swimLevel);
-            }
-
             for (const Heightfield& heightfield : recastMesh.getHeightfields())
             {
                 if (heightfield.mHeights.empty())
@@ -514,8 +545,46 @@ namespace DetourNavigator
 
             return { minZ, maxZ };
         }
+
+        std::pair<float, float> getBoundsByZ(
+            const RecastMesh& recastMesh, float agentHalfExtentsZ, const RecastSettings& settings)
+        {
+            auto [minZ, maxZ] = getBoundsByZ(recastMesh);
+
+            for (const CellWater& water : recastMesh.getWater())
+            {
+                const float swimLevel = getSwimLevel(settings, water.mWater.mLevel, agentHalfExtentsZ);
+                minZ = std::min(minZ, swimLevel);
+                maxZ = std::max(maxZ, swimLevel);
+            }
+
+            return { minZ, maxZ };
+        }
+
+        std::unique_ptr<PreparedNavMeshData> makePreparedNavMeshData(
+            RecastContext& context, const RecastSettings& settings, const RecastParams& params, rcHeightfield& solid)
+        {
+            rcFilterLowHangingWalkableObstacles(&context, params.mWalkableClimb, solid);
+            rcFilterLedgeSpans(&context, params.mWalkableHeight, params.mWalkableClimb, solid);
+            rcFilterWalkableLowHeightSpans(&context, params.mWalkableHeight, solid);
+
+            std::unique_ptr<PreparedNavMeshData> result = std::make_unique<PreparedNavMeshData>();
+
+            if (!fillPolyMesh(context, settings, params, solid, result->mPolyMesh, result->mPolyMeshDetail))
+                return nullptr;
+
+            result->mCellSize = settings.mCellSize;
+            result->mCellHeight = settings.mCellHeight;
+
+            return result;
+        }
     }
 
+    struct RasterizedRecastMesh
+    {
+        rcHeightfield mSolid;
+    };
+
     std::unique_ptr<PreparedNavMeshData> prepareNavMeshTileData(const RecastMesh& recastMesh, ESM::RefId worldspace,
         const TilePosition& tilePosition, const AgentBounds& agentBounds, const RecastSettings& settings)
     {
@@ -534,21 +603,63 @@ namespace DetourNavigator
                 context, tilePosition, agentBounds.mHalfExtents.z(), recastMesh, settings, params, solid))
             return nullptr;
 
-        rcFilterLowHangingWalkableObstacles(&context, params.mWalkableClimb, solid);
-        rcFilterLedgeSpans(&context, params.mWalkableHeight, params.mWalkableClimb, solid);
-        rcFilterWalkableLowHeightSpans(&context, params.mWalkableHeight, solid);
+        return makePreparedNavMeshData(context, settings, params, solid);
+    }
 
-        std::unique_ptr<PreparedNavMeshData> result = std::make_unique<PreparedNavMeshData>();
+    std::shared_ptr<const RasterizedRecastMesh> rasterizeRecastMesh(const RecastMesh& recastMesh,
+        ESM::RefId worldspace, const TilePosition& tilePosition, const RecastSettings& settings)
+    {
+        RecastContext context(worldspace, tilePosition, recastMesh.getVersion(), settings.mMaxLogLevel);
+
+        const auto [minZ, maxZ] = getBoundsByZ(recastMesh);
 
-        if (!fillPolyMesh(context, settings, params, solid, result->mPolyMesh, result->mPolyMeshDetail))
+        auto result = std::make_shared<RasterizedRecastMesh>();
+        if (!initHeightfield(context, tilePosition, toNavMeshCoordinates(settings, minZ),
+                toNavMeshCoordinates(settings, maxZ), settings, result->mSolid))
             return nullptr;
 
-        result->mCellSize = settings.mCellSize;
-        result->mCellHeight = settings.mCellHeight;
+        RecastParams params;
+        params.mWalkableClimb = getWalkableClimb(settings);
+
+        if (!rasterizeAgentIndependentTriangles(context, tilePosition, recastMesh, settings, params, result->mSolid))
+            return nullptr;
 
         return result;
     }
 
+    std::unique_ptr<PreparedNavMeshData> prepareNavMeshTileData(const RasterizedRecastMesh& rasterizedRecastMesh,
+        const RecastMesh& recastMesh, ESM::RefId worldspace, const TilePosition& tilePosition,
+        const AgentBounds& agentBounds, const RecastSettings& settings)
+    {
+        RecastContext context(worldspace, tilePosition, agentBounds, recastMesh.getVersion(), settings.mMaxLogLevel);
+
+        const rcHeightfield& shared = rasterizedRecastMesh.mSolid;
+        const auto [minZ, maxZ] = getBoundsByZ(recastMesh, agentBounds.mHalfExtents.z(), settings);
+
+        // Water level depends on the agent and may be below the shared heightfield. Extend it down by a whole number
+        // of cells to keep the shared spans aligned.
+        const int shift = std::max(0,
+            static_cast<int>(std::ceil((shared.bmin[1] - toNavMeshCoordinates(settings, minZ)) / shared.ch)));
+
+        rcHeightfield solid;
+        if (!initHeightfield(context, tilePosition, shared.bmin[1] - static_cast<float>(shift) * shared.ch,
+                std::max(shared.bmax[1], toNavMeshCoordinates(settings, maxZ)), settings, solid))
+            return nullptr;
+
+        const RecastParams params = makeRecastParams(settings, agentBounds);
+
+        if (!copySpans(context, shared, shift, params, solid))
+            return nullptr;
+
+        const TileBounds realTileBounds = makeRealTileBoundsWithBorder(settings, tilePosition);
+
+        if (!rasterizeTriangles(context, agentBounds.mHalfExtents.z(), recastMesh.getWater(), settings, params,
+                realTileBounds, solid))
+            return nullptr;
+
+        return makePreparedNavMeshData(context, settings, params, solid);
+    }
+
     NavMeshData makeNavMeshTileData(const PreparedNavMeshData& data,
         const std::vector<OffMeshConnection>& offMeshConnections, const AgentBounds& agentBounds,
         const TilePosition& tile, const RecastSettings& settings)
@@ -20,6 +20,7 @@ namespace DetourNavigator
     struct OffMeshConnection;
     struct AgentBounds;
     struct RecastSettings;
+    struct RasterizedRecastMesh;
 
     inline float getLength(const osg::Vec2i& value)
     {
@@ -46,6 +47,15 @@ namespace DetourNavigator
     std::unique_ptr<PreparedNavMeshData> prepareNavMeshTileData(const RecastMesh& recastMesh, ESM::RefId worldspace,
         const TilePosition& tilePosition, const AgentBounds& agentBounds, const RecastSettings& settings);
 
+    /// Rasterizes the part of recast mesh input not depending on agent bounds. Result can be used to prepare navmesh
+    /// tile data for multiple agents without rasterizing the same geometry again.
+    std::shared_ptr<const RasterizedRecastMesh> rasterizeRecastMesh(const RecastMesh& recastMesh,
+        ESM::RefId worldspace, const TilePosition& tilePosition, const RecastSettings& settings);
+
+    std::unique_ptr<PreparedNavMeshData> prepareNavMeshTileData(const RasterizedRecastMesh& rasterizedRecastMesh,
+        const RecastMesh& recastMesh, ESM::RefId worldspace, const TilePosition& tilePosition,
+        const AgentBounds& agentBounds, const RecastSettings& settings);
+
     NavMeshData makeNavMeshTileData(const PreparedNavMeshData& data,
         const std::vector<OffMeshConnection>& offMeshConnections, const AgentBounds& agentBounds,
         const TilePosition& tile, const RecastSettings& settings);
@@ -11,7 +11,10 @@
 
 #include <cstddef>
 #include <format>
+#include <iterator>
+#include <limits>
 #include <string_view>
+#include <tuple>
 #include <vector>
 
 namespace DetourNavigator
@@ -48,6 +51,11 @@ namespace DetourNavigator
             CREATE UNIQUE INDEX IF NOT EXISTS index_unique_shapes_by_name_and_type_and_hash
                 ON shapes (name, type, hash);
 
+            CREATE TABLE IF NOT EXISTS checkpoints (
+                worldspace TEXT PRIMARY KEY,
+                key BLOB NOT NULL
+            );
+
             COMMIT;
         )";
 
@@ -73,6 +81,16 @@ namespace DetourNavigator
                AND input = :input
         )";
 
+        constexpr std::string_view getTilesDataQuery = R"(
+            SELECT tile_id, version, tile_position_x, tile_position_y, input, data
+              FROM tiles
+             WHERE worldspace = :worldspace
+               AND tile_position_x >= :begin_tile_position_x
+               AND tile_position_y >= :begin_tile_position_y
+               AND tile_position_x < :end_tile_position_x
+               AND tile_position_y < :end_tile_position_y
+        )";
+
         constexpr std::string_view insertTileQuery = R"(
             INSERT INTO tiles ( tile_id,  worldspace,  version,  tile_position_x,  tile_position_y,  input,  data)
                    VALUES     (:tile_id, :worldspace, :version, :tile_position_x, :tile_position_y, :input, :data)
@@ -128,6 +146,18 @@ namespace DetourNavigator
                    VALUES      (:shape_id, :name, :type, :hash)
         )";
 
+        constexpr std::string_view findCheckpointQuery = R"(
+            SELECT count(*)
+              FROM checkpoints
+             WHERE worldspace = :worldspace
+               AND key = :key
+        )";
+
+        constexpr std::string_view insertCheckpointQuery = R"(
+            INSERT OR REPLACE INTO checkpoints ( worldspace,  key)
+                   VALUES                      (:worldspace, :key)
+        )";
+
         constexpr std::string_view vacuumQuery = R"(
             VACUUM;
         )";
@@ -171,6 +201,7 @@ namespace DetourNavigator
         , mGetMaxTileId(*mDb, DbQueries::GetMaxTileId{})
         , mFindTile(*mDb, DbQueries::FindTile{})
         , mGetTileData(*mDb, DbQueries::GetTileData{})
+        , mGetTilesData(*mDb, DbQueries::GetTilesData{})
         , mInsertTile(*mDb, DbQueries::InsertTile{})
         , mUpdateTile(*mDb, DbQueries::UpdateTile{})
         , mDeleteTilesAt(*mDb, DbQueries::DeleteTilesAt{})
@@ -179,6 +210,8 @@ namespace DetourNavigator
         , mGetMaxShapeId(*mDb, DbQueries::GetMaxShapeId{})
         , mFindShapeId(*mDb, DbQueries::FindShapeId{})
         , mInsertShape(*mDb, DbQueries::InsertShape{})
+        , mFindCheckpoint(*mDb, DbQueries::FindCheckpoint{})
+        , mInsertCheckpoint(*mDb, DbQueries::InsertCheckpoint{})
         , mVacuum(*mDb, DbQueries::Vacuum{})
     {
         const std::uint64_t dbPageSize = getPageSize(*mDb);
@@ -222,6 +255,33 @@ namespace DetourNavigator
         return result;
     }
 
+    std::vector<std::optional<TileData>> NavMeshDb::getTilesData(
+        ESM::RefId worldspace, const TilesPositionsRange& range, std::span<const TileInputAt> tiles)
+    {
+        std::vector<std::vector<std::byte>> compressedInputs;
+        compressedInputs.reserve(tiles.size());
+        for (const TileInputAt& tile : tiles)
+            compressedInputs.push_back(Misc::compress(*tile.mInput));
+        std::vector<std::tuple<TileId, TileVersion, int, int, std::vector<std::byte>, std::vector<std::byte>>> rows;
+        request(*mDb, mGetTilesData, std::back_inserter(rows), std::numeric_limits<std::size_t>::max(),
+            worldspace.serializeText(), range);
+        std::vector<std::optional<TileData>> result(tiles.size());
+        for (const auto& [tileId, version, x, y, input, data] : rows)
+        {
+            const TilePosition tilePosition(x, y);
+            std::optional<TileData> tileData;
+            for (std::size_t i = 0; i < tiles.size(); ++i)
+            {
+                if (result[i].has_value() || tiles[i].mTilePosition != tilePosition || compressedInputs[i] != input)
+                    continue;
+                if (!tileData.has_value())
+                    tileData = TileData{ .mTileId = tileId, .mVersion = version, .mData = Misc::decompress(data) };
+                result[i] = tileData;
+            }
+        }
+        return result;
+    }
+
     int NavMeshDb::insertTile(TileId tileId, ESM::RefId worldspace, const TilePosition& tilePosition,
         TileVersion version, const std::vector<std::byte>& input, const std::vector<std::byte>& data)
     {
@@ -272,6 +332,18 @@ namespace DetourNavigator
         return execute(*mDb, mInsertShape, shapeId, name, type, hash);
     }
 
+    bool NavMeshDb::hasCheckpoint(ESM::RefId worldspace, const Sqlite3::ConstBlob& key)
+    {
+        std::int64_t count = 0;
+        request(*mDb, mFindCheckpoint, &count, 1, worldspace.serializeText(), key);
+        return count > 0;
+    }
+
+    int NavMeshDb::insertCheckpoint(ESM::RefId worldspace, const Sqlite3::ConstBlob& key)
+    {
+        return execute(*mDb, mInsertCheckpoint, worldspace.serializeText(), key);
+    }
+
     void NavMeshDb::vacuum()
     {
         execute(*mDb, mVacuum);
@@ -312,6 +384,21 @@ namespace DetourNavigator
             Sqlite3::bindParameter(db, statement, ":input", input);
         }
 
+        std::string_view GetTilesData::text() noexcept
+        {
+            return getTilesDataQuery;
+        }
+
+        void GetTilesData::bind(
+            sqlite3& db, sqlite3_stmt& statement, std::string_view worldspace, const TilesPositionsRange& range)
+        {
+            Sqlite3::bindParameter(db, statement, ":worldspace", worldspace);
+            Sqlite3::bindParameter(db, statement, ":begin_tile_position_x", range.mBegin.x());
+            Sqlite3::bindParameter(db, statement, ":begin_tile_position_y", range.mBegin.y());
+            Sqlite3::bindParameter(db, statement, ":end_tile_position_x", range.mEnd.x());
+            Sqlite3::bindParameter(db, statement, ":end_tile_position_y", range.mEnd.y());
+        }
+
         std::string_view InsertTile::text() noexcept
         {
             return insertTileQuery;
@@ -417,6 +504,30 @@ namespace DetourNavigator
             Sqlite3::bindParameter(db, statement, ":hash", hash);
         }
 
+        std::string_view FindCheckpoint::text() noexcept
+        {
+            return findCheckpointQuery;
+        }
+
+        void FindCheckpoint::bind(
+            sqlite3& db, sqlite3_stmt& statement, std::string_view worldspace, const Sqlite3::ConstBlob& key)
+        {
+            Sqlite3::bindParameter(db, statement, ":worldspace", worldspace);
+            Sqlite3::bindParameter(db, statement, ":key", key);
+        }
+
+        std::string_view InsertCheckpoint::text() noexcept
+        {
+            return insertCheckpointQuery;
+        }
+
+        void InsertCheckpoint::bind(
+            sqlite3& db, sqlite3_stmt& statement, std::string_view worldspace, const Sqlite3::ConstBlob& key)
+        {
+            Sqlite3::bindParameter(db, statement, ":worldspace", worldspace);
+            Sqlite3::bindParameter(db, statement, ":key", key);
+        }
+
         std::string_view Vacuum::text() noexcept
         {
             return vacuumQuery;
@@ -14,6 +14,7 @@
 #include <cstddef>
 #include <cstdint>
 #include <optional>
+#include <span>
 #include <string_view>
 #include <vector>
 
@@ -40,6 +41,12 @@ namespace DetourNavigator
         std::vector<std::byte> mData;
     };
 
+    struct TileInputAt
+    {
+        TilePosition mTilePosition;
+        const std::vector<std::byte>* mInput;
+    };
+
     enum class ShapeType
     {
         Collision = 1,
@@ -70,6 +77,13 @@ namespace DetourNavigator
                 const TilePosition& tilePosition, const std::vector<std::byte>& input);
         };
 
+        struct GetTilesData
+        {
+            static std::string_view text() noexcept;
+            static void bind(
+                sqlite3& db, sqlite3_stmt& statement, std::string_view worldspace, const TilesPositionsRange& range);
+        };
+
         struct InsertTile
         {
             static std::string_view text() noexcept;
@@ -126,6 +140,20 @@ namespace DetourNavigator
                 ShapeType type, const Sqlite3::ConstBlob& hash);
         };
 
+        struct FindCheckpoint
+        {
+            static std::string_view text() noexcept;
+            static void bind(
+                sqlite3& db, sqlite3_stmt& statement, std::string_view worldspace, const Sqlite3::ConstBlob& key);
+        };
+
+        struct InsertCheckpoint
+        {
+            static std::string_view text() noexcept;
+            static void bind(
+                sqlite3& db, sqlite3_stmt& statement, std::string_view worldspace, const Sqlite3::ConstBlob& key);
+        };
+
         struct Vacuum
         {
             static std::string_view text() noexcept;
@@ -148,6 +176,12 @@ namespace DetourNavigator
         std::optional<TileData> getTileData(
             ESM::RefId worldspace, const TilePosition& tilePosition, const std::vector<std::byte>& input);
 
+        /// Reads all tiles with positions inside the range by a single query and returns data of the tiles matching
+        /// given positions and inputs in the same order or nullopt for not found ones. Only data of the matching
+        /// tiles is decompressed.
+        std::vector<std::optional<TileData>> getTilesData(
+            ESM::RefId worldspace, const TilesPositionsRange& range, std::span<const TileInputAt> tiles);
+
         int insertTile(TileId tileId, ESM::RefId worldspace, const TilePosition& tilePosition, TileVersion version,
             const std::vector<std::byte>& input, const std::vector<std::byte>& data);
 
@@ -165,6 +199,12 @@ namespace DetourNavigator
 
         int insertShape(ShapeId shapeId, std::string_view name, ShapeType type, const Sqlite3::ConstBlob& hash);
 
+        /// Returns true if the worldspace is marked as completely processed with the same key.
+        bool hasCheckpoint(ESM::RefId worldspace, const Sqlite3::ConstBlob& key);
+
+        /// Marks the worldspace as completely processed replacing previous key.
+        int insertCheckpoint(ESM::RefId worldspace, const Sqlite3::ConstBlob& key);
+
         void vacuum();
 
     private:
@@ -172,6 +212,7 @@ namespace DetourNavigator
         Sqlite3::Statement<DbQueries::GetMaxTileId> mGetMaxTileId;
         Sqlite3::Statement<DbQueries::FindTile> mFindTile;
         Sqlite3::Statement<DbQueries::GetTileData> mGetTileData;
+        Sqlite3::Statement<DbQueries::GetTilesData> mGetTilesData;
         Sqlite3::Statement<DbQueries::InsertTile> mInsertTile;
         Sqlite3::Statement<DbQueries::UpdateTile> mUpdateTile;
         Sqlite3::Statement<DbQueries::DeleteTilesAt> mDeleteTilesAt;
@@ -180,6 +221,8 @@ namespace DetourNavigator
         Sqlite3::Statement<DbQueries::GetMaxShapeId> mGetMaxShapeId;
         Sqlite3::Statement<DbQueries::FindShapeId> mFindShapeId;
         Sqlite3::Statement<DbQueries::InsertShape> mInsertShape;
+        Sqlite3::Statement<DbQueries::FindCheckpoint> mFindCheckpoint;
+        Sqlite3::Statement<DbQueries::InsertCheckpoint> mInsertCheckpoint;
         Sqlite3::Statement<DbQueries::Vacuum> mVacuum;
     };
 }
@@ -10,11 +10,15 @@
 
 #include <components/debug/debuglog.hpp>
 #include <components/esm/util.hpp>
+#include <components/misc/constants.hpp>
 
 #include <osg/io_utils>
 
 #include <DetourNavMesh.h>
 
+#include <algorithm>
+#include <chrono>
+
 namespace
 {
     /// Safely reset shared_ptr with definite underlying object destrutor call.
@@ -81,14 +85,22 @@ namespace DetourNavigator
         {
             return getTilePosition(settings, toNavMeshCoordinates(settings, position));
         }
+
+        TilePosition clampTilePosition(const TilePosition& position, const TilePosition& center, int radius)
+        {
+            return TilePosition(std::clamp(position.x(), center.x() - radius, center.x() + radius),
+                std::clamp(position.y(), center.y() - radius, center.y() + radius));
+        }
     }
 
     NavMeshManager::NavMeshManager(const Settings& settings, std::unique_ptr<NavMeshDb>&& db)
         : mSettings(settings)
         , mMaxRadius(getMaxRadius(settings.mMaxTilesNumber))
-        , mRecastMeshManager(settings.mRecast)
+        , mRecastMeshManager(settings.mRecast, settings.mMaxRecastMeshObjectsCacheSize)
         , mOffMeshConnectionsManager(settings.mRecast)
         , mAsyncNavMeshUpdater(settings, mRecastMeshManager, mOffMeshConnectionsManager, std::move(db))
+        , mPlayerMovementPredictor(
+              settings.mPlayerMovementPredictionTime, static_cast<float>(Constants::CellSizeInUnits))
     {
     }
 
@@ -101,6 +113,8 @@ namespace DetourNavigator
             for (auto& [agent, cache] : mCache)
                 cache = std::make_shared<GuardedNavMeshCacheItem>(++mGenerationCounter, mSettings);
             mWorldspace = worldspace;
+            mPlayerMovementPredictor.reset();
+            mAsyncNavMeshUpdater.setPredictedPlayerTile(std::nullopt);
         }
 
         const TilePosition playerTile = toNavMeshTilePosition(mSettings.mRecast, playerPosition);
@@ -193,6 +207,13 @@ namespace DetourNavigator
     void NavMeshManager::update(const osg::Vec3f& playerPosition, const UpdateGuard* guard)
     {
         const TilePosition playerTile = toNavMeshTilePosition(mSettings.mRecast, playerPosition);
+        if (mSettings.mPlayerMovementPredictionTime.count() > 0)
+        {
+            const osg::Vec3f predictedPosition
+                = mPlayerMovementPredictor.update(playerPosition, std::chrono::steady_clock::now());
+            const TilePosition predictedTile = toNavMeshTilePosition(mSettings.mRecast, predictedPosition);
+            mAsyncNavMeshUpdater.setPredictedPlayerTile(clampTilePosition(predictedTile, playerTile, mMaxRadius));
+        }
         if (mLastRecastMeshManagerRevision == mRecastMeshManager.getRevision() && mPlayerTile.has_value()
             && *mPlayerTile == playerTile)
             return;
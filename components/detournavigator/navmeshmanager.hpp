@@ -6,6 +6,7 @@
 #include "cellgridbounds.hpp"
 #include "heightfieldshape.hpp"
 #include "offmeshconnectionsmanager.hpp"
+#include "playermovementpredictor.hpp"
 #include "recastmeshtiles.hpp"
 #include "waitconditiontype.hpp"
 
@@ -73,6 +74,7 @@ namespace DetourNavigator
         TileCachedRecastMeshManager mRecastMeshManager;
         OffMeshConnectionsManager mOffMeshConnectionsManager;
         AsyncNavMeshUpdater mAsyncNavMeshUpdater;
+        PlayerMovementPredictor mPlayerMovementPredictor;
         std::map<AgentBounds, SharedNavMeshCacheItem> mCache;
         std::size_t mGenerationCounter = 0;
         std::optional<TilePosition> mPlayerTile;
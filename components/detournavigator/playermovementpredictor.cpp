@@ -0,0 +1,45 @@
+#include "playermovementpredictor.hpp"
+
+namespace DetourNavigator
+{
+    namespace
+    {
+        // Velocity changes faster than this are mostly smoothed out
+        constexpr float velocitySmoothingTime = 0.25f;
+    }
+
+    PlayerMovementPredictor::PlayerMovementPredictor(std::chrono::milliseconds predictionTime, float teleportDistance)
+        : mPredictionTime(std::chrono::duration<float>(predictionTime).count())
+        , mTeleportDistance(teleportDistance)
+    {
+    }
+
+    void PlayerMovementPredictor::reset()
+    {
+        mLastPosition.reset();
+        mVelocity = osg::Vec3f();
+    }
+
+    osg::Vec3f PlayerMovementPredictor::update(const osg::Vec3f& position, std::chrono::steady_clock::time_point now)
+    {
+        if (!mLastPosition.has_value() || (position - *mLastPosition).length() > mTeleportDistance)
+        {
+            mVelocity = osg::Vec3f();
+            mLastPosition = position;
+            mLastTime = now;
+            return position;
+        }
+
+        const float duration = std::chrono::duration<float>(now - mLastTime).count();
+        if (duration <= 0)
+            return position + mVelocity * mPredictionTime;
+
+        const osg::Vec3f velocity = (position - *mLastPosition) / duration;
+        const float factor = duration / (duration + velocitySmoothingTime);
+        mVelocity += (velocity - mVelocity) * factor;
+        mLastPosition = position;
+        mLastTime = now;
+
+        return position + mVelocity * mPredictionTime;
+    }
+}
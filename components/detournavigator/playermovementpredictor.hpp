@@ -0,0 +1,34 @@
+#ifndef OPENMW_COMPONENTS_DETOURNAVIGATOR_PLAYERMOVEMENTPREDICTOR_H
+#define OPENMW_COMPONENTS_DETOURNAVIGATOR_PLAYERMOVEMENTPREDICTOR_H
+
+#include <osg/Vec3f>
+
+#include <chrono>
+#include <optional>
+
+namespace DetourNavigator
+{
+    /// Estimates player velocity from the positions reported each frame to predict where the player will be.
+    class PlayerMovementPredictor
+    {
+    public:
+        /// @param teleportDistance Position change larger than this is considered a teleport and resets the velocity.
+        explicit PlayerMovementPredictor(std::chrono::milliseconds predictionTime, float teleportDistance);
+
+        void reset();
+
+        /// @return Position expected after prediction time.
+        osg::Vec3f update(const osg::Vec3f& position, std::chrono::steady_clock::time_point now);
+
+        const osg::Vec3f& getVelocity() const { return mVelocity; }
+
+    private:
+        const float mPredictionTime;
+        const float mTeleportDistance;
+        std::optional<osg::Vec3f> mLastPosition;
+        std::chrono::steady_clock::time_point mLastTime;
+        osg::Vec3f mVelocity;
+    };
+}
+
+#endif
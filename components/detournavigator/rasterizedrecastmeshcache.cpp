@@ -0,0 +1,57 @@
+#include "rasterizedrecastmeshcache.hpp"
+#include "makenavmesh.hpp"
+#include "recastmesh.hpp"
+
+namespace DetourNavigator
+{
+    RasterizedRecastMeshCache::RasterizedRecastMeshCache(std::size_t maxSize)
+        : mMaxSize(maxSize)
+    {
+    }
+
+    std::shared_ptr<const RasterizedRecastMesh> RasterizedRecastMeshCache::get(ESM::RefId worldspace,
+        const TilePosition& tilePosition, const RecastMesh& recastMesh, const RecastSettings& settings)
+    {
+        if (mMaxSize == 0)
+            return rasterizeRecastMesh(recastMesh, worldspace, tilePosition, settings);
+
+        std::shared_ptr<Item> item;
+
+        {
+            const std::lock_guard lock(mMutex);
+            const Key key(worldspace, tilePosition);
+            auto it = mEntries.find(key);
+            if (it == mEntries.end())
+            {
+                if (mEntries.size() >= mMaxSize)
+                {
+                    mEntries.erase(mUsage.back());
+                    mUsage.pop_back();
+                }
+                mUsage.push_front(key);
+                it = mEntries.emplace_hint(it, key, Entry{ recastMesh.getVersion(), nullptr, mUsage.begin() });
+            }
+            else
+            {
+                mUsage.splice(mUsage.begin(), mUsage, it->second.mUsage);
+            }
+            if (it->second.mItem == nullptr || it->second.mVersion != recastMesh.getVersion())
+            {
+                it->second.mVersion = recastMesh.getVersion();
+                it->second.mItem = std::make_shared<Item>();
+            }
+            item = it->second.mItem;
+        }
+
+        std::call_once(
+            item->mOnce, [&] { item->mValue = rasterizeRecastMesh(recastMesh, worldspace, tilePosition, settings); });
+
+        return item->mValue;
+    }
+
+    std::size_t RasterizedRecastMeshCache::getSize() const
+    {
+        const std::lock_guard lock(mMutex);
+        return mEntries.size();
+    }
+}
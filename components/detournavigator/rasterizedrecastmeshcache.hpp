@@ -0,0 +1,58 @@
+#ifndef OPENMW_COMPONENTS_DETOURNAVIGATOR_RASTERIZEDRECASTMESHCACHE_H
+#define OPENMW_COMPONENTS_DETOURNAVIGATOR_RASTERIZEDRECASTMESHCACHE_H
+
+#include "tileposition.hpp"
+#include "version.hpp"
+
+#include <components/esm/refid.hpp>
+
+#include <cstddef>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <tuple>
+
+namespace DetourNavigator
+{
+    class RecastMesh;
+    struct RasterizedRecastMesh;
+    struct RecastSettings;
+
+    /// Keeps rasterized recast meshes for the recently processed tiles so navmesh tiles for different agents can be
+    /// generated from the same voxelized geometry. Concurrent requests for the same tile wait for the single
+    /// rasterization.
+    class RasterizedRecastMeshCache
+    {
+    public:
+        explicit RasterizedRecastMeshCache(std::size_t maxSize);
+
+        std::shared_ptr<const RasterizedRecastMesh> get(ESM::RefId worldspace, const TilePosition& tilePosition,
+            const RecastMesh& recastMesh, const RecastSettings& settings);
+
+        std::size_t getSize() const;
+
+    private:
+        struct Item
+        {
+            std::once_flag mOnce;
+            std::shared_ptr<const RasterizedRecastMesh> mValue;
+        };
+
+        using Key = std::tuple<ESM::RefId, TilePosition>;
+
+        struct Entry
+        {
+            Version mVersion;
+            std::shared_ptr<Item> mItem;
+            std::list<Key>::iterator mUsage;
+        };
+
+        const std::size_t mMaxSize;
+        mutable std::mutex mMutex;
+        std::map<Key, Entry> mEntries;
+        std::list<Key> mUsage;
+    };
+}
+
+#endif
@@ -31,6 +31,14 @@ namespace DetourNavigator
                    << tilePosition.y() << "; agent bounds: " << agentBounds << "; version: " << version << "; ";
             return stream.str();
         }
+
+        std::string formatPrefix(ESM::RefId worldspace, const TilePosition& tilePosition, const Version& version)
+        {
+            std::ostringstream stream;
+            stream << "Worldspace: " << worldspace << "; tile position: " << tilePosition.x() << ", "
+                   << tilePosition.y() << "; version: " << version << "; ";
+            return stream.str();
+        }
     }
 
     RecastContext::RecastContext(ESM::RefId worldspace, const TilePosition& tilePosition,
@@ -40,6 +48,13 @@ namespace DetourNavigator
     {
     }
 
+    RecastContext::RecastContext(
+        ESM::RefId worldspace, const TilePosition& tilePosition, const Version& version, Debug::Level maxLogLevel)
+        : mMaxLogLevel(maxLogLevel)
+        , mPrefix(formatPrefix(worldspace, tilePosition, version))
+    {
+    }
+
     void RecastContext::doLog(const rcLogCategory category, const char* msg, const int len)
     {
         if (msg == nullptr || len <= 0)
@@ -21,6 +21,9 @@ namespace DetourNavigator
         explicit RecastContext(ESM::RefId worldspace, const TilePosition& tilePosition, const AgentBounds& agentBounds,
             const Version& version, Debug::Level maxLogLevel);
 
+        explicit RecastContext(ESM::RefId worldspace, const TilePosition& tilePosition, const Version& version,
+            Debug::Level maxLogLevel);
+
         const std::string& getPrefix() const { return mPrefix; }
 
     private:
@@ -145,6 +145,21 @@ namespace DetourNavigator
         mSources.push_back(MeshSource{ std::move(source), objectTransform, areaType });
     }
 
+    void RecastMeshBuilder::addObject(std::span<const RecastMeshTriangle> triangles, const AreaType areaType,
+        osg::ref_ptr<const Resource::BulletShape> source, const ObjectTransform& objectTransform)
+    {
+        mTriangles.insert(mTriangles.end(), triangles.begin(), triangles.end());
+        mSources.push_back(MeshSource{ std::move(source), objectTransform, areaType });
+    }
+
+    std::vector<RecastMeshTriangle> RecastMeshBuilder::makeTriangles(const TileBounds& bounds,
+        const btCollisionShape& shape, const btTransform& transform, const AreaType areaType)
+    {
+        RecastMeshBuilder builder(bounds);
+        builder.addObject(shape, transform, areaType);
+        return std::move(builder.mTriangles);
+    }
+
     void RecastMeshBuilder::addObject(
         const btCollisionShape& shape, const btTransform& transform, const AreaType areaType)
     {
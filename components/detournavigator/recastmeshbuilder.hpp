@@ -12,6 +12,7 @@
 
 #include <array>
 #include <memory>
+#include <span>
 #include <tuple>
 #include <vector>
 
@@ -51,6 +52,10 @@ namespace DetourNavigator
 
         void addObject(const btBoxShape& shape, const btTransform& transform, const AreaType areaType);
 
+        /// Adds triangles made by makeTriangles with the same bounds instead of processing the shape again.
+        void addObject(std::span<const RecastMeshTriangle> triangles, const AreaType areaType,
+            osg::ref_ptr<const Resource::BulletShape> source, const ObjectTransform& objectTransform);
+
         void addWater(const osg::Vec2i& cellPosition, const Water& water);
 
         void addHeightfield(const osg::Vec2i& cellPosition, int cellSize, float height);
@@ -60,6 +65,10 @@ namespace DetourNavigator
 
         std::shared_ptr<RecastMesh> create(const Version& version) &&;
 
+        /// Returns triangles of the shape intersecting the bounds.
+        static std::vector<RecastMeshTriangle> makeTriangles(const TileBounds& bounds, const btCollisionShape& shape,
+            const btTransform& transform, const AreaType areaType);
+
     private:
         const TileBounds mBounds;
         std::vector<RecastMeshTriangle> mTriangles;
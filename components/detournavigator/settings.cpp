@@ -96,6 +96,9 @@ namespace DetourNavigator
         result.mWaitUntilMinDistanceToPlayer = ::Settings::navigator().mWaitUntilMinDistanceToPlayer;
         result.mAsyncNavMeshUpdaterThreads = ::Settings::navigator().mAsyncNavMeshUpdaterThreads;
         result.mMaxNavMeshTilesCacheSize = ::Settings::navigator().mMaxNavMeshTilesCacheSize;
+        result.mMaxRecastMeshObjectsCacheSize = ::Settings::navigator().mMaxRecastMeshObjectsCacheSize;
+        result.mMaxRasterizedRecastMeshCacheSize = ::Settings::navigator().mMaxRasterizedRecastMeshCacheSize;
+        result.mAsyncPathFinderThreads = ::Settings::navigator().mAsyncPathFinderThreads;
         result.mEnableWriteRecastMeshToFile = ::Settings::navigator().mEnableWriteRecastMeshToFile;
         result.mEnableWriteNavMeshToFile = ::Settings::navigator().mEnableWriteNavMeshToFile;
         result.mRecastMeshPathPrefix = ::Settings::navigator().mRecastMeshPathPrefix;
@@ -103,6 +106,8 @@ namespace DetourNavigator
         result.mEnableRecastMeshFileNameRevision = ::Settings::navigator().mEnableRecastMeshFileNameRevision;
         result.mEnableNavMeshFileNameRevision = ::Settings::navigator().mEnableNavMeshFileNameRevision;
         result.mMinUpdateInterval = std::chrono::milliseconds(::Settings::navigator().mMinUpdateIntervalMs);
+        result.mPlayerMovementPredictionTime
+            = std::chrono::milliseconds(::Settings::navigator().mPlayerMovementPredictionTimeMs);
         result.mEnableNavMeshDiskCache = ::Settings::navigator().mEnableNavMeshDiskCache;
         result.mWriteToNavMeshDb = ::Settings::navigator().mWriteToNavmeshdb;
         result.mMaxDbFileSize = ::Settings::navigator().mMaxNavmeshdbFileSize;
@@ -50,9 +50,13 @@ namespace DetourNavigator
         int mMaxTilesNumber = 0;
         std::size_t mAsyncNavMeshUpdaterThreads = 0;
         std::size_t mMaxNavMeshTilesCacheSize = 0;
+        std::size_t mMaxRecastMeshObjectsCacheSize = 0;
+        std::size_t mMaxRasterizedRecastMeshCacheSize = 0;
+        std::size_t mAsyncPathFinderThreads = 0;
         std::string mRecastMeshPathPrefix;
         std::string mNavMeshPathPrefix;
         std::chrono::milliseconds mMinUpdateInterval;
+        std::chrono::milliseconds mPlayerMovementPredictionTime{ 0 };
         std::uint64_t mMaxDbFileSize = 0;
     };
 
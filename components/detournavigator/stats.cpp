@@ -2,10 +2,26 @@
 
 #include <osg/Stats>
 
+#include <algorithm>
+#include <string>
+#include <string_view>
+
 namespace DetourNavigator
 {
     namespace
     {
+        void reportStats(
+            std::string_view prefix, const LatencyHistogram& stats, unsigned int frameNumber, osg::Stats& out)
+        {
+            for (std::size_t i = 0; i < LatencyHistogram::sBounds.size(); ++i)
+                out.setAttribute(frameNumber,
+                    std::string(prefix) + " <" + std::to_string(LatencyHistogram::sBounds[i]) + "ms",
+                    static_cast<double>(stats.mCounts[i]));
+            out.setAttribute(frameNumber,
+                std::string(prefix) + " >=" + std::to_string(LatencyHistogram::sBounds.back()) + "ms",
+                static_cast<double>(stats.mCounts.back()));
+        }
+
         void reportStats(const AsyncNavMeshUpdaterStats& stats, unsigned int frameNumber, osg::Stats& out)
         {
             out.setAttribute(frameNumber, "NavMesh Jobs", static_cast<double>(stats.mJobs));
@@ -31,6 +47,9 @@ namespace DetourNavigator
             out.setAttribute(frameNumber, "NavMesh CachedTiles", static_cast<double>(stats.mCache.mCachedNavMeshTiles));
             out.setAttribute(frameNumber, "NavMesh Cache Get", static_cast<double>(stats.mCache.mGetCount));
             out.setAttribute(frameNumber, "NavMesh Cache Hit", static_cast<double>(stats.mCache.mHitCount));
+
+            reportStats("NavMesh QueueLatency", stats.mQueueLatency, frameNumber, out);
+            reportStats("NavMesh TotalLatency", stats.mTotalLatency, frameNumber, out);
         }
 
         void reportStats(const TileCachedRecastMeshManagerStats& stats, unsigned int frameNumber, osg::Stats& out)
@@ -39,9 +58,18 @@ namespace DetourNavigator
             out.setAttribute(frameNumber, "NavMesh Recast Objects", static_cast<double>(stats.mObjects));
             out.setAttribute(frameNumber, "NavMesh Recast Heightfields", static_cast<double>(stats.mHeightfields));
             out.setAttribute(frameNumber, "NavMesh Recast Water", static_cast<double>(stats.mWater));
+            out.setAttribute(frameNumber, "NavMesh Recast ObjectsTrianglesCacheSize",
+                static_cast<double>(stats.mObjectsTrianglesCacheSize));
         }
     }
 
+    void LatencyHistogram::add(std::chrono::steady_clock::duration value)
+    {
+        const auto milliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(value).count();
+        const auto bucket = std::upper_bound(sBounds.begin(), sBounds.end(), milliseconds);
+        ++mCounts[static_cast<std::size_t>(bucket - sBounds.begin())];
+    }
+
     void reportStats(const Stats& stats, unsigned int frameNumber, osg::Stats& out)
     {
         reportStats(stats.mUpdater, frameNumber, out);
@@ -1,6 +1,8 @@
 #ifndef OPENMW_COMPONENTS_DETOURNAVIGATOR_STATS_H
 #define OPENMW_COMPONENTS_DETOURNAVIGATOR_STATS_H
 
+#include <array>
+#include <chrono>
 #include <cstddef>
 #include <optional>
 
@@ -39,6 +41,16 @@ namespace DetourNavigator
         std::size_t mGetCount = 0;
     };
 
+    struct LatencyHistogram
+    {
+        /// Upper bounds of the buckets in milliseconds except the last one which is unlimited.
+        static constexpr std::array<int, 5> sBounds{ 4, 16, 64, 256, 1024 };
+
+        std::array<std::size_t, sBounds.size() + 1> mCounts{};
+
+        void add(std::chrono::steady_clock::duration value);
+    };
+
     struct AsyncNavMeshUpdaterStats
     {
         std::size_t mJobs = 0;
@@ -48,6 +60,10 @@ namespace DetourNavigator
         std::size_t mDbGetTileHits = 0;
         std::optional<DbWorkerStats> mDb;
         NavMeshTilesCacheStats mCache;
+        // From job creation to the first time a worker starts processing it
+        LatencyHistogram mQueueLatency;
+        // From job creation to the job removal after it's processed
+        LatencyHistogram mTotalLatency;
     };
 
     struct TileCachedRecastMeshManagerStats
@@ -56,6 +72,7 @@ namespace DetourNavigator
         std::size_t mObjects = 0;
         std::size_t mHeightfields = 0;
         std::size_t mWater = 0;
+        std::size_t mObjectsTrianglesCacheSize = 0;
     };
 
     struct Stats
@@ -55,6 +55,11 @@ namespace DetourNavigator
             const std::optional<std::unique_lock<Mutex>> mImpl;
         };
 
+        std::size_t getTrianglesSize(const std::vector<RecastMeshTriangle>& triangles)
+        {
+            return triangles.size() * sizeof(RecastMeshTriangle);
+        }
+
         TilesPositionsRange getIndexRange(const auto& index)
         {
             const auto bounds = index.bounds();
@@ -65,8 +70,10 @@ namespace DetourNavigator
         }
     }
 
-    TileCachedRecastMeshManager::TileCachedRecastMeshManager(const RecastSettings& settings)
+    TileCachedRecastMeshManager::TileCachedRecastMeshManager(
+        const RecastSettings& settings, std::size_t maxObjectsTrianglesCacheSize)
         : mSettings(settings)
+        , mMaxObjectsTrianglesCacheSize(maxObjectsTrianglesCacheSize)
         , mRange(infiniteRange)
     {
     }
@@ -112,6 +119,22 @@ namespace DetourNavigator
         if (changed)
             ++mRevision;
 
+        if (mObjectsTrianglesCacheSize != 0)
+        {
+            for (const auto& [id, data] : mObjects)
+            {
+                for (auto it = data->mTriangles.begin(); it != data->mTriangles.end();)
+                {
+                    if (isInTilesPositionsRange(range, it->first))
+                    {
+                        ++it;
+                        continue;
+                    }
+                    it = eraseObjectTriangles(*data, it);
+                }
+            }
+        }
+
         mRange = range;
     }
 
@@ -154,6 +177,8 @@ namespace DetourNavigator
         mWater.clear();
         mHeightfields.clear();
         mCache.clear();
+        mObjectsTrianglesCacheSize = 0;
+        mObjectsTrianglesUsage.clear();
     }
 
     bool TileCachedRecastMeshManager::addObject(ObjectId id, const CollisionShape& shape, const btTransform& transform,
@@ -177,6 +202,8 @@ namespace DetourNavigator
                               .mRevision = revision,
                               .mLastNavMeshReportedChange = {},
                               .mLastNavMeshReport = {},
+                              .mTrianglesRevision = ++mObjectsTrianglesRevision,
+                              .mTriangles = {},
                           }))
                       ->second.get();
             assert(range.mBegin != range.mEnd);
@@ -200,6 +227,7 @@ namespace DetourNavigator
                 return false;
             if (!it->second->mObject.update(transform, areaType))
                 return false;
+            resetObjectTriangles(*it->second);
             const std::size_t lastChangeRevision = it->second->mLastNavMeshReportedChange.has_value()
                 ? it->second->mLastNavMeshReportedChange->mRevision
                 : mRevision;
@@ -247,6 +275,7 @@ namespace DetourNavigator
                 return;
             range = it->second->mRange;
             mObjectIndex.remove(makeObjectIndexValue(range, it->second.get()));
+            resetObjectTriangles(*it->second);
             mObjects.erase(it);
             ++mRevision;
         }
@@ -446,6 +475,7 @@ namespace DetourNavigator
             .mObjects = mObjects.size(),
             .mHeightfields = mHeightfields.size(),
             .mWater = mWater.size(),
+            .mObjectsTrianglesCacheSize = mObjectsTrianglesCacheSize,
         };
     }
 
@@ -488,9 +518,20 @@ namespace DetourNavigator
 
     std::shared_ptr<RecastMesh> TileCachedRecastMeshManager::makeMesh(const TilePosition& tilePosition) const
     {
-        RecastMeshBuilder builder(makeRealTileBoundsWithBorder(mSettings, tilePosition));
-        using Object = std::tuple<osg::ref_ptr<const Resource::BulletShapeInstance>, ObjectTransform,
-            std::reference_wrapper<const btCollisionShape>, btTransform, AreaType>;
+        const TileBounds bounds = makeRealTileBoundsWithBorder(mSettings, tilePosition);
+        RecastMeshBuilder builder(bounds);
+        struct Object
+        {
+            osg::ref_ptr<const Resource::BulletShapeInstance> mInstance;
+            ObjectTransform mObjectTransform;
+            std::reference_wrapper<const btCollisionShape> mShape;
+            btTransform mTransform;
+            AreaType mAreaType;
+            const ObjectData* mData;
+            std::size_t mTrianglesRevision;
+            std::shared_ptr<const std::vector<RecastMeshTriangle>> mTriangles;
+        };
+        const bool useTrianglesCache = mMaxObjectsTrianglesCacheSize != 0;
         std::vector<Object> objects;
         Version version;
         bool hasInput = false;
@@ -511,9 +552,28 @@ namespace DetourNavigator
             objects.reserve(mObjects.size());
             for (auto it = mObjectIndex.qbegin(makeIndexQuery(tilePosition)); it != mObjectIndex.qend(); ++it)
             {
-                const auto& object = it->second->mObject;
-                objects.emplace_back(object.getInstance(), object.getObjectTransform(), object.getShape(),
-                    object.getTransform(), object.getAreaType());
+                const ObjectData& data = *it->second;
+                const auto& object = data.mObject;
+                std::shared_ptr<const std::vector<RecastMeshTriangle>> triangles;
+                if (useTrianglesCache)
+                {
+                    if (const auto cached = data.mTriangles.find(tilePosition); cached != data.mTriangles.end())
+                    {
+                        triangles = cached->second.mTriangles;
+                        mObjectsTrianglesUsage.splice(
+                            mObjectsTrianglesUsage.begin(), mObjectsTrianglesUsage, cached->second.mUsage);
+                    }
+                }
+                objects.push_back(Object{
+                    .mInstance = object.getInstance(),
+                    .mObjectTransform = object.getObjectTransform(),
+                    .mShape = object.getShape(),
+                    .mTransform = object.getTransform(),
+                    .mAreaType = object.getAreaType(),
+                    .mData = &data,
+                    .mTrianglesRevision = data.mTrianglesRevision,
+                    .mTriangles = std::move(triangles),
+                });
                 hasInput = true;
             }
             if (hasInput)
@@ -530,11 +590,71 @@ namespace DetourNavigator
         }
         if (!hasInput)
             return nullptr;
-        for (const auto& [instance, objectTransform, shape, transform, areaType] : objects)
-            builder.addObject(shape, transform, areaType, instance->getSource(), objectTransform);
+        if (!useTrianglesCache)
+        {
+            for (const Object& v : objects)
+                builder.addObject(v.mShape, v.mTransform, v.mAreaType, v.mInstance->getSource(), v.mObjectTransform);
+            return std::move(builder).create(version);
+        }
+        std::unordered_map<const ObjectData*, const Object*> newObjects;
+        for (Object& v : objects)
+        {
+            if (v.mTriangles == nullptr)
+            {
+                v.mTriangles = std::make_shared<const std::vector<RecastMeshTriangle>>(
+                    RecastMeshBuilder::makeTriangles(bounds, v.mShape, v.mTransform, v.mAreaType));
+                newObjects.emplace(v.mData, &v);
+            }
+            builder.addObject(*v.mTriangles, v.mAreaType, v.mInstance->getSource(), v.mObjectTransform);
+        }
+        if (!newObjects.empty())
+        {
+            const std::lock_guard lock(mMutex);
+            // Object might be removed or updated while triangles were made, so only objects which are still present
+            // in the index with the same triangles revision get them. Triangles revisions are unique within the
+            // manager so a new object allocated at the same address can't be confused with the removed one.
+            for (auto it = mObjectIndex.qbegin(makeIndexQuery(tilePosition)); it != mObjectIndex.qend(); ++it)
+            {
+                ObjectData& data = *it->second;
+                const auto object = newObjects.find(&data);
+                if (object == newObjects.end() || object->second->mTrianglesRevision != data.mTrianglesRevision)
+                    continue;
+                const std::size_t size = getTrianglesSize(*object->second->mTriangles);
+                if (size > mMaxObjectsTrianglesCacheSize || data.mTriangles.contains(tilePosition))
+                    continue;
+                while (mObjectsTrianglesCacheSize + size > mMaxObjectsTrianglesCacheSize)
+                {
+                    const ObjectTrianglesKey leastRecentlyUsed = mObjectsTrianglesUsage.back();
+                    ObjectData& evicted = *leastRecentlyUsed.mData;
+                    eraseObjectTriangles(evicted, evicted.mTriangles.find(leastRecentlyUsed.mTilePosition));
+                }
+                mObjectsTrianglesUsage.push_front(ObjectTrianglesKey{ .mData = &data, .mTilePosition = tilePosition });
+                data.mTriangles.emplace(tilePosition,
+                    CachedObjectTriangles{
+                        .mTriangles = object->second->mTriangles,
+                        .mUsage = mObjectsTrianglesUsage.begin(),
+                    });
+                mObjectsTrianglesCacheSize += size;
+            }
+        }
         return std::move(builder).create(version);
     }
 
+    void TileCachedRecastMeshManager::resetObjectTriangles(ObjectData& data)
+    {
+        for (auto it = data.mTriangles.begin(); it != data.mTriangles.end();)
+            it = eraseObjectTriangles(data, it);
+        data.mTrianglesRevision = ++mObjectsTrianglesRevision;
+    }
+
+    TileCachedRecastMeshManager::ObjectTriangles::iterator TileCachedRecastMeshManager::eraseObjectTriangles(
+        ObjectData& data, ObjectTriangles::iterator it) const
+    {
+        mObjectsTrianglesCacheSize -= getTrianglesSize(*it->second.mTriangles);
+        mObjectsTrianglesUsage.erase(it->second.mUsage);
+        return data.mTriangles.erase(it);
+    }
+
     void TileCachedRecastMeshManager::addChangedTiles(
         const std::optional<TilesPositionsRange>& range, ChangeType changeType)
     {
@@ -21,21 +21,27 @@
 
 #include <osg/Vec2i>
 
+#include <list>
 #include <map>
 #include <memory>
 #include <mutex>
 #include <optional>
 #include <unordered_map>
+#include <vector>
 
 namespace DetourNavigator
 {
     class RecastMesh;
+    struct RecastMeshTriangle;
     struct TileCachedRecastMeshManagerStats;
 
     class TileCachedRecastMeshManager
     {
     public:
-        explicit TileCachedRecastMeshManager(const RecastSettings& settings);
+        /// maxObjectsTrianglesCacheSize limits total size in bytes of object triangles kept per tile to avoid
+        /// processing shapes of unchanged objects on every tile rebuild. 0 disables the cache.
+        explicit TileCachedRecastMeshManager(
+            const RecastSettings& settings, std::size_t maxObjectsTrianglesCacheSize = 0);
 
         ScopedUpdateGuard makeUpdateGuard()
         {
@@ -88,6 +94,25 @@ namespace DetourNavigator
             Version mNavMeshVersion;
         };
 
+        struct ObjectData;
+
+        struct ObjectTrianglesKey
+        {
+            ObjectData* mData;
+            TilePosition mTilePosition;
+        };
+
+        // NOTE: object triangles are stored in front-most-recently-used order.
+        using ObjectsTrianglesUsage = std::list<ObjectTrianglesKey>;
+
+        struct CachedObjectTriangles
+        {
+            std::shared_ptr<const std::vector<RecastMeshTriangle>> mTriangles;
+            ObjectsTrianglesUsage::iterator mUsage;
+        };
+
+        using ObjectTriangles = std::map<TilePosition, CachedObjectTriangles>;
+
         struct ObjectData
         {
             RecastMeshObject mObject;
@@ -97,6 +122,8 @@ namespace DetourNavigator
             std::size_t mRevision = 0;
             std::optional<Report> mLastNavMeshReportedChange;
             std::optional<Report> mLastNavMeshReport;
+            std::size_t mTrianglesRevision = 0;
+            ObjectTriangles mTriangles;
         };
 
         struct WaterData
@@ -127,6 +154,7 @@ namespace DetourNavigator
         using HeightfieldIndexValue = std::pair<IndexBox, std::map<osg::Vec2i, HeightfieldData>::const_iterator>;
 
         const RecastSettings& mSettings;
+        const std::size_t mMaxObjectsTrianglesCacheSize;
         TilesPositionsRange mRange;
         ESM::RefId mWorldspace;
         std::unordered_map<ObjectId, std::unique_ptr<ObjectData>> mObjects;
@@ -141,6 +169,9 @@ namespace DetourNavigator
         std::map<TilePosition, CachedTile> mCache;
         std::size_t mGeneration = 0;
         std::size_t mRevision = 0;
+        std::size_t mObjectsTrianglesRevision = 0;
+        mutable std::size_t mObjectsTrianglesCacheSize = 0;
+        mutable ObjectsTrianglesUsage mObjectsTrianglesUsage;
         mutable std::mutex mMutex;
         UpdateGuard mUpdateGuard{ mMutex };
 
@@ -161,6 +192,10 @@ namespace DetourNavigator
 
         inline std::shared_ptr<RecastMesh> makeMesh(const TilePosition& tilePosition) const;
 
+        inline void resetObjectTriangles(ObjectData& data);
+
+        inline ObjectTriangles::iterator eraseObjectTriangles(ObjectData& data, ObjectTriangles::iterator it) const;
+
         inline void addChangedTiles(const std::optional<TilesPositionsRange>& range, ChangeType changeType);
     };
 }
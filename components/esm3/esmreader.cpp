@@ -372,6 +372,17 @@ namespace ESM
         mCtx.subCached = false;
     }
 
+    void ESMReader::seekRecord(std::size_t offset)
+    {
+        if (offset > mFileSize)
+            fail("Record offset is out of file bounds");
+        mEsm->seekg(static_cast<std::streamoff>(offset));
+        mCtx.leftFile = static_cast<std::streamsize>(mFileSize - offset);
+        mCtx.leftRec = 0;
+        mCtx.leftSub = 0;
+        mCtx.subCached = false;
+    }
+
     void ESMReader::getRecHeader(uint32_t& flags)
     {
         if (mCtx.leftFile < static_cast<std::streamsize>(3 * sizeof(uint32_t)))
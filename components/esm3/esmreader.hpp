@@ -297,6 +297,10 @@ namespace ESM
         // already been read
         void skipRecord();
 
+        // Continue reading from the record starting at the given file offset, e.g. when the preceding records
+        // were read by another reader
+        void seekRecord(std::size_t offset);
+
         /* Read record header. This updatesleftFile BEYOND the data that
            follows the header, ie beyond the entire record. You should use
            leftRec to orient yourself inside the record itself.
@@ -358,6 +362,8 @@ namespace ESM
         /// Sets font encoder for ESM strings
         void setEncoder(ToUTF8::Utf8Encoder* encoder) { mEncoder = encoder; }
 
+        ToUTF8::Utf8Encoder* getEncoder() const { return mEncoder; }
+
         /// Get record flags of last record
         uint32_t getRecordFlags() { return mRecordFlags; }
 
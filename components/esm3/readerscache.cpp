@@ -1,5 +1,7 @@
 #include "readerscache.hpp"
 
+#include <components/files/sharedfilestreambuf.hpp>
+
 #include <stdexcept>
 
 namespace ESM
@@ -22,80 +24,128 @@ namespace ESM
 
     ReadersCache::BusyItem ReadersCache::get(std::size_t index)
     {
-        const auto indexIt = mIndex.find(index);
-        std::list<Item>::iterator it;
-        if (indexIt == mIndex.end())
-        {
-            closeExtraReaders();
-            it = mBusyItems.emplace(mBusyItems.end());
-            mIndex.emplace(index, it);
-        }
-        else
+        std::unique_lock lock(mMutex);
+        while (true)
         {
-            switch (indexIt->second->mState)
+            const auto [begin, end] = mIndex.equal_range(index);
+            if (begin == end)
+            {
+                closeExtraReaders();
+                const auto it = mBusyItems.emplace(mBusyItems.end());
+                mIndex.emplace(index, it);
+                return BusyItem(*this, it);
+            }
+
+            std::optional<std::list<Item>::iterator> opened;
+            std::optional<std::list<Item>::iterator> free;
+            std::optional<std::list<Item>::iterator> closed;
+            bool ownedByThisThread = false;
+            for (auto indexIt = begin; indexIt != end; ++indexIt)
+            {
+                switch (indexIt->second->mState)
+                {
+                    case State::Busy:
+                        if (indexIt->second->mName.has_value())
+                            opened = indexIt->second;
+                        if (indexIt->second->mOwner == std::this_thread::get_id())
+                            ownedByThisThread = true;
+                        break;
+                    case State::Free:
+                        free = indexIt->second;
+                        break;
+                    case State::Closed:
+                        closed = indexIt->second;
+                        break;
+                }
+            }
+
+            std::list<Item>::iterator it;
+            if (free.has_value())
             {
-                case State::Busy:
-                    throw std::logic_error("ESMReader at index " + std::to_string(index) + " is busy");
-                case State::Free:
-                    it = indexIt->second;
-                    mBusyItems.splice(mBusyItems.end(), mFreeItems, it);
-                    break;
-                case State::Closed:
-                    closeExtraReaders();
-                    it = indexIt->second;
-                    if (it->mName.has_value())
-                    {
-                        it->mReader.open(*it->mName);
-                        it->mName.reset();
-                        it->mFileSize.reset();
-                    }
-                    mBusyItems.splice(mBusyItems.end(), mClosedItems, it);
-                    break;
+                it = *free;
+                mBusyItems.splice(mBusyItems.end(), mFreeItems, it);
+            }
+            else if (closed.has_value())
+            {
+                closeExtraReaders();
+                it = *closed;
+                if (it->mName.has_value())
+                    it->mReader.open(*it->mName);
+                mBusyItems.splice(mBusyItems.end(), mClosedItems, it);
+            }
+            else if (opened.has_value())
+                it = addSharedReader(index, **opened);
+            else if (ownedByThisThread)
+                throw std::logic_error("ESMReader at index " + std::to_string(index) + " is busy");
+            else
+            {
+                // The file name is known only after the reader that opens the file is released
+                mReleased.wait(lock);
+                continue;
             }
             it->mState = State::Busy;
-        }
+            it->mOwner = std::this_thread::get_id();
 
-        return BusyItem(*this, it);
+            return BusyItem(*this, it);
+        }
     }
 
-    const std::filesystem::path& ReadersCache::getName(std::size_t index) const
+    std::list<ReadersCache::Item>::iterator ReadersCache::addSharedReader(std::size_t index, const Item& source)
     {
-        const auto indexIt = mIndex.find(index);
-        if (indexIt == mIndex.end())
-            throw std::logic_error("ESMReader at index " + std::to_string(index) + " has not been created yet");
-        switch (indexIt->second->mState)
+        std::weak_ptr<const Platform::File::ScopedHandle>& sharedFile = mSharedFiles[index];
+        std::shared_ptr<const Platform::File::ScopedHandle> file = sharedFile.lock();
+        if (file == nullptr)
+        {
+            file = std::make_shared<const Platform::File::ScopedHandle>(Platform::File::open(*source.mName));
+            sharedFile = file;
+        }
+        Files::IStreamPtr stream = Files::openSharedFileStream(std::move(file));
+
+        closeExtraReaders();
+        const auto it = mBusyItems.emplace(mBusyItems.end());
+        mIndex.emplace(index, it);
+        // The reader is positioned by ESMReader::restoreContext that also sets parent file indices
+        it->mReader.openRaw(std::move(stream), *source.mName);
+        it->mReader.setIndex(static_cast<int>(index));
+        if (source.mEncoder != nullptr)
         {
-            case State::Busy:
-            case State::Free:
-                return indexIt->second->mReader.getName();
-            case State::Closed:
-                if (indexIt->second->mName)
-                    return *indexIt->second->mName;
-                throw std::logic_error("ESMReader at index " + std::to_string(index) + " has forgotten its filename");
-            default:
-                throw std::logic_error("ESMReader at index " + std::to_string(index) + " in unknown state");
+            it->mEncoder = std::make_unique<ToUTF8::Utf8Encoder>(source.mEncoder->getStatelessEncoder());
+            it->mReader.setEncoder(it->mEncoder.get());
         }
+        return it;
+    }
+
+    std::filesystem::path ReadersCache::getName(std::size_t index) const
+    {
+        const std::lock_guard lock(mMutex);
+        const auto [begin, end] = mIndex.equal_range(index);
+        if (begin == end)
+            throw std::logic_error("ESMReader at index " + std::to_string(index) + " has not been created yet");
+        for (auto it = begin; it != end; ++it)
+            if (it->second->mName.has_value())
+                return *it->second->mName;
+        // Reader has not been released since it was opened
+        const Item& item = *begin->second;
+        if (item.mState == State::Closed)
+            throw std::logic_error("ESMReader at index " + std::to_string(index) + " has forgotten its filename");
+        return item.mReader.getName();
     }
 
     std::size_t ReadersCache::getFileSize(std::size_t index)
     {
-        const auto indexIt = mIndex.find(index);
-        if (indexIt == mIndex.end())
+        const std::lock_guard lock(mMutex);
+        const auto [begin, end] = mIndex.equal_range(index);
+        if (begin == end)
             return 0;
-        switch (indexIt->second->mState)
-        {
-            case State::Busy:
-            case State::Free:
-                if (!indexIt->second->mReader.getName().empty())
-                    return indexIt->second->mReader.getFileSize();
-                throw std::logic_error("ESMReader at index " + std::to_string(index) + " has not been opened yet");
-            case State::Closed:
-                if (indexIt->second->mFileSize)
-                    return *indexIt->second->mFileSize;
-                throw std::logic_error("ESMReader at index " + std::to_string(index) + " has forgotten its file size");
-            default:
-                throw std::logic_error("ESMReader at index " + std::to_string(index) + " in unknown state");
-        }
+        for (auto it = begin; it != end; ++it)
+            if (it->second->mFileSize.has_value())
+                return *it->second->mFileSize;
+        const Item& item = *begin->second;
+        if (item.mState == State::Closed)
+            throw std::logic_error("ESMReader at index " + std::to_string(index) + " has forgotten its file size");
+        if (item.mReader.getName().empty())
+            throw std::logic_error("ESMReader at index " + std::to_string(index) + " has not been opened yet");
+        return item.mReader.getFileSize();
     }
 
     void ReadersCache::closeExtraReaders()
@@ -104,11 +154,7 @@ namespace ESM
         {
             const auto it = mFreeItems.begin();
             if (it->mReader.isOpen())
-            {
-                it->mName = it->mReader.getName();
-                it->mFileSize = it->mReader.getFileSize();
                 it->mReader.close();
-            }
             mClosedItems.splice(mClosedItems.end(), mFreeItems, it);
             it->mState = State::Closed;
         }
@@ -116,24 +162,39 @@ namespace ESM
 
     void ReadersCache::releaseItem(std::list<Item>::iterator it) noexcept
     {
-        assert(it->mState == State::Busy);
-        if (it->mReader.isOpen())
-        {
-            mFreeItems.splice(mFreeItems.end(), mBusyItems, it);
-            it->mState = State::Free;
-        }
-        else
         {
-            mClosedItems.splice(mClosedItems.end(), mBusyItems, it);
-            it->mState = State::Closed;
+            const std::lock_guard lock(mMutex);
+            assert(it->mState == State::Busy);
+            ESMReader& reader = it->mReader;
+            if (reader.isOpen())
+            {
+                it->mName = reader.getName();
+                it->mFileSize = reader.getFileSize();
+                // Readers may be used by different threads so they can't share the encoder buffer
+                if (reader.getEncoder() != nullptr && reader.getEncoder() != it->mEncoder.get())
+                {
+                    it->mEncoder = std::make_unique<ToUTF8::Utf8Encoder>(reader.getEncoder()->getStatelessEncoder());
+                    reader.setEncoder(it->mEncoder.get());
+                }
+                mFreeItems.splice(mFreeItems.end(), mBusyItems, it);
+                it->mState = State::Free;
+            }
+            else
+            {
+                mClosedItems.splice(mClosedItems.end(), mBusyItems, it);
+                it->mState = State::Closed;
+            }
         }
+        mReleased.notify_all();
     }
 
     void ReadersCache::clear()
     {
+        const std::lock_guard lock(mMutex);
         mIndex.clear();
         mBusyItems.clear();
         mFreeItems.clear();
         mClosedItems.clear();
+        mSharedFiles.clear();
     }
 }
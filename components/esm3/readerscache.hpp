@@ -3,14 +3,26 @@
 
 #include "esmreader.hpp"
 
+#include <components/platform/file.hpp>
+#include <components/toutf8/toutf8.hpp>
+
+#include <condition_variable>
 #include <cstddef>
 #include <list>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <optional>
 #include <string>
+#include <thread>
 
 namespace ESM
 {
+    /// @brief Pool of ESMReaders for content files identified by index.
+    /// @par Can be used by multiple threads. When all readers for the content file are busy and it has been opened
+    /// before, another reader is created for the same file. Such readers share a file handle and use positional reads.
+    /// If the file has not been opened yet by the only reader busy in another thread, waits until it is released.
+    /// Each reader has its own copy of the encoder.
     class ReadersCache
     {
     private:
@@ -24,9 +36,12 @@ namespace ESM
         struct Item
         {
             State mState = State::Busy;
+            std::thread::id mOwner = std::this_thread::get_id();
             ESMReader mReader;
+            // Name and size of the file last opened by the reader when it was released
             std::optional<std::filesystem::path> mName;
             std::optional<std::size_t> mFileSize;
+            std::unique_ptr<ToUTF8::Utf8Encoder> mEncoder;
 
             Item() = default;
         };
@@ -56,7 +71,7 @@ namespace ESM
 
         BusyItem get(std::size_t index);
 
-        const std::filesystem::path& getName(std::size_t index) const;
+        std::filesystem::path getName(std::size_t index) const;
 
         std::size_t getFileSize(std::size_t index);
 
@@ -64,14 +79,19 @@ namespace ESM
 
     private:
         const std::size_t mCapacity;
-        std::map<std::size_t, std::list<Item>::iterator> mIndex;
+        mutable std::mutex mMutex;
+        std::condition_variable mReleased;
+        std::multimap<std::size_t, std::list<Item>::iterator> mIndex;
         std::list<Item> mBusyItems;
         std::list<Item> mFreeItems;
         std::list<Item> mClosedItems;
+        std::map<std::size_t, std::weak_ptr<const Platform::File::ScopedHandle>> mSharedFiles;
 
         inline void closeExtraReaders();
 
         inline void releaseItem(std::list<Item>::iterator it) noexcept;
+
+        inline std::list<Item>::iterator addSharedReader(std::size_t index, const Item& source);
     };
 }
 
@@ -0,0 +1,48 @@
+#include "cachefile.hpp"
+
+#include <fstream>
+
+namespace Files
+{
+    void writeString(std::ostream& stream, std::string_view value)
+    {
+        writeValue(stream, static_cast<std::uint32_t>(value.size()));
+        stream.write(value.data(), static_cast<std::streamsize>(value.size()));
+    }
+
+    void writeStrings(std::ostream& stream, const std::vector<std::string>& values)
+    {
+        writeValue(stream, static_cast<std::uint32_t>(values.size()));
+        for (const std::string& value : values)
+            writeString(stream, value);
+    }
+
+    std::string readString(std::istream& stream)
+    {
+        std::string value(readValue<std::uint32_t>(stream), '\0');
+        if (!stream.read(value.data(), static_cast<std::streamsize>(value.size())))
+            throw std::runtime_error("unexpected end of file");
+        return value;
+    }
+
+    std::vector<std::string> readStrings(std::istream& stream)
+    {
+        std::vector<std::string> values(readValue<std::uint32_t>(stream));
+        for (std::string& value : values)
+            value = readString(stream);
+        return values;
+    }
+
+    void writeCacheFile(const std::filesystem::path& path, const std::function<void(std::ostream&)>& write)
+    {
+        std::filesystem::create_directories(path.parent_path());
+        std::filesystem::path tmpPath = path;
+        tmpPath += ".tmp";
+        {
+            std::ofstream stream(tmpPath, std::ios::binary | std::ios::trunc);
+            stream.exceptions(std::ios::failbit | std::ios::badbit);
+            write(stream);
+        }
+        std::filesystem::rename(tmpPath, path);
+    }
+}
@@ -0,0 +1,70 @@
+#ifndef COMPONENTS_FILES_CACHEFILE_H
+#define COMPONENTS_FILES_CACHEFILE_H
+
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <istream>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace Files
+{
+    /// Helpers for binary cache files written and read by the same build on the same machine, so values are stored
+    /// in native byte order.
+
+    template <class T>
+    void writeValue(std::ostream& stream, T value)
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+        stream.write(reinterpret_cast<const char*>(&value), sizeof(value));
+    }
+
+    void writeString(std::ostream& stream, std::string_view value);
+
+    template <class T>
+    void writeValues(std::ostream& stream, const std::vector<T>& values)
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+        writeValue(stream, static_cast<std::uint32_t>(values.size()));
+        stream.write(
+            reinterpret_cast<const char*>(values.data()), static_cast<std::streamsize>(values.size() * sizeof(T)));
+    }
+
+    void writeStrings(std::ostream& stream, const std::vector<std::string>& values);
+
+    template <class T>
+    T readValue(std::istream& stream)
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+        T value{};
+        if (!stream.read(reinterpret_cast<char*>(&value), sizeof(value)))
+            throw std::runtime_error("unexpected end of file");
+        return value;
+    }
+
+    std::string readString(std::istream& stream);
+
+    template <class T>
+    std::vector<T> readValues(std::istream& stream)
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+        std::vector<T> values(readValue<std::uint32_t>(stream));
+        if (!stream.read(
+                reinterpret_cast<char*>(values.data()), static_cast<std::streamsize>(values.size() * sizeof(T))))
+            throw std::runtime_error("unexpected end of file");
+        return values;
+    }
+
+    std::vector<std::string> readStrings(std::istream& stream);
+
+    /// Writes the file through a temporary one replacing the old file only when the new one is complete. Creates
+    /// missing parent directories.
+    void writeCacheFile(const std::filesystem::path& path, const std::function<void(std::ostream&)>& write);
+}
+
+#endif
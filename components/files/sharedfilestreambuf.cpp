@@ -0,0 +1,87 @@
+#include "sharedfilestreambuf.hpp"
+
+#include "streamwithbuffer.hpp"
+
+#include <algorithm>
+
+namespace Files
+{
+    namespace File = Platform::File;
+
+    SharedFileStreamBuf::SharedFileStreamBuf(std::shared_ptr<const File::ScopedHandle> file)
+        : mFile(std::move(file))
+        , mSize(File::size(*mFile))
+    {
+        setg(nullptr, nullptr, nullptr);
+    }
+
+    std::streambuf::int_type SharedFileStreamBuf::underflow()
+    {
+        if (gptr() == egptr())
+        {
+            const std::size_t toRead = std::min(mSize - mPosition, sizeof(mBuffer));
+            const std::size_t got = File::readAt(*mFile, mPosition, mBuffer, toRead);
+            mPosition += got;
+            setg(mBuffer, mBuffer, mBuffer + got);
+        }
+        if (gptr() == egptr())
+            return traits_type::eof();
+
+        return traits_type::to_int_type(*gptr());
+    }
+
+    std::streambuf::pos_type SharedFileStreamBuf::seekoff(
+        off_type offset, std::ios_base::seekdir whence, std::ios_base::openmode mode)
+    {
+        if ((mode & std::ios_base::out) || !(mode & std::ios_base::in))
+            return traits_type::eof();
+
+        std::size_t newPos;
+        switch (whence)
+        {
+            case std::ios_base::beg:
+                newPos = offset;
+                break;
+            case std::ios_base::cur:
+                newPos = (mPosition - (egptr() - gptr())) + offset;
+                break;
+            case std::ios_base::end:
+                newPos = mSize + offset;
+                break;
+            default:
+                return traits_type::eof();
+        }
+
+        return seekpos(static_cast<pos_type>(newPos), mode);
+    }
+
+    std::streambuf::pos_type SharedFileStreamBuf::seekpos(pos_type pos, std::ios_base::openmode mode)
+    {
+        if ((mode & std::ios_base::out) || !(mode & std::ios_base::in))
+            return traits_type::eof();
+
+        const std::size_t newPos = static_cast<std::size_t>(pos);
+        if (newPos > mSize)
+            return traits_type::eof();
+
+        // Keep the buffered data when seeking inside of it
+        const std::size_t bufferStart = mPosition - static_cast<std::size_t>(egptr() - eback());
+        if (eback() != nullptr && newPos >= bufferStart && newPos < mPosition)
+        {
+            setg(eback(), eback() + (newPos - bufferStart), egptr());
+            return pos;
+        }
+
+        mPosition = newPos;
+
+        // Clear read pointers so underflow() gets called on the next read attempt.
+        setg(nullptr, nullptr, nullptr);
+        return pos;
+    }
+
+    IStreamPtr openSharedFileStream(std::shared_ptr<const File::ScopedHandle> file)
+    {
+        return std::make_unique<StreamWithBuffer<SharedFileStreamBuf>>(
+            std::make_unique<SharedFileStreamBuf>(std::move(file)));
+    }
+}
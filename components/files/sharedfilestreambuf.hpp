@@ -0,0 +1,37 @@
+#ifndef OPENMW_COMPONENTS_FILES_SHAREDFILESTREAMBUF_H
+#define OPENMW_COMPONENTS_FILES_SHAREDFILESTREAMBUF_H
+
+#include "istreamptr.hpp"
+
+#include <components/platform/file.hpp>
+
+#include <memory>
+#include <streambuf>
+
+namespace Files
+{
+    /// A file streambuf reading a file handle shared with other streams. Each stream keeps its own position and reads
+    /// through Platform::File::readAt so streams over the same handle can be used by different threads.
+    class SharedFileStreamBuf final : public std::streambuf
+    {
+    public:
+        explicit SharedFileStreamBuf(std::shared_ptr<const Platform::File::ScopedHandle> file);
+
+        int_type underflow() final;
+
+        pos_type seekoff(off_type offset, std::ios_base::seekdir whence, std::ios_base::openmode mode) final;
+
+        pos_type seekpos(pos_type pos, std::ios_base::openmode mode) final;
+
+    private:
+        std::shared_ptr<const Platform::File::ScopedHandle> mFile;
+        std::size_t mSize;
+        // File position of the end of the buffered data
+        std::size_t mPosition = 0;
+        char mBuffer[8192]{ 0 };
+    };
+
+    IStreamPtr openSharedFileStream(std::shared_ptr<const Platform::File::ScopedHandle> file);
+}
+
+#endif
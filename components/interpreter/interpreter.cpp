@@ -34,6 +34,65 @@ namespace Interpreter
             }
             return it->second;
         }
+
+        // Decodes instruction the same way as Interpreter::prepare to report an error
+        [[noreturn]] void abortInvalidCode(Type_Code code)
+        {
+            switch (code >> 30)
+            {
+                case 0:
+                    abortUnknownCode(0, code >> 24);
+                case 2:
+                    abortUnknownCode(2, (code >> 20) & 0x3ff);
+            }
+
+            switch (code >> 26)
+            {
+                case 0x30:
+                    abortUnknownCode(3, (code >> 8) & 0x3ffff);
+                case 0x32:
+                    abortUnknownCode(5, code & 0x3ffffff);
+            }
+
+            abortUnknownSegment(code);
+        }
+
+        struct ExecuteInstruction
+        {
+            Runtime& mRuntime;
+
+            void operator()(const PreparedOpcode0& instruction) const { instruction.mOpcode->execute(mRuntime); }
+
+            void operator()(const PreparedOpcode1& instruction) const
+            {
+                instruction.mOpcode->execute(mRuntime, instruction.mArg0);
+            }
+
+            void operator()(const InvalidInstruction& instruction) const { abortInvalidCode(instruction.mCode); }
+        };
+
+        PreparedInstruction makeInvalidInstruction(Type_Code code)
+        {
+            return InvalidInstruction{ .mCode = code };
+        }
+
+        PreparedInstruction makeInstruction(
+            const std::map<int, std::unique_ptr<Opcode0>>& segment, Type_Code code, int opcode)
+        {
+            const auto it = segment.find(opcode);
+            if (it == segment.end())
+                return makeInvalidInstruction(code);
+            return PreparedOpcode0{ .mOpcode = it->second.get() };
+        }
+
+        PreparedInstruction makeInstruction(
+            const std::map<int, std::unique_ptr<Opcode1>>& segment, Type_Code code, int opcode, unsigned int arg0)
+        {
+            const auto it = segment.find(opcode);
+            if (it == segment.end())
+                return makeInvalidInstruction(code);
+            return PreparedOpcode1{ .mOpcode = it->second.get(), .mArg0 = arg0 };
+        }
     }
 
     [[noreturn]] void Interpreter::abortDuplicateInstruction(std::string_view name, int code)
@@ -88,6 +147,33 @@ namespace Interpreter
         abortUnknownSegment(code);
     }
 
+    PreparedInstruction Interpreter::prepare(Type_Code code) const
+    {
+        unsigned int segSpec = code >> 30;
+
+        switch (segSpec)
+        {
+            case 0:
+                return makeInstruction(mSegment0, code, code >> 24, code & 0xffffff);
+
+            case 2:
+                return makeInstruction(mSegment2, code, (code >> 20) & 0x3ff, code & 0xfffff);
+        }
+
+        segSpec = code >> 26;
+
+        switch (segSpec)
+        {
+            case 0x30:
+                return makeInstruction(mSegment3, code, (code >> 8) & 0x3ffff, code & 0xff);
+
+            case 0x32:
+                return makeInstruction(mSegment5, code, code & 0x3ffffff);
+        }
+
+        return makeInvalidInstruction(code);
+    }
+
     void Interpreter::begin()
     {
         if (mRunning)
@@ -138,4 +224,39 @@ namespace Interpreter
 
         end();
     }
+
+    std::vector<PreparedInstruction> Interpreter::prepare(const Program& program) const
+    {
+        std::vector<PreparedInstruction> result;
+        result.reserve(program.mInstructions.size());
+        for (const Type_Code code : program.mInstructions)
+            result.push_back(prepare(code));
+        return result;
+    }
+
+    void Interpreter::run(const Program& program, std::span<const PreparedInstruction> instructions, Context& context)
+    {
+        assert(instructions.size() == program.mInstructions.size());
+
+        begin();
+
+        try
+        {
+            mRuntime.configure(program, context);
+
+            while (mRuntime.getPC() >= 0 && static_cast<std::size_t>(mRuntime.getPC()) < instructions.size())
+            {
+                const PreparedInstruction& instruction = instructions[mRuntime.getPC()];
+                mRuntime.setPC(mRuntime.getPC() + 1);
+                std::visit(ExecuteInstruction{ mRuntime }, instruction);
+            }
+        }
+        catch (...)
+        {
+            end();
+            throw;
+        }
+
+        end();
+    }
 }
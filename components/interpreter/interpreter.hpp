@@ -3,8 +3,11 @@
 
 #include <map>
 #include <memory>
+#include <span>
 #include <stack>
 #include <utility>
+#include <variant>
+#include <vector>
 
 #include "opcodes.hpp"
 #include "runtime.hpp"
@@ -14,6 +17,26 @@ namespace Interpreter
 {
     struct Program;
 
+    struct PreparedOpcode0
+    {
+        Opcode0* mOpcode;
+    };
+
+    struct PreparedOpcode1
+    {
+        Opcode1* mOpcode;
+        unsigned int mArg0;
+    };
+
+    /// Instruction without installed opcode handler, fails only when executed.
+    struct InvalidInstruction
+    {
+        Type_Code mCode;
+    };
+
+    /// Instruction with opcode handler resolved by Interpreter::prepare.
+    using PreparedInstruction = std::variant<PreparedOpcode0, PreparedOpcode1, InvalidInstruction>;
+
     class Interpreter
     {
         std::stack<Runtime> mCallstack;
@@ -26,6 +49,8 @@ namespace Interpreter
 
         void execute(Type_Code code);
 
+        PreparedInstruction prepare(Type_Code code) const;
+
         void begin();
 
         void end();
@@ -71,6 +96,13 @@ namespace Interpreter
         }
 
         void run(const Program& program, Context& context);
+
+        /// Translates program instructions into instructions with resolved opcode handlers to avoid opcode lookup
+        /// on each execution. Prepared instructions are valid until the interpreter is destroyed.
+        std::vector<PreparedInstruction> prepare(const Program& program) const;
+
+        /// Same as run(program, context) but executes instructions prepared for the program by this interpreter.
+        void run(const Program& program, std::span<const PreparedInstruction> instructions, Context& context);
     };
 }
 
@@ -21,6 +21,34 @@
 
 namespace LuaUtil
 {
+    namespace
+    {
+        thread_local std::recursive_mutex* sCFunctionCallsMutex = nullptr;
+
+#ifndef NO_LUAJIT
+        int callGuardedCFunction(lua_State* state, lua_CFunction function)
+        {
+            if (sCFunctionCallsMutex == nullptr)
+                return function(state);
+            // LuaJIT raises errors by unwinding C++ frames, so the lock is released on errors as well. The mutex is
+            // recursive because C++ code may call Lua functions that call C functions again.
+            const std::lock_guard lock(*sCFunctionCallsMutex);
+            return function(state);
+        }
+#endif // NO_LUAJIT
+    }
+
+    CFunctionCallsGuard::CFunctionCallsGuard(std::recursive_mutex& mutex)
+        : mPrevious(sCFunctionCallsMutex)
+    {
+        sCFunctionCallsMutex = &mutex;
+    }
+
+    CFunctionCallsGuard::~CFunctionCallsGuard()
+    {
+        sCFunctionCallsMutex = mPrevious;
+    }
+
     static VFS::Path::Normalized packageNameToVfsPath(std::string_view packageName, const VFS::Manager& vfs)
     {
         std::string pathValue(packageName);
@@ -63,10 +91,25 @@ namespace LuaUtil
 
     bool LuaState::sProfilerEnabled = true;
 
+    bool LuaState::guardCFunctionCalls()
+    {
+#ifndef NO_LUAJIT
+        lua_State* state = mLuaState.get();
+        lua_pushlightuserdata(state, reinterpret_cast<void*>(&callGuardedCFunction));
+        luaJIT_setmode(state, -1, LUAJIT_MODE_WRAPCFUNC | LUAJIT_MODE_ON);
+        lua_pop(state, 1);
+        return true;
+#else
+        return false;
+#endif // NO_LUAJIT
+    }
+
     void LuaState::countHook(lua_State* state, lua_Debug* /*ar*/)
     {
         LuaState* self;
         (void)lua_getallocf(state, reinterpret_cast<void**>(&self));
+        if (self->mProfilerZone != nullptr)
+            self->mProfiler->sample(state, *self->mProfilerZone);
         if (self->mActiveScriptIdStack.empty())
             return;
         const ScriptId& activeScript = self->mActiveScriptIdStack.back();
@@ -120,6 +163,8 @@ namespace LuaUtil
             }
         }
         self->mTotalMemoryUsage += smallAllocDelta + bigAllocDelta;
+        if (nsize > osize)
+            self->mAllocatedMemory += nsize - osize;
         self->mSmallAllocMemoryUsage += smallAllocDelta;
 
         if (bigAllocDelta != 0)
@@ -3,6 +3,7 @@
 
 #include <filesystem>
 #include <map>
+#include <mutex>
 #include <typeinfo>
 
 #include <sol/sol.hpp>
@@ -11,6 +12,7 @@
 
 #include "configuration.hpp"
 #include "luastateptr.hpp"
+#include "profiler.hpp"
 
 namespace VFS
 {
@@ -177,8 +179,25 @@ namespace LuaUtil
             return id < mMemoryUsage.size() ? mMemoryUsage[id] : 0;
         }
 
+        // Total size of the memory allocated since the start, doesn't decrease when memory is freed. Is tracked only
+        // if Lua profiler is enabled.
+        uint64_t getAllocatedMemory() const { return mAllocatedMemory; }
+
         const LuaStateSettings& getSettings() const { return mSettings; }
 
+        // Handler profiler. Can be shared by several Lua states, call stacks are sampled only if Lua profiler is
+        // enabled.
+        void setProfiler(Profiler* profiler) { mProfiler = profiler; }
+        Profiler* getProfiler() const { return mProfiler; }
+
+        // The innermost handler that is measured by the profiler
+        const Profiler::Zone* getProfilerZone() const { return mProfilerZone; }
+        void setProfilerZone(const Profiler::Zone* zone) { mProfilerZone = zone; }
+
+        // Makes every call of a C function (i.e. of every binding) from this Lua state hold the mutex of
+        // CFunctionCallsGuard that is alive in the calling thread. Requires LuaJIT, returns false otherwise.
+        bool guardCFunctionCalls();
+
         // Note: Lua profiler can not be re-enabled after disabling.
         static void disableProfiler() { sProfilerEnabled = false; }
         static bool isProfilerEnabled() { return sProfilerEnabled; }
@@ -212,7 +231,10 @@ namespace LuaUtil
         std::map<void*, AllocOwner> mBigAllocOwners;
         uint64_t mTotalMemoryUsage = 0;
         uint64_t mSmallAllocMemoryUsage = 0;
+        uint64_t mAllocatedMemory = 0;
         std::vector<int64_t> mMemoryUsage;
+        Profiler* mProfiler = nullptr;
+        const Profiler::Zone* mProfilerZone = nullptr;
 
         // Must be declared before mSol and all sol-related objects. Then on exit it will be destructed the last.
         LuaStatePtr mLuaState;
@@ -228,6 +250,22 @@ namespace LuaUtil
         static bool sProfilerEnabled;
     };
 
+    // While alive, calls of C functions made by the current thread from Lua states with guarded C function calls hold
+    // the mutex. Allows Lua code of several states to run in parallel while C++ code is called by one of them at a
+    // time.
+    class CFunctionCallsGuard
+    {
+    public:
+        explicit CFunctionCallsGuard(std::recursive_mutex& mutex);
+        CFunctionCallsGuard(const CFunctionCallsGuard&) = delete;
+        ~CFunctionCallsGuard();
+
+        CFunctionCallsGuard& operator=(const CFunctionCallsGuard&) = delete;
+
+    private:
+        std::recursive_mutex* mPrevious;
+    };
+
     // LuaUtil::call should be used for every call of every Lua function.
     // 1) It is a workaround for a bug in `sol`. See https://github.com/ThePhD/sol2/issues/1078
     // 2) When called with ScriptId it tracks resource usage (scriptId refers to the script that is responsible for this
@@ -0,0 +1,274 @@
+#include "profiler.hpp"
+
+#include <algorithm>
+#include <iomanip>
+
+#include "luastate.hpp"
+
+namespace LuaUtil
+{
+    namespace
+    {
+        // Keeps the trace of a long capture readable by the trace viewers
+        constexpr std::size_t maxTraceEvents = 1 << 20;
+        constexpr int maxSampledFrames = 64;
+
+        double toMicroseconds(Profiler::Clock::duration value)
+        {
+            return std::chrono::duration<double, std::micro>(value).count();
+        }
+
+        double toMilliseconds(Profiler::Clock::duration value)
+        {
+            return std::chrono::duration<double, std::milli>(value).count();
+        }
+
+        void writeJsonString(std::ostream& stream, std::string_view value)
+        {
+            stream << '"';
+            for (const char c : value)
+            {
+                switch (c)
+                {
+                    case '"':
+                        stream << "\\\"";
+                        break;
+                    case '\\':
+                        stream << "\\\\";
+                        break;
+                    case '\n':
+                        stream << "\\n";
+                        break;
+                    case '\r':
+                        stream << "\\r";
+                        break;
+                    case '\t':
+                        stream << "\\t";
+                        break;
+                    default:
+                        if (static_cast<unsigned char>(c) < 0x20)
+                            stream << "\\u" << std::hex << std::setw(4) << std::setfill('0')
+                                   << static_cast<int>(c) << std::dec << std::setfill(' ');
+                        else
+                            stream << c;
+                }
+            }
+            stream << '"';
+        }
+
+        // Frames are separated by ';' and the sample count by the last space
+        void appendFrame(std::string& stack, std::string_view frame)
+        {
+            if (!stack.empty())
+                stack += ';';
+            for (const char c : frame)
+                stack += (c == ';' || c == '\n' || c == '\r') ? ':' : c;
+        }
+    }
+
+    Profiler::Zone::Zone(LuaState& lua, std::string_view script, std::string_view handler)
+    {
+        Profiler* profiler = lua.getProfiler();
+        if (profiler == nullptr || !profiler->isRunning())
+            return;
+        mLua = &lua;
+        mParent = lua.getProfilerZone();
+        mScript = script;
+        mHandler = handler;
+        mAllocatedAtStart = lua.getAllocatedMemory();
+        lua.setProfilerZone(this);
+        mStart = Clock::now();
+    }
+
+    Profiler::Zone::~Zone()
+    {
+        if (mLua == nullptr)
+            return;
+        const Clock::time_point end = Clock::now();
+        mLua->setProfilerZone(mParent);
+        mLua->getProfiler()->addCall(*this, end, mLua->getAllocatedMemory() - mAllocatedAtStart);
+    }
+
+    void Profiler::start()
+    {
+        std::lock_guard lock(mMutex);
+        mHandlers.clear();
+        mStacks.clear();
+        mTraceEvents.clear();
+        mDroppedTraceEvents = 0;
+        mThreads.clear();
+        mStartTime = Clock::now();
+        mStopTime = mStartTime;
+        mRunning = true;
+    }
+
+    void Profiler::stop()
+    {
+        std::lock_guard lock(mMutex);
+        if (!mRunning)
+            return;
+        mRunning = false;
+        mStopTime = Clock::now();
+    }
+
+    std::size_t Profiler::getThreadIndex()
+    {
+        return mThreads.emplace(std::this_thread::get_id(), mThreads.size()).first->second;
+    }
+
+    void Profiler::addCall(const Zone& zone, Clock::time_point end, std::uint64_t allocated)
+    {
+        const Clock::duration duration = end - zone.mStart;
+        HandlerId id(zone.mScript, zone.mHandler);
+        std::lock_guard lock(mMutex);
+        if (!mRunning)
+            return;
+        HandlerStats& stats = mHandlers[id];
+        ++stats.mCalls;
+        stats.mTime += duration;
+        stats.mAllocated += allocated;
+        if (mTraceEvents.size() >= maxTraceEvents)
+        {
+            ++mDroppedTraceEvents;
+            return;
+        }
+        mTraceEvents.push_back(TraceEvent{
+            .mScript = std::move(id.first),
+            .mHandler = std::move(id.second),
+            .mThread = getThreadIndex(),
+            .mStart = zone.mStart,
+            .mDuration = duration,
+            .mAllocated = allocated,
+        });
+    }
+
+    void Profiler::sample(lua_State* state, const Zone& zone)
+    {
+        if (!isRunning())
+            return;
+
+        // Samples are attributed to the outermost handler because the Lua stack contains the frames of all the
+        // nested ones
+        const Zone* root = &zone;
+        while (root->mParent != nullptr)
+            root = root->mParent;
+
+        std::string frames[maxSampledFrames];
+        int depth = 0;
+        lua_Debug ar;
+        for (int level = 0; depth < maxSampledFrames && lua_getstack(state, level, &ar) == 1; ++level)
+        {
+            if (lua_getinfo(state, "Sn", &ar) == 0)
+                continue;
+            std::string& frame = frames[depth++];
+            if (ar.what != nullptr && std::string_view(ar.what) == "C")
+            {
+                frame = "[C] ";
+                frame += ar.name != nullptr ? ar.name : "?";
+                continue;
+            }
+            frame = ar.name != nullptr ? ar.name : "?";
+            frame += " (";
+            frame += ar.short_src;
+            frame += ':';
+            frame += std::to_string(ar.linedefined);
+            frame += ')';
+        }
+
+        std::string stack;
+        appendFrame(stack, root->mScript);
+        appendFrame(stack, root->mHandler);
+        for (int i = depth - 1; i >= 0; --i)
+            appendFrame(stack, frames[i]);
+
+        std::lock_guard lock(mMutex);
+        if (!mRunning)
+            return;
+        ++mStacks[std::move(stack)];
+    }
+
+    std::map<Profiler::HandlerId, Profiler::HandlerStats> Profiler::getHandlerStats() const
+    {
+        std::lock_guard lock(mMutex);
+        return mHandlers;
+    }
+
+    std::map<std::string, std::uint64_t> Profiler::getSampledStacks() const
+    {
+        std::lock_guard lock(mMutex);
+        return mStacks;
+    }
+
+    Profiler::Clock::duration Profiler::getCaptureDuration() const
+    {
+        std::lock_guard lock(mMutex);
+        return (mRunning ? Clock::now() : mStopTime) - mStartTime;
+    }
+
+    void Profiler::writeChromeTrace(std::ostream& stream) const
+    {
+        std::lock_guard lock(mMutex);
+        stream << std::fixed << std::setprecision(3);
+        stream << "{\"traceEvents\":[";
+        bool first = true;
+        for (const auto& [thread, index] : mThreads)
+        {
+            stream << (first ? "\n" : ",\n");
+            first = false;
+            stream << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << index
+                   << ",\"args\":{\"name\":\"Lua " << index << "\"}}";
+        }
+        for (const TraceEvent& event : mTraceEvents)
+        {
+            stream << (first ? "\n" : ",\n");
+            first = false;
+            stream << "{\"name\":";
+            writeJsonString(stream, event.mHandler);
+            stream << ",\"cat\":";
+            writeJsonString(stream, event.mScript);
+            stream << ",\"ph\":\"X\",\"ts\":" << toMicroseconds(event.mStart - mStartTime)
+                   << ",\"dur\":" << toMicroseconds(event.mDuration) << ",\"pid\":1,\"tid\":" << event.mThread
+                   << ",\"args\":{\"allocated\":" << event.mAllocated << "}}";
+        }
+        stream << "\n],\"displayTimeUnit\":\"ms\",\"otherData\":{\"droppedEvents\":" << mDroppedTraceEvents
+               << "}}\n";
+        stream << std::defaultfloat;
+    }
+
+    void Profiler::writeCollapsedStacks(std::ostream& stream) const
+    {
+        std::lock_guard lock(mMutex);
+        for (const auto& [stack, count] : mStacks)
+            stream << stack << ' ' << count << '\n';
+    }
+
+    void Profiler::writeSummary(std::ostream& stream, std::size_t maxHandlers) const
+    {
+        std::vector<std::pair<HandlerId, HandlerStats>> handlers;
+        Clock::duration captureDuration;
+        {
+            std::lock_guard lock(mMutex);
+            handlers.assign(mHandlers.begin(), mHandlers.end());
+            captureDuration = (mRunning ? Clock::now() : mStopTime) - mStartTime;
+        }
+        std::sort(handlers.begin(), handlers.end(),
+            [](const auto& l, const auto& r) { return l.second.mTime > r.second.mTime; });
+        if (handlers.size() > maxHandlers)
+            handlers.resize(maxHandlers);
+
+        const double seconds = std::max(std::chrono::duration<double>(captureDuration).count(), 1e-6);
+        stream << std::fixed << std::setprecision(3);
+        stream << "Lua profiler capture of " << seconds << " s, slowest handlers (including nested handlers):\n";
+        stream << std::setw(12) << "total ms" << std::setw(10) << "calls" << std::setw(12) << "avg ms"
+               << std::setw(14) << "alloc KiB/s"
+               << "  script: handler\n";
+        for (const auto& [id, stats] : handlers)
+        {
+            const double total = toMilliseconds(stats.mTime);
+            stream << std::setw(12) << total << std::setw(10) << stats.mCalls << std::setw(12)
+                   << total / std::max<std::uint64_t>(stats.mCalls, 1) << std::setw(14)
+                   << stats.mAllocated / 1024.0 / seconds << "  " << id.first << ": " << id.second << '\n';
+        }
+        stream << std::defaultfloat;
+    }
+}
@@ -0,0 +1,109 @@
+#ifndef COMPONENTS_LUA_PROFILER_H
+#define COMPONENTS_LUA_PROFILER_H
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+struct lua_State;
+
+namespace LuaUtil
+{
+    class LuaState;
+
+    // Measures wall time, call count and allocated memory of every handler (engine handlers, event handlers and
+    // timers) of every script and samples Lua call stacks while a capture is running. Can be shared by several Lua
+    // states that are updated on different threads.
+    class Profiler
+    {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        struct HandlerStats
+        {
+            std::uint64_t mCalls = 0;
+            Clock::duration mTime{};
+            std::uint64_t mAllocated = 0; // bytes
+        };
+
+        // Script path and handler name
+        using HandlerId = std::pair<std::string, std::string>;
+
+        // Measures a handler from construction to destruction if the capture is running
+        class Zone
+        {
+        public:
+            Zone(LuaState& lua, std::string_view script, std::string_view handler);
+            ~Zone();
+
+            Zone(const Zone&) = delete;
+            Zone& operator=(const Zone&) = delete;
+
+        private:
+            friend class Profiler;
+
+            // Null if the zone is not measured
+            LuaState* mLua = nullptr;
+            const Zone* mParent = nullptr;
+            std::string_view mScript;
+            std::string_view mHandler;
+            Clock::time_point mStart;
+            std::uint64_t mAllocatedAtStart = 0;
+        };
+
+        // Drops data of the previous capture
+        void start();
+        void stop();
+        bool isRunning() const { return mRunning.load(std::memory_order_relaxed); }
+
+        // Called by LuaState every few thousands of Lua instructions executed inside of the zone
+        void sample(lua_State* state, const Zone& zone);
+
+        std::map<HandlerId, HandlerStats> getHandlerStats() const;
+        std::map<std::string, std::uint64_t> getSampledStacks() const;
+        Clock::duration getCaptureDuration() const;
+
+        // Writes handler calls as complete events of Chrome trace event format (chrome://tracing, Perfetto)
+        void writeChromeTrace(std::ostream& stream) const;
+        // Writes sampled stacks in collapsed format (flamegraph.pl, speedscope, inferno), one "frame;frame count" per
+        // line starting from the script and the handler
+        void writeCollapsedStacks(std::ostream& stream) const;
+        // Writes the handlers with the largest wall time
+        void writeSummary(std::ostream& stream, std::size_t maxHandlers) const;
+
+    private:
+        struct TraceEvent
+        {
+            std::string mScript;
+            std::string mHandler;
+            std::size_t mThread;
+            Clock::time_point mStart;
+            Clock::duration mDuration;
+            std::uint64_t mAllocated;
+        };
+
+        void addCall(const Zone& zone, Clock::time_point end, std::uint64_t allocated);
+        std::size_t getThreadIndex();
+
+        mutable std::mutex mMutex;
+        std::atomic_bool mRunning{ false };
+        Clock::time_point mStartTime;
+        Clock::time_point mStopTime;
+        std::map<HandlerId, HandlerStats> mHandlers;
+        std::map<std::string, std::uint64_t> mStacks;
+        std::vector<TraceEvent> mTraceEvents;
+        std::uint64_t mDroppedTraceEvents = 0;
+        std::map<std::thread::id, std::size_t> mThreads;
+    };
+}
+
+#endif // COMPONENTS_LUA_PROFILER_H
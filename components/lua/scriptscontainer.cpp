@@ -370,6 +370,7 @@ namespace LuaUtil
                 const Handler& h = list[i - 1];
                 try
                 {
+                    const Profiler::Zone zone(mLua, scriptPath(h.mScriptId), eventName);
                     sol::object res = LuaUtil::call({ this, h.mScriptId }, h.mFn, object);
                     if (res.is<bool>() && !res.as<bool>())
                         break; // Skip other handlers if 'false' was returned.
@@ -727,11 +728,13 @@ namespace LuaUtil
                 auto it = script.mRegisteredCallbacks.find(callbackName);
                 if (it == script.mRegisteredCallbacks.end())
                     throw std::logic_error("Callback '" + callbackName + "' doesn't exist");
+                const Profiler::Zone zone(mLua, scriptPath(t.mScriptId), callbackName);
                 LuaUtil::call({ this, t.mScriptId }, it->second, t.mArg);
             }
             else
             {
                 int64_t id = std::get<int64_t>(t.mCallback);
+                const Profiler::Zone zone(mLua, scriptPath(t.mScriptId), "timer");
                 LuaUtil::call({ this, t.mScriptId }, script.mTemporaryCallbacks.at(id));
                 script.mTemporaryCallbacks.erase(id);
             }
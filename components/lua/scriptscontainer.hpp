@@ -83,6 +83,8 @@ namespace LuaUtil
         ScriptsContainer(ScriptsContainer&&) = delete;
         virtual ~ScriptsContainer();
 
+        LuaState& getLuaState() const { return mLua; }
+
         // `conf` specifies the list of scripts that should be autostarted in this container; the script
         // names themselves are stored in ScriptsConfiguration.
         void setAutoStartConf(ScriptIdsWithInitializationData conf) { mAutoStartScripts = std::move(conf); }
@@ -215,6 +217,7 @@ namespace LuaUtil
             {
                 try
                 {
+                    const Profiler::Zone zone(mLua, scriptPath(handler.mScriptId), handlers.mName);
                     LuaUtil::call({ this, handler.mScriptId }, handler.mFn, args...);
                 }
                 catch (std::exception& e)
@@ -195,44 +195,68 @@ namespace LuaUtil
             throw std::runtime_error("Value is not serializable.");
     }
 
+    static int getAbsoluteIndex(lua_State* lua, int index)
+    {
+        return index > 0 ? index : lua_gettop(lua) + index + 1;
+    }
+
+    // Values are read directly from the Lua stack. Creating a sol::object for every key and value of a table would
+    // add and remove a registry reference for each of them.
     static void serialize(
-        BinaryData& out, const sol::object& obj, const UserdataSerializer* customSerializer, int recursionCounter)
+        BinaryData& out, lua_State* lua, int index, const UserdataSerializer* customSerializer, int recursionCounter)
     {
-        if (obj.get_type() == sol::type::lightuserdata)
+        const int type = lua_type(lua, index);
+        if (type == LUA_TLIGHTUSERDATA)
             throw std::runtime_error("Light userdata is not allowed to be serialized.");
-        if (obj.is<sol::function>())
+        if (type == LUA_TFUNCTION)
             throw std::runtime_error("Functions are not allowed to be serialized.");
-        else if (obj.is<sol::userdata>())
-            serializeUserdata(out, obj, customSerializer);
-        else if (obj.is<sol::lua_table>())
-        {
-            if (recursionCounter >= 32)
-                throw std::runtime_error(
-                    "Can not serialize more than 32 nested tables. Likely the table contains itself.");
-            sol::table table = obj;
-            appendType(out, SerializedType::TABLE_START);
-            for (auto& [key, value] : table)
-            {
-                serialize(out, key, customSerializer, recursionCounter + 1);
-                serialize(out, value, customSerializer, recursionCounter + 1);
-            }
-            appendType(out, SerializedType::TABLE_END);
-        }
-        else if (obj.is<double>())
+        if ((type == LUA_TTABLE || type == LUA_TUSERDATA) && luaL_getmetafield(lua, index, "__call") != 0)
         {
-            appendType(out, SerializedType::NUMBER);
-            appendValue<double>(out, obj.as<double>());
+            lua_pop(lua, 1);
+            throw std::runtime_error("Functions are not allowed to be serialized.");
         }
-        else if (obj.is<std::string_view>())
-            appendString(out, obj.as<std::string_view>());
-        else if (obj.is<bool>())
+        switch (type)
         {
-            char v = obj.as<bool>() ? 1 : 0;
-            appendType(out, SerializedType::BOOLEAN);
-            out.push_back(v);
+            case LUA_TUSERDATA:
+                serializeUserdata(out, sol::userdata(lua, index), customSerializer);
+                return;
+            case LUA_TTABLE:
+            {
+                if (recursionCounter >= 32)
+                    throw std::runtime_error(
+                        "Can not serialize more than 32 nested tables. Likely the table contains itself.");
+                // Key and value of the current entry and the metatable field checked for them
+                if (lua_checkstack(lua, 4) == 0)
+                    throw std::runtime_error("Not enough Lua stack space to serialize a table.");
+                const int table = getAbsoluteIndex(lua, index);
+                appendType(out, SerializedType::TABLE_START);
+                lua_pushnil(lua);
+                while (lua_next(lua, table) != 0)
+                {
+                    serialize(out, lua, -2, customSerializer, recursionCounter + 1);
+                    serialize(out, lua, -1, customSerializer, recursionCounter + 1);
+                    lua_pop(lua, 1);
+                }
+                appendType(out, SerializedType::TABLE_END);
+                return;
+            }
+            case LUA_TNUMBER:
+                appendType(out, SerializedType::NUMBER);
+                appendValue<double>(out, lua_tonumber(lua, index));
+                return;
+            case LUA_TSTRING:
+            {
+                std::size_t size = 0;
+                const char* data = lua_tolstring(lua, index, &size);
+                appendString(out, std::string_view(data, size));
+                return;
+            }
+            case LUA_TBOOLEAN:
+                appendType(out, SerializedType::BOOLEAN);
+                out.push_back(lua_toboolean(lua, index) ? 1 : 0);
+                return;
         }
-        else
-            throw std::runtime_error("Unknown Lua type.");
+        throw std::runtime_error("Unknown Lua type.");
     }
 
     static void deserializeImpl(
@@ -356,13 +380,34 @@ namespace LuaUtil
         throw std::runtime_error("Unknown type in serialized data: " + std::to_string(type));
     }
 
-    BinaryData serialize(const sol::object& obj, const UserdataSerializer* customSerializer)
+    void serialize(BinaryData& out, const sol::object& obj, const UserdataSerializer* customSerializer)
     {
+        out.clear();
         if (obj == sol::nil)
-            return "";
+            return;
+        out.push_back(FORMAT_VERSION);
+        lua_State* lua = obj.lua_state();
+        const int top = lua_gettop(lua);
+        if (lua_checkstack(lua, 3) == 0)
+            throw std::runtime_error("Not enough Lua stack space to serialize a value.");
+        try
+        {
+            obj.push(lua);
+            serialize(out, lua, -1, customSerializer, 0);
+        }
+        catch (...)
+        {
+            lua_settop(lua, top);
+            out.clear();
+            throw;
+        }
+        lua_settop(lua, top);
+    }
+
+    BinaryData serialize(const sol::object& obj, const UserdataSerializer* customSerializer)
+    {
         BinaryData res;
-        res.push_back(FORMAT_VERSION);
-        serialize(res, obj, customSerializer, 0);
+        serialize(res, obj, customSerializer);
         return res;
     }
 
@@ -51,6 +51,8 @@ namespace LuaUtil
     };
 
     BinaryData serialize(const sol::object&, const UserdataSerializer* customSerializer = nullptr);
+    // Replaces the content of `out`. Allows to reuse the allocated buffer.
+    void serialize(BinaryData& out, const sol::object&, const UserdataSerializer* customSerializer = nullptr);
     sol::object deserialize(lua_State* lua, std::string_view binaryData,
         const UserdataSerializer* customSerializer = nullptr, bool readOnly = false);
 
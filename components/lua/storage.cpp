@@ -36,8 +36,12 @@ namespace LuaUtil
 
     sol::object LuaStorage::Value::getReadOnly(lua_State* state) const
     {
-        if (mReadOnlyValue == sol::nil && !mSerializedValue.empty())
+        if (mSerializedValue.empty())
+            return sol::nil;
+        if (mReadOnlyValue == sol::nil)
             mReadOnlyValue = sol::main_object(deserialize(state, mSerializedValue, nullptr, true));
+        else if (mReadOnlyValue.lua_state() != sol::main_thread(state, state))
+            return deserialize(state, mSerializedValue, nullptr, true); // Cached in another Lua state
         return mReadOnlyValue;
     }
 
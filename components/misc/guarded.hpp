@@ -4,15 +4,16 @@
 #include <condition_variable>
 #include <memory>
 #include <mutex>
+#include <shared_mutex>
 #include <type_traits>
 
 namespace Misc
 {
-    template <class T>
+    template <class T, class Lock = std::unique_lock<std::mutex>>
     class Locked
     {
     public:
-        Locked(std::mutex& mutex, std::remove_reference_t<T>& value)
+        Locked(typename Lock::mutex_type& mutex, std::remove_reference_t<T>& value)
             : mLock(mutex)
             , mValue(value)
         {
@@ -25,11 +26,13 @@ namespace Misc
         std::remove_reference_t<T>& operator*() const { return get(); }
 
     private:
-        std::unique_lock<std::mutex> mLock;
+        Lock mLock;
         std::reference_wrapper<std::remove_reference_t<T>> mValue;
     };
 
-    template <class T>
+    /// @brief Value accessible only under the lock. With std::shared_mutex multiple readers may access the value at the
+    /// same time using lockShared.
+    template <class T, class Mutex = std::mutex>
     class ScopeGuarded
     {
     public:
@@ -70,9 +73,17 @@ namespace Misc
         {
         }
 
-        Locked<T> lock() { return Locked<T>(mMutex, mValue); }
+        Locked<T, std::unique_lock<Mutex>> lock() { return Locked<T, std::unique_lock<Mutex>>(mMutex, mValue); }
 
-        Locked<const T> lockConst() const { return Locked<const T>(mMutex, mValue); }
+        Locked<const T, std::unique_lock<Mutex>> lockConst() const
+        {
+            return Locked<const T, std::unique_lock<Mutex>>(mMutex, mValue);
+        }
+
+        Locked<const T, std::shared_lock<Mutex>> lockShared() const
+        {
+            return Locked<const T, std::shared_lock<Mutex>>(mMutex, mValue);
+        }
 
         template <class Predicate>
         void wait(std::condition_variable& cv, Predicate&& predicate)
@@ -82,7 +93,7 @@ namespace Misc
         }
 
     private:
-        mutable std::mutex mMutex;
+        mutable Mutex mMutex;
         T mValue;
     };
 }
@@ -0,0 +1,235 @@
+#include "jobsystem.hpp"
+
+#include <components/debug/debuglog.hpp>
+
+#include <algorithm>
+#include <utility>
+
+namespace Misc
+{
+    namespace
+    {
+        thread_local const JobSystem* sCurrentJobSystem = nullptr;
+        thread_local std::size_t sCurrentQueue = 0;
+
+        std::exception_ptr takeException(std::mutex& mutex, std::exception_ptr& exception)
+        {
+            const std::lock_guard lock(mutex);
+            return std::exchange(exception, nullptr);
+        }
+    }
+
+    JobSystem::JobSystem(std::size_t threads)
+        : mThreadCount(threads)
+    {
+        mQueues.reserve(threads + 1);
+        for (std::size_t i = 0; i < threads + 1; ++i)
+            mQueues.push_back(std::make_unique<Queue>());
+        mThreads.reserve(threads);
+        for (std::size_t i = 0; i < threads; ++i)
+            mThreads.emplace_back([this, i] { work(i); });
+    }
+
+    JobSystem::~JobSystem()
+    {
+        {
+            const std::lock_guard lock(mSleepMutex);
+            mStopping = true;
+        }
+        mWakeUp.notify_all();
+        for (std::thread& thread : mThreads)
+            thread.join();
+    }
+
+    void JobSystem::post(std::function<void()>&& job)
+    {
+        Job value{ .mFunction = std::move(job), .mGroup = nullptr };
+        if (mThreadCount == 0)
+            execute(value);
+        else
+            push(std::move(value));
+    }
+
+    void JobSystem::run(JobGroup& group, std::function<void()>&& job)
+    {
+        group.mPending.fetch_add(1, std::memory_order_relaxed);
+        Job value{ .mFunction = std::move(job), .mGroup = &group };
+        if (mThreadCount == 0)
+            execute(value);
+        else
+            push(std::move(value));
+    }
+
+    void JobSystem::wait(JobGroup& group)
+    {
+        const std::size_t queue = getCurrentQueue();
+        while (!group.isDone())
+        {
+            if (std::optional<Job> job = pop(queue))
+            {
+                execute(*job);
+                continue;
+            }
+            std::unique_lock lock(mSleepMutex);
+            mWakeUp.wait(
+                lock, [&] { return group.isDone() || mQueued.load(std::memory_order_acquire) > 0; });
+        }
+        if (std::exception_ptr exception = takeException(group.mMutex, group.mException))
+            std::rethrow_exception(exception);
+    }
+
+    void JobSystem::parallelFor(std::size_t count, const std::function<void(std::size_t)>& function)
+    {
+        if (count == 0)
+            return;
+        if (count == 1 || mThreadCount == 0)
+        {
+            for (std::size_t i = 0; i < count; ++i)
+                function(i);
+            return;
+        }
+
+        std::atomic<std::size_t> next{ 0 };
+        const auto process = [&] {
+            for (std::size_t i = next.fetch_add(1, std::memory_order_relaxed); i < count;
+                 i = next.fetch_add(1, std::memory_order_relaxed))
+                function(i);
+        };
+
+        JobGroup group;
+        const std::size_t helpers = std::min(count - 1, mThreadCount);
+        for (std::size_t i = 0; i < helpers; ++i)
+            run(group, process);
+
+        try
+        {
+            process();
+        }
+        catch (...)
+        {
+            // Helpers use the local state so they have to finish before leaving
+            try
+            {
+                wait(group);
+            }
+            catch (...)
+            {
+            }
+            throw;
+        }
+        wait(group);
+    }
+
+    std::size_t JobSystem::getCurrentQueue() const
+    {
+        return sCurrentJobSystem == this ? sCurrentQueue : mThreadCount;
+    }
+
+    void JobSystem::push(Job&& job)
+    {
+        Queue& queue = *mQueues[getCurrentQueue()];
+        {
+            const std::lock_guard lock(queue.mMutex);
+            queue.mJobs.push_back(std::move(job));
+        }
+        mQueued.fetch_add(1, std::memory_order_release);
+        // Sleeping threads check the counter while holding the mutex so they can't miss the notification
+        {
+            const std::lock_guard lock(mSleepMutex);
+        }
+        mWakeUp.notify_one();
+    }
+
+    std::optional<JobSystem::Job> JobSystem::pop(std::size_t queue)
+    {
+        if (mQueued.load(std::memory_order_acquire) == 0)
+            return std::nullopt;
+        const auto take = [&](Queue& value, bool newest) -> std::optional<Job> {
+            const std::lock_guard lock(value.mMutex);
+            if (value.mJobs.empty())
+                return std::nullopt;
+            std::optional<Job> result;
+            if (newest)
+            {
+                result = std::move(value.mJobs.back());
+                value.mJobs.pop_back();
+            }
+            else
+            {
+                result = std::move(value.mJobs.front());
+                value.mJobs.pop_front();
+            }
+            mQueued.fetch_sub(1, std::memory_order_relaxed);
+            return result;
+        };
+        // Own recently added jobs are likely to use the data still in cache
+        if (queue < mThreadCount)
+            if (std::optional<Job> job = take(*mQueues[queue], true))
+                return job;
+        for (std::size_t i = 1; i <= mQueues.size(); ++i)
+        {
+            const std::size_t other = (queue + i) % mQueues.size();
+            if (other == queue && queue < mThreadCount)
+                continue;
+            if (std::optional<Job> job = take(*mQueues[other], false))
+                return job;
+        }
+        return std::nullopt;
+    }
+
+    void JobSystem::execute(Job& job)
+    {
+        JobGroup* const group = job.mGroup;
+        try
+        {
+            job.mFunction();
+        }
+        catch (const std::exception& e)
+        {
+            if (group == nullptr)
+                Log(Debug::Error) << "Job failed: " << e.what();
+            else
+            {
+                const std::lock_guard lock(group->mMutex);
+                if (group->mException == nullptr)
+                    group->mException = std::current_exception();
+            }
+        }
+        catch (...)
+        {
+            if (group == nullptr)
+                Log(Debug::Error) << "Job failed with unknown exception";
+            else
+            {
+                const std::lock_guard lock(group->mMutex);
+                if (group->mException == nullptr)
+                    group->mException = std::current_exception();
+            }
+        }
+        // Release captured state before the waiting thread may continue
+        job.mFunction = nullptr;
+        if (group != nullptr && group->mPending.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        {
+            const std::lock_guard lock(mSleepMutex);
+            mWakeUp.notify_all();
+        }
+    }
+
+    void JobSystem::work(std::size_t queue)
+    {
+        sCurrentJobSystem = this;
+        sCurrentQueue = queue;
+        while (true)
+        {
+            if (std::optional<Job> job = pop(queue))
+            {
+                execute(*job);
+                continue;
+            }
+            std::unique_lock lock(mSleepMutex);
+            mWakeUp.wait(lock, [&] { return mStopping || mQueued.load(std::memory_order_acquire) > 0; });
+            if (mStopping && mQueued.load(std::memory_order_acquire) == 0)
+                return;
+        }
+    }
+}
@@ -0,0 +1,104 @@
+#ifndef OPENMW_COMPONENTS_MISC_JOBSYSTEM_H
+#define OPENMW_COMPONENTS_MISC_JOBSYSTEM_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+namespace Misc
+{
+    /// @brief Set of jobs started with JobSystem::run to wait for.
+    class JobGroup
+    {
+    public:
+        JobGroup() = default;
+
+        JobGroup(const JobGroup&) = delete;
+
+        JobGroup& operator=(const JobGroup&) = delete;
+
+        bool isDone() const { return mPending.load(std::memory_order_acquire) == 0; }
+
+    private:
+        std::atomic<std::size_t> mPending{ 0 };
+        std::mutex mMutex;
+        std::exception_ptr mException;
+
+        friend class JobSystem;
+    };
+
+    /// @brief Fixed size thread pool with a job queue per worker thread.
+    /// @par Workers take the most recently added jobs from their own queue and steal the oldest jobs from other
+    /// queues when it's empty. Jobs added by other threads go into a shared queue. A thread waiting for a group
+    /// executes queued jobs meanwhile so jobs can start other jobs and wait for them. With zero threads jobs are
+    /// executed immediately.
+    /// @note All methods are thread safe.
+    class JobSystem
+    {
+    public:
+        explicit JobSystem(std::size_t threads);
+
+        /// Finishes all queued jobs and joins the worker threads.
+        ~JobSystem();
+
+        JobSystem(const JobSystem&) = delete;
+        JobSystem& operator=(const JobSystem&) = delete;
+
+        std::size_t getThreadCount() const { return mThreadCount; }
+
+        /// Add a job nobody waits for. Thrown exceptions are logged.
+        void post(std::function<void()>&& job);
+
+        /// Add a job to the group. The group must outlive the job.
+        void run(JobGroup& group, std::function<void()>&& job);
+
+        /// Return when all jobs of the group are finished, rethrowing the first exception thrown by them.
+        void wait(JobGroup& group);
+
+        /// Call function for each index in [0, count) using both the worker threads and the calling thread and return
+        /// when all calls are finished. The first thrown exception is rethrown after all started calls are finished.
+        void parallelFor(std::size_t count, const std::function<void(std::size_t)>& function);
+
+    private:
+        struct Job
+        {
+            std::function<void()> mFunction;
+            JobGroup* mGroup;
+        };
+
+        struct Queue
+        {
+            std::mutex mMutex;
+            std::deque<Job> mJobs;
+        };
+
+        const std::size_t mThreadCount;
+        // Queue for each worker thread followed by the queue shared by all other threads
+        std::vector<std::unique_ptr<Queue>> mQueues;
+        std::atomic<std::size_t> mQueued{ 0 };
+        std::mutex mSleepMutex;
+        std::condition_variable mWakeUp;
+        bool mStopping = false;
+        std::vector<std::thread> mThreads;
+
+        std::size_t getCurrentQueue() const;
+
+        void push(Job&& job);
+
+        std::optional<Job> pop(std::size_t queue);
+
+        void execute(Job& job);
+
+        void work(std::size_t queue);
+    };
+}
+
+#endif
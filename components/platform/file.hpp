@@ -1,8 +1,10 @@
 #ifndef OPENMW_COMPONENTS_PLATFORM_FILE_HPP
 #define OPENMW_COMPONENTS_PLATFORM_FILE_HPP
 
+#include <cstdint>
 #include <cstdlib>
 #include <filesystem>
+#include <utility>
 
 namespace Platform::File
 {
@@ -30,6 +32,9 @@ namespace Platform::File
 
     size_t read(Handle handle, void* data, size_t size);
 
+    /// Reads from given position without using the file position so the same handle can be read by multiple threads.
+    size_t readAt(Handle handle, size_t position, void* data, size_t size);
+
     class ScopedHandle
     {
         Handle mHandle{ Handle::Invalid };
@@ -63,6 +68,54 @@ namespace Platform::File
 
         operator Handle() const { return mHandle; }
     };
+
+    struct MappedRegion
+    {
+        const char* mData = nullptr;
+        size_t mSize = 0;
+        intptr_t mNativeHandle = 0;
+    };
+
+    /// Maps the whole file into memory for reading. Returns an empty region if the file can't be mapped.
+    MappedRegion map(Handle handle);
+
+    void unmap(const MappedRegion& region);
+
+    class ScopedMapping
+    {
+        MappedRegion mRegion;
+
+    public:
+        ScopedMapping() noexcept = default;
+        ScopedMapping(const ScopedMapping& other) = delete;
+        explicit ScopedMapping(const MappedRegion& region) noexcept
+            : mRegion(region)
+        {
+        }
+        ScopedMapping(ScopedMapping&& other) noexcept
+            : mRegion(std::exchange(other.mRegion, MappedRegion{}))
+        {
+        }
+        ScopedMapping& operator=(const ScopedMapping& other) = delete;
+        ScopedMapping& operator=(ScopedMapping&& other) noexcept
+        {
+            if (mRegion.mData != nullptr)
+                unmap(mRegion);
+            mRegion = std::exchange(other.mRegion, MappedRegion{});
+            return *this;
+        }
+        ~ScopedMapping()
+        {
+            if (mRegion.mData != nullptr)
+                unmap(mRegion);
+        }
+
+        const char* data() const { return mRegion.mData; }
+
+        size_t size() const { return mRegion.mSize; }
+
+        bool empty() const { return mRegion.mData == nullptr; }
+    };
 }
 
 #endif // OPENMW_COMPONENTS_PLATFORM_FILE_HPP
@@ -6,6 +6,8 @@
 #include <stdexcept>
 #include <string.h>
 #include <string>
+#include <sys/mman.h>
+#include <sys/stat.h>
 #include <sys/types.h>
 #include <unistd.h>
 
@@ -103,4 +105,38 @@ namespace Platform::File
         return amount;
     }
 
+    size_t readAt(Handle handle, size_t position, void* data, size_t size)
+    {
+        auto nativeHandle = getNativeHandle(handle);
+
+        const ssize_t amount = ::pread(nativeHandle, data, size, static_cast<off_t>(position));
+        if (amount == -1)
+        {
+            throw std::system_error(errno, std::generic_category(),
+                "An attempt to read " + std::to_string(size) + " bytes at " + std::to_string(position) + " failed");
+        }
+        return static_cast<size_t>(amount);
+    }
+
+    MappedRegion map(Handle handle)
+    {
+        const auto nativeHandle = getNativeHandle(handle);
+
+        struct stat status;
+        if (::fstat(nativeHandle, &status) == -1 || status.st_size <= 0)
+            return MappedRegion{};
+
+        const size_t size = static_cast<size_t>(status.st_size);
+        void* const data = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, nativeHandle, 0);
+        if (data == MAP_FAILED)
+            return MappedRegion{};
+
+        return MappedRegion{ .mData = static_cast<const char*>(data), .mSize = size };
+    }
+
+    void unmap(const MappedRegion& region)
+    {
+        ::munmap(const_cast<char*>(region.mData), region.mSize);
+    }
+
 }
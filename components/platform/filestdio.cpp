@@ -2,6 +2,7 @@
 
 #include <cassert>
 #include <errno.h>
+#include <mutex>
 #include <stdexcept>
 #include <string.h>
 #include <string>
@@ -93,4 +94,21 @@ namespace Platform::File
         return static_cast<size_t>(amount);
     }
 
+    size_t readAt(Handle handle, size_t position, void* data, size_t size)
+    {
+        // There is no positional read in stdio, serialize seek and read of all handles instead
+        static std::mutex mutex;
+        const std::lock_guard lock(mutex);
+        seek(handle, position);
+        return read(handle, data, size);
+    }
+
+    MappedRegion map(Handle /*handle*/)
+    {
+        // Memory mapping is not supported, callers fall back to reading
+        return MappedRegion{};
+    }
+
+    void unmap(const MappedRegion& /*region*/) {}
+
 }
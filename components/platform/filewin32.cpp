@@ -1,6 +1,7 @@
 #include "file.hpp"
 
 #include <cassert>
+#include <limits>
 #include <components/misc/windows.hpp>
 #include <stdexcept>
 #include <string>
@@ -99,4 +100,57 @@ namespace Platform::File
 
         return bytesRead;
     }
+
+    size_t readAt(Handle handle, size_t position, void* data, size_t size)
+    {
+        auto nativeHandle = getNativeHandle(handle);
+
+        // Synchronous read with an offset doesn't depend on the file pointer of the handle
+        OVERLAPPED overlapped{};
+        overlapped.Offset = static_cast<DWORD>(position);
+        overlapped.OffsetHigh = static_cast<DWORD>(static_cast<std::uint64_t>(position) >> 32);
+
+        DWORD bytesRead{};
+
+        if (!ReadFile(nativeHandle, data, static_cast<DWORD>(size), &bytesRead, &overlapped))
+        {
+            if (const DWORD errCode = GetLastError(); errCode != ERROR_HANDLE_EOF)
+                throw std::runtime_error(std::string("A read operation on a file failed: ") + std::to_string(errCode));
+        }
+
+        return bytesRead;
+    }
+
+    MappedRegion map(Handle handle)
+    {
+        auto nativeHandle = getNativeHandle(handle);
+
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(nativeHandle, &size) || size.QuadPart <= 0
+            || static_cast<unsigned long long>(size.QuadPart) > std::numeric_limits<size_t>::max())
+            return MappedRegion{};
+
+        HANDLE mapping = CreateFileMappingW(nativeHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mapping == nullptr)
+            return MappedRegion{};
+
+        const void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        if (data == nullptr)
+        {
+            CloseHandle(mapping);
+            return MappedRegion{};
+        }
+
+        return MappedRegion{
+            .mData = static_cast<const char*>(data),
+            .mSize = static_cast<size_t>(size.QuadPart),
+            .mNativeHandle = reinterpret_cast<intptr_t>(mapping),
+        };
+    }
+
+    void unmap(const MappedRegion& region)
+    {
+        UnmapViewOfFile(region.mData);
+        CloseHandle(reinterpret_cast<HANDLE>(region.mNativeHandle));
+    }
 }
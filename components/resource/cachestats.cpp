@@ -24,6 +24,9 @@ namespace Resource
             "Get",
             "Hit",
             "Expired",
+            "Contended",
+            "Evicted",
+            "Memory",
         };
 
         for (std::string_view suffix : suffixes)
@@ -36,5 +39,8 @@ namespace Resource
         dst.setAttribute(frameNumber, makeAttribute(prefix, "Get"), static_cast<double>(src.mGet));
         dst.setAttribute(frameNumber, makeAttribute(prefix, "Hit"), static_cast<double>(src.mHit));
         dst.setAttribute(frameNumber, makeAttribute(prefix, "Expired"), static_cast<double>(src.mExpired));
+        dst.setAttribute(frameNumber, makeAttribute(prefix, "Contended"), static_cast<double>(src.mContended));
+        dst.setAttribute(frameNumber, makeAttribute(prefix, "Evicted"), static_cast<double>(src.mEvicted));
+        dst.setAttribute(frameNumber, makeAttribute(prefix, "Memory"), static_cast<double>(src.mMemoryUsage));
     }
 }
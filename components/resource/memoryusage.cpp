@@ -0,0 +1,138 @@
+#include "memoryusage.hpp"
+
+#include "bulletshape.hpp"
+
+#include <osg/Geometry>
+#include <osg/Image>
+#include <osg/Node>
+#include <osg/NodeVisitor>
+#include <osg/Texture>
+
+#include <BulletCollision/CollisionShapes/btBvhTriangleMeshShape.h>
+#include <BulletCollision/CollisionShapes/btCompoundShape.h>
+#include <BulletCollision/CollisionShapes/btOptimizedBvh.h>
+#include <BulletCollision/CollisionShapes/btScaledBvhTriangleMeshShape.h>
+#include <BulletCollision/CollisionShapes/btStridingMeshInterface.h>
+
+#include <unordered_set>
+
+namespace Resource
+{
+    namespace
+    {
+        class GeometryMemoryUsageVisitor : public osg::NodeVisitor
+        {
+        public:
+            GeometryMemoryUsageVisitor()
+                : osg::NodeVisitor(TRAVERSE_ALL_CHILDREN)
+            {
+            }
+
+            void apply(osg::Geometry& geometry) override
+            {
+                osg::Geometry::ArrayList arrays;
+                geometry.getArrayList(arrays);
+                for (const osg::ref_ptr<osg::Array>& array : arrays)
+                    if (array != nullptr && mVisited.insert(array.get()).second)
+                        mResult += array->getTotalDataSize();
+
+                osg::Geometry::DrawElementsList drawElements;
+                geometry.getDrawElementsList(drawElements);
+                for (const osg::DrawElements* elements : drawElements)
+                    if (elements != nullptr && mVisited.insert(elements).second)
+                        mResult += elements->getTotalDataSize();
+            }
+
+            std::size_t getResult() const { return mResult; }
+
+        private:
+            std::unordered_set<const osg::BufferData*> mVisited;
+            std::size_t mResult = 0;
+        };
+
+        std::size_t getMeshMemoryUsage(const btStridingMeshInterface& mesh)
+        {
+            std::size_t result = 0;
+            for (int i = 0, n = mesh.getNumSubParts(); i < n; ++i)
+            {
+                const unsigned char* vertices = nullptr;
+                int numVertices = 0;
+                PHY_ScalarType vertexType = PHY_FLOAT;
+                int vertexStride = 0;
+                const unsigned char* indices = nullptr;
+                int indexStride = 0;
+                int numFaces = 0;
+                PHY_ScalarType indexType = PHY_INTEGER;
+                mesh.getLockedReadOnlyVertexIndexBase(
+                    &vertices, numVertices, vertexType, vertexStride, &indices, indexStride, numFaces, indexType, i);
+                result += static_cast<std::size_t>(numVertices) * static_cast<std::size_t>(vertexStride);
+                result += static_cast<std::size_t>(numFaces) * static_cast<std::size_t>(indexStride);
+                mesh.unLockReadOnlyVertexBase(i);
+            }
+            return result;
+        }
+
+        std::size_t getShapeMemoryUsage(const btCollisionShape* shape)
+        {
+            if (shape == nullptr)
+                return 0;
+
+            if (shape->isCompound())
+            {
+                const btCompoundShape& compound = static_cast<const btCompoundShape&>(*shape);
+                std::size_t result = 0;
+                for (int i = 0, n = compound.getNumChildShapes(); i < n; ++i)
+                    result += getShapeMemoryUsage(compound.getChildShape(i));
+                return result;
+            }
+
+            if (shape->getShapeType() == SCALED_TRIANGLE_MESH_SHAPE_PROXYTYPE)
+                return getShapeMemoryUsage(static_cast<const btScaledBvhTriangleMeshShape&>(*shape).getChildShape());
+
+            if (shape->getShapeType() == TRIANGLE_MESH_SHAPE_PROXYTYPE)
+            {
+                btBvhTriangleMeshShape& mesh
+                    = const_cast<btBvhTriangleMeshShape&>(static_cast<const btBvhTriangleMeshShape&>(*shape));
+                std::size_t result = getMeshMemoryUsage(*mesh.getMeshInterface());
+                if (const btOptimizedBvh* bvh = mesh.getOptimizedBvh())
+                    result += bvh->calculateSerializeBufferSize();
+                return result;
+            }
+
+            return 0;
+        }
+    }
+
+    std::size_t estimateMemoryUsage(const osg::Object& object)
+    {
+        if (const osg::Image* image = dynamic_cast<const osg::Image*>(&object))
+            return image->getTotalSizeInBytesIncludingMipmaps();
+
+        if (const osg::Texture* texture = dynamic_cast<const osg::Texture*>(&object))
+        {
+            std::size_t result = 0;
+            for (unsigned i = 0, n = texture->getNumImages(); i < n; ++i)
+                if (const osg::Image* image = texture->getImage(i))
+                    result += image->getTotalSizeInBytesIncludingMipmaps();
+            return result;
+        }
+
+        if (const osg::Node* node = dynamic_cast<const osg::Node*>(&object))
+        {
+            GeometryMemoryUsageVisitor visitor;
+            const_cast<osg::Node*>(node)->accept(visitor);
+            return visitor.getResult();
+        }
+
+        if (const BulletShape* shape = dynamic_cast<const BulletShape*>(&object))
+        {
+            // Instances share mesh data with their source
+            if (dynamic_cast<const BulletShapeInstance*>(shape) != nullptr)
+                return 0;
+            return getShapeMemoryUsage(shape->mCollisionShape.get())
+                + getShapeMemoryUsage(shape->mAvoidCollisionShape.get());
+        }
+
+        return 0;
+    }
+}
@@ -0,0 +1,19 @@
+#ifndef OPENMW_COMPONENTS_RESOURCE_MEMORYUSAGE_H
+#define OPENMW_COMPONENTS_RESOURCE_MEMORYUSAGE_H
+
+#include <cstddef>
+
+namespace osg
+{
+    class Object;
+}
+
+namespace Resource
+{
+    /// Returns estimated number of bytes of the data owned by the object: image data, vertex and index arrays for
+    /// nodes and triangle meshes for bullet shapes. Images referenced by nodes are not included because they are
+    /// cached separately.
+    std::size_t estimateMemoryUsage(const osg::Object& object);
+}
+
+#endif
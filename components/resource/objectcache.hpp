@@ -3,6 +3,8 @@
 // - removeExpiredObjectsInCache no longer keeps a lock while the unref happens.
 // - template allows customized KeyType.
 // - objects with uninitialized time stamp are not removed.
+// - items can be split across independently locked shards selected by key hash.
+// - estimated memory usage is tracked per item and least recently used items are evicted to fit into a budget.
 
 /* -*-c++-*- OpenSceneGraph - Copyright (C) 1998-2006 Robert Osfield
  *
@@ -22,15 +24,29 @@
 
 #include "cachestats.hpp"
 
+#include <components/misc/hash.hpp>
+#include <components/vfs/pathutil.hpp>
+
 #include <osg/Node>
 #include <osg/Referenced>
+#include <osg/Vec2f>
 #include <osg/ref_ptr>
 
 #include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cmath>
+#include <functional>
 #include <map>
+#include <memory>
 #include <mutex>
 #include <optional>
+#include <shared_mutex>
 #include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 namespace osg
@@ -46,19 +62,153 @@ namespace Resource
     struct GenericObjectCacheItem
     {
         osg::ref_ptr<osg::Object> mValue;
-        double mLastUsage;
+        std::atomic<double> mLastUsage;
+        std::size_t mMemoryUsage;
+
+        explicit GenericObjectCacheItem(osg::ref_ptr<osg::Object> value, double lastUsage, std::size_t memoryUsage)
+            : mValue(std::move(value))
+            , mLastUsage(lastUsage)
+            , mMemoryUsage(memoryUsage)
+        {
+        }
+    };
+
+    /// Returns estimated number of bytes owned by the cached object.
+    using ObjectMemoryUsageFunction = std::size_t (*)(const osg::Object& object);
+
+    /// Hashes cache keys to select a shard. Strings and paths of the same value produce the same hash to support
+    /// heterogeneous lookup.
+    struct ObjectCacheKeyHash
+    {
+        std::size_t operator()(std::string_view value) const { return std::hash<std::string_view>{}(value); }
+
+        std::size_t operator()(const std::string& value) const { return (*this)(std::string_view(value)); }
+
+        std::size_t operator()(const VFS::Path::Normalized& value) const { return (*this)(value.view()); }
+
+        std::size_t operator()(VFS::Path::NormalizedView value) const { return (*this)(value.value()); }
+
+        std::size_t operator()(const osg::Vec2f& value) const
+        {
+            std::size_t seed = 0;
+            Misc::hashCombine(seed, value.x());
+            Misc::hashCombine(seed, value.y());
+            return seed;
+        }
+
+        template <class... T>
+        std::size_t operator()(const std::tuple<T...>& value) const
+            requires(std::is_invocable_v<const ObjectCacheKeyHash&, const T&> && ...)
+        {
+            std::size_t seed = 0;
+            std::apply([&](const T&... v) { (Misc::hashCombine(seed, (*this)(v)), ...); }, value);
+            return seed;
+        }
+
+        template <class T>
+        std::size_t operator()(const T& value) const
+            requires requires { std::hash<T>{}(value); }
+        {
+            return std::hash<T>{}(value);
+        }
     };
 
     template <typename KeyType>
     class GenericObjectCache : public osg::Referenced
     {
     public:
+        /// Keys without ObjectCacheKeyHash support are always stored in a single shard.
+        static constexpr bool sSupportsSharding = std::is_invocable_v<const ObjectCacheKeyHash&, const KeyType&>;
+
+        explicit GenericObjectCache(std::size_t shardCount = 1)
+        {
+            resetShards(shardCount);
+        }
+
+        /*
+         * @brief Splits the cache into the given number of independently locked shards
+         *
+         * Lookups take a shared lock on a single shard only so they are not blocked by lookups of other threads and
+         * are blocked by modifications only when these modify the same shard. Existing items are redistributed.
+         *
+         * \note
+         * Must not be called concurrently with any other member function.
+         */
+        void setShardCount(std::size_t shardCount)
+        {
+            if (!sSupportsSharding || shardCount == 0 || shardCount == mShardCount)
+                return;
+            const std::unique_ptr<Shard[]> shards = std::move(mShards);
+            const std::size_t count = mShardCount;
+            resetShards(shardCount);
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                Shard& shard = shards[i];
+                for (auto& [key, item] : shard.mItems)
+                {
+                    Shard& target = getShard(key);
+                    target.mItems.emplace(std::piecewise_construct, std::forward_as_tuple(key),
+                        std::forward_as_tuple(std::move(item.mValue), item.mLastUsage, item.mMemoryUsage));
+                    target.mMemoryUsage += item.mMemoryUsage;
+                }
+                Shard& first = mShards[0];
+                first.mGet += shard.mGet;
+                first.mHit += shard.mHit;
+                first.mExpired += shard.mExpired;
+                first.mContended += shard.mContended;
+                first.mEvicted += shard.mEvicted;
+            }
+        }
+
+        std::size_t getShardCount() const { return mShardCount; }
+
+        /// Sets a function to estimate memory usage of objects added after this call.
+        /// @note Must not be called concurrently with any other member function.
+        void setMemoryUsageFunction(ObjectMemoryUsageFunction value) { mMemoryUsageFunction = value; }
+
+        /// Limits estimated memory usage of the cache, 0 means no limit. The limit is enforced by update().
+        void setMemoryBudget(std::size_t value) { mMemoryBudget = value; }
+
+        std::size_t getMemoryBudget() const { return mMemoryBudget; }
+
+        /*
+         * @brief Removes least recently used items until at least the given number of bytes is freed
+         *
+         * Only items that are not referenced outside of the cache are removed since removing the others does not free
+         * any memory. Each shard frees a part of the requested size proportional to its memory usage.
+         *
+         * @return estimated number of freed bytes
+         */
+        std::size_t evict(std::size_t bytes)
+        {
+            if (bytes == 0)
+                return 0;
+            const std::size_t total = getStats().mMemoryUsage;
+            if (total == 0)
+                return 0;
+            std::size_t freed = 0;
+            std::vector<osg::ref_ptr<osg::Object>> objectsToRemove;
+            for (std::size_t i = 0; i < mShardCount; ++i)
+            {
+                Shard& shard = mShards[i];
+                {
+                    const std::unique_lock lock = lockUnique(shard);
+                    const std::size_t shardBytes = static_cast<std::size_t>(
+                        std::ceil(static_cast<double>(bytes) * shard.mMemoryUsage / static_cast<double>(total)));
+                    freed += evict(shard, shardBytes, objectsToRemove);
+                }
+                objectsToRemove.clear();
+            }
+            return freed;
+        }
+
         /*
          * @brief Updates usage timestamps and removes expired items
          *
          * Updates the lastUsage timestamp of cached non-nullptr items that have external references.
          * Initializes lastUsage timestamp for new items.
          * Removes items that haven't been referenced for longer than expiryDelay.
+         * Shards are processed one by one so lookups in other shards are not blocked.
          *
          * \note
          * Last usage might be updated from other places so nullptr items
@@ -69,77 +219,115 @@ namespace Resource
          */
         void update(double referenceTime, double expiryDelay)
         {
+            const double expiryTime = referenceTime - expiryDelay;
             std::vector<osg::ref_ptr<osg::Object>> objectsToRemove;
+            for (std::size_t i = 0; i < mShardCount; ++i)
             {
-                const double expiryTime = referenceTime - expiryDelay;
-                std::lock_guard<std::mutex> lock(mMutex);
+                Shard& shard = mShards[i];
+                {
+                    const std::unique_lock lock = lockUnique(shard);
 
-                std::erase_if(mItems, [&](auto& v) {
-                    Item& item = v.second;
+                    for (auto it = shard.mItems.begin(); it != shard.mItems.end();)
+                    {
+                        Item& item = it->second;
 
-                    // update last usage timestamp if item is being referenced externally
-                    // or initialize if not set
-                    if ((item.mValue != nullptr && item.mValue->referenceCount() > 1) || item.mLastUsage == 0)
-                        item.mLastUsage = referenceTime;
+                        // update last usage timestamp if item is being referenced externally
+                        // or initialize if not set
+                        if ((item.mValue != nullptr && item.mValue->referenceCount() > 1) || item.mLastUsage == 0)
+                            item.mLastUsage = referenceTime;
 
-                    // skip items that have been accessed since expiryTime
-                    if (item.mLastUsage > expiryTime)
-                        return false;
+                        // skip items that have been accessed since expiryTime
+                        if (item.mLastUsage > expiryTime)
+                        {
+                            ++it;
+                            continue;
+                        }
 
-                    ++mExpired;
+                        ++shard.mExpired;
+                        shard.mMemoryUsage -= item.mMemoryUsage;
 
-                    // just mark for removal here so objects can be removed in bulk outside the lock
-                    if (item.mValue != nullptr)
-                        objectsToRemove.push_back(std::move(item.mValue));
+                        // just mark for removal here so objects can be removed in bulk outside the lock
+                        if (item.mValue != nullptr)
+                            objectsToRemove.push_back(std::move(item.mValue));
 
-                    return true;
-                });
+                        it = shard.mItems.erase(it);
+                    }
+                }
+                // remove expired items from cache
+                objectsToRemove.clear();
             }
-            // remove expired items from cache
-            objectsToRemove.clear();
+
+            if (mMemoryBudget == 0)
+                return;
+
+            const std::size_t memoryUsage = getStats().mMemoryUsage;
+            if (memoryUsage > mMemoryBudget)
+                evict(memoryUsage - mMemoryBudget);
         }
 
         /** Remove all objects in the cache regardless of having external references or expiry times.*/
         void clear()
         {
-            std::lock_guard<std::mutex> lock(mMutex);
-            mItems.clear();
+            for (std::size_t i = 0; i < mShardCount; ++i)
+            {
+                Shard& shard = mShards[i];
+                const std::unique_lock lock = lockUnique(shard);
+                shard.mItems.clear();
+                shard.mMemoryUsage = 0;
+            }
         }
 
         /** Add a key,object,timestamp triple to the Registry::ObjectCache.*/
         template <class K>
         void addEntryToObjectCache(K&& key, osg::Object* object, double timestamp = 0.0)
         {
-            std::lock_guard<std::mutex> lock(mMutex);
-            const auto it = mItems.find(key);
-            if (it == mItems.end())
-                mItems.emplace_hint(it, std::forward<K>(key), Item{ object, timestamp });
+            const std::size_t memoryUsage
+                = object != nullptr && mMemoryUsageFunction != nullptr ? mMemoryUsageFunction(*object) : 0;
+            osg::ref_ptr<osg::Object> replaced;
+            Shard& shard = getShard(key);
+            const std::unique_lock lock = lockUnique(shard);
+            const auto it = shard.mItems.find(key);
+            if (it == shard.mItems.end())
+                shard.mItems.emplace_hint(it, std::piecewise_construct, std::forward_as_tuple(std::forward<K>(key)),
+                    std::forward_as_tuple(object, timestamp, memoryUsage));
             else
-                it->second = Item{ object, timestamp };
+            {
+                shard.mMemoryUsage -= it->second.mMemoryUsage;
+                replaced = std::exchange(it->second.mValue, object);
+                it->second.mLastUsage = timestamp;
+                it->second.mMemoryUsage = memoryUsage;
+            }
+            shard.mMemoryUsage += memoryUsage;
         }
 
         /** Remove Object from cache.*/
         void removeFromObjectCache(const auto& key)
         {
-            std::lock_guard<std::mutex> lock(mMutex);
-            const auto itr = mItems.find(key);
-            if (itr != mItems.end())
-                mItems.erase(itr);
+            Shard& shard = getShard(key);
+            const std::unique_lock lock = lockUnique(shard);
+            const auto itr = shard.mItems.find(key);
+            if (itr != shard.mItems.end())
+            {
+                shard.mMemoryUsage -= itr->second.mMemoryUsage;
+                shard.mItems.erase(itr);
+            }
         }
 
         /** Get an ref_ptr<Object> from the object cache*/
         osg::ref_ptr<osg::Object> getRefFromObjectCache(const auto& key)
         {
-            std::lock_guard<std::mutex> lock(mMutex);
-            if (Item* const item = find(key))
+            Shard& shard = getShard(key);
+            const std::shared_lock lock = lockShared(shard);
+            if (Item* const item = find(shard, key))
                 return item->mValue;
             return nullptr;
         }
 
         std::optional<osg::ref_ptr<osg::Object>> getRefFromObjectCacheOrNone(const auto& key)
         {
-            const std::lock_guard<std::mutex> lock(mMutex);
-            if (Item* const item = find(key))
+            Shard& shard = getShard(key);
+            const std::shared_lock lock = lockShared(shard);
+            if (Item* const item = find(shard, key))
                 return item->mValue;
             return std::nullopt;
         }
@@ -147,8 +335,9 @@ namespace Resource
         /** Check if an object is in the cache, and if it is, update its usage time stamp. */
         bool checkInObjectCache(const auto& key, double timeStamp)
         {
-            std::lock_guard<std::mutex> lock(mMutex);
-            if (Item* const item = find(key))
+            Shard& shard = getShard(key);
+            const std::shared_lock lock = lockShared(shard);
+            if (Item* const item = find(shard, key))
             {
                 item->mLastUsage = timeStamp;
                 return true;
@@ -159,67 +348,192 @@ namespace Resource
         /** call releaseGLObjects on all objects attached to the object cache.*/
         void releaseGLObjects(osg::State* state)
         {
-            std::lock_guard<std::mutex> lock(mMutex);
-            for (const auto& [k, v] : mItems)
-                v.mValue->releaseGLObjects(state);
+            for (std::size_t i = 0; i < mShardCount; ++i)
+            {
+                Shard& shard = mShards[i];
+                const std::shared_lock lock = lockShared(shard);
+                for (const auto& [k, v] : shard.mItems)
+                    v.mValue->releaseGLObjects(state);
+            }
         }
 
         /** call node->accept(nv); for all nodes in the objectCache. */
         void accept(osg::NodeVisitor& nv)
         {
-            std::lock_guard<std::mutex> lock(mMutex);
-            for (const auto& [k, v] : mItems)
-                if (osg::Object* const object = v.mValue.get())
-                    if (osg::Node* const node = dynamic_cast<osg::Node*>(object))
-                        node->accept(nv);
+            for (std::size_t i = 0; i < mShardCount; ++i)
+            {
+                Shard& shard = mShards[i];
+                const std::shared_lock lock = lockShared(shard);
+                for (const auto& [k, v] : shard.mItems)
+                    if (osg::Object* const object = v.mValue.get())
+                        if (osg::Node* const node = dynamic_cast<osg::Node*>(object))
+                            node->accept(nv);
+            }
         }
 
-        /** call operator()(KeyType, osg::Object*) for each object in the cache. */
+        /** call operator()(KeyType, osg::Object*) for each object in the cache. Keys are ordered within a shard. */
         template <class Functor>
         void call(Functor&& f)
         {
-            std::lock_guard<std::mutex> lock(mMutex);
-            for (const auto& [k, v] : mItems)
-                f(k, v.mValue.get());
+            for (std::size_t i = 0; i < mShardCount; ++i)
+            {
+                Shard& shard = mShards[i];
+                const std::shared_lock lock = lockShared(shard);
+                for (const auto& [k, v] : shard.mItems)
+                    f(k, v.mValue.get());
+            }
         }
 
         template <class K>
         std::optional<std::pair<KeyType, osg::ref_ptr<osg::Object>>> lowerBound(K&& key)
         {
-            const std::lock_guard<std::mutex> lock(mMutex);
-            const auto it = mItems.lower_bound(std::forward<K>(key));
-            if (it == mItems.end())
-                return std::nullopt;
-            return std::pair(it->first, it->second.mValue);
+            std::optional<std::pair<KeyType, osg::ref_ptr<osg::Object>>> result;
+            for (std::size_t i = 0; i < mShardCount; ++i)
+            {
+                Shard& shard = mShards[i];
+                const std::shared_lock lock = lockShared(shard);
+                const auto it = shard.mItems.lower_bound(key);
+                if (it != shard.mItems.end() && (!result.has_value() || it->first < result->first))
+                    result.emplace(it->first, it->second.mValue);
+            }
+            return result;
         }
 
         CacheStats getStats() const
         {
-            const std::lock_guard<std::mutex> lock(mMutex);
-            return CacheStats{
-                .mSize = mItems.size(),
-                .mGet = mGet,
-                .mHit = mHit,
-                .mExpired = mExpired,
-            };
+            CacheStats result;
+            for (std::size_t i = 0; i < mShardCount; ++i)
+            {
+                const CacheStats stats = getShardStats(mShards[i]);
+                result.mSize += stats.mSize;
+                result.mGet += stats.mGet;
+                result.mHit += stats.mHit;
+                result.mExpired += stats.mExpired;
+                result.mContended += stats.mContended;
+                result.mEvicted += stats.mEvicted;
+                result.mMemoryUsage += stats.mMemoryUsage;
+            }
+            return result;
+        }
+
+        std::vector<CacheStats> getShardStats() const
+        {
+            std::vector<CacheStats> result;
+            result.reserve(mShardCount);
+            for (std::size_t i = 0; i < mShardCount; ++i)
+                result.push_back(getShardStats(mShards[i]));
+            return result;
         }
 
     protected:
         using Item = GenericObjectCacheItem;
 
-        std::map<KeyType, Item, std::less<>> mItems;
-        mutable std::mutex mMutex;
-        std::size_t mGet = 0;
-        std::size_t mHit = 0;
-        std::size_t mExpired = 0;
+        struct Shard
+        {
+            std::map<KeyType, Item, std::less<>> mItems;
+            mutable std::shared_mutex mMutex;
+            std::atomic_size_t mGet = 0;
+            std::atomic_size_t mHit = 0;
+            std::size_t mExpired = 0;
+            std::size_t mEvicted = 0;
+            std::size_t mMemoryUsage = 0;
+            mutable std::atomic_size_t mContended = 0;
+        };
+
+        std::unique_ptr<Shard[]> mShards;
+        std::size_t mShardCount = 0;
+        ObjectMemoryUsageFunction mMemoryUsageFunction = nullptr;
+        std::atomic_size_t mMemoryBudget = 0;
+
+        void resetShards(std::size_t shardCount)
+        {
+            assert(shardCount > 0);
+            mShardCount = sSupportsSharding ? shardCount : 1;
+            mShards = std::make_unique<Shard[]>(mShardCount);
+        }
+
+        Shard& getShard(const auto& key) const
+        {
+            if constexpr (sSupportsSharding)
+            {
+                static_assert(std::is_invocable_v<const ObjectCacheKeyHash&, decltype(key)>,
+                    "Keys used for lookup should have the same hash as equal KeyType values");
+                if (mShardCount > 1)
+                    return mShards[ObjectCacheKeyHash{}(key) % mShardCount];
+            }
+            return mShards[0];
+        }
+
+        static std::unique_lock<std::shared_mutex> lockUnique(const Shard& shard)
+        {
+            std::unique_lock lock(shard.mMutex, std::try_to_lock);
+            if (!lock.owns_lock())
+            {
+                ++shard.mContended;
+                lock.lock();
+            }
+            return lock;
+        }
+
+        static std::shared_lock<std::shared_mutex> lockShared(const Shard& shard)
+        {
+            std::shared_lock lock(shard.mMutex, std::try_to_lock);
+            if (!lock.owns_lock())
+            {
+                ++shard.mContended;
+                lock.lock();
+            }
+            return lock;
+        }
+
+        static CacheStats getShardStats(const Shard& shard)
+        {
+            const std::shared_lock lock = lockShared(shard);
+            return CacheStats{
+                .mSize = shard.mItems.size(),
+                .mGet = shard.mGet,
+                .mHit = shard.mHit,
+                .mExpired = shard.mExpired,
+                .mContended = shard.mContended,
+                .mEvicted = shard.mEvicted,
+                .mMemoryUsage = shard.mMemoryUsage,
+            };
+        }
+
+        static std::size_t evict(Shard& shard, std::size_t bytes, std::vector<osg::ref_ptr<osg::Object>>& removed)
+        {
+            using Iterator = typename std::map<KeyType, Item, std::less<>>::iterator;
+
+            std::vector<Iterator> candidates;
+            for (auto it = shard.mItems.begin(); it != shard.mItems.end(); ++it)
+                if (it->second.mValue != nullptr && it->second.mValue->referenceCount() == 1
+                    && it->second.mMemoryUsage > 0)
+                    candidates.push_back(it);
+
+            std::sort(candidates.begin(), candidates.end(),
+                [](Iterator l, Iterator r) { return l->second.mLastUsage < r->second.mLastUsage; });
+
+            std::size_t freed = 0;
+            for (Iterator it : candidates)
+            {
+                if (freed >= bytes)
+                    break;
+                freed += it->second.mMemoryUsage;
+                shard.mMemoryUsage -= it->second.mMemoryUsage;
+                ++shard.mEvicted;
+                removed.push_back(std::move(it->second.mValue));
+                shard.mItems.erase(it);
+            }
+            return freed;
+        }
 
-        Item* find(const auto& key)
+        static Item* find(Shard& shard, const auto& key)
         {
-            ++mGet;
-            const auto it = mItems.find(key);
-            if (it == mItems.end())
+            ++shard.mGet;
+            const auto it = shard.mItems.find(key);
+            if (it == shard.mItems.end())
                 return nullptr;
-            ++mHit;
+            ++shard.mHit;
             return &it->second;
         }
     };
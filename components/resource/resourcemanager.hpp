@@ -5,6 +5,7 @@
 
 #include <components/vfs/pathutil.hpp>
 
+#include "memoryusage.hpp"
 #include "objectcache.hpp"
 
 namespace VFS
@@ -28,6 +29,10 @@ namespace Resource
         virtual void updateCache(double referenceTime) = 0;
         virtual void clearCache() = 0;
         virtual void setExpiryDelay(double expiryDelay) = 0;
+        virtual void setCacheShards(std::size_t count) = 0;
+        virtual void setMemoryBudget(std::size_t bytes) = 0;
+        virtual std::size_t getMemoryUsage() const = 0;
+        virtual std::size_t evictCache(std::size_t bytes) = 0;
         virtual void reportStats(unsigned int frameNumber, osg::Stats* stats) const = 0;
         virtual void releaseGLObjects(osg::State* state) = 0;
     };
@@ -46,6 +51,7 @@ namespace Resource
             , mCache(new CacheType)
             , mExpiryDelay(expiryDelay)
         {
+            mCache->setMemoryUsageFunction(&estimateMemoryUsage);
         }
 
         virtual ~GenericResourceManager() = default;
@@ -60,6 +66,18 @@ namespace Resource
         void setExpiryDelay(double expiryDelay) final { mExpiryDelay = expiryDelay; }
         double getExpiryDelay() const { return mExpiryDelay; }
 
+        /// Split the cache into independently locked shards to reduce lock contention between threads.
+        /// @note Must not be called concurrently with the cache access.
+        void setCacheShards(std::size_t count) final { mCache->setShardCount(count); }
+
+        /// Limit estimated memory usage of the cache, 0 means no limit. Least recently used objects are evicted.
+        void setMemoryBudget(std::size_t bytes) final { mCache->setMemoryBudget(bytes); }
+
+        std::size_t getMemoryUsage() const final { return mCache->getStats().mMemoryUsage; }
+
+        /// Evict least recently used objects that are not referenced elsewhere to free the given amount of memory.
+        std::size_t evictCache(std::size_t bytes) final { return mCache->evict(bytes); }
+
         const VFS::Manager* getVFS() const { return mVFS; }
 
         void reportStats(unsigned int frameNumber, osg::Stats* stats) const override {}
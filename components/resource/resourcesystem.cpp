@@ -1,6 +1,13 @@
 #include "resourcesystem.hpp"
 
 #include <algorithm>
+#include <chrono>
+#include <cmath>
+
+#include <osg/Stats>
+
+#include <components/bsa/decompressionpool.hpp>
+#include <components/vfs/manager.hpp>
 
 #include "animblendrulesmanager.hpp"
 #include "bgsmfilemanager.hpp"
@@ -81,11 +88,53 @@ namespace Resource
         mNifFileManager->setExpiryDelay(0.0);
     }
 
+    void ResourceSystem::setCacheShards(std::size_t count)
+    {
+        mCacheShards = count;
+        for (BaseResourceManager* manager : mResourceManagers)
+            manager->setCacheShards(count);
+    }
+
+    void ResourceSystem::setMemoryBudget(std::size_t total, std::size_t perManager)
+    {
+        mMemoryBudget = total;
+        mManagerMemoryBudget = perManager;
+        for (BaseResourceManager* manager : mResourceManagers)
+            manager->setMemoryBudget(perManager);
+    }
+
+    std::size_t ResourceSystem::getMemoryUsage() const
+    {
+        std::size_t result = 0;
+        for (const BaseResourceManager* manager : mResourceManagers)
+            result += manager->getMemoryUsage();
+        return result;
+    }
+
     void ResourceSystem::updateCache(double referenceTime)
     {
         for (std::vector<BaseResourceManager*>::iterator it = mResourceManagers.begin(); it != mResourceManagers.end();
              ++it)
             (*it)->updateCache(referenceTime);
+
+        if (mMemoryBudget == 0)
+            return;
+
+        std::vector<std::size_t> usage;
+        usage.reserve(mResourceManagers.size());
+        std::size_t total = 0;
+        for (const BaseResourceManager* manager : mResourceManagers)
+            total += usage.emplace_back(manager->getMemoryUsage());
+
+        if (total <= mMemoryBudget)
+            return;
+
+        // Each manager frees a part proportional to its usage in the order of registration so scene nodes release
+        // references to images before images are evicted
+        const double excess = static_cast<double>(total - mMemoryBudget);
+        for (std::size_t i = 0; i < mResourceManagers.size(); ++i)
+            mResourceManagers[i]->evictCache(
+                static_cast<std::size_t>(std::ceil(excess * static_cast<double>(usage[i]) / total)));
     }
 
     void ResourceSystem::clearCache()
@@ -97,6 +146,8 @@ namespace Resource
 
     void ResourceSystem::addResourceManager(BaseResourceManager* resourceMgr)
     {
+        resourceMgr->setCacheShards(mCacheShards);
+        resourceMgr->setMemoryBudget(mManagerMemoryBudget);
         mResourceManagers.push_back(resourceMgr);
     }
 
@@ -118,6 +169,21 @@ namespace Resource
         for (std::vector<BaseResourceManager*>::const_iterator it = mResourceManagers.begin();
              it != mResourceManagers.end(); ++it)
             (*it)->reportStats(frameNumber, stats);
+
+        stats->setAttribute(frameNumber, "Resource Memory", static_cast<double>(getMemoryUsage()));
+        stats->setAttribute(frameNumber, "Resource MemoryBudget", static_cast<double>(mMemoryBudget));
+
+        if (const Bsa::DecompressionPool* const pool = mVFS->getDecompressionPool())
+        {
+            const Bsa::DecompressionStats archiveStats = pool->getStats();
+            stats->setAttribute(frameNumber, "Archive Decompressed", static_cast<double>(archiveStats.mJobs));
+            stats->setAttribute(
+                frameNumber, "Archive CompressedBytes", static_cast<double>(archiveStats.mInputBytes));
+            stats->setAttribute(
+                frameNumber, "Archive DecompressedBytes", static_cast<double>(archiveStats.mOutputBytes));
+            stats->setAttribute(frameNumber, "Archive DecompressionTime",
+                std::chrono::duration<double>(archiveStats.mTime).count());
+        }
     }
 
     void ResourceSystem::releaseGLObjects(osg::State* state)
@@ -1,6 +1,7 @@
 #ifndef OPENMW_COMPONENTS_RESOURCE_RESOURCESYSTEM_H
 #define OPENMW_COMPONENTS_RESOURCE_RESOURCESYSTEM_H
 
+#include <cstddef>
 #include <memory>
 #include <vector>
 
@@ -67,6 +68,17 @@ namespace Resource
         /// How long to keep objects in cache after no longer being referenced.
         void setExpiryDelay(double expiryDelay);
 
+        /// Number of independently locked shards for each resource manager cache. Applies to all current and later
+        /// added managers.
+        /// @note Must not be called concurrently with the cache access.
+        void setCacheShards(std::size_t count);
+
+        /// Limit estimated memory usage of all caches together and of each resource manager cache, 0 means no limit.
+        /// The limits are enforced by updateCache() evicting least recently used objects.
+        void setMemoryBudget(std::size_t total, std::size_t perManager);
+
+        std::size_t getMemoryUsage() const;
+
         /// @note May be called from any thread.
         const VFS::Manager* getVFS() const;
 
@@ -88,6 +100,9 @@ namespace Resource
         std::vector<BaseResourceManager*> mResourceManagers;
 
         const VFS::Manager* mVFS;
+        std::size_t mCacheShards = 1;
+        std::size_t mMemoryBudget = 0;
+        std::size_t mManagerMemoryBudget = 0;
 
         ResourceSystem(const ResourceSystem&);
         void operator=(const ResourceSystem&);
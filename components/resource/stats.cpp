@@ -96,6 +96,18 @@ namespace Resource
                 "Blending Rules",
             };
 
+            constexpr std::string_view resourceMemory[] = {
+                "Resource Memory",
+                "Resource MemoryBudget",
+            };
+
+            constexpr std::string_view archive[] = {
+                "Archive Decompressed",
+                "Archive CompressedBytes",
+                "Archive DecompressedBytes",
+                "Archive DecompressionTime",
+            };
+
             constexpr std::string_view cellPreloader[] = {
                 "CellPreloader Count",
                 "CellPreloader Added",
@@ -120,10 +132,23 @@ namespace Resource
                 "NavMesh CachedTiles",
                 "NavMesh Cache Get",
                 "NavMesh Cache Hit",
+                "NavMesh QueueLatency <4ms",
+                "NavMesh QueueLatency <16ms",
+                "NavMesh QueueLatency <64ms",
+                "NavMesh QueueLatency <256ms",
+                "NavMesh QueueLatency <1024ms",
+                "NavMesh QueueLatency >=1024ms",
+                "NavMesh TotalLatency <4ms",
+                "NavMesh TotalLatency <16ms",
+                "NavMesh TotalLatency <64ms",
+                "NavMesh TotalLatency <256ms",
+                "NavMesh TotalLatency <1024ms",
+                "NavMesh TotalLatency >=1024ms",
                 "NavMesh Recast Tiles",
                 "NavMesh Recast Objects",
                 "NavMesh Recast Heightfields",
                 "NavMesh Recast Water",
+                "NavMesh Recast ObjectsTrianglesCacheSize",
             };
 
             std::vector<std::string> statNames;
@@ -131,13 +156,28 @@ namespace Resource
             for (std::string_view name : firstPage)
                 statNames.emplace_back(name);
 
+            constexpr std::size_t cachesPerPage = 3;
+
             for (std::size_t i = 0; i < std::size(caches); ++i)
             {
                 Resource::addCacheStatsAttibutes(caches[i], statNames);
-                if ((i + 1) % 5 != 0)
+                if ((i + 1) % cachesPerPage != 0)
                     statNames.emplace_back();
+                else
+                    while (statNames.size() % itemsPerPage != 0)
+                        statNames.emplace_back();
             }
 
+            for (std::string_view name : resourceMemory)
+                statNames.emplace_back(name);
+
+            statNames.emplace_back();
+
+            for (std::string_view name : archive)
+                statNames.emplace_back(name);
+
+            statNames.emplace_back();
+
             for (std::string_view name : cellPreloader)
                 statNames.emplace_back(name);
 
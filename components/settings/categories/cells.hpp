@@ -31,6 +31,12 @@ namespace Settings
             makeMaxSanitizerFloat(0) };
         SettingValue<float> mPredictionTime{ mIndex, "Cells", "prediction time", makeMaxSanitizerFloat(0) };
         SettingValue<float> mCacheExpiryDelay{ mIndex, "Cells", "cache expiry delay", makeMaxSanitizerFloat(0) };
+        SettingValue<int> mCacheShards{ mIndex, "Cells", "cache shards", makeClampSanitizerInt(1, 256) };
+        SettingValue<int> mCacheMemoryBudget{ mIndex, "Cells", "cache memory budget", makeMaxSanitizerInt(0) };
+        SettingValue<int> mCacheTypeMemoryBudget{ mIndex, "Cells", "cache type memory budget",
+            makeMaxSanitizerInt(0) };
+        SettingValue<int> mArchiveDecompressionThreads{ mIndex, "Cells", "archive decompression threads",
+            makeClampSanitizerInt(0, 64) };
         SettingValue<float> mTargetFramerate{ mIndex, "Cells", "target framerate", makeMaxStrictSanitizerFloat(0) };
         SettingValue<int> mPointersCacheSize{ mIndex, "Cells", "pointers cache size", makeClampSanitizerInt(40, 1000) };
     };
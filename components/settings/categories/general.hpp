@@ -32,6 +32,13 @@ namespace Settings
         SettingValue<bool> mGmstOverridesL10n{ mIndex, "General", "gmst overrides l10n" };
         SettingValue<std::size_t> mLogBufferSize{ mIndex, "General", "log buffer size" };
         SettingValue<std::size_t> mConsoleHistoryBufferSize{ mIndex, "General", "console history buffer size" };
+        SettingValue<bool> mCacheFileIndex{ mIndex, "General", "cache file index" };
+        SettingValue<bool> mCacheContent{ mIndex, "General", "cache content" };
+        SettingValue<int> mContentLoadingThreads{ mIndex, "General", "content loading threads",
+            makeClampSanitizerInt(0, 64) };
+        SettingValue<bool> mCacheScripts{ mIndex, "General", "cache scripts" };
+        SettingValue<int> mScriptCompilingThreads{ mIndex, "General", "script compiling threads",
+            makeClampSanitizerInt(0, 64) };
     };
 }
 
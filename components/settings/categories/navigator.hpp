@@ -43,6 +43,13 @@ namespace Settings
         SettingValue<std::size_t> mAsyncNavMeshUpdaterThreads{ mIndex, "Navigator", "async nav mesh updater threads",
             makeMaxSanitizerSize(1) };
         SettingValue<std::size_t> mMaxNavMeshTilesCacheSize{ mIndex, "Navigator", "max nav mesh tiles cache size" };
+        SettingValue<std::size_t> mMaxRecastMeshObjectsCacheSize{ mIndex, "Navigator",
+            "max recast mesh objects cache size" };
+        SettingValue<std::size_t> mMaxRasterizedRecastMeshCacheSize{ mIndex, "Navigator",
+            "max rasterized recast mesh cache size" };
+        SettingValue<std::size_t> mAsyncPathFinderThreads{ mIndex, "Navigator", "async path finder threads" };
+        SettingValue<std::size_t> mMaxCellPortalGraphSearchNodes{ mIndex, "Navigator",
+            "max cell portal graph search nodes" };
         SettingValue<std::size_t> mMaxPolygonPathSize{ mIndex, "Navigator", "max polygon path size" };
         SettingValue<std::size_t> mMaxSmoothPathSize{ mIndex, "Navigator", "max smooth path size" };
         SettingValue<bool> mEnableWriteRecastMeshToFile{ mIndex, "Navigator", "enable write recast mesh to file" };
@@ -58,6 +65,8 @@ namespace Settings
         SettingValue<bool> mEnableRecastMeshRender{ mIndex, "Navigator", "enable recast mesh render" };
         SettingValue<int> mMaxTilesNumber{ mIndex, "Navigator", "max tiles number", makeMaxSanitizerInt(0) };
         SettingValue<int> mMinUpdateIntervalMs{ mIndex, "Navigator", "min update interval ms", makeMaxSanitizerInt(0) };
+        SettingValue<int> mPlayerMovementPredictionTimeMs{ mIndex, "Navigator", "player movement prediction time ms",
+            makeMaxSanitizerInt(0) };
         SettingValue<int> mWaitUntilMinDistanceToPlayer{ mIndex, "Navigator", "wait until min distance to player",
             makeMaxSanitizerInt(0) };
         SettingValue<bool> mEnableNavMeshDiskCache{ mIndex, "Navigator", "enable nav mesh disk cache" };
@@ -25,6 +25,8 @@ namespace Settings
         SettingValue<std::string> mHrtf{ mIndex, "Sound", "hrtf" };
         SettingValue<bool> mCameraListener{ mIndex, "Sound", "camera listener" };
         SettingValue<float> mDopplerFactor{ mIndex, "Sound", "doppler factor", makeClampSanitizerFloat(0, 1) };
+        SettingValue<int> mAsyncLoadingThreads{ mIndex, "Sound", "async loading threads",
+            makeClampSanitizerInt(0, 64) };
     };
 }
 
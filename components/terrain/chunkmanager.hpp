@@ -3,6 +3,7 @@
 
 #include <tuple>
 
+#include <components/misc/hash.hpp>
 #include <components/resource/resourcemanager.hpp>
 
 #include "buffercache.hpp"
@@ -70,6 +71,28 @@ namespace Terrain
     {
         return TemplateKey{ .mCenter = l.mCenter, .mLod = l.mLod } < r;
     }
+}
+
+namespace std
+{
+    // Used to split the chunk cache into shards
+    template <>
+    struct hash<Terrain::ChunkKey>
+    {
+        std::size_t operator()(const Terrain::ChunkKey& value) const
+        {
+            std::size_t seed = 0;
+            Misc::hashCombine(seed, value.mCenter.x());
+            Misc::hashCombine(seed, value.mCenter.y());
+            Misc::hashCombine(seed, value.mLod);
+            Misc::hashCombine(seed, value.mLodFlags);
+            return seed;
+        }
+    };
+}
+
+namespace Terrain
+{
 
     /// @brief Handles loading and caching of terrain chunks
     class ChunkManager : public Resource::GenericResourceManager<ChunkKey>, public QuadTreeWorld::ChunkManager
@@ -10,6 +10,7 @@
 #include <components/misc/strings/conversion.hpp>
 #include <components/vfs/archive.hpp>
 #include <components/vfs/file.hpp>
+#include <components/vfs/filemap.hpp>
 #include <components/vfs/manager.hpp>
 #include <components/vfs/pathutil.hpp>
 
@@ -73,7 +74,11 @@ namespace TestingOpenMW
         {
         }
 
-        void listResources(VFS::FileMap& out) override { out = mFiles; }
+        void listResources(VFS::FileIndex& out) override
+        {
+            for (const auto& [path, file] : mFiles)
+                out.insert(VFS::Path::NormalizedView(path), file);
+        }
 
         bool contains(VFS::Path::NormalizedView file) const override { return mFiles.contains(file); }
 
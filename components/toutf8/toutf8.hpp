@@ -59,6 +59,9 @@ namespace ToUTF8
     public:
         explicit Utf8Encoder(FromType sourceEncoding);
 
+        /// Create an encoder with the same encoding but separate buffer e.g. for another thread.
+        explicit Utf8Encoder(const StatelessUtf8Encoder& encoder);
+
         /// Convert to UTF8 from the previously given code page.
         /// Returns a view to internal buffer invalidate by next getUtf8 or getLegacyEnc call if input is not
         /// ASCII-only string. Otherwise returns a view to the input.
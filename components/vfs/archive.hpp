@@ -3,9 +3,14 @@
 
 #include <string>
 
-#include "filemap.hpp"
+#include "fileindex.hpp"
 #include "pathutil.hpp"
 
+namespace Bsa
+{
+    class DecompressionPool;
+}
+
 namespace VFS
 {
     class Archive
@@ -14,12 +19,15 @@ namespace VFS
         virtual ~Archive() = default;
 
         /// List all resources contained in this archive.
-        virtual void listResources(FileMap& out) = 0;
+        virtual void listResources(FileIndex& out) = 0;
 
         /// True if this archive contains the provided normalized file.
         virtual bool contains(Path::NormalizedView file) const = 0;
 
         virtual std::string getDescription() const = 0;
+
+        /// Set the pool used to decompress files contained in this archive, may be nullptr.
+        virtual void setDecompressionPool(Bsa::DecompressionPool* /*pool*/) {}
     };
 
 }
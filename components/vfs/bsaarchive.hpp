@@ -81,13 +81,13 @@ namespace VFS
             std::sort(mFiles.begin(), mFiles.end());
         }
 
-        void listResources(FileMap& out) override
+        void listResources(FileIndex& out) override
         {
             std::string buffer;
             for (auto& resource : mResources)
             {
                 std::string_view path = getUtf8(resource.mInfo->name(), buffer);
-                out[VFS::Path::Normalized(path)] = &resource;
+                out.insert(VFS::Path::Normalized(path), &resource);
             }
         }
 
@@ -98,6 +98,8 @@ namespace VFS
 
         std::string getDescription() const override { return std::string{ "BSA: " } + mFile->getFilename(); }
 
+        void setDecompressionPool(Bsa::DecompressionPool* pool) override { mFile->setDecompressionPool(pool); }
+
         BSAFileType* getFile() const { return mFile.get(); }
 
         std::string_view getUtf8(std::string_view input, std::string& buffer) const
@@ -0,0 +1,55 @@
+#include "fileindex.hpp"
+
+#include <algorithm>
+
+namespace VFS
+{
+    void FileIndex::build()
+    {
+        mLookup.clear();
+
+        // Keep insertion order for equal paths to let the last added file to override the others
+        std::stable_sort(mEntries.begin(), mEntries.end(),
+            [](const Entry& lhs, const Entry& rhs) { return lhs.first.view() < rhs.first.view(); });
+
+        auto out = mEntries.begin();
+        for (auto it = mEntries.begin(); it != mEntries.end(); ++it)
+        {
+            const auto next = std::next(it);
+            if (next != mEntries.end() && next->first.view() == it->first.view())
+                continue;
+            if (out != it)
+                *out = std::move(*it);
+            ++out;
+        }
+        mEntries.erase(out, mEntries.end());
+
+        mLookup.reserve(mEntries.size());
+        for (const Entry& entry : mEntries)
+            mLookup.emplace(entry.first.view(), entry.second);
+    }
+
+    void FileIndex::clear()
+    {
+        mLookup.clear();
+        mEntries.clear();
+    }
+
+    File* FileIndex::find(std::string_view normalizedPath) const
+    {
+        const auto it = mLookup.find(normalizedPath);
+        if (it == mLookup.end())
+            return nullptr;
+        return it->second;
+    }
+
+    std::pair<FileIndex::const_iterator, FileIndex::const_iterator> FileIndex::getPrefixRange(
+        std::string_view prefix) const
+    {
+        const auto first = std::lower_bound(mEntries.begin(), mEntries.end(), prefix,
+            [](const Entry& entry, std::string_view value) { return entry.first.view() < value; });
+        const auto last = std::partition_point(
+            first, mEntries.end(), [&](const Entry& entry) { return entry.first.view().starts_with(prefix); });
+        return { first, last };
+    }
+}
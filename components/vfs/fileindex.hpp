@@ -0,0 +1,67 @@
+#ifndef OPENMW_COMPONENTS_VFS_FILEINDEX_H
+#define OPENMW_COMPONENTS_VFS_FILEINDEX_H
+
+#include <cstddef>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "pathutil.hpp"
+
+namespace VFS
+{
+    class File;
+
+    /// @brief Index of all files provided by the registered archives.
+    /// @par Files are collected with insert() and become visible after build(). The index is a sorted flat array
+    /// to iterate over files with a common path prefix and a hash table for lookups by exact path.
+    class FileIndex
+    {
+    public:
+        using Entry = std::pair<Path::Normalized, File*>;
+        using const_iterator = std::vector<Entry>::const_iterator;
+
+        FileIndex() = default;
+
+        // The lookup table refers to the paths owned by this object
+        FileIndex(const FileIndex&) = delete;
+        FileIndex(FileIndex&&) = delete;
+
+        FileIndex& operator=(const FileIndex&) = delete;
+        FileIndex& operator=(FileIndex&&) = delete;
+
+        /// Add a file. It replaces a file with the same path added before once build() is called.
+        /// @note Lookups are invalid until build() is called.
+        void insert(Path::Normalized&& path, File* file) { mEntries.emplace_back(std::move(path), file); }
+
+        void insert(Path::NormalizedView path, File* file) { mEntries.emplace_back(Path::Normalized(path), file); }
+
+        /// Sort the inserted files dropping overridden ones and build the lookup table.
+        void build();
+
+        void clear();
+
+        std::size_t size() const { return mEntries.size(); }
+
+        /// Returns nullptr when there is no such file.
+        /// @note May be called from any thread once the index has been built.
+        File* find(std::string_view normalizedPath) const;
+
+        bool contains(std::string_view normalizedPath) const { return find(normalizedPath) != nullptr; }
+
+        const_iterator begin() const { return mEntries.begin(); }
+
+        const_iterator end() const { return mEntries.end(); }
+
+        /// Get all files with normalized path starting with the given prefix in alphabetical order.
+        std::pair<const_iterator, const_iterator> getPrefixRange(std::string_view prefix) const;
+
+    private:
+        std::vector<Entry> mEntries;
+        // Keys refer to the paths stored in mEntries
+        std::unordered_map<std::string_view, File*> mLookup;
+    };
+}
+
+#endif
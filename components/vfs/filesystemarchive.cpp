@@ -1,17 +1,105 @@
 #include "filesystemarchive.hpp"
 
+#include <cstdint>
 #include <filesystem>
+#include <format>
+#include <fstream>
+#include <functional>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
 
 #include "pathutil.hpp"
 
 #include <components/debug/debuglog.hpp>
+#include <components/files/cachefile.hpp>
 #include <components/files/constrainedfilestream.hpp>
 #include <components/files/conversion.hpp>
 
 namespace VFS
 {
+    namespace
+    {
+        constexpr std::uint32_t indexCacheMagic = 0x49534656; // VFSI
+        constexpr std::uint32_t indexCacheVersion = 1;
+
+        struct IndexCache
+        {
+            std::string mRoot;
+            // Relative path and last write time of each directory including the root
+            std::vector<std::pair<std::string, std::int64_t>> mDirectories;
+            // Relative path of each file
+            std::vector<std::string> mFiles;
+        };
+
+        std::filesystem::path getIndexCachePath(const std::filesystem::path& dir, const std::string& root)
+        {
+            return dir / std::format("vfs-{:016x}.bin", static_cast<std::uint64_t>(std::hash<std::string>()(root)));
+        }
+
+        std::int64_t getLastWriteTime(const std::filesystem::path& path, std::error_code& ec)
+        {
+            return static_cast<std::int64_t>(std::filesystem::last_write_time(path, ec).time_since_epoch().count());
+        }
+
+        void writeIndexCache(const std::filesystem::path& path, const IndexCache& cache)
+        {
+            Files::writeCacheFile(path, [&](std::ostream& stream) {
+                Files::writeValue(stream, indexCacheMagic);
+                Files::writeValue(stream, indexCacheVersion);
+                Files::writeString(stream, cache.mRoot);
+                Files::writeValue(stream, static_cast<std::uint64_t>(cache.mDirectories.size()));
+                for (const auto& [directory, lastWriteTime] : cache.mDirectories)
+                {
+                    Files::writeString(stream, directory);
+                    Files::writeValue(stream, lastWriteTime);
+                }
+                Files::writeValue(stream, static_cast<std::uint64_t>(cache.mFiles.size()));
+                for (const std::string& file : cache.mFiles)
+                    Files::writeString(stream, file);
+            });
+        }
+
+        std::optional<IndexCache> readIndexCache(const std::filesystem::path& path)
+        {
+            std::ifstream stream(path, std::ios::binary);
+            if (!stream.is_open())
+                return std::nullopt;
+            if (Files::readValue<std::uint32_t>(stream) != indexCacheMagic
+                || Files::readValue<std::uint32_t>(stream) != indexCacheVersion)
+                return std::nullopt;
+            IndexCache cache;
+            cache.mRoot = Files::readString(stream);
+            const std::uint64_t directories = Files::readValue<std::uint64_t>(stream);
+            for (std::uint64_t i = 0; i < directories; ++i)
+            {
+                std::string directory = Files::readString(stream);
+                cache.mDirectories.emplace_back(std::move(directory), Files::readValue<std::int64_t>(stream));
+            }
+            const std::uint64_t files = Files::readValue<std::uint64_t>(stream);
+            for (std::uint64_t i = 0; i < files; ++i)
+                cache.mFiles.push_back(Files::readString(stream));
+            return cache;
+        }
+
+        // Adding, removing or renaming a file or a directory updates the last write time of the containing directory
+        // so the cached list of files is valid as long as all directories have the same last write time.
+        bool isUpToDate(const IndexCache& cache, const std::filesystem::path& root)
+        {
+            for (const auto& [directory, lastWriteTime] : cache.mDirectories)
+            {
+                std::error_code ec;
+                const std::filesystem::path path
+                    = directory.empty() ? root : root / Files::pathFromUnicodeString(directory);
+                if (getLastWriteTime(path, ec) != lastWriteTime || ec)
+                    return false;
+            }
+            return !cache.mDirectories.empty();
+        }
+    }
 
-    FileSystemArchive::FileSystemArchive(const std::filesystem::path& path)
+    FileSystemArchive::FileSystemArchive(const std::filesystem::path& path, const std::filesystem::path& indexCacheDir)
         : mPath(path)
     {
         const auto str = mPath.u8string();
@@ -20,6 +108,32 @@ namespace VFS
         if (prefix > 0 && str[prefix - 1] != '\\' && str[prefix - 1] != '/')
             ++prefix;
 
+        std::filesystem::path cachePath;
+        IndexCache cache;
+        if (!indexCacheDir.empty())
+        {
+            cache.mRoot = Files::pathToUnicodeString(mPath);
+            cachePath = getIndexCachePath(indexCacheDir, cache.mRoot);
+            try
+            {
+                if (std::optional<IndexCache> cached = readIndexCache(cachePath);
+                    cached.has_value() && cached->mRoot == cache.mRoot && isUpToDate(*cached, mPath))
+                {
+                    for (const std::string& file : cached->mFiles)
+                        addFile(file, mPath / Files::pathFromUnicodeString(file));
+                    return;
+                }
+            }
+            catch (const std::exception& e)
+            {
+                Log(Debug::Warning) << "Failed to read file index cache " << cachePath << ": " << e.what();
+                mIndex.clear();
+            }
+
+            std::error_code ec;
+            cache.mDirectories.emplace_back(std::string(), getLastWriteTime(mPath, ec));
+        }
+
         std::filesystem::recursive_directory_iterator iterator(mPath);
 
         for (auto it = std::filesystem::begin(iterator), end = std::filesystem::end(iterator); it != end;)
@@ -30,14 +144,17 @@ namespace VFS
             {
                 const std::filesystem::path& filePath = entry.path();
                 const std::string proper = Files::pathToUnicodeString(filePath);
-                VFS::Path::Normalized searchable(std::string_view{ proper }.substr(prefix));
-                FileSystemArchiveFile file(filePath);
-
-                const auto inserted = mIndex.emplace(std::move(searchable), std::move(file));
-                if (!inserted.second)
-                    Log(Debug::Warning)
-                        << "Found duplicate file for '" << proper
-                        << "', please check your file system for two files with the same name in different cases.";
+                const std::string_view relativePath = std::string_view{ proper }.substr(prefix);
+                if (!cachePath.empty())
+                    cache.mFiles.emplace_back(relativePath);
+                addFile(relativePath, filePath);
+            }
+            else if (!cachePath.empty())
+            {
+                // Last write time is taken before the directory content is listed to detect changes made meanwhile
+                std::error_code ec;
+                const std::string proper = Files::pathToUnicodeString(entry.path());
+                cache.mDirectories.emplace_back(proper.substr(prefix), getLastWriteTime(entry.path(), ec));
             }
 
             // Exception thrown by the operator++ may not contain the context of the error like what exact path caused
@@ -51,12 +168,33 @@ namespace VFS
                     + "\" when incrementing to the next item from \"" + Files::pathToUnicodeString(prevPath)
                     + "\": " + ec.message());
         }
+
+        if (cachePath.empty())
+            return;
+
+        try
+        {
+            writeIndexCache(cachePath, cache);
+        }
+        catch (const std::exception& e)
+        {
+            Log(Debug::Warning) << "Failed to write file index cache " << cachePath << ": " << e.what();
+        }
+    }
+
+    void FileSystemArchive::addFile(std::string_view relativePath, const std::filesystem::path& filePath)
+    {
+        const auto inserted = mIndex.emplace(VFS::Path::Normalized(relativePath), FileSystemArchiveFile(filePath));
+        if (!inserted.second)
+            Log(Debug::Warning)
+                << "Found duplicate file for '" << Files::pathToUnicodeString(filePath)
+                << "', please check your file system for two files with the same name in different cases.";
     }
 
-    void FileSystemArchive::listResources(FileMap& out)
+    void FileSystemArchive::listResources(FileIndex& out)
     {
         for (auto& [k, v] : mIndex)
-            out[k] = &v;
+            out.insert(VFS::Path::NormalizedView(k), &v);
     }
 
     bool FileSystemArchive::contains(Path::NormalizedView file) const
@@ -5,7 +5,9 @@
 #include "file.hpp"
 
 #include <filesystem>
+#include <map>
 #include <string>
+#include <string_view>
 
 namespace VFS
 {
@@ -28,9 +30,12 @@ namespace VFS
     class FileSystemArchive : public Archive
     {
     public:
-        FileSystemArchive(const std::filesystem::path& path);
+        /// @param indexCacheDir Directory to store the list of files in to avoid walking the directory tree next time
+        /// when it's not changed. Not used when empty.
+        explicit FileSystemArchive(
+            const std::filesystem::path& path, const std::filesystem::path& indexCacheDir = std::filesystem::path());
 
-        void listResources(FileMap& out) override;
+        void listResources(FileIndex& out) override;
 
         bool contains(Path::NormalizedView file) const override;
 
@@ -39,6 +44,8 @@ namespace VFS
     private:
         std::map<VFS::Path::Normalized, FileSystemArchiveFile, std::less<>> mIndex;
         std::filesystem::path mPath;
+
+        void addFile(std::string_view relativePath, const std::filesystem::path& filePath);
     };
 
 }
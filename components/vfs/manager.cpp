@@ -3,6 +3,7 @@
 #include <cassert>
 #include <stdexcept>
 
+#include <components/bsa/decompressionpool.hpp>
 #include <components/files/conversion.hpp>
 #include <components/misc/strings/lower.hpp>
 #include <components/vfs/recursivedirectoryiterator.hpp>
@@ -26,6 +27,7 @@ namespace VFS
 
     void Manager::addArchive(std::unique_ptr<Archive>&& archive)
     {
+        archive->setDecompressionPool(mDecompressionPool.get());
         mArchives.push_back(std::move(archive));
     }
 
@@ -35,6 +37,24 @@ namespace VFS
 
         for (const auto& archive : mArchives)
             archive->listResources(mIndex);
+
+        mIndex.build();
+    }
+
+    void Manager::setDecompressionThreads(std::size_t threads)
+    {
+        if (threads == (mDecompressionPool == nullptr ? 0 : mDecompressionPool->getThreadCount()))
+            return;
+
+        for (const auto& archive : mArchives)
+            archive->setDecompressionPool(nullptr);
+
+        mDecompressionPool.reset();
+        if (threads > 0)
+            mDecompressionPool = std::make_unique<Bsa::DecompressionPool>(threads);
+
+        for (const auto& archive : mArchives)
+            archive->setDecompressionPool(mDecompressionPool.get());
     }
 
     Files::IStreamPtr Manager::find(Path::NormalizedView name) const
@@ -63,12 +83,12 @@ namespace VFS
 
     bool Manager::exists(const Path::Normalized& name) const
     {
-        return mIndex.find(name) != mIndex.end();
+        return mIndex.contains(name.view());
     }
 
     bool Manager::exists(Path::NormalizedView name) const
     {
-        return mIndex.find(name) != mIndex.end();
+        return mIndex.contains(name.value());
     }
 
     std::string Manager::getArchive(const Path::Normalized& name) const
@@ -83,42 +103,32 @@ namespace VFS
 
     std::filesystem::file_time_type Manager::getLastModified(VFS::Path::NormalizedView name) const
     {
-        const auto found = mIndex.find(name);
-        if (found == mIndex.end())
+        const File* const file = mIndex.find(name.value());
+        if (file == nullptr)
             throw std::runtime_error("Resource '" + std::string(name.value()) + "' not found");
-        return found->second->getLastModified();
+        return file->getLastModified();
     }
 
     std::string Manager::getStem(VFS::Path::NormalizedView name) const
     {
-        const auto found = mIndex.find(name);
-        if (found == mIndex.end())
+        const File* const file = mIndex.find(name.value());
+        if (file == nullptr)
             throw std::runtime_error("Resource '" + std::string(name.value()) + "' not found");
-        return found->second->getStem();
+        return file->getStem();
     }
 
     RecursiveDirectoryRange Manager::getRecursiveDirectoryIterator(std::string_view path) const
     {
         if (path.empty())
             return { mIndex.begin(), mIndex.end() };
-        std::string normalized = Path::normalizeFilename(path);
-        const auto it = mIndex.lower_bound(normalized);
-        if (it == mIndex.end() || !it->first.view().starts_with(normalized))
-            return { it, it };
-        ++normalized.back();
-        return { it, mIndex.lower_bound(normalized) };
+        const auto [first, last] = mIndex.getPrefixRange(Path::normalizeFilename(path));
+        return { first, last };
     }
 
     RecursiveDirectoryRange Manager::getRecursiveDirectoryIterator(VFS::Path::NormalizedView path) const
     {
-        if (path.value().empty())
-            return { mIndex.begin(), mIndex.end() };
-        const auto it = mIndex.lower_bound(path);
-        if (it == mIndex.end() || !it->first.view().starts_with(path.value()))
-            return { it, it };
-        std::string copy(path.value());
-        ++copy.back();
-        return { it, mIndex.lower_bound(copy) };
+        const auto [first, last] = mIndex.getPrefixRange(path.value());
+        return { first, last };
     }
 
     RecursiveDirectoryRange Manager::getRecursiveDirectoryIterator() const
@@ -129,9 +139,9 @@ namespace VFS
     Files::IStreamPtr Manager::findNormalized(std::string_view normalizedPath) const
     {
         assert(Path::isNormalized(normalizedPath));
-        const auto it = mIndex.find(normalizedPath);
-        if (it == mIndex.end())
+        File* const file = mIndex.find(normalizedPath);
+        if (file == nullptr)
             return nullptr;
-        return it->second->open();
+        return file->open();
     }
 }
@@ -9,9 +9,14 @@
 #include <string_view>
 #include <vector>
 
-#include "filemap.hpp"
+#include "fileindex.hpp"
 #include "pathutil.hpp"
 
+namespace Bsa
+{
+    class DecompressionPool;
+}
+
 namespace VFS
 {
     class Archive;
@@ -39,6 +44,15 @@ namespace VFS
         /// Build the file index. Should be called when all archives have been registered.
         void buildIndex();
 
+        /// Start the given number of threads to decompress archive files and use them for all registered archives.
+        /// With zero threads files are decompressed on the thread reading them.
+        /// @note Should be called before any file is read.
+        void setDecompressionThreads(std::size_t threads);
+
+        /// Get the pool used to decompress archive files, nullptr when there are no decompression threads.
+        /// @note May be called from any thread.
+        Bsa::DecompressionPool* getDecompressionPool() const { return mDecompressionPool.get(); }
+
         /// Does a file with this name exist?
         /// @note May be called from any thread once the index has been built.
         bool exists(const Path::Normalized& name) const;
@@ -74,7 +88,9 @@ namespace VFS
     private:
         std::vector<std::unique_ptr<Archive>> mArchives;
 
-        FileMap mIndex;
+        FileIndex mIndex;
+        // Declared after the archives to finish queued jobs before the archives are destroyed
+        std::unique_ptr<Bsa::DecompressionPool> mDecompressionPool;
 
         inline Files::IStreamPtr findNormalized(std::string_view normalizedPath) const;
 
@@ -3,7 +3,7 @@
 
 #include <string>
 
-#include "filemap.hpp"
+#include "fileindex.hpp"
 #include "pathutil.hpp"
 
 namespace VFS
@@ -11,7 +11,7 @@ namespace VFS
     class RecursiveDirectoryIterator
     {
     public:
-        RecursiveDirectoryIterator(FileMap::const_iterator it)
+        RecursiveDirectoryIterator(FileIndex::const_iterator it)
             : mIt(it)
         {
         }
@@ -29,7 +29,7 @@ namespace VFS
         friend bool operator==(const RecursiveDirectoryIterator& lhs, const RecursiveDirectoryIterator& rhs) = default;
 
     private:
-        FileMap::const_iterator mIt;
+        FileIndex::const_iterator mIt;
     };
 
     class RecursiveDirectoryRange
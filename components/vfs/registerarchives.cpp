@@ -14,7 +14,8 @@ namespace VFS
 {
 
     void registerArchives(VFS::Manager* vfs, const Files::Collections& collections,
-        const std::vector<std::string>& archives, bool useLooseFiles, const ToUTF8::StatelessUtf8Encoder* encoder)
+        const std::vector<std::string>& archives, bool useLooseFiles, const ToUTF8::StatelessUtf8Encoder* encoder,
+        const std::filesystem::path& indexCacheDir)
     {
         const Files::PathContainer& dataDirs = collections.getPaths();
 
@@ -42,7 +43,7 @@ namespace VFS
                 {
                     Log(Debug::Info) << "Adding data directory " << dataDir;
                     // Last data dir has the highest priority
-                    vfs->addArchive(std::make_unique<FileSystemArchive>(dataDir));
+                    vfs->addArchive(std::make_unique<FileSystemArchive>(dataDir, indexCacheDir));
                 }
                 else
                     Log(Debug::Info) << "Ignoring duplicate data directory " << dataDir;
@@ -3,6 +3,8 @@
 
 #include <components/files/collections.hpp>
 
+#include <filesystem>
+
 namespace ToUTF8
 {
     class StatelessUtf8Encoder;
@@ -13,8 +15,10 @@ namespace VFS
     class Manager;
 
     /// @brief Register BSA and file system archives based on the given OpenMW configuration.
+    /// @param indexCacheDir Directory to cache lists of loose files in, not used when empty.
     void registerArchives(VFS::Manager* vfs, const Files::Collections& collections,
-        const std::vector<std::string>& archives, bool useLooseFiles, const ToUTF8::StatelessUtf8Encoder* encoder);
+        const std::vector<std::string>& archives, bool useLooseFiles, const ToUTF8::StatelessUtf8Encoder* encoder,
+        const std::filesystem::path& indexCacheDir = std::filesystem::path());
 }
 
 #endif
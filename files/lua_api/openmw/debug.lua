@@ -89,4 +89,20 @@
 ---
 -- To reload modified shaders
 -- @function [parent=#Debug] triggerShaderReload
+
+---
+-- Start measuring wall time, call count and memory allocation of handlers of all scripts. Drops the previous capture.
+-- Lua call stacks are sampled only if `lua profiler` is enabled in settings.
+-- @function [parent=#Debug] startLuaProfiler
+
+---
+-- Stop the Lua profiler, log a summary and write the capture to `<path>.json` (Chrome trace) and `<path>.folded`
+-- (collapsed stacks for flame graphs). The path is set by `--lua-profile` command line option and is `lua_profile`
+-- in the log directory by default.
+-- @function [parent=#Debug] stopLuaProfiler
+
+---
+-- Is the Lua profiler running
+-- @function [parent=#Debug] isLuaProfilerRunning
+-- @return #boolean
 return nil
@@ -40,6 +40,61 @@
 -- @return openmw.core#GameObject
 -- @usage local obj = nearby.getObjectByFormId(core.getFormId('Morrowind.esm', 128964))
 
+---
+-- @type OBJECT_LIST
+-- @field [parent=#OBJECT_LIST] #number Activators Objects from `nearby.activators`
+-- @field [parent=#OBJECT_LIST] #number Actors Objects from `nearby.actors`
+-- @field [parent=#OBJECT_LIST] #number Containers Objects from `nearby.containers`
+-- @field [parent=#OBJECT_LIST] #number Doors Objects from `nearby.doors`
+-- @field [parent=#OBJECT_LIST] #number Items Objects from `nearby.items`
+-- @field [parent=#OBJECT_LIST] #number All Objects from all the lists above
+
+---
+-- Lists that are searched by `findObjectsInRadius`, `findObjectsInBox` and `findObjectsInCone`.
+-- Several lists can be combined with @{openmw_util#util.bitOr}.
+-- @field [parent=#nearby] #OBJECT_LIST OBJECT_LIST
+
+---
+-- A table of parameters for @{#nearby.findObjectsInRadius}, @{#nearby.findObjectsInBox} and
+-- @{#nearby.findObjectsInCone}
+-- @type FindObjectsOptions
+-- @field #number lists Lists to search (see @{openmw.nearby#OBJECT_LIST}), all by default
+
+---
+-- Find objects with position within the given distance from a point.
+-- Much faster than checking the distance to every object of `nearby.actors` or other lists in Lua.
+-- Positions are taken once per frame, so objects moved by the current script are found at the old position.
+-- Raises an error if any of the numbers is NaN or infinite.
+-- @function [parent=#nearby] findObjectsInRadius
+-- @param openmw.util#Vector3 center
+-- @param #number radius
+-- @param #FindObjectsOptions options An optional table with additional optional arguments
+-- @return openmw.core#ObjectList Objects sorted by distance to the center
+-- @usage local enemies = nearby.findObjectsInRadius(self.position, 500, {lists = nearby.OBJECT_LIST.Actors})
+
+---
+-- Find objects with position inside of a box.
+-- Raises an error if any of the numbers is NaN or infinite.
+-- @function [parent=#nearby] findObjectsInBox
+-- @param openmw.util#Box box
+-- @param #FindObjectsOptions options An optional table with additional optional arguments
+-- @return openmw.core#ObjectList Objects sorted by distance to the box center
+
+---
+-- Find objects with position inside of a cone.
+-- Raises an error if any of the numbers is NaN or infinite.
+-- @function [parent=#nearby] findObjectsInCone
+-- @param openmw.util#Vector3 apex
+-- @param openmw.util#Vector3 direction Axis of the cone
+-- @param #number angle Maximal angle (in radians) between the axis and the direction to an object
+-- @param #number range Maximal distance from the apex
+-- @param #FindObjectsOptions options An optional table with additional optional arguments
+-- @return openmw.core#ObjectList Objects sorted by distance to the apex
+-- @usage -- Items in front of the actor within 60 degrees field of view
+-- local forward = self.rotation * util.vector3(0, 1, 0)
+-- local items = nearby.findObjectsInCone(self.position, forward, math.rad(30), 300,
+--     {lists = nearby.OBJECT_LIST.Items})
+
 ---
 -- @type COLLISION_TYPE
 -- @field [parent=#COLLISION_TYPE] #number World